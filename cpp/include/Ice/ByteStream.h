@@ -0,0 +1,200 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_BYTE_STREAM_H
+#define ICE_BYTE_STREAM_H
+
+#include <IceUtil/Monitor.h>
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Time.h>
+#include <Ice/Object.h>
+#include <Ice/Proxy.h>
+#include <Ice/Current.h>
+#include <Ice/IncomingAsync.h>
+#include <Ice/UniquePtr.h>
+
+#include <map>
+#include <deque>
+
+namespace Ice
+{
+
+/**
+ * Sends a sequence of bytes of arbitrary length to a ByteStreamServant without materializing
+ * it in a single request. The bytes are sent in chunks, each chunk being an ordinary twoway
+ * request for the given operation with the in-parameters of the following Slice operation:
+ *
+ * <pre>
+ * void op(string stream, int chunk, bool last, Ice::ByteSeq data);
+ * </pre>
+ *
+ * At most window chunks are outstanding at any time: write blocks until the receiver
+ * acknowledges an outstanding chunk, which bounds the memory used by the stream on
+ * both sides to window chunks.
+ * \headerfile Ice/Ice.h
+ */
+class ICE_API ByteStreamWriter :
+#ifdef ICE_CPP11_MAPPING
+    public std::enable_shared_from_this<ByteStreamWriter>,
+#else
+    public virtual IceUtil::Shared,
+#endif
+    private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    /**
+     * Constructs a writer for a new stream. The stream is identified by a UUID.
+     * @param proxy The proxy of the ByteStreamServant receiving the stream.
+     * @param operation The name of the operation used to send the chunks.
+     * @param chunkSize The maximum number of bytes sent with each chunk.
+     * @param window The maximum number of outstanding chunks.
+     */
+    ByteStreamWriter(const ObjectPrxPtr& proxy, const std::string& operation, int chunkSize = 64 * 1024,
+                     int window = 4);
+
+    /**
+     * Obtains the identifier of this stream, as provided to ByteStreamServant::received.
+     * @return The stream identifier.
+     */
+    const std::string& getId() const;
+
+    /**
+     * Writes bytes to the stream. Complete chunks are sent as soon as they are filled, the
+     * remaining bytes are buffered until the next write or until the stream is closed.
+     * @param begin The start of the bytes to write.
+     * @param end The end of the bytes to write.
+     * @throws Exception Raised if sending a previous chunk failed.
+     */
+    void write(const Byte* begin, const Byte* end);
+
+    /**
+     * Writes bytes to the stream.
+     * @param bytes The bytes to write.
+     * @throws Exception Raised if sending a previous chunk failed.
+     */
+    void write(const std::vector<Byte>& bytes);
+
+    /**
+     * Sends the buffered bytes as the last chunk of the stream and waits until the receiver
+     * acknowledged all the chunks.
+     * @throws Exception Raised if sending a chunk failed.
+     */
+    void close();
+
+private:
+
+    void send(const Byte*, const Byte*, bool);
+    void completed();
+    void exception(const Exception&);
+
+#ifndef ICE_CPP11_MAPPING
+    void response(bool, const std::pair<const Byte*, const Byte*>&);
+#endif
+
+    const ObjectPrxPtr _proxy;
+    const std::string _operation;
+    const std::string _id;
+    const size_t _chunkSize;
+    const int _window;
+
+    std::vector<Byte> _buffer;
+    Int _nextChunk;
+    int _outstanding;
+    bool _closed;
+    IceInternal::UniquePtr<Exception> _exception;
+};
+ICE_DEFINE_PTR(ByteStreamWriterPtr, ByteStreamWriter);
+
+/**
+ * Base class for servants receiving streams sent by a ByteStreamWriter. The chunks of a
+ * stream are passed to received in order and one at a time, as they arrive. A chunk is
+ * acknowledged to the writer once received returns, so a slow consumer throttles the
+ * writer. If received raises an exception, the exception is returned to the writer and
+ * the stream is aborted: the chunks of the stream which are still in flight are rejected.
+ * A stream which doesn't receive any chunk for the idle timeout is discarded along with
+ * its chunks received out of order, and chunks of unknown streams which can't be the first
+ * chunks of a new stream are rejected.
+ * \headerfile Ice/Ice.h
+ */
+class ICE_API ByteStreamServant : public BlobjectArrayAsync
+{
+public:
+
+    /**
+     * Constructs the servant.
+     * @param maxPending The maximum number of chunks received out of order which are kept
+     * per stream until their predecessors are received. This should be at least the window
+     * size of the writers.
+     * @param idleTimeout The number of seconds after which a stream which doesn't receive any
+     * chunk is discarded.
+     */
+    ByteStreamServant(int maxPending = 16, int idleTimeout = 60);
+
+    /**
+     * Called for each chunk of a stream.
+     * @param stream The identifier of the stream.
+     * @param data The bytes of the chunk. The bytes are only valid for the duration of the call.
+     * @param last True if this is the last chunk of the stream.
+     * @param current The Current object for the request carrying the chunk.
+     */
+    virtual void received(const std::string& stream, const std::pair<const Byte*, const Byte*>& data, bool last,
+                          const Current& current) = 0;
+
+    /// \cond INTERNAL
+#ifdef ICE_CPP11_MAPPING
+    virtual void ice_invokeAsync(std::pair<const Byte*, const Byte*>,
+                                 std::function<void(bool, const std::pair<const Byte*, const Byte*>&)>,
+                                 std::function<void(std::exception_ptr)>,
+                                 const Current&);
+#else
+    virtual void ice_invoke_async(const AMD_Object_ice_invokePtr&, const std::pair<const Byte*, const Byte*>&,
+                                  const Current&);
+#endif
+    /// \endcond
+
+private:
+
+    struct Chunk
+    {
+        std::vector<Byte> data;
+        bool last;
+        Current current;
+#ifdef ICE_CPP11_MAPPING
+        std::function<void(bool, const std::pair<const Byte*, const Byte*>&)> response;
+        std::function<void(std::exception_ptr)> error;
+#else
+        AMD_Object_ice_invokePtr cb;
+#endif
+    };
+
+    struct Stream
+    {
+        Stream() : nextChunk(0), dispatching(false), aborted(false)
+        {
+        }
+
+        Int nextChunk;
+        bool dispatching;
+        bool aborted;
+        IceUtil::Time lastActivity;
+        std::map<Int, Chunk> pending;
+    };
+
+    void reap();
+    void dispatch(const std::string&, Int, const std::pair<const Byte*, const Byte*>&, Chunk&, const Current&);
+    bool deliver(const std::string&, const std::pair<const Byte*, const Byte*>&, const Chunk&, const Current&);
+
+    const size_t _maxPending;
+    const IceUtil::Time _idleTimeout;
+    IceUtil::Mutex _mutex;
+    IceUtil::Time _nextReap;
+    std::map<std::string, Stream> _streams;
+    std::deque<std::string> _aborted;
+};
+ICE_DEFINE_PTR(ByteStreamServantPtr, ByteStreamServant);
+
+}
+
+#endif
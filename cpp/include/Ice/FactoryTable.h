@@ -8,6 +8,7 @@
 #include <IceUtil/Mutex.h>
 #include <Ice/UserExceptionFactory.h>
 #include <Ice/ValueFactory.h>
+#include <Ice/ValueArena.h>
 
 namespace Ice
 {
@@ -47,6 +48,12 @@ public:
     ICE_DELEGATE(::Ice::ValueFactory) getValueFactory(const ::std::string&) const;
     void removeValueFactory(const ::std::string&);
 
+#ifdef ICE_CPP11_MAPPING
+    void addArenaValueFactory(const ::std::string&, ArenaValueFactory);
+    ArenaValueFactory getArenaValueFactory(const ::std::string&) const;
+    void removeArenaValueFactory(const ::std::string&);
+#endif
+
     void addTypeId(int, const ::std::string&);
     std::string getTypeId(int) const;
     void removeTypeId(int);
@@ -63,6 +70,12 @@ private:
     typedef ::std::map< ::std::string, VFPair> VFTable;
     VFTable _vft;
 
+#ifdef ICE_CPP11_MAPPING
+    typedef ::std::pair<ArenaValueFactory, int> AVFPair;
+    typedef ::std::map< ::std::string, AVFPair> AVFTable;
+    AVFTable _avft;
+#endif
+
     typedef ::std::pair< ::std::string, int> TypeIdPair;
     typedef ::std::map<int, TypeIdPair> TypeIdTable;
     TypeIdTable _typeIdTable;
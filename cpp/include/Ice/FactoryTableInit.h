@@ -66,6 +66,7 @@ public:
     {
 #ifdef ICE_CPP11_MAPPING
         factoryTable->addValueFactory(typeId, defaultValueFactory<O>);
+        factoryTable->addArenaValueFactory(typeId, arenaValueFactory<O>);
 #else
         factoryTable->addValueFactory(typeId, new DefaultValueFactory<O>(typeId));
 #endif
@@ -74,6 +75,9 @@ public:
     ~DefaultValueFactoryInit()
     {
         factoryTable->removeValueFactory(typeId);
+#ifdef ICE_CPP11_MAPPING
+        factoryTable->removeArenaValueFactory(typeId);
+#endif
     }
 
     const ::std::string typeId;
@@ -0,0 +1,44 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_FILE_DESCRIPTORS_H
+#define ICE_FILE_DESCRIPTORS_H
+
+#include <Ice/Config.h>
+#include <Ice/ConnectionF.h>
+
+#include <vector>
+
+#if !defined(_WIN32) && (!defined(__APPLE__) || TARGET_OS_IPHONE == 0)
+
+namespace Ice
+{
+
+/**
+ * Queues file descriptors to be passed to the peer of a unix connection. The descriptors are
+ * duplicated, the caller keeps ownership of the given descriptors. The queued descriptors are
+ * sent with the next bytes written to the connection: descriptors queued before sending a
+ * request on the connection are received by the peer before it dispatches this request.
+ * @param connection The unix connection.
+ * @param fds The file descriptors to pass.
+ * @throws FeatureNotSupportedException Raised if the connection is not a unix connection.
+ */
+ICE_API void sendFileDescriptors(const ConnectionPtr& connection, const std::vector<int>& fds);
+
+/**
+ * Takes file descriptors received over a unix connection, in the order in which they were
+ * sent by the peer. The caller owns the returned descriptors and is responsible for closing
+ * them.
+ * @param connection The unix connection.
+ * @param max The maximum number of descriptors to take.
+ * @return The received descriptors, an empty vector if no descriptors were received.
+ * @throws FeatureNotSupportedException Raised if the connection is not a unix connection.
+ */
+ICE_API std::vector<int> takeFileDescriptors(const ConnectionPtr& connection, size_t max);
+
+}
+
+#endif
+
+#endif
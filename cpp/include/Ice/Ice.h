@@ -13,6 +13,7 @@
 #include <Ice/LocalException.h>
 #include <Ice/PropertiesAdmin.h>
 #include <Ice/Properties.h>
+#include <Ice/PropertyAccessor.h>
 #include <Ice/Logger.h>
 #include <Ice/LoggerUtil.h>
 #include <Ice/RemoteLogger.h>
@@ -37,6 +38,8 @@
 #include <Ice/Locator.h>
 #include <Ice/Router.h>
 #include <Ice/DispatchInterceptor.h>
+#include <Ice/ByteStream.h>
+#include <Ice/FileDescriptors.h>
 #include <Ice/Plugin.h>
 #include <Ice/NativePropertiesAdmin.h>
 #include <Ice/Instrumentation.h>
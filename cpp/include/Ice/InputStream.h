@@ -18,6 +18,7 @@
 #include <Ice/UserExceptionFactory.h>
 #include <Ice/StreamHelpers.h>
 #include <Ice/FactoryTable.h>
+#include <Ice/ValueArena.h>
 
 namespace Ice
 {
@@ -189,6 +190,11 @@ public:
         {
             d();
         }
+
+        if(_arena)
+        {
+            _arena->release();
+        }
 #endif
     }
 
@@ -251,6 +257,19 @@ public:
     void setCompactIdResolver(const CompactIdResolverPtr& r);
 #endif
 
+#ifdef ICE_CPP11_MAPPING
+    /**
+     * Indicates whether to allocate the instances of Slice classes unmarshaled from the
+     * current encapsulation in an arena. The memory of the arena is released at once when
+     * the last instance allocated in it is destroyed, which is cheaper than releasing the
+     * memory of each instance for large graphs. Instances created by a value factory
+     * registered with the communicator are not allocated in the arena. The setting is
+     * reset when the encapsulation ends, the default is false.
+     * @param b True to allocate instances in an arena, false otherwise.
+     */
+    void setArenaAllocation(bool b);
+#endif
+
 #ifndef ICE_CPP11_MAPPING
     /**
      * Indicates whether to mark instances of Slice classes as collectable. If the stream is
@@ -1263,7 +1282,7 @@ private:
         EncapsDecoder(InputStream* stream, Encaps* encaps, bool sliceValues, size_t classGraphDepthMax,
                       const Ice::ValueFactoryManagerPtr& f) :
             _stream(stream), _encaps(encaps), _sliceValues(sliceValues), _classGraphDepthMax(classGraphDepthMax),
-            _classGraphDepth(0), _valueFactoryManager(f), _typeIdIndex(0)
+            _classGraphDepth(0), _valueFactoryManager(f)
         {
         }
 
@@ -1273,8 +1292,93 @@ private:
         void addPatchEntry(Int, PatchFunc, void*);
         void unmarshal(Int, const ValuePtr&);
 
-        typedef std::map<Int, ValuePtr> IndexToPtrMap;
-        typedef std::map<Int, std::string> TypeIdMap;
+        //
+        // The sender assigns indexes to instances sequentially, the tables indexed
+        // by instance index keep the entries in a vector. An entry whose index is
+        // too far beyond the number of entries inserted so far is kept in a map
+        // instead, to not allocate a large vector for a bogus index.
+        //
+        template<typename T> class IndexTable
+        {
+        public:
+
+            IndexTable() : _size(0), _inserted(0)
+            {
+            }
+
+            T* find(Int index)
+            {
+                const size_t i = static_cast<size_t>(index);
+                if(i < _dense.size())
+                {
+                    return _dense[i].first ? &_dense[i].second : 0;
+                }
+                typename std::map<Int, T>::iterator p = _sparse.find(index);
+                return p != _sparse.end() ? &p->second : 0;
+            }
+
+            T& insert(Int index)
+            {
+                const size_t i = static_cast<size_t>(index);
+                ++_inserted;
+                if(i >= _dense.size() && i < 2 * _inserted + 64)
+                {
+                    _dense.resize(i + 1);
+                }
+
+                T* v;
+                bool inserted;
+                if(i < _dense.size())
+                {
+                    inserted = !_dense[i].first;
+                    _dense[i].first = true;
+                    v = &_dense[i].second;
+                }
+                else
+                {
+                    typename std::map<Int, T>::iterator p = _sparse.find(index);
+                    inserted = p == _sparse.end();
+                    v = &_sparse[index];
+                }
+                if(inserted)
+                {
+                    ++_size;
+                }
+                return *v;
+            }
+
+            void erase(Int index)
+            {
+                const size_t i = static_cast<size_t>(index);
+                if(i < _dense.size())
+                {
+                    if(_dense[i].first)
+                    {
+                        _dense[i] = std::pair<bool, T>();
+                        --_size;
+                    }
+                }
+                else if(_sparse.erase(index) > 0)
+                {
+                    --_size;
+                }
+            }
+
+            bool empty() const
+            {
+                return _size == 0;
+            }
+
+        private:
+
+            std::vector<std::pair<bool, T> > _dense; // Whether the entry is set and its value.
+            std::map<Int, T> _sparse;
+            size_t _size;
+            size_t _inserted;
+        };
+
+        typedef IndexTable<ValuePtr> IndexToPtrMap;
+        typedef std::vector<std::string> TypeIdList;
 
         struct PatchEntry
         {
@@ -1283,7 +1387,7 @@ private:
             size_t classGraphDepth;
         };
         typedef std::vector<PatchEntry> PatchList;
-        typedef std::map<Int, PatchList> PatchMap;
+        typedef IndexTable<PatchList> PatchMap;
 
         InputStream* _stream;
         Encaps* _encaps;
@@ -1299,8 +1403,7 @@ private:
 
         // Encapsulation attributes for object un-marshalling
         IndexToPtrMap _unmarshaledMap;
-        TypeIdMap _typeIdMap;
-        Int _typeIdIndex;
+        TypeIdList _typeIds; // Type ID with index i + 1 at position i.
         ValueList _valueList;
     };
 
@@ -1436,6 +1539,9 @@ private:
     public:
 
         Encaps() : start(0), decoder(0), previous(0)
+#ifdef ICE_CPP11_MAPPING
+            , arenaAllocation(false)
+#endif
         {
             // Inlined for performance reasons.
         }
@@ -1451,6 +1557,9 @@ private:
             decoder = 0;
 
             previous = 0;
+#ifdef ICE_CPP11_MAPPING
+            arenaAllocation = false;
+#endif
         }
 
         Container::size_type start;
@@ -1460,6 +1569,10 @@ private:
         EncapsDecoder* decoder;
 
         Encaps* previous;
+
+#ifdef ICE_CPP11_MAPPING
+        bool arenaAllocation;
+#endif
     };
 
     //
@@ -1505,6 +1618,8 @@ private:
 
 #ifdef ICE_CPP11_MAPPING
     std::vector<std::function<void()>> _deleters;
+
+    IceInternal::ValueArena* _arena; // Created when the first instance is allocated in an arena.
 #endif
 
 };
@@ -8,6 +8,7 @@
 #include <Ice/Properties.h>
 #include <Ice/NativePropertiesAdmin.h>
 #include <Ice/Initialize.h>
+#include <Ice/UniquePtr.h>
 
 #include <Ice/Metrics.h>
 
@@ -41,6 +42,56 @@ template<typename T> class MetricsHelperT;
 namespace IceInternal
 {
 
+//
+// A histogram of the lifetime of metrics objects. The buckets are
+// log-linear: 8 buckets for each power of two. The observations are
+// counted in shards selected from the calling thread to avoid contention
+// between threads, the shards are merged when the histogram is read.
+//
+class ICE_API MetricsHistogram : private IceUtil::noncopyable
+{
+public:
+
+    MetricsHistogram();
+    ~MetricsHistogram();
+
+    void add(Ice::Long);
+    IceMX::LatencyHistogram get() const;
+
+private:
+
+    struct Shard
+    {
+        Shard() : buckets(0)
+        {
+        }
+
+        IceUtil::Mutex mutex;
+        Ice::Long* buckets; // Allocated on first use.
+        char padding[64]; // Avoid false sharing between shards.
+    };
+
+    Shard _shards[16];
+};
+
+//
+// Identifies the source of the cacheable attributes of a metrics helper:
+// the proxy and operation of an invocation or the object adapter, identity,
+// facet and operation of a dispatch. See MetricsMapT::getMatching. The
+// cache keeps the proxies of its keys alive until it's cleared, fixed
+// proxies are never used as keys since they hold a connection.
+//
+struct ICE_API MetricsCacheKey
+{
+    Ice::ObjectPrxPtr proxy;
+    std::string adapter;
+    Ice::Identity identity;
+    std::string facet;
+    std::string operation;
+
+    bool operator<(const MetricsCacheKey&) const;
+};
+
 class ICE_API MetricsMapI;
 ICE_DEFINE_PTR(MetricsMapIPtr, MetricsMapI);
 
@@ -75,6 +126,11 @@ public:
             return match(value);
         }
 
+        const std::string& getAttribute() const
+        {
+            return _attribute;
+        }
+
     private:
 
         bool match(const std::string&);
@@ -98,6 +154,18 @@ public:
     };
     ICE_DEFINE_PTR(RegExpPtr, RegExp);
 
+    //
+    // Receives the metrics of the map objects, see visitMetrics.
+    //
+    class ICE_API Visitor
+    {
+    public:
+
+        virtual ~Visitor();
+
+        virtual void visit(const IceMX::MetricsPtr&) = 0;
+    };
+
     virtual ~MetricsMapI();
 
     MetricsMapI(const std::string&, const Ice::PropertiesPtr&);
@@ -108,6 +176,7 @@ public:
     virtual IceMX::MetricsFailuresSeq getFailures() = 0;
     virtual IceMX::MetricsFailures getFailures(const std::string&) = 0;
     virtual IceMX::MetricsMap getMetrics() const = 0;
+    virtual void visitMetrics(Visitor&) const = 0;
 
     virtual MetricsMapIPtr clone() const = 0;
 
@@ -119,6 +188,7 @@ protected:
     const std::vector<std::string> _groupByAttributes;
     const std::vector<std::string> _groupBySeparators;
     const int _retain;
+    const bool _histogram;
     const std::vector<RegExpPtr> _accept;
     const std::vector<RegExpPtr> _reject;
 };
@@ -168,7 +238,7 @@ public:
     public:
 
         EntryT(MetricsMapTPtr map, const TPtr& object, const typename std::list<EntryTPtr>::iterator& p) :
-            _map(map), _object(object), _detachedPos(p)
+            _map(map), _object(object), _latency(map->_histogram ? new MetricsHistogram() : 0), _detachedPos(p)
         {
         }
 
@@ -221,6 +291,11 @@ public:
         void
         detach(Ice::Long lifetime)
         {
+            if(_latency.get())
+            {
+                _latency->add(lifetime); // Outside the map lock, the histogram is sharded.
+            }
+
             IceUtil::Mutex::Lock sync(*_map);
             _object->totalLifetime += lifetime;
             if(--_object->current == 0)
@@ -266,6 +341,10 @@ public:
             {
                 metrics.get()->*p->second.second = p->second.first->getMetrics();
             }
+            if(_latency.get())
+            {
+                metrics->latency = _latency->get();
+            }
             return metrics;
         }
 
@@ -286,6 +365,7 @@ public:
         friend class MetricsMapT;
         MetricsMapTPtr _map;
         TPtr _object;
+        const IceInternal::UniquePtr<MetricsHistogram> _latency;
         IceMX::StringIntDict _failures;
         std::map<std::string, std::pair<MetricsMapIPtr, SubMapMember> > _subMaps;
         typename std::list<EntryTPtr>::iterator _detachedPos;
@@ -345,6 +425,7 @@ public:
         _destroyed = true;
         _objects.clear(); // Break cyclic reference counts
         _detachedQueue.clear(); // Break cyclic reference counts
+        _cache.clear(); // Break cyclic reference counts
     }
 
     virtual IceMX::MetricsMap
@@ -360,6 +441,36 @@ public:
         return objects;
     }
 
+    virtual void
+    visitMetrics(Visitor& visitor) const
+    {
+        //
+        // Unlike getMetrics, the map isn't copied: each object is cloned
+        // with the map locked only for the duration of the clone and the
+        // visitor is called without the lock.
+        //
+        std::vector<EntryTPtr> entries;
+        {
+            Lock sync(*this);
+            entries.reserve(_objects.size());
+            for(typename std::map<std::string, EntryTPtr>::const_iterator p = _objects.begin(); p != _objects.end();
+                ++p)
+            {
+                entries.push_back(p->second);
+            }
+        }
+
+        for(typename std::vector<EntryTPtr>::const_iterator p = entries.begin(); p != entries.end(); ++p)
+        {
+            IceMX::MetricsPtr metrics;
+            {
+                Lock sync(*this);
+                metrics = (*p)->clone();
+            }
+            visitor.visit(metrics);
+        }
+    }
+
     virtual IceMX::MetricsFailuresSeq
     getFailures()
     {
@@ -404,6 +515,34 @@ public:
     EntryTPtr
     getMatching(const IceMX::MetricsHelperT<T>& helper, const EntryTPtr& previous = EntryTPtr())
     {
+        //
+        // If the attributes used by the filters and the GroupBy property only
+        // depend on the helper cache key, the result of the previous lookup
+        // with the same key is cached. This saves evaluating the filters and
+        // computing the key of the metrics object, which often requires
+        // stringifying a proxy or an identity.
+        //
+        MetricsCacheKey cacheKey;
+        const bool cacheable = isCacheable(helper) && helper.getCacheKey(cacheKey);
+        if(cacheable)
+        {
+            Lock sync(*this);
+            if(_destroyed)
+            {
+                return ICE_NULLPTR;
+            }
+
+            typename std::map<MetricsCacheKey, EntryTPtr>::const_iterator p = _cache.find(cacheKey);
+            if(p != _cache.end())
+            {
+                if(p->second && p->second != previous)
+                {
+                    p->second->attach(helper);
+                }
+                return p->second;
+            }
+        }
+
         //
         // Check the accept and reject filters.
         //
@@ -411,7 +550,7 @@ public:
         {
             if(!(*p)->match(helper, false))
             {
-                return ICE_NULLPTR;
+                return rejected(cacheable ? &cacheKey : 0);
             }
         }
 
@@ -419,7 +558,7 @@ public:
         {
             if((*p)->match(helper, true))
             {
-                return ICE_NULLPTR;
+                return rejected(cacheable ? &cacheKey : 0);
             }
         }
 
@@ -451,7 +590,7 @@ public:
         }
         catch(const std::exception&)
         {
-            return ICE_NULLPTR;
+            return rejected(cacheable ? &cacheKey : 0);
         }
 
         //
@@ -466,6 +605,10 @@ public:
         if(previous && previous->_object->id == key)
         {
             assert(_objects[key] == previous);
+            if(cacheable)
+            {
+                addToCache(cacheKey, previous);
+            }
             return previous;
         }
 
@@ -484,12 +627,70 @@ public:
 #endif
 
         }
+        if(cacheable)
+        {
+            addToCache(cacheKey, p->second);
+        }
         p->second->attach(helper);
         return p->second;
     }
 
 private:
 
+    bool
+    isCacheable(const IceMX::MetricsHelperT<T>& helper) const
+    {
+        for(std::vector<std::string>::const_iterator p = _groupByAttributes.begin(); p != _groupByAttributes.end();
+            ++p)
+        {
+            if(!helper.isCacheable(*p))
+            {
+                return false;
+            }
+        }
+        for(std::vector<RegExpPtr>::const_iterator p = _accept.begin(); p != _accept.end(); ++p)
+        {
+            if(!helper.isCacheable((*p)->getAttribute()))
+            {
+                return false;
+            }
+        }
+        for(std::vector<RegExpPtr>::const_iterator p = _reject.begin(); p != _reject.end(); ++p)
+        {
+            if(!helper.isCacheable((*p)->getAttribute()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    EntryTPtr
+    rejected(const MetricsCacheKey* cacheKey)
+    {
+        if(cacheKey)
+        {
+            Lock sync(*this);
+            if(!_destroyed)
+            {
+                addToCache(*cacheKey, ICE_NULLPTR);
+            }
+        }
+        return ICE_NULLPTR;
+    }
+
+    void
+    addToCache(const MetricsCacheKey& cacheKey, const EntryTPtr& entry)
+    {
+        // This is called with the map mutex locked.
+
+        if(_cache.size() >= 1024)
+        {
+            _cache.clear(); // Keep the cache bounded, it's refilled on the next lookups.
+        }
+        _cache.insert(typename std::map<MetricsCacheKey, EntryTPtr>::value_type(cacheKey, entry));
+    }
+
     virtual MetricsMapIPtr clone() const
     {
         return ICE_MAKE_SHARED(MetricsMapT<MetricsType>, *this);
@@ -541,6 +742,7 @@ private:
         {
             _objects.erase(_detachedQueue.front()->_object->id);
             _detachedQueue.pop_front();
+            _cache.clear(); // The cache might reference the removed entry.
         }
 
         // Add the entry at the back of the queue.
@@ -554,6 +756,7 @@ private:
     bool _destroyed;
     std::map<std::string, EntryTPtr> _objects;
     std::list<EntryTPtr> _detachedQueue;
+    std::map<MetricsCacheKey, EntryTPtr> _cache;
     std::map<std::string, std::pair<SubMapMember, MetricsMapIPtr> > _subMaps;
 };
 
@@ -692,6 +895,11 @@ public:
 #endif
     std::vector<MetricsMapIPtr> getMaps(const std::string&) const;
 
+    //
+    // Returns the maps of the enabled views indexed by map name and view name.
+    //
+    std::map<std::string, std::map<std::string, MetricsMapIPtr> > getMapsByName() const;
+
     const Ice::LoggerPtr& getLogger() const;
 
 private:
@@ -37,6 +37,18 @@ public:
         // To be overridden in specialization to initialize state attributes
     }
 
+    virtual bool getCacheKey(IceInternal::MetricsCacheKey&) const
+    {
+        // To be overridden in specialization if the value of some attributes
+        // only depends on a cache key, see isCacheable.
+        return false;
+    }
+
+    virtual bool isCacheable(const std::string&) const
+    {
+        return false;
+    }
+
 protected:
 
     template<typename Helper> class AttributeResolverT
@@ -15,6 +15,10 @@
 #include <Ice/SlicedDataF.h>
 #include <Ice/StreamHelpers.h>
 
+#ifdef ICE_CPP11_COMPILER
+#   include <unordered_map>
+#endif
+
 namespace Ice
 {
 
@@ -929,8 +933,29 @@ private:
         OutputStream* _stream;
         Encaps* _encaps;
 
+#ifdef ICE_CPP11_COMPILER
+        struct PtrHash
+        {
+            size_t operator()(const ValuePtr& v) const
+            {
+                return std::hash<const void*>()(v.get());
+            }
+        };
+
+        struct PtrEqual
+        {
+            bool operator()(const ValuePtr& lhs, const ValuePtr& rhs) const
+            {
+                return lhs.get() == rhs.get();
+            }
+        };
+
+        typedef std::unordered_map<ValuePtr, Int, PtrHash, PtrEqual> PtrToIndexMap;
+        typedef std::unordered_map<std::string, Int> TypeIdMap;
+#else
         typedef std::map<ValuePtr, Int> PtrToIndexMap;
         typedef std::map<std::string, Int> TypeIdMap;
+#endif
 
         // Encapsulation attributes for value marshaling.
         PtrToIndexMap _marshaledMap;
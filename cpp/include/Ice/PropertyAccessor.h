@@ -0,0 +1,111 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_PROPERTY_ACCESSOR_H
+#define ICE_PROPERTY_ACCESSOR_H
+
+#include <Ice/Properties.h>
+
+namespace Ice
+{
+
+class PropertiesI;
+
+/**
+ * A handle to a single property of a property set. The accessor resolves the
+ * property key once when it is created, reading the property with the accessor
+ * doesn't look up the key and doesn't lock the property set. This is intended
+ * for properties that are read frequently, such as properties read for each
+ * connection or invocation.
+ *
+ * For example:
+ *
+ * \code
+ * Ice::PropertyAccessor traceLevel(communicator->getProperties(), "MyApp.Trace");
+ * ...
+ * if(traceLevel.getAsInt() > 0)
+ * {
+ *     ...
+ * }
+ * \endcode
+ *
+ * The accessor always returns the current value of the property, including
+ * updates made with Properties::setProperty after the accessor was created.
+ * \headerfile Ice/Ice.h
+ */
+class ICE_API PropertyAccessor
+{
+public:
+
+    /**
+     * Constructs an accessor that isn't associated with a property set. All
+     * the properties read with this accessor are unset.
+     */
+    PropertyAccessor();
+
+    /**
+     * Constructs an accessor for the given property.
+     * @param properties The property set.
+     * @param key The property key.
+     */
+    PropertyAccessor(const PropertiesPtr& properties, const std::string& key);
+
+    /**
+     * Get the key of the property.
+     * @return The property key.
+     */
+    const std::string& getKey() const;
+
+    /**
+     * Get the property value.
+     * @return The property value or the empty string if the property is not set.
+     */
+    std::string get() const;
+
+    /**
+     * Get the property value, or the given default value if the property is not set.
+     * @param value The default value.
+     * @return The property value or the default value.
+     */
+    std::string getWithDefault(const std::string& value) const;
+
+    /**
+     * Get the property value as an integer.
+     * @return The property value interpreted as an integer, or 0 if the property is not set.
+     */
+    Int getAsInt() const;
+
+    /**
+     * Get the property value as an integer, or the given default value if the property is not set.
+     * @param value The default value.
+     * @return The property value interpreted as an integer, or the default value.
+     */
+    Int getAsIntWithDefault(Int value) const;
+
+    /**
+     * Get the property value as a list of strings.
+     * @return The property value interpreted as a list of strings, or an empty list if the
+     * property is not set.
+     */
+    StringSeq getAsList() const;
+
+    /**
+     * Get the property value as a list of strings, or the given default value if the property
+     * is not set.
+     * @param value The default value.
+     * @return The property value interpreted as a list of strings, or the default value.
+     */
+    StringSeq getAsListWithDefault(const StringSeq& value) const;
+
+private:
+
+    PropertiesPtr _properties;
+    PropertiesI* _impl; // Null if the property set isn't implemented by the Ice run time.
+    size_t _slot;
+    std::string _key;
+};
+
+}
+
+#endif
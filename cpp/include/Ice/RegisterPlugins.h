@@ -39,6 +39,15 @@ namespace Ice
  */
 ICE_PLUGIN_REGISTER_DECLSPEC_IMPORT void registerIceStringConverter(bool loadOnInitialize = true);
 
+/**
+ * When using static libraries, calling this function ensures the metrics exporter plug-in is
+ * linked with the application.
+ * @param loadOnInitialize If true, the plug-in is loaded (created) during communicator initialization.
+ * If false, the plug-in is only loaded during communicator initialization if its corresponding
+ * plug-in property is set to 1.
+ */
+ICE_PLUGIN_REGISTER_DECLSPEC_IMPORT void registerIceMetricsExporter(bool loadOnInitialize = true);
+
 /**
  * When using static libraries, calling this function ensures the UDP transport is
  * linked with the application.
@@ -56,6 +65,28 @@ ICE_PLUGIN_REGISTER_DECLSPEC_IMPORT void registerIceUDP(bool loadOnInitialize =
  * plug-in property is set to 1.
  */
 ICE_PLUGIN_REGISTER_DECLSPEC_IMPORT void registerIceWS(bool loadOnInitialize = true);
+
+#if defined(ICE_HAS_SHM)
+/**
+ * When using static libraries, calling this function ensures the shared memory transport is
+ * linked with the application. The shared memory transport requires glibc 2.27 or later.
+ * @param loadOnInitialize If true, the plug-in is loaded (created) during communicator initialization.
+ * If false, the plug-in is only loaded during communicator initialization if its corresponding
+ * plug-in property is set to 1.
+ */
+ICE_PLUGIN_REGISTER_DECLSPEC_IMPORT void registerIceSHM(bool loadOnInitialize = true);
+#endif
+
+#if !defined(_WIN32) && (!defined(__APPLE__) || TARGET_OS_IPHONE == 0)
+/**
+ * When using static libraries, calling this function ensures the Unix domain socket transport is
+ * linked with the application.
+ * @param loadOnInitialize If true, the plug-in is loaded (created) during communicator initialization.
+ * If false, the plug-in is only loaded during communicator initialization if its corresponding
+ * plug-in property is set to 1.
+ */
+ICE_PLUGIN_REGISTER_DECLSPEC_IMPORT void registerIceUNIX(bool loadOnInitialize = true);
+#endif
 #endif
 
 #ifndef ICESSL_API_EXPORTS
@@ -0,0 +1,175 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_VALUE_ARENA_H
+#define ICE_VALUE_ARENA_H
+
+#include <Ice/Config.h>
+
+#ifdef ICE_CPP11_MAPPING
+
+#include <Ice/ValueF.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <cstdlib>
+
+namespace IceInternal
+{
+
+//
+// An arena for the class instances unmarshaled from a stream. The instances
+// are allocated with ValueArenaAllocator. The arena counts the stream and the
+// allocations which aren't released yet, and releases all its memory at once
+// when the stream and the last instance are destroyed. Only the thread which
+// unmarshals the instances allocates from the arena, the instances can be
+// destroyed by any thread.
+//
+class ValueArena
+{
+public:
+
+    ValueArena() :
+        _blockSize(0),
+        _next(0),
+        _remaining(0),
+        _count(1) // The reference of the stream.
+    {
+    }
+
+    //
+    // Releases a reference, the arena is destroyed when the stream and all
+    // the allocations released their reference.
+    //
+    void release()
+    {
+        if(_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete this;
+        }
+    }
+
+    void* allocate(size_t size, size_t alignment)
+    {
+        size_t padding = (alignment - reinterpret_cast<size_t>(_next) % alignment) % alignment;
+        if(padding + size > _remaining)
+        {
+            //
+            // Allocate a new block, the blocks grow with the arena to reduce the
+            // number of allocations for large graphs.
+            //
+            size_t blockSize = _blocks.empty() ? 4096 : 2 * _blockSize;
+            if(blockSize > 64 * 1024)
+            {
+                blockSize = 64 * 1024;
+            }
+            if(blockSize < size + alignment)
+            {
+                blockSize = size + alignment;
+            }
+            void* block = std::malloc(blockSize);
+            if(!block)
+            {
+                throw std::bad_alloc();
+            }
+            _blocks.push_back(block);
+            _blockSize = blockSize;
+            _next = static_cast<char*>(block);
+            _remaining = blockSize;
+            padding = (alignment - reinterpret_cast<size_t>(_next) % alignment) % alignment;
+        }
+
+        void* p = _next + padding;
+        _next += padding + size;
+        _remaining -= padding + size;
+        _count.fetch_add(1, std::memory_order_relaxed);
+        return p;
+    }
+
+private:
+
+    ValueArena(const ValueArena&) = delete;
+    ValueArena& operator=(const ValueArena&) = delete;
+
+    ~ValueArena()
+    {
+        for(std::vector<void*>::const_iterator p = _blocks.begin(); p != _blocks.end(); ++p)
+        {
+            std::free(*p);
+        }
+    }
+
+    std::vector<void*> _blocks;
+    size_t _blockSize;
+    char* _next;
+    size_t _remaining;
+    std::atomic<size_t> _count;
+};
+
+//
+// The allocator used with std::allocate_shared to allocate an instance and
+// its control block in the arena. The control block keeps a copy of the
+// allocator, it only holds a plain pointer to keep the control block small
+// and to avoid reference counting when the allocator is copied. Memory is
+// never deallocated individually, it is released with the arena.
+//
+template<typename T>
+class ValueArenaAllocator
+{
+public:
+
+    using value_type = T;
+
+    ValueArenaAllocator(ValueArena* a) :
+        arena(a)
+    {
+    }
+
+    template<typename U>
+    ValueArenaAllocator(const ValueArenaAllocator<U>& other) :
+        arena(other.arena)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t)
+    {
+        arena->release();
+    }
+
+    ValueArena* arena;
+};
+
+template<typename T, typename U>
+bool operator==(const ValueArenaAllocator<T>& lhs, const ValueArenaAllocator<U>& rhs)
+{
+    return lhs.arena == rhs.arena;
+}
+
+template<typename T, typename U>
+bool operator!=(const ValueArenaAllocator<T>& lhs, const ValueArenaAllocator<U>& rhs)
+{
+    return lhs.arena != rhs.arena;
+}
+
+using ArenaValueFactory = ::std::function<::std::shared_ptr<::Ice::Value>(ValueArena*)>;
+
+template<class V>
+::std::shared_ptr<::Ice::Value>
+arenaValueFactory(ValueArena* arena)
+{
+    return ::std::allocate_shared<V>(ValueArenaAllocator<V>(arena));
+}
+
+}
+
+#endif
+
+#endif
@@ -126,6 +126,9 @@ public:
     // - IcePatch2.Thorough
     // - IcePatch2.ChunkSize
     // - IcePatch2.Remove
+    // - IcePatch2Client.DownloadWindow
+    // - IcePatch2Client.DownloadFiles
+    // - IcePatch2Client.DecompressThreads
     //
     // See the Ice manual for more information on these properties.
     //
@@ -134,6 +137,8 @@ public:
     //
     // Create a patcher with the given parameters. These parameters
     // are equivalent to the configuration properties described above.
+    // The download and decompression settings are read from the
+    // properties of the communicator of the file server proxy.
     //
     static PatcherPtr create(const FileServerPrx&, const PatcherFeedbackPtr&, const std::string&, bool, Ice::Int, Ice::Int);
 };
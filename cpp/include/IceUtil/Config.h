@@ -148,6 +148,15 @@
 #   define ICE_HAS_THREAD_SAFE_LOCAL_STATIC
 #endif
 
+//
+// The shared memory transport requires epoll, eventfd and sealed memfd
+// segments (glibc 2.27 or later).
+//
+#if defined(__linux__) && !defined(ICE_NO_EPOLL) && defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+#   define ICE_HAS_SHM
+#endif
+
 //
 // Compiler extensions to export and import symbols: see the documentation
 // for Visual Studio, Solaris Studio and GCC.
@@ -7,6 +7,8 @@
 
 #include <vector>
 #include <string>
+#include <map>
+#include <algorithm>
 
 using namespace std;
 using namespace Ice;
@@ -142,6 +144,12 @@ public:
     {
     }
 
+    const string&
+    criteria() const
+    {
+        return _criteria;
+    }
+
     bool
     match(const string& space, string::size_type& pos)
     {
@@ -178,6 +186,12 @@ public:
     {
     }
 
+    const string&
+    criteria() const
+    {
+        return _criteria;
+    }
+
     bool
     match(const string& space, string::size_type& pos)
     {
@@ -285,9 +299,7 @@ class MatchesNumber : public AddressMatcher
 {
 public:
     MatchesNumber(const vector<int>& values, const vector<Range>& ranges,
-                  const char* descriptionPrefix = "matches "):
-        _values(values),
-        _ranges(ranges)
+                  const char* descriptionPrefix = "matches ")
     {
         ostringstream ostr;
         ostr << descriptionPrefix;
@@ -332,37 +344,62 @@ public:
         }
         ostr << ends;
         _description = ostr.str();
+
+        //
+        // The values and ranges are merged into a table of disjoint ranges
+        // sorted by their start, which is searched with a binary search.
+        //
+        vector<Range> table = ranges;
+        for(vector<int>::const_iterator i = values.begin(); i != values.end(); ++i)
+        {
+            Range r;
+            r.start = *i;
+            r.end = *i;
+            table.push_back(r);
+        }
+        sort(table.begin(), table.end(), RangeStartLess());
+        for(vector<Range>::const_iterator i = table.begin(); i != table.end(); ++i)
+        {
+            if(i->start > i->end)
+            {
+                continue; // Empty range
+            }
+            if(!_table.empty() && i->start <= _table.back().end + 1)
+            {
+                _table.back().end = max(_table.back().end, i->end);
+            }
+            else
+            {
+                _table.push_back(*i);
+            }
+        }
     }
 
     bool
     match(const string & space, string::size_type& pos)
     {
+        if(pos > space.size())
+        {
+            return false;
+        }
         istringstream istr(space.substr(pos));
         int val;
         if(!(istr >> val))
         {
             return false;
         }
-        pos += static_cast<string::size_type>(istr.tellg());
-        {
-            for(vector<int>::const_iterator i = _values.begin(); i != _values.end(); ++i)
-            {
-                if(val == *i)
-                {
-                    return true;
-                }
-            }
-        }
-        {
-            for(vector<Range>::const_iterator i = _ranges.begin(); i != _ranges.end(); ++i)
-            {
-                if((val >= i->start) && (val <= i->end))
-                {
-                    return true;
-                }
-            }
-        }
-        return false;
+        //
+        // tellg() fails if the number is at the end of the string.
+        //
+        pos = istr.eof() ? space.size() : pos + static_cast<string::size_type>(istr.tellg());
+        return matchValue(val);
+    }
+
+    bool
+    matchValue(long val) const
+    {
+        vector<Range>::const_iterator p = upper_bound(_table.begin(), _table.end(), val, RangeStartLess());
+        return p != _table.begin() && val <= (p - 1)->end;
     }
 
     virtual const char*
@@ -372,8 +409,21 @@ public:
     }
 
 private:
-    const vector<int> _values;
-    const vector<Range> _ranges;
+
+    struct RangeStartLess
+    {
+        bool operator()(const Range& lhs, const Range& rhs) const
+        {
+            return lhs.start < rhs.start;
+        }
+
+        bool operator()(long lhs, const Range& rhs) const
+        {
+            return lhs < rhs.start;
+        }
+    };
+
+    vector<Range> _table;
     string _description;
 };
 
@@ -513,6 +563,61 @@ public:
     }
 };
 
+//
+// The host and port of an endpoint, extracted from its stringified form.
+//
+struct EndpointAddress
+{
+    string host;
+    string port;
+};
+
+static bool
+extractPart(const char* opt, const string& source, string& result)
+{
+    string::size_type start = source.find(opt);
+    if(start == string::npos)
+    {
+        return false;
+    }
+    start += strlen(opt);
+    string::size_type end = source.find(' ', start);
+    if(end != string::npos)
+    {
+        result = source.substr(start, end - start);
+    }
+    else
+    {
+        result = source.substr(start);
+    }
+    return true;
+}
+
+//
+// Extracts the addresses of the proxy endpoints, returns false if the proxy has
+// no endpoints or if an endpoint has no host or port.
+//
+static bool
+extractAddresses(const ObjectPrx& prx, vector<EndpointAddress>& addresses)
+{
+    EndpointSeq endpoints = prx->ice_getEndpoints();
+    if(endpoints.size() == 0)
+    {
+        return false;
+    }
+
+    addresses.resize(endpoints.size());
+    for(EndpointSeq::size_type i = 0; i < endpoints.size(); ++i)
+    {
+        string info = endpoints[i]->toString();
+        if(!extractPart("-h ", info, addresses[i].host) || !extractPart("-p ", info, addresses[i].port))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 //
 // A proxy validation rule encapsulating an address filter.
 //
@@ -540,59 +645,69 @@ public:
     virtual bool
     check(const ObjectPrx& prx) const
     {
-        EndpointSeq endpoints = prx->ice_getEndpoints();
-        if(endpoints.size() == 0)
+        vector<EndpointAddress> addresses;
+        if(!extractAddresses(prx, addresses))
         {
             return false;
         }
 
-        for(EndpointSeq::const_iterator i = endpoints.begin(); i != endpoints.end(); ++i)
+        for(vector<EndpointAddress>::const_iterator i = addresses.begin(); i != addresses.end(); ++i)
         {
-            string info = (*i)->toString();
-            string host;
-            if(!extractPart("-h ", info, host))
+            if(!match(*i))
             {
                 return false;
             }
-            string port;
-            if(!extractPart("-p ", info, port))
+        }
+        return true;
+    }
+
+    bool
+    match(const EndpointAddress& address) const
+    {
+        string::size_type pos = 0;
+        if(_portMatcher && !_portMatcher->match(address.port, pos))
+        {
+            if(_traceLevel >= 3)
             {
-                return false;
+                Trace out(_communicator->getLogger(), "Glacier2");
+                out << _portMatcher->toString() << " failed to match " << address.port << " at pos=" << pos << "\n";
             }
+            return false;
+        }
 
-            string::size_type pos = 0;
-            if(_portMatcher && !_portMatcher->match(port, pos))
+        pos = 0;
+        for(vector<AddressMatcher*>::const_iterator j = _addressRules.begin(); j != _addressRules.end(); ++j)
+        {
+            if(!(*j)->match(address.host, pos))
             {
                 if(_traceLevel >= 3)
                 {
                     Trace out(_communicator->getLogger(), "Glacier2");
-                    out << _portMatcher->toString() << " failed to match " << port << " at pos=" << pos << "\n";
+                    out << (*j)->toString() << " failed to match " << address.host << " at pos=" << pos << "\n";
                 }
                 return false;
             }
-
-            pos = 0;
-            for(vector<AddressMatcher*>::const_iterator j = _addressRules.begin(); j != _addressRules.end(); ++j)
+            if(_traceLevel >= 3)
             {
-                if(!(*j)->match(host, pos))
-                {
-                    if(_traceLevel >= 3)
-                    {
-                        Trace out(_communicator->getLogger(), "Glacier2");
-                        out << (*j)->toString() << " failed to match " << host << " at pos=" << pos << "\n";
-                    }
-                    return false;
-                }
-                if(_traceLevel >= 3)
-                {
-                    Trace out(_communicator->getLogger(), "Glacier2");
-                    out << (*j)->toString() << " matched " << host << " at pos=" << pos << "\n";
-                }
+                Trace out(_communicator->getLogger(), "Glacier2");
+                out << (*j)->toString() << " matched " << address.host << " at pos=" << pos << "\n";
             }
         }
         return true;
     }
 
+    const vector<AddressMatcher*>&
+    addressMatchers() const
+    {
+        return _addressRules;
+    }
+
+    const MatchesNumber*
+    portMatcher() const
+    {
+        return _portMatcher;
+    }
+
     void
     dump() const
     {
@@ -610,31 +725,244 @@ public:
 
 private:
 
+    CommunicatorPtr _communicator;
+    vector<AddressMatcher*> _addressRules;
+    MatchesNumber* _portMatcher;
+    const int _traceLevel;
+};
+
+//
+// The compiled form of a set of rules. The host matchers of the most common
+// address filters, a host name ("foo.com"), a host name with a wildcard prefix
+// ("*.foo.com") or a host name with a wildcard suffix ("10.0.*"), are stored
+// in tries. The endpoint host is checked against all these rules by walking
+// the tries once instead of checking each rule in turn. The other address
+// filters and the other rules are checked in turn.
+//
+class ProxyRuleSet
+{
+public:
+
+    ProxyRuleSet(const vector<ProxyRule*>& rules) :
+        _prefixes(1),
+        _suffixes(1)
+    {
+        for(vector<ProxyRule*>::const_iterator p = rules.begin(); p != rules.end(); ++p)
+        {
+            const AddressRule* rule = dynamic_cast<const AddressRule*>(*p);
+            if(!rule)
+            {
+                _others.push_back(*p);
+                continue;
+            }
+
+            const vector<AddressMatcher*>& matchers = rule->addressMatchers();
+            if(matchers.size() == 1 && dynamic_cast<const MatchesAny*>(matchers[0]))
+            {
+                _anyHost.push_back(rule);
+            }
+            else if(matchers.size() == 1 && dynamic_cast<const StartsWithString*>(matchers[0]))
+            {
+                insert(_prefixes, static_cast<const StartsWithString*>(matchers[0])->criteria(), false, rule);
+            }
+            else if(matchers.size() == 1 && dynamic_cast<const EndsWithString*>(matchers[0]))
+            {
+                insert(_suffixes, static_cast<const EndsWithString*>(matchers[0])->criteria(), true, rule);
+            }
+            else
+            {
+                _addressRules.push_back(rule);
+            }
+        }
+    }
+
+    //
+    // Returns true if one of the rules matches the proxy. The addresses are
+    // null if they couldn't be extracted from the proxy, in which case no
+    // address rule matches.
+    //
     bool
-    extractPart(const char* opt, const string& source, string& result) const
+    match(const ObjectPrx& proxy, const vector<EndpointAddress>* addresses) const
     {
-        string::size_type start = source.find(opt);
-        if(start == string::npos)
+        if(addresses)
         {
-            return false;
+            //
+            // An address rule must match all the endpoints. The candidates are
+            // the rules matching the first endpoint, checked with the other
+            // endpoints.
+            //
+            vector<const AddressRule*> candidates;
+            findRules((*addresses)[0], addresses->size() == 1, candidates);
+            for(vector<const AddressRule*>::const_iterator p = candidates.begin(); p != candidates.end(); ++p)
+            {
+                vector<EndpointAddress>::const_iterator q = addresses->begin() + 1;
+                while(q != addresses->end() && (*p)->match(*q))
+                {
+                    ++q;
+                }
+                if(q == addresses->end())
+                {
+                    return true;
+                }
+            }
         }
-        start += strlen(opt);
-        string::size_type end = source.find(' ', start);
-        if(end != string::npos)
+
+        for(vector<ProxyRule*>::const_iterator p = _others.begin(); p != _others.end(); ++p)
         {
-            result = source.substr(start, end - start);
+            if((*p)->check(proxy))
+            {
+                return true;
+            }
         }
-        else
+        return false;
+    }
+
+    bool
+    hasAddressRules() const
+    {
+        return !_anyHost.empty() || _prefixes.size() > 1 || _suffixes.size() > 1 || !_addressRules.empty();
+    }
+
+private:
+
+    struct Node
+    {
+        map<char, size_t> children;
+        vector<const AddressRule*> rules; // The rules whose host criteria ends at this node.
+    };
+
+    static void
+    insert(vector<Node>& trie, const string& criteria, bool reverse, const AddressRule* rule)
+    {
+        size_t node = 0;
+        for(string::size_type i = 0; i < criteria.size(); ++i)
         {
-            result = source.substr(start);
+            char c = reverse ? criteria[criteria.size() - i - 1] : criteria[i];
+            map<char, size_t>::const_iterator p = trie[node].children.find(c);
+            if(p == trie[node].children.end())
+            {
+                trie.push_back(Node());
+                trie[node].children.insert(make_pair(c, trie.size() - 1));
+                node = trie.size() - 1;
+            }
+            else
+            {
+                node = p->second;
+            }
         }
-        return true;
+        trie[node].rules.push_back(rule);
     }
 
-    CommunicatorPtr _communicator;
-    vector<AddressMatcher*> _addressRules;
-    MatchesNumber* _portMatcher;
-    const int _traceLevel;
+    //
+    // The endpoint port, parsed once for all the rules like MatchesNumber::match
+    // parses it.
+    //
+    struct Port
+    {
+        Port(const string& s) :
+            parsed(false),
+            valid(false),
+            value(0),
+            str(s)
+        {
+        }
+
+        bool
+        match(const MatchesNumber* matcher)
+        {
+            if(!parsed)
+            {
+                istringstream istr(str);
+                valid = static_cast<bool>(istr >> value);
+                parsed = true;
+            }
+            return valid && matcher->matchValue(value);
+        }
+
+        bool parsed;
+        bool valid;
+        int value;
+        const string& str;
+    };
+
+    static void
+    addRules(const vector<const AddressRule*>& rules, Port& port, vector<const AddressRule*>& result)
+    {
+        for(vector<const AddressRule*>::const_iterator p = rules.begin(); p != rules.end(); ++p)
+        {
+            if(!(*p)->portMatcher() || port.match((*p)->portMatcher()))
+            {
+                result.push_back(*p);
+            }
+        }
+    }
+
+    //
+    // Finds the rules matching the endpoint address, or only the first one if
+    // firstOnly is true.
+    //
+    void
+    findRules(const EndpointAddress& address, bool firstOnly, vector<const AddressRule*>& result) const
+    {
+        const string& host = address.host;
+        Port port(address.port);
+
+        addRules(_anyHost, port, result);
+        if(firstOnly && !result.empty())
+        {
+            return;
+        }
+
+        size_t node = 0;
+        for(string::size_type i = 0; i < host.size(); ++i)
+        {
+            map<char, size_t>::const_iterator p = _prefixes[node].children.find(host[i]);
+            if(p == _prefixes[node].children.end())
+            {
+                break;
+            }
+            node = p->second;
+            addRules(_prefixes[node].rules, port, result);
+            if(firstOnly && !result.empty())
+            {
+                return;
+            }
+        }
+
+        node = 0;
+        for(string::size_type i = host.size(); i > 0; --i)
+        {
+            map<char, size_t>::const_iterator p = _suffixes[node].children.find(host[i - 1]);
+            if(p == _suffixes[node].children.end())
+            {
+                break;
+            }
+            node = p->second;
+            addRules(_suffixes[node].rules, port, result);
+            if(firstOnly && !result.empty())
+            {
+                return;
+            }
+        }
+
+        for(vector<const AddressRule*>::const_iterator p = _addressRules.begin(); p != _addressRules.end(); ++p)
+        {
+            if((*p)->match(address))
+            {
+                result.push_back(*p);
+                if(firstOnly)
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    vector<const AddressRule*> _anyHost;
+    vector<Node> _prefixes;
+    vector<Node> _suffixes;
+    vector<const AddressRule*> _addressRules;
+    vector<ProxyRule*> _others;
 };
 
 static void
@@ -800,11 +1128,18 @@ parseProperty(const Ice::CommunicatorPtr& communicator, const string& property,
 }
 
 //
-// Helper function for checking a rule set.
+// Helper function for checking a rule set. The rules are checked in turn
+// when tracing the address matchers, otherwise with their compiled form.
 //
 static bool
-match(const vector<ProxyRule*>& rules, const ObjectPrx& proxy)
+match(const vector<ProxyRule*>& rules, const ProxyRuleSet* ruleSet, const ObjectPrx& proxy,
+      const vector<EndpointAddress>* addresses, int traceLevel)
 {
+    if(traceLevel < 3)
+    {
+        return ruleSet->match(proxy, addresses);
+    }
+
     for(vector<ProxyRule*>::const_iterator i = rules.begin(); i != rules.end(); ++i)
     {
         if((*i)->check(proxy))
@@ -861,7 +1196,9 @@ private:
 
 Glacier2::ProxyVerifier::ProxyVerifier(const CommunicatorPtr& communicator):
     _communicator(communicator),
-    _traceLevel(communicator->getProperties()->getPropertyAsInt("Glacier2.Client.Trace.Reject"))
+    _traceLevel(communicator->getProperties()->getPropertyAsInt("Glacier2.Client.Trace.Reject")),
+    _acceptRuleSet(0),
+    _rejectRuleSet(0)
 {
     //
     // Evaluation order is dependant on how the rules are stored to the
@@ -912,10 +1249,15 @@ Glacier2::ProxyVerifier::ProxyVerifier(const CommunicatorPtr& communicator):
             throw InitializationException(__FILE__, __LINE__, os.str());
         }
     }
+
+    _acceptRuleSet = new ProxyRuleSet(_acceptRules);
+    _rejectRuleSet = new ProxyRuleSet(_rejectRules);
 }
 
 Glacier2::ProxyVerifier::~ProxyVerifier()
 {
+    delete _acceptRuleSet;
+    delete _rejectRuleSet;
     for(vector<ProxyRule*>::const_iterator i = _acceptRules.begin(); i != _acceptRules.end(); ++i)
     {
         delete (*i);
@@ -937,6 +1279,17 @@ Glacier2::ProxyVerifier::verify(const ObjectPrx& proxy)
         return true;
     }
 
+    //
+    // The endpoint addresses are extracted once for all the address rules.
+    //
+    vector<EndpointAddress> addresses;
+    const vector<EndpointAddress>* addrs = 0;
+    if(_traceLevel < 3 && (_acceptRuleSet->hasAddressRules() || _rejectRuleSet->hasAddressRules()) &&
+       extractAddresses(proxy, addresses))
+    {
+        addrs = &addresses;
+    }
+
     bool result = false;
 
     if(_rejectRules.size() == 0)
@@ -944,20 +1297,20 @@ Glacier2::ProxyVerifier::verify(const ObjectPrx& proxy)
         //
         // If there are no reject rules, we assume "reject all".
         //
-        result = match(_acceptRules, proxy);
+        result = match(_acceptRules, _acceptRuleSet, proxy, addrs, _traceLevel);
     }
     else if(_acceptRules.size() == 0)
     {
         //
         // If no accept rules are defined we assume accept all.
         //
-        result = !match(_rejectRules, proxy);
+        result = !match(_rejectRules, _rejectRuleSet, proxy, addrs, _traceLevel);
     }
     else
     {
-        if(match(_acceptRules, proxy))
+        if(match(_acceptRules, _acceptRuleSet, proxy, addrs, _traceLevel))
         {
-            result = !match(_rejectRules, proxy);
+            result = !match(_rejectRules, _rejectRuleSet, proxy, addrs, _traceLevel);
         }
     }
 
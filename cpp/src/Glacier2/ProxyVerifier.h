@@ -27,6 +27,8 @@ public:
     virtual bool check(const Ice::ObjectPrx&) const = 0;
 };
 
+class ProxyRuleSet;
+
 class ProxyVerifier : public IceUtil::Shared
 {
 public:
@@ -47,6 +49,9 @@ private:
 
     std::vector<ProxyRule*> _acceptRules;
     std::vector<ProxyRule*> _rejectRules;
+
+    ProxyRuleSet* _acceptRuleSet;
+    ProxyRuleSet* _rejectRuleSet;
 };
 typedef IceUtil::Handle<ProxyVerifier> ProxyVerifierPtr;
 
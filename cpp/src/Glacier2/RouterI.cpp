@@ -237,14 +237,14 @@ Glacier2::RouterI::getSession() const
 IceUtil::Time
 Glacier2::RouterI::getTimestamp() const
 {
-    // Can only be called with the SessionRouterI mutex locked
+    // Can only be called with the mutex of the SessionRouterI router map shard locked
     return _timestamp;
 }
 
 void
 Glacier2::RouterI::updateTimestamp() const
 {
-    // Can only be called with the SessionRouterI mutex locked
+    // Can only be called with the mutex of the SessionRouterI router map shard locked
     _timestamp = IceUtil::Time::now(IceUtil::Time::Monotonic);
 }
 
@@ -100,6 +100,24 @@ getIPConnectionInfo(const Ice::ConnectionInfoPtr& info)
     return ICE_NULLPTR;
 }
 
+size_t
+hashKey(const Ice::ConnectionPtr& connection)
+{
+    size_t h = reinterpret_cast<size_t>(connection.get());
+    return (h >> 4) ^ (h >> 12);
+}
+
+size_t
+hashKey(const string& category)
+{
+    size_t h = 2166136261U;
+    for(string::const_iterator p = category.begin(); p != category.end(); ++p)
+    {
+        h = (h ^ static_cast<unsigned char>(*p)) * 16777619U;
+    }
+    return h;
+}
+
 }
 
 namespace Glacier2
@@ -660,6 +678,117 @@ CreateSession::exception(const Ice::Exception& ex)
     }
 }
 
+template<typename K> RouterIPtr
+Glacier2::RouterMap<K>::find(const K& key, bool updateTimestamp) const
+{
+    Shard& sh = shard(key);
+    IceUtil::Mutex::Lock sync(sh.mutex);
+    typename map<K, RouterIPtr>::const_iterator p = sh.routers.find(key);
+    if(p == sh.routers.end())
+    {
+        return 0;
+    }
+    if(updateTimestamp)
+    {
+        p->second->updateTimestamp();
+    }
+    return p->second;
+}
+
+template<typename K> bool
+Glacier2::RouterMap<K>::insert(const K& key, const RouterIPtr& router)
+{
+    Shard& sh = shard(key);
+    IceUtil::Mutex::Lock sync(sh.mutex);
+    return sh.routers.insert(make_pair(key, router)).second;
+}
+
+template<typename K> RouterIPtr
+Glacier2::RouterMap<K>::erase(const K& key)
+{
+    Shard& sh = shard(key);
+    IceUtil::Mutex::Lock sync(sh.mutex);
+    typename map<K, RouterIPtr>::iterator p = sh.routers.find(key);
+    if(p == sh.routers.end())
+    {
+        return 0;
+    }
+    RouterIPtr router = p->second;
+    sh.routers.erase(p);
+    return router;
+}
+
+template<typename K> void
+Glacier2::RouterMap<K>::eraseExpired(const IceUtil::Time& minTimestamp, vector<RouterIPtr>& routers)
+{
+    for(size_t i = 0; i < shardCount; ++i)
+    {
+        IceUtil::Mutex::Lock sync(_shards[i].mutex);
+        typename map<K, RouterIPtr>::iterator p = _shards[i].routers.begin();
+        while(p != _shards[i].routers.end())
+        {
+            if(p->second->getTimestamp() < minTimestamp)
+            {
+                routers.push_back(p->second);
+                _shards[i].routers.erase(p++);
+            }
+            else
+            {
+                ++p;
+            }
+        }
+    }
+}
+
+template<typename K> void
+Glacier2::RouterMap<K>::clear(vector<RouterIPtr>& routers)
+{
+    for(size_t i = 0; i < shardCount; ++i)
+    {
+        IceUtil::Mutex::Lock sync(_shards[i].mutex);
+        for(typename map<K, RouterIPtr>::const_iterator p = _shards[i].routers.begin();
+            p != _shards[i].routers.end(); ++p)
+        {
+            routers.push_back(p->second);
+        }
+        _shards[i].routers.clear();
+    }
+}
+
+template<typename K> void
+Glacier2::RouterMap<K>::getAll(vector<RouterIPtr>& routers) const
+{
+    for(size_t i = 0; i < shardCount; ++i)
+    {
+        IceUtil::Mutex::Lock sync(_shards[i].mutex);
+        for(typename map<K, RouterIPtr>::const_iterator p = _shards[i].routers.begin();
+            p != _shards[i].routers.end(); ++p)
+        {
+            routers.push_back(p->second);
+        }
+    }
+}
+
+template<typename K> bool
+Glacier2::RouterMap<K>::empty() const
+{
+    for(size_t i = 0; i < shardCount; ++i)
+    {
+        IceUtil::Mutex::Lock sync(_shards[i].mutex);
+        if(!_shards[i].routers.empty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename K> typename Glacier2::RouterMap<K>::Shard&
+Glacier2::RouterMap<K>::shard(const K& key) const
+{
+    return _shards[hashKey(key) % shardCount];
+}
+
 SessionRouterI::SessionRouterI(const InstancePtr& instance,
                                const PermissionsVerifierPrx& verifier,
                                const SessionManagerPrx& sessionManager,
@@ -676,8 +805,6 @@ SessionRouterI::SessionRouterI(const InstancePtr& instance,
     _closeCallback(new CloseCallbackI(this)),
     _heartbeatCallback(new HeartbeatCallbackI(this)),
     _sessionThread(_sessionTimeout > IceUtil::Time() ? new SessionThread(this, _sessionTimeout) : 0),
-    _routersByConnectionHint(_routersByConnection.end()),
-    _routersByCategoryHint(_routersByCategory.end()),
     _sessionDestroyCallback(newCallback_Session_destroy(this, &SessionRouterI::sessionDestroyException)),
     _destroy(false)
 {
@@ -738,7 +865,7 @@ SessionRouterI::~SessionRouterI()
 void
 SessionRouterI::destroy()
 {
-    map<ConnectionPtr, RouterIPtr> routers;
+    vector<RouterIPtr> routers;
     SessionThreadPtr sessionThread;
     Callback_Session_destroyPtr destroyCallback;
     {
@@ -748,11 +875,10 @@ SessionRouterI::destroy()
         _destroy = true;
         notify();
 
-        _routersByConnection.swap(routers);
-        _routersByConnectionHint = _routersByConnection.end();
+        _routersByConnection.clear(routers);
 
-        _routersByCategory.clear();
-        _routersByCategoryHint = _routersByCategory.end();
+        vector<RouterIPtr> routersByCategory;
+        _routersByCategory.clear(routersByCategory);
 
         sessionThread = _sessionThread;
         _sessionThread = 0;
@@ -767,9 +893,9 @@ SessionRouterI::destroy()
     // We destroy the routers outside the thread synchronization, to
     // avoid deadlocks.
     //
-    for(map<ConnectionPtr, RouterIPtr>::iterator p = routers.begin(); p != routers.end(); ++p)
+    for(vector<RouterIPtr>::iterator p = routers.begin(); p != routers.end(); ++p)
     {
-        p->second->destroy(destroyCallback);
+        (*p)->destroy(destroyCallback);
     }
 
     if(sessionThread)
@@ -891,15 +1017,11 @@ SessionRouterI::destroySession(const Current& current)
 void
 SessionRouterI::refreshSession_async(const AMD_Router_refreshSessionPtr& callback, const Ice::Current& current)
 {
-    RouterIPtr router;
+    RouterIPtr router = getRouter(current.con, current.id, false); // getRouter updates the session timestamp.
+    if(!router)
     {
-        IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-        router = getRouterImpl(current.con, current.id, false); // getRouter updates the session timestamp.
-        if(!router)
-        {
-            callback->ice_exception(SessionNotExistException());
-            return;
-        }
+        callback->ice_exception(SessionNotExistException());
+        return;
     }
 
     SessionPrx session = router->getSession();
@@ -920,19 +1042,15 @@ SessionRouterI::refreshSession_async(const AMD_Router_refreshSessionPtr& callbac
 void
 SessionRouterI::refreshSession(const Ice::ConnectionPtr& con)
 {
-    RouterIPtr router;
+    RouterIPtr router = getRouter(con, Ice::Identity(), false); // getRouter updates the session timestamp.
+    if(!router)
     {
-        IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-        router = getRouterImpl(con, Ice::Identity(), false); // getRouter updates the session timestamp.
-        if(!router)
-        {
-            //
-            // Close the connection otherwise the peer has no way to know that the
-            // session has gone.
-            //
-            con->close(ICE_SCOPED_ENUM(ConnectionClose, Forcefully));
-            throw SessionNotExistException();
-        }
+        //
+        // Close the connection otherwise the peer has no way to know that the
+        // session has gone.
+        //
+        con->close(ICE_SCOPED_ENUM(ConnectionClose, Forcefully));
+        throw SessionNotExistException();
     }
 
     SessionPrx session = router->getSession();
@@ -958,33 +1076,17 @@ SessionRouterI::destroySession(const ConnectionPtr& connection)
             throw ObjectNotExistException(__FILE__, __LINE__);
         }
 
-        map<ConnectionPtr, RouterIPtr>::iterator p;
-
-        if(_routersByConnectionHint != _routersByConnection.end() && _routersByConnectionHint->first == connection)
-        {
-            p = _routersByConnectionHint;
-        }
-        else
-        {
-            p = _routersByConnection.find(connection);
-        }
-
-        if(p == _routersByConnection.end())
+        router = _routersByConnection.erase(connection);
+        if(!router)
         {
             throw SessionNotExistException();
         }
 
-        router = p->second;
-
-        _routersByConnection.erase(p++);
-        _routersByConnectionHint = p;
-
         if(_instance->serverObjectAdapter())
         {
             string category = router->getServerProxy(Current())->ice_getIdentity().category;
             assert(!category.empty());
             _routersByCategory.erase(category);
-            _routersByCategoryHint = _routersByCategory.end();
         }
     }
 
@@ -1020,54 +1122,38 @@ SessionRouterI::updateSessionObservers()
     Glacier2::Instrumentation::RouterObserverPtr observer = _instance->getObserver();
     assert(observer);
 
-    for(map<ConnectionPtr, RouterIPtr>::iterator p = _routersByConnection.begin(); p != _routersByConnection.end(); ++p)
+    vector<RouterIPtr> routers;
+    _routersByConnection.getAll(routers);
+    for(vector<RouterIPtr>::iterator p = routers.begin(); p != routers.end(); ++p)
     {
-        p->second->updateObserver(observer);
+        (*p)->updateObserver(observer);
     }
 }
 
 RouterIPtr
 SessionRouterI::getRouter(const ConnectionPtr& connection, const Ice::Identity& id, bool close) const
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
     return getRouterImpl(connection, id, close);
 }
 
 Ice::ObjectPtr
 SessionRouterI::getClientBlobject(const ConnectionPtr& connection, const Ice::Identity& id) const
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
     return getRouterImpl(connection, id, true)->getClientBlobject();
 }
 
 Ice::ObjectPtr
 SessionRouterI::getServerBlobject(const string& category) const
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-
-    if(_destroy)
-    {
-        throw ObjectNotExistException(__FILE__, __LINE__);
-    }
-
-    map<string, RouterIPtr>& routers = const_cast<map<string, RouterIPtr>&>(_routersByCategory);
-
-    if(_routersByCategoryHint != routers.end() && _routersByCategoryHint->first == category)
-    {
-        return _routersByCategoryHint->second->getServerBlobject();
-    }
-
-    map<string, RouterIPtr>::iterator p = routers.find(category);
-
-    if(p != routers.end())
-    {
-        _routersByCategoryHint = p;
-        return p->second->getServerBlobject();
-    }
-    else
+    //
+    // The routers are removed from the map when the session router is destroyed.
+    //
+    RouterIPtr router = _routersByCategory.find(category);
+    if(!router)
     {
         throw ObjectNotExistException(__FILE__, __LINE__);
     }
+    return router->getServerBlobject();
 }
 
 void
@@ -1086,29 +1172,15 @@ SessionRouterI::expireSessions()
         assert(_sessionTimeout > IceUtil::Time());
         IceUtil::Time minTimestamp = IceUtil::Time::now(IceUtil::Time::Monotonic) - _sessionTimeout;
 
-        map<ConnectionPtr, RouterIPtr>::iterator p = _routersByConnection.begin();
+        _routersByConnection.eraseExpired(minTimestamp, routers);
 
-        while(p != _routersByConnection.end())
+        if(_instance->serverObjectAdapter())
         {
-            if(p->second->getTimestamp() < minTimestamp)
+            for(vector<RouterIPtr>::const_iterator p = routers.begin(); p != routers.end(); ++p)
             {
-                RouterIPtr router = p->second;
-                routers.push_back(router);
-
-                _routersByConnection.erase(p++);
-                _routersByConnectionHint = p;
-
-                if(_instance->serverObjectAdapter())
-                {
-                    string category = router->getServerProxy(Current())->ice_getIdentity().category;
-                    assert(!category.empty());
-                    _routersByCategory.erase(category);
-                    _routersByCategoryHint = _routersByCategory.end();
-                }
-            }
-            else
-            {
-                ++p;
+                string category = (*p)->getServerProxy(Current())->ice_getIdentity().category;
+                assert(!category.empty());
+                _routersByCategory.erase(category);
             }
         }
     }
@@ -1136,28 +1208,30 @@ SessionRouterI::getRouterImpl(const ConnectionPtr& connection, const Ice::Identi
     // a proxy which points to the client endpoints (in which case the request
     // is forwarded with collocation optimization).
     //
-    if(_destroy || !connection)
+    if(!connection)
     {
         throw ObjectNotExistException(__FILE__, __LINE__);
     }
 
-    map<ConnectionPtr, RouterIPtr>& routers = const_cast<map<ConnectionPtr, RouterIPtr>&>(_routersByConnection);
-
-    if(_routersByConnectionHint != routers.end() && _routersByConnectionHint->first == connection)
+    //
+    // The router is looked up without locking the session router, this is
+    // called for each request forwarded by the router.
+    //
+    RouterIPtr router = _routersByConnection.find(connection, true);
+    if(router)
     {
-        _routersByConnectionHint->second->updateTimestamp();
-        return _routersByConnectionHint->second;
+        return router;
     }
 
-    map<ConnectionPtr, RouterIPtr>::iterator p = routers.find(connection);
-
-    if(p != routers.end())
     {
-        _routersByConnectionHint = p;
-        p->second->updateTimestamp();
-        return p->second;
+        IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
+        if(_destroy)
+        {
+            throw ObjectNotExistException(__FILE__, __LINE__);
+        }
     }
-    else if(close)
+
+    if(close)
     {
         if(_rejectTraceLevel >= 1)
         {
@@ -1194,22 +1268,9 @@ SessionRouterI::startCreateSession(const CreateSessionPtr& cb, const ConnectionP
     //
     // Check whether a session already exists for the connection.
     //
+    if(_routersByConnection.find(connection))
     {
-        map<ConnectionPtr, RouterIPtr>::iterator p;
-        if(_routersByConnectionHint != _routersByConnection.end() &&
-           _routersByConnectionHint->first == connection)
-        {
-            p = _routersByConnectionHint;
-        }
-        else
-        {
-            p = _routersByConnection.find(connection);
-        }
-
-        if(p != _routersByConnection.end())
-        {
-            throw CannotCreateSessionException("session exists");
-        }
+        throw CannotCreateSessionException("session exists");
     }
 
     map<ConnectionPtr, CreateSessionPtr>::iterator p = _pending.find(connection);
@@ -1258,17 +1319,18 @@ SessionRouterI::finishCreateSession(const ConnectionPtr& connection, const Route
         throw CannotCreateSessionException("router is shutting down");
     }
 
-    _routersByConnectionHint = _routersByConnection.insert(
-        _routersByConnectionHint, pair<const ConnectionPtr, RouterIPtr>(connection, router));
+    _routersByConnection.insert(connection, router);
 
     if(_instance->serverObjectAdapter())
     {
         string category = router->getServerProxy(Ice::emptyCurrent)->ice_getIdentity().category;
         assert(!category.empty());
-        pair<map<string, RouterIPtr>::iterator, bool> rc =
-            _routersByCategory.insert(pair<const string, RouterIPtr>(category, router));
-        assert(rc.second);
-        _routersByCategoryHint = rc.first;
+#ifndef NDEBUG
+        bool inserted = _routersByCategory.insert(category, router);
+        assert(inserted);
+#else
+        _routersByCategory.insert(category, router);
+#endif
     }
 
     connection->setCloseCallback(_closeCallback);
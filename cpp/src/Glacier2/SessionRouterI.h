@@ -15,6 +15,7 @@
 #include <Glacier2/Instrumentation.h>
 
 #include <set>
+#include <vector>
 
 namespace Glacier2
 {
@@ -40,6 +41,38 @@ typedef IceUtil::Handle<ClientBlobject> ClientBlobjectPtr;
 class ServerBlobject;
 typedef IceUtil::Handle<ServerBlobject> ServerBlobjectPtr;
 
+//
+// A map of routers split into shards, each shard has its own mutex. The
+// routers of different sessions are found concurrently, without locking
+// the session router.
+//
+template<typename K>
+class RouterMap
+{
+public:
+
+    RouterIPtr find(const K&, bool = false) const;
+    bool insert(const K&, const RouterIPtr&);
+    RouterIPtr erase(const K&);
+    void eraseExpired(const IceUtil::Time&, std::vector<RouterIPtr>&);
+    void clear(std::vector<RouterIPtr>&);
+    void getAll(std::vector<RouterIPtr>&) const;
+    bool empty() const;
+
+private:
+
+    struct Shard
+    {
+        IceUtil::Mutex mutex;
+        std::map<K, RouterIPtr> routers;
+    };
+
+    Shard& shard(const K&) const;
+
+    static const size_t shardCount = 64;
+    mutable Shard _shards[shardCount];
+};
+
 class CreateSession : public IceUtil::Shared
 {
 public:
@@ -163,11 +196,8 @@ private:
     typedef IceUtil::Handle<SessionThread> SessionThreadPtr;
     SessionThreadPtr _sessionThread;
 
-    std::map<Ice::ConnectionPtr, RouterIPtr> _routersByConnection;
-    mutable std::map<Ice::ConnectionPtr, RouterIPtr>::iterator _routersByConnectionHint;
-
-    std::map<std::string, RouterIPtr> _routersByCategory;
-    mutable std::map<std::string, RouterIPtr>::iterator _routersByCategoryHint;
+    RouterMap<Ice::ConnectionPtr> _routersByConnection;
+    RouterMap<std::string> _routersByCategory;
 
     std::map<Ice::ConnectionPtr, CreateSessionPtr> _pending;
 
@@ -20,6 +20,10 @@ class TcpAcceptor;
 ICE_API IceUtil::Shared* upCast(TcpAcceptor*);
 typedef Handle<TcpAcceptor> TcpAcceptorPtr;
 
+class PathAcceptor;
+ICE_API IceUtil::Shared* upCast(PathAcceptor*);
+typedef Handle<PathAcceptor> PathAcceptorPtr;
+
 }
 
 #endif
@@ -0,0 +1,217 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/BalancedRequestHandler.h>
+#include <Ice/Reference.h>
+#include <Ice/Instance.h>
+#include <Ice/ProxyFactory.h>
+#include <Ice/Proxy.h>
+#include <Ice/ConnectionI.h>
+#include <Ice/EndpointI.h>
+#include <Ice/TraceLevels.h>
+#include <Ice/LoggerUtil.h>
+#include <IceUtil/Random.h>
+
+using namespace std;
+using namespace IceInternal;
+
+namespace
+{
+
+//
+// The delay in milliseconds during which an endpoint isn't used after a connection
+// failure, unless all the endpoints failed.
+//
+const int retryDelay = 1000;
+
+}
+
+BalancedRequestHandler::BalancedRequestHandler(const ReferencePtr& ref, const vector<EndpointIPtr>& endpoints) :
+    RequestHandler(ref),
+    _retryTimes(endpoints.size())
+{
+    assert(endpoints.size() > 1);
+    ProxyFactoryPtr factory = ref->getInstance()->proxyFactory();
+    for(vector<EndpointIPtr>::const_iterator p = endpoints.begin(); p != endpoints.end(); ++p)
+    {
+        ReferencePtr r = ref->changeEndpoints(vector<EndpointIPtr>(1, *p));
+        r = r->changeEndpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Ordered));
+        r = r->changeCollocationOptimized(false);
+        _proxies.push_back(factory->referenceToProxy(r));
+    }
+}
+
+RequestHandlerPtr
+BalancedRequestHandler::update(const RequestHandlerPtr&, const RequestHandlerPtr&)
+{
+    //
+    // This request handler is never replaced, the failures of the connections are
+    // handled with the request handlers of the endpoints.
+    //
+    return ICE_SHARED_FROM_THIS;
+}
+
+AsyncStatus
+BalancedRequestHandler::sendAsyncRequest(const ProxyOutgoingAsyncBasePtr& out)
+{
+    size_t i = select();
+    RequestHandlerPtr handler = _proxies[i]->_getRequestHandler();
+    try
+    {
+        return handler->sendAsyncRequest(out);
+    }
+    catch(const RetryException&)
+    {
+        //
+        // The connection to the endpoint is closed, clear its request handler to
+        // establish a new connection when the request is retried.
+        //
+        _proxies[i]->_updateRequestHandler(handler, ICE_NULLPTR);
+        throw;
+    }
+    catch(const Ice::LocalException& ex)
+    {
+        if(!_proxies[i]->ice_getCachedConnection())
+        {
+            failed(i, handler, ex); // The connection establishment failed.
+        }
+        throw;
+    }
+}
+
+void
+BalancedRequestHandler::asyncRequestCanceled(const OutgoingAsyncBasePtr&, const Ice::LocalException&)
+{
+    //
+    // Nothing to do, requests are canceled with the request handler or connection of
+    // the endpoint which sent them.
+    //
+}
+
+Ice::ConnectionIPtr
+BalancedRequestHandler::getConnection()
+{
+    for(vector<Ice::ObjectPrxPtr>::const_iterator p = _proxies.begin(); p != _proxies.end(); ++p)
+    {
+        Ice::ConnectionPtr connection = (*p)->ice_getCachedConnection();
+        if(connection)
+        {
+            return ICE_DYNAMIC_CAST(Ice::ConnectionI, connection);
+        }
+    }
+    return ICE_NULLPTR;
+}
+
+Ice::ConnectionIPtr
+BalancedRequestHandler::waitForConnection()
+{
+    return _proxies[select()]->_getRequestHandler()->waitForConnection();
+}
+
+size_t
+BalancedRequestHandler::select()
+{
+    //
+    // Pick two distinct endpoints at random and use the one whose connection has the
+    // fewest outstanding requests ("power of two choices"). Requests accumulate on the
+    // connections of slow or busy servers so this also steers invocations away from
+    // them, without sending all the invocations to the least loaded server.
+    //
+    const size_t size = _proxies.size();
+    size_t i = IceUtilInternal::random(static_cast<int>(size));
+    size_t j = IceUtilInternal::random(static_cast<int>(size - 1));
+    if(j >= i)
+    {
+        ++j;
+    }
+
+    size_t loadI = 0;
+    size_t loadJ = 0;
+    const bool availableI = getLoad(i, loadI);
+    const bool availableJ = getLoad(j, loadJ);
+    if(availableI && availableJ)
+    {
+        return loadJ < loadI ? j : i;
+    }
+    else if(availableI)
+    {
+        return i;
+    }
+    else if(availableJ)
+    {
+        return j;
+    }
+
+    //
+    // Both endpoints recently failed, use another endpoint if one is available or
+    // otherwise the endpoint which failed first.
+    //
+    IceUtil::Mutex::Lock sync(_mutex);
+    const IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    size_t next = i;
+    for(size_t k = 0; k < size; ++k)
+    {
+        if(_retryTimes[k] <= now)
+        {
+            return k;
+        }
+        else if(_retryTimes[k] < _retryTimes[next])
+        {
+            next = k;
+        }
+    }
+    return next;
+}
+
+bool
+BalancedRequestHandler::getLoad(size_t i, size_t& load)
+{
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        if(_retryTimes[i] > IceUtil::Time::now(IceUtil::Time::Monotonic))
+        {
+            return false;
+        }
+    }
+
+    //
+    // Getting the request handler of the endpoint establishes the connection if it's
+    // not already established.
+    //
+    RequestHandlerPtr handler = _proxies[i]->_getRequestHandler();
+    try
+    {
+        Ice::ConnectionIPtr connection = handler->getConnection();
+        load = connection ? connection->getOutstandingRequestCount() : 0;
+        return true;
+    }
+    catch(const Ice::LocalException& ex)
+    {
+        failed(i, handler, ex);
+        return false;
+    }
+}
+
+void
+BalancedRequestHandler::failed(size_t i, const RequestHandlerPtr& handler, const Ice::LocalException& ex)
+{
+    //
+    // Clear the request handler of the endpoint, a new connection will be established
+    // once the endpoint is used again.
+    //
+    _proxies[i]->_updateRequestHandler(handler, ICE_NULLPTR);
+
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        _retryTimes[i] = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::milliSeconds(retryDelay);
+    }
+
+    TraceLevelsPtr traceLevels = _reference->getInstance()->traceLevels();
+    if(traceLevels->retry >= 2)
+    {
+        Ice::Trace out(_reference->getInstance()->initializationData().logger, traceLevels->retryCat);
+        out << "connection to endpoint failed, using the other endpoints of the proxy\n";
+        out << "endpoint: " << _proxies[i]->_getReference()->getEndpoints()[0]->toString() << "\n" << ex;
+    }
+}
@@ -0,0 +1,58 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_BALANCED_REQUEST_HANDLER_H
+#define ICE_BALANCED_REQUEST_HANDLER_H
+
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Time.h>
+
+#include <Ice/RequestHandler.h>
+#include <Ice/EndpointIF.h>
+#include <Ice/ProxyF.h>
+
+#include <vector>
+
+namespace IceInternal
+{
+
+//
+// The request handler of proxies using the balanced endpoint selection. It
+// keeps a proxy with a single endpoint for each endpoint of the reference and
+// sends each request with the request handler of one of these proxies, which
+// establishes and caches the connection to the endpoint.
+//
+class BalancedRequestHandler ICE_FINAL : public RequestHandler
+#ifdef ICE_CPP11_MAPPING
+                             , public std::enable_shared_from_this<BalancedRequestHandler>
+#endif
+{
+public:
+
+    BalancedRequestHandler(const ReferencePtr&, const std::vector<EndpointIPtr>&);
+
+    virtual RequestHandlerPtr update(const RequestHandlerPtr&, const RequestHandlerPtr&);
+
+    virtual AsyncStatus sendAsyncRequest(const ProxyOutgoingAsyncBasePtr&);
+
+    virtual void asyncRequestCanceled(const OutgoingAsyncBasePtr&, const Ice::LocalException&);
+
+    virtual Ice::ConnectionIPtr getConnection();
+    virtual Ice::ConnectionIPtr waitForConnection();
+
+private:
+
+    size_t select();
+    bool getLoad(size_t, size_t&);
+    void failed(size_t, const RequestHandlerPtr&, const Ice::LocalException&);
+
+    std::vector<Ice::ObjectPrxPtr> _proxies;
+
+    IceUtil::Mutex _mutex;
+    std::vector<IceUtil::Time> _retryTimes; // Endpoints aren't used until their retry time after a failure.
+};
+
+}
+
+#endif
@@ -0,0 +1,478 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/ByteStream.h>
+#include <Ice/ObjectAdapter.h>
+#include <Ice/Communicator.h>
+#include <Ice/LocalException.h>
+#include <Ice/InputStream.h>
+#include <Ice/OutputStream.h>
+#include <Ice/UUID.h>
+
+using namespace std;
+using namespace Ice;
+
+namespace
+{
+
+//
+// The number of aborted streams remembered by a ByteStreamServant to reject the
+// chunks still in flight when the stream was aborted.
+//
+const size_t maxAbortedStreams = 1024;
+
+}
+
+Ice::ByteStreamWriter::ByteStreamWriter(const ObjectPrxPtr& proxy, const string& operation, int chunkSize,
+                                        int window) :
+    _proxy(proxy->ice_twoway()),
+    _operation(operation),
+    _id(generateUUID()),
+    _chunkSize(static_cast<size_t>(chunkSize)),
+    _window(window),
+    _nextChunk(0),
+    _outstanding(0),
+    _closed(false)
+{
+    if(chunkSize <= 0 || window <= 0)
+    {
+        throw IceUtil::IllegalArgumentException(__FILE__, __LINE__, "invalid chunk size or window for byte stream");
+    }
+}
+
+const string&
+Ice::ByteStreamWriter::getId() const
+{
+    return _id;
+}
+
+void
+Ice::ByteStreamWriter::write(const Byte* begin, const Byte* end)
+{
+    while(begin != end)
+    {
+        if(_buffer.empty() && static_cast<size_t>(end - begin) >= _chunkSize)
+        {
+            //
+            // Send complete chunks directly from the caller's bytes, there's no need to
+            // buffer them.
+            //
+            send(begin, begin + _chunkSize, false);
+            begin += _chunkSize;
+        }
+        else
+        {
+            size_t sz = min(static_cast<size_t>(end - begin), _chunkSize - _buffer.size());
+            _buffer.insert(_buffer.end(), begin, begin + sz);
+            begin += sz;
+            if(_buffer.size() == _chunkSize)
+            {
+                send(&_buffer[0], &_buffer[0] + _buffer.size(), false);
+                _buffer.clear();
+            }
+        }
+    }
+}
+
+void
+Ice::ByteStreamWriter::write(const vector<Byte>& bytes)
+{
+    if(!bytes.empty())
+    {
+        write(&bytes[0], &bytes[0] + bytes.size());
+    }
+}
+
+void
+Ice::ByteStreamWriter::close()
+{
+    bool closed;
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        closed = _closed;
+    }
+
+    if(!closed)
+    {
+        if(_buffer.empty())
+        {
+            send(0, 0, true);
+        }
+        else
+        {
+            send(&_buffer[0], &_buffer[0] + _buffer.size(), true);
+            _buffer.clear();
+        }
+    }
+
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    while(!_exception && _outstanding > 0)
+    {
+        wait();
+    }
+    if(_exception)
+    {
+        _exception->ice_throw();
+    }
+}
+
+void
+Ice::ByteStreamWriter::send(const Byte* begin, const Byte* end, bool last)
+{
+    Int chunk;
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        if(_closed)
+        {
+            throw IceUtil::IllegalArgumentException(__FILE__, __LINE__, "byte stream `" + _id + "' is closed");
+        }
+
+        //
+        // Flow control: wait for the receiver to acknowledge a chunk if the window is full.
+        //
+        while(!_exception && _outstanding >= _window)
+        {
+            wait();
+        }
+        if(_exception)
+        {
+            _exception->ice_throw();
+        }
+
+        ++_outstanding;
+        chunk = _nextChunk++;
+        _closed = last;
+    }
+
+    OutputStream os(_proxy->ice_getCommunicator(), _proxy->ice_getEncodingVersion());
+    os.startEncapsulation();
+    os.write(_id);
+    os.write(chunk);
+    os.write(last);
+    os.write(begin, end);
+    os.endEncapsulation();
+
+#ifdef ICE_CPP11_MAPPING
+    auto self = shared_from_this();
+    _proxy->ice_invokeAsync(_operation, OperationMode::Normal, os.finished(),
+                            [self](bool ok, pair<const Byte*, const Byte*>)
+                            {
+                                if(ok)
+                                {
+                                    self->completed();
+                                }
+                                else
+                                {
+                                    self->exception(UnknownUserException(__FILE__, __LINE__,
+                                                                         "byte stream chunk raised user exception"));
+                                }
+                            },
+                            [self](exception_ptr ex)
+                            {
+                                try
+                                {
+                                    rethrow_exception(ex);
+                                }
+                                catch(const Exception& e)
+                                {
+                                    self->exception(e);
+                                }
+                                catch(const std::exception& e)
+                                {
+                                    self->exception(UnknownException(__FILE__, __LINE__, e.what()));
+                                }
+                            });
+#else
+    _proxy->begin_ice_invoke(_operation, Normal, os.finished(),
+                             newCallback_Object_ice_invoke(this, &ByteStreamWriter::response,
+                                                           &ByteStreamWriter::exception));
+#endif
+}
+
+void
+Ice::ByteStreamWriter::completed()
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    --_outstanding;
+    notifyAll();
+}
+
+void
+Ice::ByteStreamWriter::exception(const Exception& ex)
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    --_outstanding;
+    if(!_exception)
+    {
+        ICE_SET_EXCEPTION_FROM_CLONE(_exception, ex.ice_clone());
+    }
+    notifyAll();
+}
+
+#ifndef ICE_CPP11_MAPPING
+void
+Ice::ByteStreamWriter::response(bool ok, const pair<const Byte*, const Byte*>&)
+{
+    if(ok)
+    {
+        completed();
+    }
+    else
+    {
+        exception(UnknownUserException(__FILE__, __LINE__, "byte stream chunk raised user exception"));
+    }
+}
+#endif
+
+Ice::ByteStreamServant::ByteStreamServant(int maxPending, int idleTimeout) :
+    _maxPending(static_cast<size_t>(maxPending)),
+    _idleTimeout(IceUtil::Time::seconds(idleTimeout))
+{
+}
+
+#ifdef ICE_CPP11_MAPPING
+void
+Ice::ByteStreamServant::ice_invokeAsync(pair<const Byte*, const Byte*> inEncaps,
+                                        function<void(bool, const pair<const Byte*, const Byte*>&)> response,
+                                        function<void(exception_ptr)> error,
+                                        const Current& current)
+#else
+void
+Ice::ByteStreamServant::ice_invoke_async(const AMD_Object_ice_invokePtr& cb,
+                                         const pair<const Byte*, const Byte*>& inEncaps,
+                                         const Current& current)
+#endif
+{
+    //
+    // The chunk data is unmarshaled as a view over the request buffer, it's only copied if
+    // the chunk can't be delivered right away.
+    //
+    InputStream in(current.adapter->getCommunicator(), inEncaps);
+    in.startEncapsulation();
+    string id;
+    Int chunk;
+    bool last;
+    pair<const Byte*, const Byte*> data;
+    in.read(id);
+    in.read(chunk);
+    in.read(last);
+    in.read(data);
+    in.endEncapsulation();
+
+    Chunk c;
+    c.last = last;
+#ifdef ICE_CPP11_MAPPING
+    c.response = ::std::move(response);
+    c.error = ::std::move(error);
+#else
+    c.cb = cb;
+#endif
+    dispatch(id, chunk, data, c, current);
+}
+
+void
+Ice::ByteStreamServant::dispatch(const string& id, Int chunk, const pair<const Byte*, const Byte*>& data, Chunk& c,
+                                 const Current& current)
+{
+    if(chunk < 0)
+    {
+        throw MarshalException(__FILE__, __LINE__, "invalid chunk for byte stream `" + id + "'");
+    }
+
+    reap();
+
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        map<string, Stream>::iterator p = _streams.find(id);
+        if(p == _streams.end())
+        {
+            //
+            // A writer doesn't send a chunk before the chunks preceding its window were
+            // acknowledged, only the first chunks of a stream can be received before the
+            // stream is known.
+            //
+            if(static_cast<size_t>(chunk) >= _maxPending)
+            {
+                throw UnknownException(__FILE__, __LINE__, "unknown byte stream `" + id + "'");
+            }
+            p = _streams.insert(make_pair(id, Stream())).first;
+        }
+        Stream& stream = p->second;
+        stream.lastActivity = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        if(stream.aborted)
+        {
+            throw UnknownException(__FILE__, __LINE__, "byte stream `" + id + "' was aborted");
+        }
+        if(chunk < stream.nextChunk || stream.pending.find(chunk) != stream.pending.end())
+        {
+            throw MarshalException(__FILE__, __LINE__, "duplicate chunk for byte stream `" + id + "'");
+        }
+
+        if(stream.dispatching || chunk != stream.nextChunk)
+        {
+            //
+            // Another thread is delivering chunks of this stream or a previous chunk is missing,
+            // keep a copy of this chunk for later delivery.
+            //
+            if(stream.pending.size() >= _maxPending)
+            {
+                throw MemoryLimitException(__FILE__, __LINE__, "too many pending chunks for byte stream `" + id + "'");
+            }
+            c.data.assign(data.first, data.second);
+            c.current = current;
+            stream.pending[chunk] = c;
+            return;
+        }
+        stream.dispatching = true;
+    }
+
+    bool ok = deliver(id, data, c, current);
+    bool last = c.last;
+    map<Int, Chunk> aborted;
+    while(true)
+    {
+        Chunk next;
+        {
+            IceUtil::Mutex::Lock sync(_mutex);
+            map<string, Stream>::iterator p = _streams.find(id);
+            assert(p != _streams.end());
+            Stream& stream = p->second;
+            if(!ok)
+            {
+                aborted.swap(stream.pending);
+                stream.aborted = true;
+                stream.dispatching = false;
+                _aborted.push_back(id);
+                if(_aborted.size() > maxAbortedStreams)
+                {
+                    _streams.erase(_aborted.front());
+                    _aborted.pop_front();
+                }
+                break;
+            }
+            else if(last)
+            {
+                aborted.swap(stream.pending);
+                _streams.erase(p);
+                break;
+            }
+
+            ++stream.nextChunk;
+            map<Int, Chunk>::iterator q = stream.pending.begin();
+            if(q == stream.pending.end() || q->first != stream.nextChunk)
+            {
+                stream.dispatching = false;
+                stream.lastActivity = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                return;
+            }
+            next = q->second;
+            stream.pending.erase(q);
+        }
+
+        pair<const Byte*, const Byte*> d(static_cast<const Byte*>(0), static_cast<const Byte*>(0));
+        if(!next.data.empty())
+        {
+            d.first = &next.data[0];
+            d.second = d.first + next.data.size();
+        }
+        ok = deliver(id, d, next, next.current);
+        last = next.last;
+    }
+
+    //
+    // Chunks received after the last chunk or after a failure are rejected.
+    //
+    for(map<Int, Chunk>::const_iterator p = aborted.begin(); p != aborted.end(); ++p)
+    {
+        UnknownException ex(__FILE__, __LINE__, "byte stream `" + id + "' was aborted");
+#ifdef ICE_CPP11_MAPPING
+        p->second.error(make_exception_ptr(ex));
+#else
+        p->second.cb->ice_exception(ex);
+#endif
+    }
+}
+
+void
+Ice::ByteStreamServant::reap()
+{
+    vector<pair<string, Chunk> > expired;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        if(now < _nextReap)
+        {
+            return;
+        }
+        _nextReap = now + IceUtil::Time::seconds(1);
+
+        //
+        // Discard the idle streams, the aborted streams are discarded once too many
+        // streams were aborted.
+        //
+        map<string, Stream>::iterator p = _streams.begin();
+        while(p != _streams.end())
+        {
+            if(!p->second.dispatching && !p->second.aborted && now - p->second.lastActivity > _idleTimeout)
+            {
+                for(map<Int, Chunk>::const_iterator q = p->second.pending.begin(); q != p->second.pending.end(); ++q)
+                {
+                    expired.push_back(make_pair(p->first, q->second));
+                }
+                _streams.erase(p++);
+            }
+            else
+            {
+                ++p;
+            }
+        }
+    }
+
+    for(vector<pair<string, Chunk> >::const_iterator p = expired.begin(); p != expired.end(); ++p)
+    {
+        UnknownException ex(__FILE__, __LINE__, "byte stream `" + p->first + "' expired");
+#ifdef ICE_CPP11_MAPPING
+        p->second.error(make_exception_ptr(ex));
+#else
+        p->second.cb->ice_exception(ex);
+#endif
+    }
+}
+
+bool
+Ice::ByteStreamServant::deliver(const string& id, const pair<const Byte*, const Byte*>& data, const Chunk& c,
+                                const Current& current)
+{
+    try
+    {
+        received(id, data, c.last, current);
+    }
+    catch(...)
+    {
+#ifdef ICE_CPP11_MAPPING
+        c.error(current_exception());
+#else
+        try
+        {
+            throw;
+        }
+        catch(const std::exception& ex)
+        {
+            c.cb->ice_exception(ex);
+        }
+        catch(...)
+        {
+            c.cb->ice_exception();
+        }
+#endif
+        return false;
+    }
+
+#ifdef ICE_CPP11_MAPPING
+    c.response(true, pair<const Byte*, const Byte*>(static_cast<const Byte*>(0), static_cast<const Byte*>(0)));
+#else
+    c.cb->ice_response(true, vector<Byte>());
+#endif
+    return true;
+}
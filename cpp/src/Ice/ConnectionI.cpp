@@ -107,6 +107,33 @@ private:
     InputStream _stream;
 };
 
+//
+// A message read and parsed along with other messages available on the connection,
+// see ConnectionI::message.
+//
+class ReceivedMessage : public IceUtil::Shared
+{
+public:
+
+    ReceivedMessage(Instance* instance) :
+        stream(instance, currentProtocolEncoding),
+        invokeNum(0),
+        requestId(0),
+        compress(0)
+    {
+    }
+
+    InputStream stream;
+    Int invokeNum;
+    Int requestId;
+    Byte compress;
+    ServantManagerPtr servantManager;
+    ObjectAdapterPtr adapter;
+    OutgoingAsyncBasePtr outAsync;
+    ICE_DELEGATE(HeartbeatCallback) heartbeatCallback;
+};
+typedef IceUtil::Handle<ReceivedMessage> ReceivedMessagePtr;
+
 class FinishCall : public DispatchWorkItem
 {
 public:
@@ -771,6 +798,13 @@ Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compres
     return status;
 }
 
+size_t
+Ice::ConnectionI::getOutstandingRequestCount() const
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    return _asyncRequests.size();
+}
+
 BatchRequestQueuePtr
 Ice::ConnectionI::getBatchRequestQueue() const
 {
@@ -1409,6 +1443,12 @@ Ice::ConnectionI::connector() const
     return _connector; // No mutex protection necessary, _connector is immutable.
 }
 
+TransceiverPtr
+Ice::ConnectionI::transceiver() const
+{
+    return _transceiver; // No mutex protection necessary, _transceiver is immutable.
+}
+
 void
 Ice::ConnectionI::setAdapter(const ObjectAdapterPtr& adapter)
 {
@@ -1587,6 +1627,7 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
     OutgoingAsyncBasePtr outAsync;
     ICE_DELEGATE(HeartbeatCallback) heartbeatCallback;
     int dispatchCount = 0;
+    vector<ReceivedMessagePtr> messages;
 
     ThreadPoolMessage<ConnectionI> msg(current, *this);
     {
@@ -1623,96 +1664,9 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
                 }
             }
 
-            while(readyOp & SocketOperationRead)
+            if(readyOp & SocketOperationRead)
             {
-                if(_observer && !_readHeader)
-                {
-                    _observer.startRead(_readStream);
-                }
-
-                readOp = read(_readStream);
-                if(readOp & SocketOperationRead)
-                {
-                    break;
-                }
-                if(_observer && !_readHeader)
-                {
-                    assert(_readStream.i == _readStream.b.end());
-                    _observer.finishRead(_readStream);
-                }
-
-                if(_readHeader) // Read header if necessary.
-                {
-                    _readHeader = false;
-
-                    if(_observer)
-                    {
-                        _observer->receivedBytes(static_cast<int>(headerSize));
-                    }
-
-                    //
-                    // Connection is validated on first message. This is only used by
-                    // setState() to check wether or not we can print a connection
-                    // warning (a client might close the connection forcefully if the
-                    // connection isn't validated, we don't want to print a warning
-                    // in this case).
-                    //
-                    _validated = true;
-
-                    ptrdiff_t pos = _readStream.i - _readStream.b.begin();
-                    if(pos < headerSize)
-                    {
-                        //
-                        // This situation is possible for small UDP packets.
-                        //
-                        throw IllegalMessageSizeException(__FILE__, __LINE__);
-                    }
-
-                    _readStream.i = _readStream.b.begin();
-                    const Byte* m;
-                    _readStream.readBlob(m, static_cast<Int>(sizeof(magic)));
-                    if(m[0] != magic[0] || m[1] != magic[1] || m[2] != magic[2] || m[3] != magic[3])
-                    {
-                        throw BadMagicException(__FILE__, __LINE__, "", Ice::ByteSeq(&m[0], &m[0] + sizeof(magic)));
-                    }
-                    ProtocolVersion pv;
-                    _readStream.read(pv);
-                    checkSupportedProtocol(pv);
-                    EncodingVersion ev;
-                    _readStream.read(ev);
-                    checkSupportedProtocolEncoding(ev);
-
-                    Byte messageType;
-                    _readStream.read(messageType);
-                    Byte compressByte;
-                    _readStream.read(compressByte);
-                    Int size;
-                    _readStream.read(size);
-                    if(size < headerSize)
-                    {
-                        throw IllegalMessageSizeException(__FILE__, __LINE__);
-                    }
-
-                    if(size > static_cast<Int>(_messageSizeMax))
-                    {
-                        Ex::throwMemoryLimitException(__FILE__, __LINE__, static_cast<size_t>(size), _messageSizeMax);
-                    }
-                    if(static_cast<size_t>(size) > _readStream.b.size())
-                    {
-                        _readStream.b.resize(static_cast<size_t>(size));
-                    }
-                    _readStream.i = _readStream.b.begin() + pos;
-                }
-
-                if(_readStream.i != _readStream.b.end())
-                {
-                    if(_endpoint->datagram())
-                    {
-                        throw DatagramLimitException(__FILE__, __LINE__); // The message was truncated.
-                    }
-                    continue;
-                }
-                break;
+                readOp = readMessage();
             }
 
             SocketOperation newOp = static_cast<SocketOperation>(readOp | writeOp);
@@ -1776,6 +1730,44 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
                                                                               outAsync,
                                                                               heartbeatCallback,
                                                                               dispatchCount));
+
+#if !defined(ICE_USE_IOCP)
+                    //
+                    // Also read and parse the messages which are already available (up to the
+                    // MessageBatchSize of the thread pool) to dispatch them with this message,
+                    // in order and from this thread. This saves a thread pool round trip for
+                    // each message when many small requests are pipelined on the connection.
+                    //
+                    const int messageBatchSize = _threadPool->messageBatchSize();
+                    while(_state == StateActive && !_endpoint->datagram() &&
+                          static_cast<int>(messages.size()) + 1 < messageBatchSize)
+                    {
+                        try
+                        {
+                            if(readMessage() & SocketOperationRead)
+                            {
+                                break; // The next message isn't available yet.
+                            }
+                        }
+                        catch(const LocalException& ex)
+                        {
+                            setState(StateClosed, ex);
+                            break;
+                        }
+
+                        ReceivedMessagePtr message = new ReceivedMessage(_instance.get());
+                        newOp = static_cast<SocketOperation>(newOp | parseMessage(message->stream,
+                                                                                  message->invokeNum,
+                                                                                  message->requestId,
+                                                                                  message->compress,
+                                                                                  message->servantManager,
+                                                                                  message->adapter,
+                                                                                  message->outAsync,
+                                                                                  message->heartbeatCallback,
+                                                                                  dispatchCount));
+                        messages.push_back(message);
+                    }
+#endif
                 }
 
                 if(readyOp & SocketOperationWrite)
@@ -1850,22 +1842,143 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
     _threadPool->dispatchFromThisThread(new DispatchCall(ICE_SHARED_FROM_THIS, startCB, sentCBs, compress, requestId,
                                                          invokeNum, servantManager, adapter, outAsync,
                                                          heartbeatCallback, current.stream));
+    for(vector<ReceivedMessagePtr>::const_iterator p = messages.begin(); p != messages.end(); ++p)
+    {
+        _threadPool->dispatchFromThisThread(new DispatchCall(ICE_SHARED_FROM_THIS, StartCallbackPtr(),
+                                                             vector<OutgoingMessage>(), (*p)->compress,
+                                                             (*p)->requestId, (*p)->invokeNum, (*p)->servantManager,
+                                                             (*p)->adapter, (*p)->outAsync, (*p)->heartbeatCallback,
+                                                             (*p)->stream));
+    }
 #else
     if(!_dispatcher) // Optimization, call dispatch() directly if there's no dispatcher.
     {
         dispatch(startCB, sentCBs, compress, requestId, invokeNum, servantManager, adapter, outAsync, heartbeatCallback,
                  current.stream);
+        for(vector<ReceivedMessagePtr>::const_iterator p = messages.begin(); p != messages.end(); ++p)
+        {
+            dispatch(StartCallbackPtr(), vector<OutgoingMessage>(), (*p)->compress, (*p)->requestId,
+                     (*p)->invokeNum, (*p)->servantManager, (*p)->adapter, (*p)->outAsync, (*p)->heartbeatCallback,
+                     (*p)->stream);
+        }
     }
     else
     {
         _threadPool->dispatchFromThisThread(new DispatchCall(ICE_SHARED_FROM_THIS, startCB, sentCBs, compress, requestId,
                                                              invokeNum, servantManager, adapter, outAsync,
                                                              heartbeatCallback, current.stream));
-
+        for(vector<ReceivedMessagePtr>::const_iterator p = messages.begin(); p != messages.end(); ++p)
+        {
+            _threadPool->dispatchFromThisThread(new DispatchCall(ICE_SHARED_FROM_THIS, StartCallbackPtr(),
+                                                                 vector<OutgoingMessage>(), (*p)->compress,
+                                                                 (*p)->requestId, (*p)->invokeNum,
+                                                                 (*p)->servantManager, (*p)->adapter, (*p)->outAsync,
+                                                                 (*p)->heartbeatCallback, (*p)->stream));
+        }
     }
 #endif
 }
 
+SocketOperation
+Ice::ConnectionI::readMessage()
+{
+    //
+    // Reads a protocol message into _readStream. Returns SocketOperationRead if the
+    // message isn't complete yet and more data needs to be read from the transceiver.
+    //
+    while(true)
+    {
+        if(_observer && !_readHeader)
+        {
+            _observer.startRead(_readStream);
+        }
+
+        SocketOperation op = read(_readStream);
+        if(op & SocketOperationRead)
+        {
+            return op;
+        }
+        if(_observer && !_readHeader)
+        {
+            assert(_readStream.i == _readStream.b.end());
+            _observer.finishRead(_readStream);
+        }
+
+        if(_readHeader) // Read header if necessary.
+        {
+            _readHeader = false;
+
+            if(_observer)
+            {
+                _observer->receivedBytes(static_cast<int>(headerSize));
+            }
+
+            //
+            // Connection is validated on first message. This is only used by
+            // setState() to check wether or not we can print a connection
+            // warning (a client might close the connection forcefully if the
+            // connection isn't validated, we don't want to print a warning
+            // in this case).
+            //
+            _validated = true;
+
+            ptrdiff_t pos = _readStream.i - _readStream.b.begin();
+            if(pos < headerSize)
+            {
+                //
+                // This situation is possible for small UDP packets.
+                //
+                throw IllegalMessageSizeException(__FILE__, __LINE__);
+            }
+
+            _readStream.i = _readStream.b.begin();
+            const Byte* m;
+            _readStream.readBlob(m, static_cast<Int>(sizeof(magic)));
+            if(m[0] != magic[0] || m[1] != magic[1] || m[2] != magic[2] || m[3] != magic[3])
+            {
+                throw BadMagicException(__FILE__, __LINE__, "", Ice::ByteSeq(&m[0], &m[0] + sizeof(magic)));
+            }
+            ProtocolVersion pv;
+            _readStream.read(pv);
+            checkSupportedProtocol(pv);
+            EncodingVersion ev;
+            _readStream.read(ev);
+            checkSupportedProtocolEncoding(ev);
+
+            Byte messageType;
+            _readStream.read(messageType);
+            Byte compressByte;
+            _readStream.read(compressByte);
+            Int size;
+            _readStream.read(size);
+            if(size < headerSize)
+            {
+                throw IllegalMessageSizeException(__FILE__, __LINE__);
+            }
+
+            if(size > static_cast<Int>(_messageSizeMax))
+            {
+                Ex::throwMemoryLimitException(__FILE__, __LINE__, static_cast<size_t>(size), _messageSizeMax);
+            }
+            if(static_cast<size_t>(size) > _readStream.b.size())
+            {
+                _readStream.b.resize(static_cast<size_t>(size));
+            }
+            _readStream.i = _readStream.b.begin() + pos;
+        }
+
+        if(_readStream.i != _readStream.b.end())
+        {
+            if(_endpoint->datagram())
+            {
+                throw DatagramLimitException(__FILE__, __LINE__); // The message was truncated.
+            }
+            continue;
+        }
+        return SocketOperationNone;
+    }
+}
+
 void
 ConnectionI::dispatch(const StartCallbackPtr& startCB, const vector<OutgoingMessage>& sentCBs,
                       Byte compress, Int requestId, Int invokeNum, const ServantManagerPtr& servantManager,
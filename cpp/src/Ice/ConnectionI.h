@@ -164,6 +164,7 @@ public:
     void monitor(const IceUtil::Time&, const IceInternal::ACMConfig&);
 
     IceInternal::AsyncStatus sendAsyncRequest(const IceInternal::OutgoingAsyncBasePtr&, bool, bool, int);
+    size_t getOutstandingRequestCount() const; // Number of requests waiting for a response.
 
     IceInternal::BatchRequestQueuePtr getBatchRequestQueue() const;
 
@@ -213,6 +214,7 @@ public:
 
     IceInternal::EndpointIPtr endpoint() const;
     IceInternal::ConnectorPtr connector() const;
+    IceInternal::TransceiverPtr transceiver() const;
 
     virtual void setAdapter(const ObjectAdapterPtr&); // From Connection.
     virtual ObjectAdapterPtr getAdapter() const ICE_NOEXCEPT; // From Connection.
@@ -296,6 +298,7 @@ private:
     void doUncompress(Ice::InputStream&, Ice::InputStream&);
 #endif
 
+    IceInternal::SocketOperation readMessage();
     IceInternal::SocketOperation parseMessage(Ice::InputStream&, Int&, Int&, Byte&,
                                               IceInternal::ServantManagerPtr&, ObjectAdapterPtr&,
                                               IceInternal::OutgoingAsyncBasePtr&, ICE_DELEGATE(HeartbeatCallback)&, int&);
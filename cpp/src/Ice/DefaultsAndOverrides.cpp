@@ -102,6 +102,7 @@ IceInternal::DefaultsAndOverrides::DefaultsAndOverrides(const PropertiesPtr& pro
         properties->getPropertyAsIntWithDefault("Ice.Default.CollocationOptimized", 1) > 0;
 
     value = properties->getPropertyWithDefault("Ice.Default.EndpointSelection", "Random");
+    defaultBalanced = false;
     if(value == "Random")
     {
         defaultEndpointSelection = ICE_ENUM(EndpointSelectionType, Random);
@@ -110,10 +111,19 @@ IceInternal::DefaultsAndOverrides::DefaultsAndOverrides(const PropertiesPtr& pro
     {
         defaultEndpointSelection = ICE_ENUM(EndpointSelectionType, Ordered);
     }
+    else if(value == "Balanced")
+    {
+        //
+        // Balanced isn't an endpoint selection type of the other language mappings,
+        // the connections to the endpoints are established in random order.
+        //
+        defaultEndpointSelection = ICE_ENUM(EndpointSelectionType, Random);
+        defaultBalanced = true;
+    }
     else
     {
         throw EndpointSelectionTypeParseException(__FILE__, __LINE__, "illegal value `" + value +
-                                                  "'; expected `Random' or `Ordered'");
+                                                  "'; expected `Random', `Ordered' or `Balanced'");
     }
 
     const_cast<int&>(defaultTimeout) =
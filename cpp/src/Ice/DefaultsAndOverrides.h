@@ -28,6 +28,7 @@ public:
     std::string defaultProtocol;
     bool defaultCollocationOptimization;
     Ice::EndpointSelectionType defaultEndpointSelection;
+    bool defaultBalanced;
     int defaultTimeout;
     int defaultInvocationTimeout;
     int defaultLocatorCacheTimeout;
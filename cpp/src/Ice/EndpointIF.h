@@ -14,6 +14,9 @@ namespace IceInternal
 class EndpointI;
 class TcpEndpointI;
 class UdpEndpointI;
+class PathEndpointI;
+class ShmEndpointI;
+class UnixEndpointI;
 class WSEndpoint;
 class EndpointI_connectors;
 
@@ -22,6 +25,9 @@ class EndpointI_connectors;
 using EndpointIPtr = ::std::shared_ptr<EndpointI>;
 using TcpEndpointIPtr = ::std::shared_ptr<TcpEndpointI>;
 using UdpEndpointIPtr = ::std::shared_ptr<UdpEndpointI>;
+using PathEndpointIPtr = ::std::shared_ptr<PathEndpointI>;
+using ShmEndpointIPtr = ::std::shared_ptr<ShmEndpointI>;
+using UnixEndpointIPtr = ::std::shared_ptr<UnixEndpointI>;
 using WSEndpointPtr = ::std::shared_ptr<WSEndpoint>;
 using EndpointI_connectorsPtr = ::std::shared_ptr<EndpointI_connectors>;
 
@@ -36,6 +42,15 @@ typedef Handle<TcpEndpointI> TcpEndpointIPtr;
 ICE_API IceUtil::Shared* upCast(UdpEndpointI*);
 typedef Handle<UdpEndpointI> UdpEndpointIPtr;
 
+ICE_API IceUtil::Shared* upCast(PathEndpointI*);
+typedef Handle<PathEndpointI> PathEndpointIPtr;
+
+ICE_API IceUtil::Shared* upCast(ShmEndpointI*);
+typedef Handle<ShmEndpointI> ShmEndpointIPtr;
+
+ICE_API IceUtil::Shared* upCast(UnixEndpointI*);
+typedef Handle<UnixEndpointI> UnixEndpointIPtr;
+
 ICE_API IceUtil::Shared* upCast(WSEndpoint*);
 typedef Handle<WSEndpoint> WSEndpointPtr;
 
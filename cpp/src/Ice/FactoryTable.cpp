@@ -117,6 +117,57 @@ IceInternal::FactoryTable::removeValueFactory(const string& t)
     }
 }
 
+#ifdef ICE_CPP11_MAPPING
+
+//
+// Add a factory to the arena value factory table.
+//
+void
+IceInternal::FactoryTable::addArenaValueFactory(const string& t, ArenaValueFactory f)
+{
+    IceUtil::Mutex::Lock lock(_m);
+    assert(f);
+    AVFTable::iterator i = _avft.find(t);
+    if(i == _avft.end())
+    {
+        _avft[t] = AVFPair(f, 1);
+    }
+    else
+    {
+        i->second.second++;
+    }
+}
+
+//
+// Return the arena value factory for a given type ID
+//
+IceInternal::ArenaValueFactory
+IceInternal::FactoryTable::getArenaValueFactory(const string& t) const
+{
+    IceUtil::Mutex::Lock lock(_m);
+    AVFTable::const_iterator i = _avft.find(t);
+    return i != _avft.end() ? i->second.first : ArenaValueFactory();
+}
+
+//
+// Remove a factory from the arena value factory table, see removeValueFactory.
+//
+void
+IceInternal::FactoryTable::removeArenaValueFactory(const string& t)
+{
+    IceUtil::Mutex::Lock lock(_m);
+    AVFTable::iterator i = _avft.find(t);
+    if(i != _avft.end())
+    {
+        if(--i->second.second == 0)
+        {
+            _avft.erase(i);
+        }
+    }
+}
+
+#endif
+
 //
 // Add a factory to the value factory table.
 //
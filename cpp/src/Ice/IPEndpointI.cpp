@@ -10,6 +10,7 @@
 #include <Ice/LoggerUtil.h>
 #include <Ice/HashUtil.h>
 #include <Ice/NetworkProxy.h>
+#include <Ice/InstrumentationI.h>
 #include <IceUtil/MutexPtrLock.h>
 
 using namespace std;
@@ -40,6 +41,27 @@ public:
 
 Init init;
 
+ObserverPtr
+getLookupObserver(const InstancePtr& instance, const IPEndpointIPtr& endpoint,
+                  CommunicatorObserverI::EndpointLookupCache cache)
+{
+    const CommunicatorObserverPtr& obsv = instance->initializationData().observer;
+    if(!obsv)
+    {
+        return 0;
+    }
+
+    //
+    // The IceMX observer records whether the addresses were found in the cache.
+    //
+    CommunicatorObserverI* observer = dynamic_cast<CommunicatorObserverI*>(obsv.get());
+    if(observer)
+    {
+        return observer->getEndpointLookupObserver(endpoint, cache);
+    }
+    return obsv->getEndpointLookupObserver(endpoint);
+}
+
 }
 
 #ifndef ICE_CPP11_MAPPING
@@ -534,13 +556,59 @@ IceInternal::IPEndpointI::IPEndpointI(const ProtocolInstancePtr& instance, Input
 }
 
 IceInternal::EndpointHostResolver::EndpointHostResolver(const InstancePtr& instance) :
-    IceUtil::Thread("Ice.HostResolver"),
     _instance(instance),
     _protocol(instance->protocolSupport()),
     _preferIPv6(instance->preferIPv6()),
-    _destroyed(false)
+    _cacheTTL(IceUtil::Time::seconds(
+        instance->initializationData().properties->getPropertyAsIntWithDefault("Ice.HostResolver.CacheTTL", 0))),
+    _negativeCacheTTL(IceUtil::Time::seconds(
+        instance->initializationData().properties->getPropertyAsIntWithDefault("Ice.HostResolver.NegativeCacheTTL", 0))),
+    _destroyed(false),
+    _cachePruneSize(64)
 {
-    updateObserver();
+    const PropertiesPtr properties = _instance->initializationData().properties;
+    int size = properties->getPropertyAsIntWithDefault("Ice.HostResolver.Size", 1);
+    if(size < 1)
+    {
+        Warning out(_instance->initializationData().logger);
+        out << "Ice.HostResolver.Size < 1; Size adjusted to 1";
+        size = 1;
+    }
+
+    bool hasPriority = properties->getProperty("Ice.ThreadPriority") != "";
+    int priority = properties->getPropertyAsInt("Ice.ThreadPriority");
+
+    __setNoDelete(true);
+    try
+    {
+        for(int i = 0; i < size; ++i)
+        {
+            ostringstream name;
+            name << "Ice.HostResolver";
+            if(size > 1)
+            {
+                name << '-' << i;
+            }
+            HelperThreadPtr thread = new HelperThread(this, name.str());
+            if(hasPriority)
+            {
+                thread->start(0, priority);
+            }
+            else
+            {
+                thread->start();
+            }
+            _threads.push_back(thread);
+        }
+    }
+    catch(...)
+    {
+        destroy();
+        joinWithAllThreads();
+        __setNoDelete(false);
+        throw;
+    }
+    __setNoDelete(false);
 }
 
 void
@@ -548,8 +616,9 @@ IceInternal::EndpointHostResolver::resolve(const string& host, int port, Ice::En
                                            const IPEndpointIPtr& endpoint, const EndpointI_connectorsPtr& callback)
 {
     //
-    // Try to get the addresses without DNS lookup. If this doesn't work, we queue a resolve
-    // entry and the thread will take care of getting the endpoint addresses.
+    // Try to get the addresses without DNS lookup. If this doesn't work, we look for the
+    // addresses in the cache and otherwise queue a resolve entry and a thread will take care
+    // of getting the endpoint addresses.
     //
     NetworkProxyPtr networkProxy = _instance->networkProxy();
     if(!networkProxy)
@@ -568,30 +637,74 @@ IceInternal::EndpointHostResolver::resolve(const string& host, int port, Ice::En
             callback->exception(ex);
             return;
         }
+
+        //
+        // The cache isn't used with a network proxy, the addresses are resolved with the
+        // protocol supported by the proxy.
+        //
+        vector<Address> addrs;
+        Ice::Int error;
+        if(findCachedAddresses(host, port, addrs, error))
+        {
+            ObserverPtr observer = getLookupObserver(_instance, endpoint, CommunicatorObserverI::CacheHit);
+            if(observer)
+            {
+                observer->attach();
+            }
+            try
+            {
+                if(addrs.empty())
+                {
+                    throw Ice::DNSException(__FILE__, __LINE__, error, host);
+                }
+                sortAddresses(addrs, _protocol, selType, _preferIPv6);
+                if(observer)
+                {
+                    observer->detach();
+                }
+                callback->connectors(endpoint->connectors(addrs, 0));
+            }
+            catch(const Ice::LocalException& ex)
+            {
+                if(observer)
+                {
+                    observer->failed(ex.ice_id());
+                    observer->detach();
+                }
+                callback->exception(ex);
+            }
+            return;
+        }
     }
 
     Lock sync(*this);
     assert(!_destroyed);
 
+    //
+    // If the same host and port is already being resolved, the entry waits for the result of
+    // this query instead of queuing a new one.
+    //
+    Query query = make_pair(host, port);
+    map<Query, vector<ResolveEntry> >::iterator p = _pending.find(query);
+    const bool merged = p != _pending.end();
+    if(!merged)
+    {
+        p = _pending.insert(make_pair(query, vector<ResolveEntry>())).first;
+        _queue.push_back(query);
+        notify();
+    }
+
     ResolveEntry entry;
-    entry.host = host;
-    entry.port = port;
     entry.selType = selType;
     entry.endpoint = endpoint;
     entry.callback = callback;
-
-    const CommunicatorObserverPtr& obsv = _instance->initializationData().observer;
-    if(obsv)
+    entry.observer = getLookupObserver(_instance, endpoint,
+                                       merged ? CommunicatorObserverI::CacheMerged : CommunicatorObserverI::CacheMiss);
+    if(entry.observer)
     {
-        entry.observer = obsv->getEndpointLookupObserver(endpoint);
-        if(entry.observer)
-        {
-            entry.observer->attach();
-        }
+        entry.observer->attach();
     }
-
-    _queue.push_back(entry);
-    notify();
+    p->second.push_back(entry);
 }
 
 void
@@ -600,15 +713,55 @@ IceInternal::EndpointHostResolver::destroy()
     Lock sync(*this);
     assert(!_destroyed);
     _destroyed = true;
-    notify();
+    notifyAll();
+}
+
+void
+IceInternal::EndpointHostResolver::joinWithAllThreads()
+{
+    //
+    // _threads is immutable after destroy() has been called, therefore no synchronization is
+    // needed. (Synchronization wouldn't be possible here anyway, because otherwise the other
+    // threads would never terminate.)
+    //
+    for(vector<HelperThreadPtr>::iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+
+    for(map<Query, vector<ResolveEntry> >::const_iterator p = _pending.begin(); p != _pending.end(); ++p)
+    {
+        for(vector<ResolveEntry>::const_iterator q = p->second.begin(); q != p->second.end(); ++q)
+        {
+            Ice::CommunicatorDestroyedException ex(__FILE__, __LINE__);
+            if(q->observer)
+            {
+                q->observer->failed(ex.ice_id());
+                q->observer->detach();
+            }
+            q->callback->exception(ex);
+        }
+    }
+    _pending.clear();
+    _queue.clear();
+}
+
+void
+IceInternal::EndpointHostResolver::updateObservers()
+{
+    Lock sync(*this);
+    for(vector<HelperThreadPtr>::iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        (*p)->updateObserver();
+    }
 }
 
 void
-IceInternal::EndpointHostResolver::run()
+IceInternal::EndpointHostResolver::run(const HelperThreadPtr& thread)
 {
     while(true)
     {
-        ResolveEntry r;
+        Query query;
         ThreadObserverPtr threadObserver;
         {
             Lock sync(*this);
@@ -622,19 +775,23 @@ IceInternal::EndpointHostResolver::run()
                 break;
             }
 
-            r = _queue.front();
+            query = _queue.front();
             _queue.pop_front();
-            threadObserver = _observer.get();
+            threadObserver = thread->getObserver();
         }
 
         if(threadObserver)
         {
-            threadObserver->stateChanged(ICE_ENUM(ThreadState, ThreadStateIdle), ICE_ENUM(ThreadState, ThreadStateInUseForOther));
+            threadObserver->stateChanged(ICE_ENUM(ThreadState, ThreadStateIdle),
+                                         ICE_ENUM(ThreadState, ThreadStateInUseForOther));
         }
 
+        NetworkProxyPtr networkProxy = _instance->networkProxy();
+        const bool cache = !networkProxy;
+        vector<Address> addresses;
+        IceInternal::UniquePtr<Ice::LocalException> exception;
         try
         {
-            NetworkProxyPtr networkProxy = _instance->networkProxy();
             ProtocolSupport protocol = _protocol;
             if(networkProxy)
             {
@@ -645,61 +802,172 @@ IceInternal::EndpointHostResolver::run()
                 }
             }
 
-            vector<Address> addresses = getAddresses(r.host, r.port, protocol, r.selType, _preferIPv6, true);
-            if(r.observer)
+            addresses = getAddresses(query.first, query.second, protocol, ICE_ENUM(EndpointSelectionType, Ordered),
+                                     _preferIPv6, true);
+            if(cache)
             {
-                r.observer->detach();
-                r.observer = 0;
+                cacheAddresses(query.first, query.second, addresses, 0);
             }
-
-            r.callback->connectors(r.endpoint->connectors(addresses, networkProxy));
-
-            if(threadObserver)
+        }
+        catch(const Ice::DNSException& ex)
+        {
+            if(cache)
             {
-                threadObserver->stateChanged(ICE_ENUM(ThreadState, ThreadStateInUseForOther),
-                                             ICE_ENUM(ThreadState, ThreadStateIdle));
+                cacheAddresses(query.first, query.second, vector<Address>(), ex.error);
             }
-
+            ICE_SET_EXCEPTION_FROM_CLONE(exception, ex.ice_clone());
         }
         catch(const Ice::LocalException& ex)
         {
-            if(threadObserver)
+            ICE_SET_EXCEPTION_FROM_CLONE(exception, ex.ice_clone());
+        }
+
+        vector<ResolveEntry> entries;
+        {
+            Lock sync(*this);
+            map<Query, vector<ResolveEntry> >::iterator p = _pending.find(query);
+            assert(p != _pending.end());
+            entries.swap(p->second);
+            _pending.erase(p);
+        }
+
+        for(vector<ResolveEntry>::iterator r = entries.begin(); r != entries.end(); ++r)
+        {
+            try
             {
-                threadObserver->stateChanged(ICE_ENUM(ThreadState, ThreadStateInUseForOther),
-                                             ICE_ENUM(ThreadState, ThreadStateIdle));
+                if(exception)
+                {
+                    exception->ice_throw();
+                }
+
+                vector<Address> addrs = addresses;
+                if(r->selType != ICE_ENUM(EndpointSelectionType, Ordered))
+                {
+                    sortAddresses(addrs, networkProxy ? networkProxy->getProtocolSupport() : _protocol, r->selType,
+                                  _preferIPv6);
+                }
+                if(r->observer)
+                {
+                    r->observer->detach();
+                    r->observer = 0;
+                }
+                r->callback->connectors(r->endpoint->connectors(addrs, networkProxy));
             }
-            if(r.observer)
+            catch(const Ice::LocalException& ex)
             {
-                r.observer->failed(ex.ice_id());
-                r.observer->detach();
+                if(r->observer)
+                {
+                    r->observer->failed(ex.ice_id());
+                    r->observer->detach();
+                }
+                r->callback->exception(ex);
             }
-            r.callback->exception(ex);
         }
+
+        if(threadObserver)
+        {
+            threadObserver->stateChanged(ICE_ENUM(ThreadState, ThreadStateInUseForOther),
+                                         ICE_ENUM(ThreadState, ThreadStateIdle));
+        }
+    }
+}
+
+bool
+IceInternal::EndpointHostResolver::findCachedAddresses(const string& host, int port, vector<Address>& addresses,
+                                                       Ice::Int& error)
+{
+    if(_cacheTTL == IceUtil::Time() && _negativeCacheTTL == IceUtil::Time())
+    {
+        return false;
+    }
+
+    Lock sync(*this);
+    map<Query, CacheEntry>::iterator p = _cache.find(make_pair(host, port));
+    if(p == _cache.end())
+    {
+        return false;
+    }
+    if(p->second.expiration <= IceUtil::Time::now(IceUtil::Time::Monotonic))
+    {
+        _cache.erase(p);
+        return false;
     }
+    addresses = p->second.addresses;
+    error = p->second.error;
+    return true;
+}
 
-    for(deque<ResolveEntry>::const_iterator p = _queue.begin(); p != _queue.end(); ++p)
+void
+IceInternal::EndpointHostResolver::cacheAddresses(const string& host, int port, const vector<Address>& addresses,
+                                                  Ice::Int error)
+{
+    const IceUtil::Time& ttl = addresses.empty() ? _negativeCacheTTL : _cacheTTL;
+    if(ttl == IceUtil::Time())
     {
-        Ice::CommunicatorDestroyedException ex(__FILE__, __LINE__);
-        if(p->observer)
+        return;
+    }
+
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+
+    Lock sync(*this);
+    if(_cache.size() >= _cachePruneSize)
+    {
+        map<Query, CacheEntry>::iterator p = _cache.begin();
+        while(p != _cache.end())
         {
-            p->observer->failed(ex.ice_id());
-            p->observer->detach();
+            if(p->second.expiration <= now)
+            {
+                _cache.erase(p++);
+            }
+            else
+            {
+                ++p;
+            }
         }
-        p->callback->exception(ex);
+        _cachePruneSize = max(static_cast<size_t>(64), 2 * _cache.size());
     }
-    _queue.clear();
 
-    if(_observer)
+    CacheEntry& entry = _cache[make_pair(host, port)];
+    entry.addresses = addresses;
+    entry.error = error;
+    entry.expiration = now + ttl;
+}
+
+IceInternal::EndpointHostResolver::HelperThread::HelperThread(const EndpointHostResolverPtr& resolver,
+                                                              const string& name) :
+    IceUtil::Thread(name),
+    _resolver(resolver)
+{
+    updateObserver();
+}
+
+void
+IceInternal::EndpointHostResolver::HelperThread::run()
+{
+    try
     {
-        _observer.detach();
+        _resolver->run(this);
     }
+    catch(const exception& ex)
+    {
+        Error out(_resolver->_instance->initializationData().logger);
+        out << "exception in endpoint host resolver thread " << name() << ":\n" << ex;
+    }
+    catch(...)
+    {
+        Error out(_resolver->_instance->initializationData().logger);
+        out << "unknown exception in endpoint host resolver thread " << name();
+    }
+
+    _observer.detach();
+    _resolver = 0; // Break cyclic dependency.
 }
 
 void
-IceInternal::EndpointHostResolver::updateObserver()
+IceInternal::EndpointHostResolver::HelperThread::updateObserver()
 {
-    Lock sync(*this);
-    const CommunicatorObserverPtr& obsv = _instance->initializationData().observer;
+    // Must be called with the resolver mutex locked
+    const CommunicatorObserverPtr& obsv = _resolver->_instance->initializationData().observer;
     if(obsv)
     {
         _observer.attach(obsv->getThreadObserver("Communicator",
@@ -708,3 +976,10 @@ IceInternal::EndpointHostResolver::updateObserver()
                                                  _observer.get()));
     }
 }
+
+ThreadObserverPtr
+IceInternal::EndpointHostResolver::HelperThread::getObserver() const
+{
+    // Must be called with the resolver mutex locked
+    return _observer.get();
+}
@@ -16,6 +16,7 @@
 #include <Ice/ObserverHelper.h>
 
 #include <deque>
+#include <map>
 
 namespace IceInternal
 {
@@ -102,8 +103,33 @@ private:
     mutable Ice::Int _hashValue;
 };
 
-class ICE_API EndpointHostResolver : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+//
+// Resolves the host names of IP endpoints with a pool of Ice.HostResolver.Size
+// threads. Concurrent lookups of the same host and port are merged into a
+// single DNS query. Successful and failed lookups can be cached, for
+// Ice.HostResolver.CacheTTL and Ice.HostResolver.NegativeCacheTTL seconds
+// respectively, the cache is disabled by default.
+//
+class ICE_API EndpointHostResolver : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
 {
+    class HelperThread : public IceUtil::Thread
+    {
+    public:
+
+        HelperThread(const EndpointHostResolverPtr&, const std::string&);
+        virtual void run();
+
+        void updateObserver();
+        Ice::Instrumentation::ThreadObserverPtr getObserver() const;
+
+    private:
+
+        EndpointHostResolverPtr _resolver;
+        ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
+    };
+    typedef IceUtil::Handle<HelperThread> HelperThreadPtr;
+    friend class HelperThread;
+
 public:
 
     EndpointHostResolver(const InstancePtr&);
@@ -111,28 +137,44 @@ public:
     void resolve(const std::string&, int, Ice::EndpointSelectionType, const IPEndpointIPtr&,
                  const EndpointI_connectorsPtr&);
     void destroy();
+    void joinWithAllThreads();
 
-    virtual void run();
-    void updateObserver();
+    void updateObservers();
 
 private:
 
+    void run(const HelperThreadPtr&);
+    bool findCachedAddresses(const std::string&, int, std::vector<Address>&, Ice::Int&);
+    void cacheAddresses(const std::string&, int, const std::vector<Address>&, Ice::Int);
+
     struct ResolveEntry
     {
-        std::string host;
-        int port;
         Ice::EndpointSelectionType selType;
         IPEndpointIPtr endpoint;
         EndpointI_connectorsPtr callback;
         Ice::Instrumentation::ObserverPtr observer;
     };
 
+    struct CacheEntry
+    {
+        std::vector<Address> addresses; // Empty if the lookup failed.
+        Ice::Int error; // The DNSException error if the lookup failed.
+        IceUtil::Time expiration;
+    };
+
+    typedef std::pair<std::string, int> Query;
+
     const InstancePtr _instance;
     const IceInternal::ProtocolSupport _protocol;
     const bool _preferIPv6;
+    const IceUtil::Time _cacheTTL;
+    const IceUtil::Time _negativeCacheTTL;
     bool _destroyed;
-    std::deque<ResolveEntry> _queue;
-    ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
+    std::vector<HelperThreadPtr> _threads;
+    std::deque<Query> _queue; // The queries waiting for a thread.
+    std::map<Query, std::vector<ResolveEntry> > _pending; // The lookups waiting for each queued or running query.
+    std::map<Query, CacheEntry> _cache;
+    size_t _cachePruneSize; // Expired entries are removed when the cache reaches this size.
 };
 
 #ifndef ICE_CPP11_MAPPING
@@ -97,6 +97,61 @@ private:
     size_t _index; // index in all SlotVector
     long _id; // corresponds to owner in the Slot
 };
+
+//
+// Write the proxy context combined with the implicit context, the entries of
+// the proxy context take precedence. The two sorted contexts are merged while
+// they are written, this avoids copying them into a temporary context on each
+// invocation.
+//
+void
+writeCombined(const Context& proxyCtx, const Context& implicitCtx, ::Ice::OutputStream* s)
+{
+    Context::const_iterator p = proxyCtx.begin();
+    Context::const_iterator q = implicitCtx.begin();
+    Int size = static_cast<Int>(proxyCtx.size());
+    while(q != implicitCtx.end())
+    {
+        if(p == proxyCtx.end() || q->first < p->first)
+        {
+            ++size;
+            ++q;
+        }
+        else if(p->first < q->first)
+        {
+            ++p;
+        }
+        else
+        {
+            ++p;
+            ++q;
+        }
+    }
+
+    s->writeSize(size);
+    p = proxyCtx.begin();
+    q = implicitCtx.begin();
+    while(p != proxyCtx.end() || q != implicitCtx.end())
+    {
+        if(q == implicitCtx.end() || (p != proxyCtx.end() && !(q->first < p->first)))
+        {
+            if(q != implicitCtx.end() && !(p->first < q->first))
+            {
+                ++q; // Overridden by the proxy context.
+            }
+            s->write(p->first);
+            s->write(p->second);
+            ++p;
+        }
+        else
+        {
+            s->write(q->first);
+            s->write(q->second);
+            ++q;
+        }
+    }
+}
+
 }
 
 extern "C" void iceImplicitContextThreadDestructor(void*);
@@ -216,10 +271,7 @@ SharedImplicitContext::write(const Context& proxyCtx, ::Ice::OutputStream* s) co
     }
     else
     {
-        Context combined = proxyCtx;
-        combined.insert(_context.begin(), _context.end());
-        lock.release();
-        s->write(combined);
+        writeCombined(proxyCtx, _context, s);
     }
 }
 
@@ -603,9 +655,7 @@ PerThreadImplicitContext::write(const Context& proxyCtx, ::Ice::OutputStream* s)
     }
     else
     {
-        Context combined = proxyCtx;
-        combined.insert(threadCtx->begin(), threadCtx->end());
-        s->write(combined);
+        writeCombined(proxyCtx, *threadCtx, s);
     }
 }
 
@@ -179,6 +179,9 @@ Ice::InputStream::initialize(const EncodingVersion& encoding)
     _sliceValues = true;
     _startSeq = -1;
     _minSeqSize = 0;
+#ifdef ICE_CPP11_MAPPING
+    _arena = nullptr;
+#endif
 }
 
 void
@@ -193,6 +196,13 @@ Ice::InputStream::clear()
 
     _startSeq = -1;
     _sliceValues = true;
+#ifdef ICE_CPP11_MAPPING
+    if(_arena)
+    {
+        _arena->release();
+        _arena = nullptr;
+    }
+#endif
 }
 
 void
@@ -217,6 +227,15 @@ Ice::InputStream::setCompactIdResolver(const CompactIdResolverPtr& r)
     _compactIdResolver = r;
 }
 
+#ifdef ICE_CPP11_MAPPING
+void
+Ice::InputStream::setArenaAllocation(bool on)
+{
+    initEncaps();
+    _currentEncaps->arenaAllocation = on;
+}
+#endif
+
 #ifndef ICE_CPP11_MAPPING
 void
 Ice::InputStream::setCollectObjects(bool on)
@@ -273,6 +292,8 @@ Ice::InputStream::swap(InputStream& other)
     std::swap(_encoding, other._encoding);
 #ifndef ICE_CPP11_MAPPING
     std::swap(_collectObjects, other._collectObjects);
+#else
+    std::swap(_arena, other._arena);
 #endif
     std::swap(_traceSlicing, other._traceSlicing);
     std::swap(_classGraphDepthMax, other._classGraphDepthMax);
@@ -1727,18 +1748,17 @@ Ice::InputStream::EncapsDecoder::readTypeId(bool isIndex)
     if(isIndex)
     {
         Int index = _stream->readSize();
-        TypeIdMap::const_iterator k = _typeIdMap.find(index);
-        if(k == _typeIdMap.end())
+        if(index < 1 || static_cast<size_t>(index) > _typeIds.size())
         {
             throw UnmarshalOutOfBoundsException(__FILE__, __LINE__);
         }
-        return k->second;
+        return _typeIds[static_cast<size_t>(index - 1)];
     }
     else
     {
         string typeId;
         _stream->read(typeId, false);
-        _typeIdMap.insert(make_pair(++_typeIdIndex, typeId));
+        _typeIds.push_back(typeId);
         return typeId;
     }
 }
@@ -1795,11 +1815,27 @@ Ice::InputStream::EncapsDecoder::newInstance(const string& typeId)
     if(!v)
     {
 #ifdef ICE_CPP11_MAPPING
-        function<ValuePtr(const string&)> of = IceInternal::factoryTable->getValueFactory(typeId);
-        if(of)
+        if(_encaps->arenaAllocation)
         {
-            v = of(typeId);
-            assert(v);
+            IceInternal::ArenaValueFactory af = IceInternal::factoryTable->getArenaValueFactory(typeId);
+            if(af)
+            {
+                if(!_stream->_arena)
+                {
+                    _stream->_arena = new IceInternal::ValueArena;
+                }
+                v = af(_stream->_arena);
+                assert(v);
+            }
+        }
+        if(!v)
+        {
+            function<ValuePtr(const string&)> of = IceInternal::factoryTable->getValueFactory(typeId);
+            if(of)
+            {
+                v = of(typeId);
+                assert(v);
+            }
         }
 #else
         ValueFactoryPtr of = IceInternal::factoryTable->getValueFactory(typeId);
@@ -1822,15 +1858,15 @@ Ice::InputStream::EncapsDecoder::addPatchEntry(Int index, PatchFunc patchFunc, v
     // Check if we already unmarshaled the object. If that's the case, just patch the object smart pointer
     // and we're done. A null value indicates we've encountered a cycle and Ice.AllowClassCycles is false.
     //
-    IndexToPtrMap::iterator p = _unmarshaledMap.find(index);
-    if(p != _unmarshaledMap.end())
+    ValuePtr* p = _unmarshaledMap.find(index);
+    if(p)
     {
-        if (p->second == ICE_NULLPTR)
+        if (*p == ICE_NULLPTR)
         {
             assert(!_stream->_instance->acceptClassCycles());
             throw MarshalException(__FILE__, __LINE__, "cycle detected during Value unmarshaling");
         }
-        (*patchFunc)(patchAddr, p->second);
+        (*patchFunc)(patchAddr, *p);
         return;
     }
 
@@ -1840,14 +1876,14 @@ Ice::InputStream::EncapsDecoder::addPatchEntry(Int index, PatchFunc patchFunc, v
     // unmarshaled.
     //
 
-    PatchMap::iterator q = _patchMap.find(index);
-    if(q == _patchMap.end())
+    PatchList* q = _patchMap.find(index);
+    if(!q)
     {
         //
         // We have no outstanding instances to be patched for this
         // index, so make a new entry in the patch map.
         //
-        q = _patchMap.insert(make_pair(index, PatchList())).first;
+        q = &_patchMap.insert(index);
     }
 
     //
@@ -1857,7 +1893,7 @@ Ice::InputStream::EncapsDecoder::addPatchEntry(Int index, PatchFunc patchFunc, v
     e.patchFunc = patchFunc;
     e.patchAddr = patchAddr;
     e.classGraphDepth = _classGraphDepth;
-    q->second.push_back(e);
+    q->push_back(e);
 }
 
 void
@@ -1870,7 +1906,7 @@ Ice::InputStream::EncapsDecoder::unmarshal(Int index, const Ice::ValuePtr& v)
     // If circular references are not allowed we insert null (for cycle detection) and add
     // the object to the map once it has been fully unmarshaled.
     //
-    _unmarshaledMap.insert(make_pair(index, _stream->_instance->acceptClassCycles() ? v : Ice::ValuePtr()));
+    _unmarshaledMap.insert(index) = _stream->_instance->acceptClassCycles() ? v : Ice::ValuePtr();
 
     //
     // Read the object.
@@ -1880,15 +1916,15 @@ Ice::InputStream::EncapsDecoder::unmarshal(Int index, const Ice::ValuePtr& v)
     //
     // Patch all instances now that the object is unmarshaled.
     //
-    PatchMap::iterator patchPos = _patchMap.find(index);
-    if(patchPos != _patchMap.end())
+    PatchList* patchList = _patchMap.find(index);
+    if(patchList)
     {
-        assert(patchPos->second.size() > 0);
+        assert(patchList->size() > 0);
 
         //
         // Patch all pointers that refer to the instance.
         //
-        for(PatchList::iterator k = patchPos->second.begin(); k != patchPos->second.end(); ++k)
+        for(PatchList::iterator k = patchList->begin(); k != patchList->end(); ++k)
         {
             (*k->patchFunc)(k->patchAddr, v);
         }
@@ -1897,7 +1933,7 @@ Ice::InputStream::EncapsDecoder::unmarshal(Int index, const Ice::ValuePtr& v)
         // Clear out the patch map for that index -- there is nothing left
         // to patch for that index for the time being.
         //
-        _patchMap.erase(patchPos);
+        _patchMap.erase(index);
     }
 
     if(_valueList.empty() && _patchMap.empty())
@@ -1928,7 +1964,7 @@ Ice::InputStream::EncapsDecoder::unmarshal(Int index, const Ice::ValuePtr& v)
     {
         // This class has been fully unmarshaled without creating any cycles
         // It can be added to the map now.
-        _unmarshaledMap[index] = v;
+        _unmarshaledMap.insert(index) = v;
     }
 }
 
@@ -2221,11 +2257,11 @@ Ice::InputStream::EncapsDecoder10::readInstance()
     // keep the biggest one.
     //
     _classGraphDepth = 0;
-    PatchMap::iterator patchPos = _patchMap.find(index);
-    if(patchPos != _patchMap.end())
+    PatchList* patchList = _patchMap.find(index);
+    if(patchList)
     {
-        assert(patchPos->second.size() > 0);
-        for(PatchList::iterator k = patchPos->second.begin(); k != patchPos->second.end(); ++k)
+        assert(patchList->size() > 0);
+        for(PatchList::iterator k = patchList->begin(); k != patchList->end(); ++k)
         {
             if(k->classGraphDepth > _classGraphDepth)
             {
@@ -468,6 +468,28 @@ IceInternal::Instance::serverThreadPool()
     return _serverThreadPool;
 }
 
+vector<ThreadPoolPtr>
+IceInternal::Instance::threadPools()
+{
+    Lock sync(*this);
+
+    if(_state == StateDestroyed)
+    {
+        throw CommunicatorDestroyedException(__FILE__, __LINE__);
+    }
+
+    vector<ThreadPoolPtr> threadPools;
+    if(_clientThreadPool)
+    {
+        threadPools.push_back(_clientThreadPool);
+    }
+    if(_serverThreadPool)
+    {
+        threadPools.push_back(_serverThreadPool);
+    }
+    return threadPools;
+}
+
 EndpointHostResolverPtr
 IceInternal::Instance::endpointHostResolver()
 {
@@ -1479,16 +1501,6 @@ IceInternal::Instance::finishSetup(int& argc, const char* argv[], const Ice::Com
     try
     {
         _endpointHostResolver = new EndpointHostResolver(this);
-        bool hasPriority = _initData.properties->getProperty("Ice.ThreadPriority") != "";
-        int priority = _initData.properties->getPropertyAsInt("Ice.ThreadPriority");
-        if(hasPriority)
-        {
-            _endpointHostResolver->start(0, priority);
-        }
-        else
-        {
-            _endpointHostResolver->start();
-        }
     }
     catch(const IceUtil::Exception& ex)
     {
@@ -1683,7 +1695,7 @@ IceInternal::Instance::destroy()
     }
     if(_endpointHostResolver)
     {
-        _endpointHostResolver->getThreadControl().join();
+        _endpointHostResolver->joinWithAllThreads();
     }
 
 #ifdef ICE_CPP11_COMPILER
@@ -1795,7 +1807,7 @@ IceInternal::Instance::updateThreadObservers()
         _objectAdapterFactory->updateObservers(&ObjectAdapterI::updateThreadObservers);
         if(_endpointHostResolver)
         {
-            _endpointHostResolver->updateObserver();
+            _endpointHostResolver->updateObservers();
         }
         if(_timer)
         {
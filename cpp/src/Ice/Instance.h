@@ -95,6 +95,7 @@ public:
     NetworkProxyPtr networkProxy() const;
     ThreadPoolPtr clientThreadPool();
     ThreadPoolPtr serverThreadPool();
+    std::vector<ThreadPoolPtr> threadPools(); // The client and server thread pools, doesn't create the server pool.
     EndpointHostResolverPtr endpointHostResolver();
     RetryQueuePtr retryQueue();
     IceUtil::TimerPtr timer();
@@ -10,6 +10,7 @@
 #include <Ice/LocalException.h>
 #include <Ice/Communicator.h>
 #include <Ice/LoggerUtil.h>
+#include <Ice/Reference.h>
 
 using namespace std;
 using namespace Ice;
@@ -243,6 +244,29 @@ public:
         v->size += _size;
     }
 
+    virtual bool getCacheKey(MetricsCacheKey& key) const
+    {
+        if(!_current.adapter)
+        {
+            return false;
+        }
+        key.adapter = _current.adapter->getName();
+        key.identity = _current.id;
+        key.facet = _current.facet;
+        key.operation = _current.operation;
+        return true;
+    }
+
+    virtual bool isCacheable(const string& attribute) const
+    {
+        //
+        // The attributes which only depend on the object adapter, identity,
+        // facet and operation.
+        //
+        return attribute == "none" || attribute == "parent" || attribute == "id" || attribute == "operation" ||
+            attribute == "identity" || attribute == "facet";
+    }
+
     string resolve(const string& attribute) const
     {
         if(attribute.compare(0, 8, "context.") == 0)
@@ -389,6 +413,30 @@ public:
         return attributes(this, attribute);
     }
 
+    virtual bool getCacheKey(MetricsCacheKey& key) const
+    {
+        //
+        // Invocations on fixed proxies are not cached, the cached proxy would
+        // keep the connection of the proxy alive.
+        //
+        if(_proxy && dynamic_cast<FixedReference*>(_proxy->_getReference().get()))
+        {
+            return false;
+        }
+        key.proxy = _proxy;
+        key.operation = _operation;
+        return true;
+    }
+
+    virtual bool isCacheable(const string& attribute) const
+    {
+        //
+        // All the attributes except the context attributes only depend on
+        // the proxy and operation, unknown attributes are never resolved.
+        //
+        return attribute.compare(0, 8, "context.") != 0;
+    }
+
     string
     getMode() const
     {
@@ -707,6 +755,7 @@ public:
         {
             add("parent", &EndpointHelper::getParent);
             add("id", &EndpointHelper::getId);
+            add("cache", &EndpointHelper::getCache);
             addEndpointAttributes<EndpointHelper>(*this);
         }
     };
@@ -716,7 +765,10 @@ public:
     {
     }
 
-    EndpointHelper(const EndpointPtr& endpt) : _endpoint(endpt)
+    EndpointHelper(const EndpointPtr& endpt, CommunicatorObserverI::EndpointLookupCache cache) :
+        _endpoint(endpt),
+        _cache(cache == CommunicatorObserverI::CacheHit ? "hit" :
+               (cache == CommunicatorObserverI::CacheMerged ? "merged" : "miss"))
     {
     }
 
@@ -757,9 +809,16 @@ public:
         return _endpoint->toString();
     }
 
+    const string&
+    getCache() const
+    {
+        return _cache;
+    }
+
 private:
 
     const EndpointPtr _endpoint;
+    const string _cache; // Whether the endpoint addresses were found in the host resolver cache.
     mutable string _id;
     mutable EndpointInfoPtr _endpointInfo;
 };
@@ -952,6 +1011,12 @@ CommunicatorObserverI::getConnectionEstablishmentObserver(const EndpointPtr& end
 
 ObserverPtr
 CommunicatorObserverI::getEndpointLookupObserver(const EndpointPtr& endpt)
+{
+    return getEndpointLookupObserver(endpt, CacheMiss);
+}
+
+ObserverPtr
+CommunicatorObserverI::getEndpointLookupObserver(const EndpointPtr& endpt, EndpointLookupCache cache)
 {
     if(_endpointLookups.isEnabled())
     {
@@ -962,7 +1027,7 @@ CommunicatorObserverI::getEndpointLookupObserver(const EndpointPtr& endpt)
             {
                 delegate = _delegate->getEndpointLookupObserver(endpt);
             }
-            return _endpointLookups.getObserverWithDelegate(EndpointHelper(endpt), delegate);
+            return _endpointLookups.getObserverWithDelegate(EndpointHelper(endpt, cache), delegate);
         }
         catch(const exception& ex)
         {
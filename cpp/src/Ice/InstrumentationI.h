@@ -217,6 +217,14 @@ public:
 
     virtual Ice::Instrumentation::ObserverPtr getEndpointLookupObserver(const Ice::EndpointPtr&);
 
+    //
+    // Used by the endpoint host resolver, the cache attribute of the metrics is set to "hit"
+    // if the addresses were found in the resolver cache, "merged" if the lookup waits for a
+    // pending lookup of the same host and port and "miss" otherwise.
+    //
+    enum EndpointLookupCache { CacheMiss, CacheHit, CacheMerged };
+    Ice::Instrumentation::ObserverPtr getEndpointLookupObserver(const Ice::EndpointPtr&, EndpointLookupCache);
+
     virtual Ice::Instrumentation::ConnectionObserverPtr
     getConnectionObserver(const Ice::ConnectionInfoPtr&,
                           const Ice::EndpointPtr&,
@@ -12,6 +12,9 @@
 #include <Ice/LoggerUtil.h>
 
 #include <IceUtil/StringUtil.h>
+#include <IceUtil/Thread.h>
+
+#include <cstring>
 
 using namespace std;
 using namespace Ice;
@@ -28,9 +31,74 @@ const string suffixes[] =
     "Accept.*",
     "Reject.*",
     "RetainDetached",
+    "Histogram",
     "Map.*",
 };
 
+//
+// The histogram buckets: latencies below 8us have their own bucket, above
+// each power of two is divided in 8 buckets. Latencies of 2^41us (about
+// 25 days) or more are counted in the last bucket.
+//
+const int histogramSubBucketBits = 3;
+const int histogramSubBuckets = 1 << histogramSubBucketBits;
+const int histogramMaxBit = 40;
+const int histogramBucketCount = (histogramMaxBit - histogramSubBucketBits + 2) * histogramSubBuckets;
+
+int
+histogramBucket(Ice::Long value)
+{
+    if(value < histogramSubBuckets)
+    {
+        return value < 0 ? 0 : static_cast<int>(value);
+    }
+    if(value >= static_cast<Ice::Long>(1) << (histogramMaxBit + 1))
+    {
+        return histogramBucketCount - 1;
+    }
+
+    int msb = 0;
+    for(int shift = 32; shift > 0; shift >>= 1)
+    {
+        if(value >= static_cast<Ice::Long>(1) << (msb + shift))
+        {
+            msb += shift;
+        }
+    }
+    int shift = msb - histogramSubBucketBits;
+    return (shift + 1) * histogramSubBuckets + static_cast<int>((value >> shift) & (histogramSubBuckets - 1));
+}
+
+Ice::Long
+histogramUpperBound(int bucket)
+{
+    if(bucket < histogramSubBuckets)
+    {
+        return bucket;
+    }
+    int shift = bucket / histogramSubBuckets - 1;
+    Ice::Long lower = static_cast<Ice::Long>(histogramSubBuckets + bucket % histogramSubBuckets) << shift;
+    return lower + (static_cast<Ice::Long>(1) << shift) - 1;
+}
+
+size_t
+histogramShard(size_t shardCount)
+{
+    //
+    // Hash the bytes of the thread ID, the ID is an opaque type on some
+    // platforms and is often an aligned address.
+    //
+    IceUtil::ThreadControl::ID id = IceUtil::ThreadControl().id();
+    unsigned char bytes[sizeof(id)];
+    memcpy(bytes, &id, sizeof(id));
+    unsigned int h = 2166136261U;
+    for(size_t i = 0; i < sizeof(id); ++i)
+    {
+        h = (h ^ bytes[i]) * 16777619U;
+    }
+    return h % shardCount;
+}
+
 void
 validateProperties(const string& prefix, const PropertiesPtr& properties)
 {
@@ -140,6 +208,101 @@ MetricsMapI::RegExp::match(const string& value)
 #endif
 }
 
+bool
+MetricsCacheKey::operator<(const MetricsCacheKey& rhs) const
+{
+    if(proxy.get() != rhs.proxy.get())
+    {
+        if(!proxy || !rhs.proxy)
+        {
+            return !proxy;
+        }
+        if(*proxy < *rhs.proxy)
+        {
+            return true;
+        }
+        else if(*rhs.proxy < *proxy)
+        {
+            return false;
+        }
+    }
+    if(operation != rhs.operation)
+    {
+        return operation < rhs.operation;
+    }
+    if(identity != rhs.identity)
+    {
+        return identity < rhs.identity;
+    }
+    if(facet != rhs.facet)
+    {
+        return facet < rhs.facet;
+    }
+    return adapter < rhs.adapter;
+}
+
+MetricsHistogram::MetricsHistogram()
+{
+}
+
+MetricsHistogram::~MetricsHistogram()
+{
+    for(size_t i = 0; i < sizeof(_shards) / sizeof(*_shards); ++i)
+    {
+        delete[] _shards[i].buckets;
+    }
+}
+
+void
+MetricsHistogram::add(Ice::Long value)
+{
+    int bucket = histogramBucket(value);
+    Shard& shard = _shards[histogramShard(sizeof(_shards) / sizeof(*_shards))];
+
+    IceUtil::Mutex::Lock sync(shard.mutex);
+    if(!shard.buckets)
+    {
+        shard.buckets = new Ice::Long[histogramBucketCount]();
+    }
+    ++shard.buckets[bucket];
+}
+
+LatencyHistogram
+MetricsHistogram::get() const
+{
+    vector<Ice::Long> counts(histogramBucketCount, 0);
+    for(size_t i = 0; i < sizeof(_shards) / sizeof(*_shards); ++i)
+    {
+        const Shard& shard = _shards[i];
+        IceUtil::Mutex::Lock sync(shard.mutex);
+        if(shard.buckets)
+        {
+            for(int j = 0; j < histogramBucketCount; ++j)
+            {
+                counts[j] += shard.buckets[j];
+            }
+        }
+    }
+
+    LatencyHistogram histogram;
+    for(int j = 0; j < histogramBucketCount; ++j)
+    {
+        if(counts[j] > 0)
+        {
+            LatencyBucket b;
+            b.upperBound = histogramUpperBound(j);
+            b.count = counts[j];
+            histogram.push_back(b);
+        }
+    }
+    return histogram;
+}
+
+MetricsMapI::Visitor::~Visitor()
+{
+    // Out of line to avoid weak vtable
+}
+
 MetricsMapI::~MetricsMapI()
 {
     // Out of line to avoid weak vtable
@@ -148,6 +311,7 @@ MetricsMapI::~MetricsMapI()
 MetricsMapI::MetricsMapI(const std::string& mapPrefix, const PropertiesPtr& properties) :
     _properties(properties->getPropertiesForPrefix(mapPrefix)),
     _retain(properties->getPropertyAsIntWithDefault(mapPrefix + "RetainDetached", 10)),
+    _histogram(properties->getPropertyAsInt(mapPrefix + "Histogram") > 0),
     _accept(parseRule(properties, mapPrefix + "Accept")),
     _reject(parseRule(properties, mapPrefix + "Reject"))
 {
@@ -207,6 +371,7 @@ MetricsMapI::MetricsMapI(const MetricsMapI& map) :
     _groupByAttributes(map._groupByAttributes),
     _groupBySeparators(map._groupBySeparators),
     _retain(map._retain),
+    _histogram(map._histogram),
     _accept(map._accept),
     _reject(map._reject)
 {
@@ -628,6 +793,22 @@ MetricsAdminI::getMaps(const string& mapName) const
     return maps;
 }
 
+std::map<string, std::map<string, MetricsMapIPtr> >
+MetricsAdminI::getMapsByName() const
+{
+    Lock sync(*this);
+    std::map<string, std::map<string, MetricsMapIPtr> > maps;
+    for(std::map<string, MetricsViewIPtr>::const_iterator p = _views.begin(); p != _views.end(); ++p)
+    {
+        vector<string> names = p->second->getMaps();
+        for(vector<string>::const_iterator q = names.begin(); q != names.end(); ++q)
+        {
+            maps[*q][p->first] = p->second->getMap(*q);
+        }
+    }
+    return maps;
+}
+
 const LoggerPtr&
 MetricsAdminI::getLogger() const
 {
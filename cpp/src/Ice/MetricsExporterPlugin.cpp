@@ -0,0 +1,803 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Config.h>
+
+#include <Ice/Initialize.h>
+#include <Ice/Communicator.h>
+#include <Ice/Plugin.h>
+#include <Ice/LoggerUtil.h>
+#include <Ice/LocalException.h>
+#include <Ice/Instance.h>
+#include <Ice/TraceLevels.h>
+#include <Ice/InstrumentationI.h>
+#include <Ice/MetricsAdminI.h>
+#include <Ice/ThreadPool.h>
+#include <Ice/Network.h>
+#include <Ice/HttpParser.h>
+#include <IceUtil/Thread.h>
+#include <IceUtil/OutputUtil.h>
+
+#include <list>
+
+#ifndef _WIN32
+#   include <poll.h>
+#endif
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+using namespace IceMX;
+
+namespace
+{
+
+//
+// A scraper must send its request and read the response within socketTimeout
+// milliseconds. The scrapers are served concurrently, up to maxScrapers at a
+// time, so a slow or idle scraper doesn't delay the others.
+//
+const int socketTimeout = 10000;
+const size_t maxScrapers = 16;
+const size_t maxRequestSize = 8192;
+
+string
+escapeLabelValue(const string& value)
+{
+    string result;
+    result.reserve(value.size());
+    for(string::const_iterator p = value.begin(); p != value.end(); ++p)
+    {
+        switch(*p)
+        {
+            case '\\':
+            {
+                result += "\\\\";
+                break;
+            }
+            case '"':
+            {
+                result += "\\\"";
+                break;
+            }
+            case '\n':
+            {
+                result += "\\n";
+                break;
+            }
+            default:
+            {
+                result += *p;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+//
+// Converts a metrics map name such as "ConnectionEstablishment" to the
+// component of a metric name such as "connection_establishment".
+//
+string
+toMetricName(const string& name)
+{
+    string result;
+    for(string::const_iterator p = name.begin(); p != name.end(); ++p)
+    {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if(isupper(c))
+        {
+            if(p != name.begin())
+            {
+                result += '_';
+            }
+            result += static_cast<char>(tolower(c));
+        }
+        else if(isalnum(c))
+        {
+            result += *p;
+        }
+        else
+        {
+            result += '_';
+        }
+    }
+    return result;
+}
+
+//
+// The metric families of the maps with the same name. The Prometheus text
+// format requires the samples of a family to be grouped together, the samples
+// are added to their family as the metrics objects are visited and the
+// families are written once all the maps with this name are visited.
+//
+class MetricFamilies
+{
+public:
+
+    void
+    add(const string& family, const char* type, const string& sample, const string& labels, Ice::Long value)
+    {
+        Family& f = _families[family];
+        f.type = type;
+        f.samples += sample;
+        f.samples += labels;
+        f.samples += ' ';
+        f.samples += IceUtilInternal::int64ToString(value);
+        f.samples += '\n';
+    }
+
+    void
+    add(const string& family, const char* type, const string& labels, Ice::Long value)
+    {
+        add(family, type, family, labels, value);
+    }
+
+    string
+    str() const
+    {
+        string result;
+        for(map<string, Family>::const_iterator p = _families.begin(); p != _families.end(); ++p)
+        {
+            result += "# TYPE " + p->first + " " + p->second.type + "\n";
+            result += p->second.samples;
+        }
+        return result;
+    }
+
+private:
+
+    struct Family
+    {
+        const char* type;
+        string samples;
+    };
+    map<string, Family> _families;
+};
+
+class MetricsRenderer : public MetricsMapI::Visitor
+{
+public:
+
+    MetricsRenderer(MetricFamilies& families, const string& prefix, const string& labels) :
+        _families(families), _prefix(prefix), _labels(labels)
+    {
+    }
+
+    virtual void
+    visit(const MetricsPtr& metrics)
+    {
+        const string labels = _labels + ",id=\"" + escapeLabelValue(metrics->id) + "\"";
+        const string l = "{" + labels + "}";
+
+        _families.add(_prefix + "_total", "counter", l, metrics->total);
+        _families.add(_prefix + "_current", "gauge", l, metrics->current);
+        _families.add(_prefix + "_lifetime_microseconds_total", "counter", l, metrics->totalLifetime);
+        _families.add(_prefix + "_failures_total", "counter", l, metrics->failures);
+
+        if(metrics->latency)
+        {
+            //
+            // The histogram buckets only hold the count of their own range,
+            // Prometheus buckets are cumulative. The lifetime of the objects is
+            // recorded with the histogram so it's also the sum of the samples.
+            //
+            const string family = _prefix + "_latency_microseconds";
+            const LatencyHistogram& histogram = *metrics->latency;
+            Ice::Long count = 0;
+            for(LatencyHistogram::const_iterator p = histogram.begin(); p != histogram.end(); ++p)
+            {
+                count += p->count;
+                _families.add(family, "histogram", family + "_bucket",
+                              "{" + labels + ",le=\"" + IceUtilInternal::int64ToString(p->upperBound) + "\"}", count);
+            }
+            _families.add(family, "histogram", family + "_bucket", "{" + labels + ",le=\"+Inf\"}", count);
+            _families.add(family, "histogram", family + "_sum", l, metrics->totalLifetime);
+            _families.add(family, "histogram", family + "_count", l, count);
+        }
+
+        ThreadMetricsPtr thread = ICE_DYNAMIC_CAST(ThreadMetrics, metrics);
+        if(thread)
+        {
+            _families.add(_prefix + "_in_use_for_io", "gauge", l, thread->inUseForIO);
+            _families.add(_prefix + "_in_use_for_user", "gauge", l, thread->inUseForUser);
+            _families.add(_prefix + "_in_use_for_other", "gauge", l, thread->inUseForOther);
+            return;
+        }
+
+        DispatchMetricsPtr dispatch = ICE_DYNAMIC_CAST(DispatchMetrics, metrics);
+        if(dispatch)
+        {
+            _families.add(_prefix + "_user_exceptions_total", "counter", l, dispatch->userException);
+            _families.add(_prefix + "_size_bytes_total", "counter", l, dispatch->size);
+            _families.add(_prefix + "_reply_size_bytes_total", "counter", l, dispatch->replySize);
+            return;
+        }
+
+        InvocationMetricsPtr invocation = ICE_DYNAMIC_CAST(InvocationMetrics, metrics);
+        if(invocation)
+        {
+            _families.add(_prefix + "_retries_total", "counter", l, invocation->retry);
+            _families.add(_prefix + "_user_exceptions_total", "counter", l, invocation->userException);
+
+            const string childLabels = _labels + ",invocation=\"" + escapeLabelValue(metrics->id) + "\"";
+            visitChildren(invocation->remotes, _prefix + "_remote", childLabels);
+            visitChildren(invocation->collocated, _prefix + "_collocated", childLabels);
+            return;
+        }
+
+        ChildInvocationMetricsPtr child = ICE_DYNAMIC_CAST(ChildInvocationMetrics, metrics);
+        if(child)
+        {
+            _families.add(_prefix + "_size_bytes_total", "counter", l, child->size);
+            _families.add(_prefix + "_reply_size_bytes_total", "counter", l, child->replySize);
+            return;
+        }
+
+        ConnectionMetricsPtr connection = ICE_DYNAMIC_CAST(ConnectionMetrics, metrics);
+        if(connection)
+        {
+            _families.add(_prefix + "_received_bytes_total", "counter", l, connection->receivedBytes);
+            _families.add(_prefix + "_sent_bytes_total", "counter", l, connection->sentBytes);
+            return;
+        }
+    }
+
+private:
+
+    void
+    visitChildren(const MetricsMap& children, const string& prefix, const string& labels)
+    {
+        MetricsRenderer renderer(_families, prefix, labels);
+        for(MetricsMap::const_iterator p = children.begin(); p != children.end(); ++p)
+        {
+            renderer.visit(*p);
+        }
+    }
+
+    MetricFamilies& _families;
+    const string _prefix;
+    const string _labels;
+};
+
+typedef map<string, map<string, MetricsMapIPtr> > MetricsMaps;
+
+//
+// Renders the metrics of the maps with the given name from all the views.
+//
+string
+renderMaps(const string& name, const map<string, MetricsMapIPtr>& views)
+{
+    MetricFamilies families;
+    for(map<string, MetricsMapIPtr>::const_iterator p = views.begin(); p != views.end(); ++p)
+    {
+        MetricsRenderer renderer(families, "ice_" + toMetricName(name), "view=\"" + escapeLabelValue(p->first) + "\"");
+        p->second->visitMetrics(renderer);
+    }
+    return families.str();
+}
+
+class MetricsExporterPlugin : public Plugin
+{
+public:
+
+    MetricsExporterPlugin(const CommunicatorPtr&);
+
+    virtual void initialize();
+    virtual void destroy();
+
+    void run();
+
+private:
+
+    struct Scraper
+    {
+        SOCKET fd;
+        IceUtil::Time deadline;
+        vector<Byte> request;
+        bool responding; // Set once the request is read.
+        bool chunked;
+        string buffer; // The part of the response being written.
+        size_t written;
+        MetricsMaps maps; // The metrics maps which are not rendered yet.
+    };
+
+    bool read(Scraper&);
+    bool write(Scraper&);
+    void respond(Scraper&, const Byte*);
+    void appendBody(Scraper&, const string&);
+    string threadPools();
+
+    const InstancePtr _instance;
+    MetricsAdminIPtr _metrics;
+    IceUtil::ThreadPtr _thread;
+    SOCKET _fd;
+    SOCKET _fdIntrRead;
+    SOCKET _fdIntrWrite;
+};
+
+class ExporterThread : public IceUtil::Thread
+{
+public:
+
+    ExporterThread(MetricsExporterPlugin* plugin) :
+        IceUtil::Thread("Ice.MetricsExporter"),
+        _plugin(plugin)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _plugin->run();
+    }
+
+private:
+
+    MetricsExporterPlugin* _plugin; // The plugin joins with the thread when destroyed.
+};
+
+int
+doPoll(vector<struct pollfd>& fds, int timeout)
+{
+#ifdef _WIN32
+    return ::WSAPoll(&fds[0], static_cast<ULONG>(fds.size()), timeout);
+#else
+    return ::poll(&fds[0], static_cast<nfds_t>(fds.size()), timeout);
+#endif
+}
+
+}
+
+MetricsExporterPlugin::MetricsExporterPlugin(const CommunicatorPtr& communicator) :
+    _instance(getInstance(communicator)),
+    _fd(INVALID_SOCKET),
+    _fdIntrRead(INVALID_SOCKET),
+    _fdIntrWrite(INVALID_SOCKET)
+{
+}
+
+void
+MetricsExporterPlugin::initialize()
+{
+    //
+    // The metrics are only available if the metrics admin facet is enabled,
+    // the thread pool statistics are exported regardless.
+    //
+    CommunicatorObserverIPtr observer = ICE_DYNAMIC_CAST(CommunicatorObserverI,
+                                                         _instance->initializationData().observer);
+    if(observer)
+    {
+        _metrics = observer->getFacet();
+    }
+    else
+    {
+        Warning out(_instance->initializationData().logger);
+        out << "metrics exporter: the Metrics admin facet is not enabled, only the thread pools are exported";
+    }
+
+    const PropertiesPtr properties = _instance->initializationData().properties;
+    const string host = properties->getPropertyWithDefault("IceMX.Exporter.Host", "127.0.0.1");
+    const int port = properties->getPropertyAsInt("IceMX.Exporter.Port");
+
+    Address addr = getAddressForServer(host, port, _instance->protocolSupport(), _instance->preferIPv6(), true);
+    _fd = createServerSocket(false, addr, _instance->protocolSupport());
+    try
+    {
+        setBlock(_fd, false);
+#ifndef _WIN32
+        setReuseAddress(_fd, true);
+#endif
+        addr = doBind(_fd, addr);
+        doListen(_fd, 16);
+
+        SOCKET fds[2];
+        createPipe(fds);
+        _fdIntrRead = fds[0];
+        _fdIntrWrite = fds[1];
+    }
+    catch(...)
+    {
+        closeSocketNoThrow(_fd);
+        _fd = INVALID_SOCKET;
+        throw;
+    }
+
+    if(_instance->traceLevels()->network >= 1)
+    {
+        Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+        out << "listening for metrics scrapes at " << addrToString(addr);
+    }
+
+    _thread = new ExporterThread(this);
+    _thread->start();
+}
+
+void
+MetricsExporterPlugin::destroy()
+{
+    if(_thread)
+    {
+        char c = 0;
+#ifdef _WIN32
+        ::send(_fdIntrWrite, &c, 1, 0);
+#else
+        while(::write(_fdIntrWrite, &c, 1) == -1 && errno == EINTR)
+        {
+        }
+#endif
+        _thread->getThreadControl().join();
+        _thread = 0;
+    }
+
+    if(_fdIntrRead != INVALID_SOCKET)
+    {
+        closeSocketNoThrow(_fdIntrRead);
+        closeSocketNoThrow(_fdIntrWrite);
+        _fdIntrRead = INVALID_SOCKET;
+        _fdIntrWrite = INVALID_SOCKET;
+    }
+
+    if(_fd != INVALID_SOCKET)
+    {
+        closeSocketNoThrow(_fd);
+        _fd = INVALID_SOCKET;
+    }
+    _metrics = ICE_NULLPTR;
+}
+
+void
+MetricsExporterPlugin::run()
+{
+    list<Scraper> scrapers;
+    while(true)
+    {
+        //
+        // Wait for the interrupt pipe, for new connections unless too many scrapers
+        // are connected, and for each scraper to be ready to read its request or
+        // write its response.
+        //
+        vector<struct pollfd> fds(2 + scrapers.size());
+        fds[0].fd = _fdIntrRead;
+        fds[0].events = POLLIN;
+        fds[1].fd = scrapers.size() < maxScrapers ? _fd : INVALID_SOCKET;
+        fds[1].events = POLLIN;
+
+        IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        int timeout = -1;
+        size_t i = 2;
+        for(list<Scraper>::const_iterator p = scrapers.begin(); p != scrapers.end(); ++p, ++i)
+        {
+            fds[i].fd = p->fd;
+            fds[i].events = p->responding ? POLLOUT : POLLIN;
+            int remaining = static_cast<int>(max(p->deadline - now, IceUtil::Time()).toMilliSeconds());
+            timeout = timeout < 0 ? remaining : min(timeout, remaining);
+        }
+
+        if(doPoll(fds, timeout) == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+            Error out(_instance->initializationData().logger);
+            out << "metrics exporter: poll failed:\n" << SocketException(__FILE__, __LINE__, getSocketErrno());
+            break;
+        }
+
+        if(fds[0].revents)
+        {
+            break; // Destroyed.
+        }
+
+        //
+        // Serve the scrapers ready for reading or writing. A scraper is closed once
+        // its response is written, when it fails or when its deadline is reached.
+        //
+        now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        i = 2;
+        for(list<Scraper>::iterator p = scrapers.begin(); p != scrapers.end(); ++i)
+        {
+            bool done = false;
+            try
+            {
+                if(fds[i].revents)
+                {
+                    done = p->responding ? write(*p) : read(*p);
+                }
+                done = done || p->deadline <= now;
+            }
+            catch(const std::exception& ex)
+            {
+                if(_instance->traceLevels()->network >= 2)
+                {
+                    Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+                    out << "metrics exporter: scrape failed:\n" << ex;
+                }
+                done = true;
+            }
+
+            if(done)
+            {
+                closeSocketNoThrow(p->fd);
+                p = scrapers.erase(p);
+            }
+            else
+            {
+                ++p;
+            }
+        }
+
+        if(fds[1].revents)
+        {
+            try
+            {
+                Scraper scraper;
+                scraper.fd = doAccept(_fd);
+                scraper.deadline = now + IceUtil::Time::milliSeconds(socketTimeout);
+                scraper.responding = false;
+                scraper.chunked = false;
+                scraper.written = 0;
+                try
+                {
+                    setBlock(scraper.fd, false);
+                }
+                catch(const SocketException&)
+                {
+                    closeSocketNoThrow(scraper.fd);
+                    throw;
+                }
+                scrapers.push_back(scraper);
+            }
+            catch(const SocketException&)
+            {
+                // The connection was closed before it was accepted.
+            }
+        }
+    }
+
+    for(list<Scraper>::const_iterator p = scrapers.begin(); p != scrapers.end(); ++p)
+    {
+        closeSocketNoThrow(p->fd);
+    }
+}
+
+bool
+MetricsExporterPlugin::read(Scraper& scraper)
+{
+    //
+    // Read the available data of the request, the request must fit in
+    // maxRequestSize and the body if any is ignored. Returns true if the
+    // connection must be closed.
+    //
+    size_t pos = scraper.request.size();
+    scraper.request.resize(maxRequestSize);
+    char* buf = reinterpret_cast<char*>(&scraper.request[pos]);
+#ifdef _WIN32
+    ssize_t ret = ::recv(scraper.fd, buf, static_cast<int>(maxRequestSize - pos), 0);
+#else
+    ssize_t ret = ::recv(scraper.fd, buf, maxRequestSize - pos, 0);
+#endif
+    if(ret == 0)
+    {
+        return true; // Connection closed by the scraper.
+    }
+    else if(ret == SOCKET_ERROR)
+    {
+        scraper.request.resize(pos);
+        if(interrupted() || wouldBlock())
+        {
+            return false;
+        }
+        throw SocketException(__FILE__, __LINE__, getSocketErrno());
+    }
+    scraper.request.resize(pos + static_cast<size_t>(ret));
+
+    HttpParserPtr parser = new HttpParser;
+    const Byte* end = parser->isCompleteMessage(&scraper.request[0], &scraper.request[0] + scraper.request.size());
+    if(!end)
+    {
+        return scraper.request.size() == maxRequestSize;
+    }
+
+    respond(scraper, end);
+    return write(scraper);
+}
+
+bool
+MetricsExporterPlugin::write(Scraper& scraper)
+{
+    //
+    // Write as much of the response as possible, the metrics maps are rendered
+    // one name at a time once the previous part of the response is written.
+    // Returns true once the response is written.
+    //
+    while(true)
+    {
+        if(scraper.written == scraper.buffer.size())
+        {
+            if(scraper.maps.empty())
+            {
+                return true;
+            }
+
+            string body = renderMaps(scraper.maps.begin()->first, scraper.maps.begin()->second);
+            scraper.maps.erase(scraper.maps.begin());
+            scraper.buffer.clear();
+            scraper.written = 0;
+            appendBody(scraper, body);
+            continue;
+        }
+
+        const char* p = scraper.buffer.c_str() + scraper.written;
+        size_t remaining = scraper.buffer.size() - scraper.written;
+#ifdef _WIN32
+        ssize_t ret = ::send(scraper.fd, p, static_cast<int>(remaining), 0);
+#else
+        ssize_t ret = ::send(scraper.fd, p, remaining, 0);
+#endif
+        if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+            if(wouldBlock())
+            {
+                return false;
+            }
+            throw SocketException(__FILE__, __LINE__, getSocketErrno());
+        }
+        scraper.written += static_cast<size_t>(ret);
+    }
+}
+
+void
+MetricsExporterPlugin::respond(Scraper& scraper, const Byte* end)
+{
+    scraper.responding = true;
+
+    HttpParserPtr parser = new HttpParser;
+    try
+    {
+        parser->parse(&scraper.request[0], end);
+    }
+    catch(const WebSocketException&)
+    {
+        scraper.buffer = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        return;
+    }
+
+    string uri = parser->uri();
+    string::size_type pos = uri.find('?');
+    if(pos != string::npos)
+    {
+        uri = uri.substr(0, pos);
+    }
+
+    if(parser->type() != HttpParser::TypeRequest || parser->method() != "GET")
+    {
+        scraper.buffer =
+            "HTTP/1.1 405 Method Not Allowed\r\nAllow: GET\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        return;
+    }
+    else if(uri != "/metrics")
+    {
+        scraper.buffer = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        return;
+    }
+
+    //
+    // The length of the metrics isn't known until they are all rendered, the
+    // body is sent with the chunked transfer encoding, or delimited by the
+    // connection closure for HTTP/1.0 scrapers. Each map is only locked while
+    // its entries are cloned for rendering.
+    //
+    scraper.chunked = parser->versionMajor() > 1 || (parser->versionMajor() == 1 && parser->versionMinor() >= 1);
+    scraper.buffer = "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n";
+    if(scraper.chunked)
+    {
+        scraper.buffer += "Transfer-Encoding: chunked\r\n";
+    }
+    scraper.buffer += "Connection: close\r\n\r\n";
+    if(_metrics)
+    {
+        scraper.maps = _metrics->getMapsByName();
+    }
+    appendBody(scraper, threadPools());
+}
+
+void
+MetricsExporterPlugin::appendBody(Scraper& scraper, const string& body)
+{
+    if(!scraper.chunked)
+    {
+        scraper.buffer += body;
+        return;
+    }
+
+    //
+    // An empty chunk ends the body, it's only sent after the last map.
+    //
+    if(!body.empty())
+    {
+        ostringstream os;
+        os << hex << body.size() << "\r\n";
+        scraper.buffer += os.str();
+        scraper.buffer += body;
+        scraper.buffer += "\r\n";
+    }
+    if(scraper.maps.empty())
+    {
+        scraper.buffer += "0\r\n\r\n";
+    }
+}
+
+string
+MetricsExporterPlugin::threadPools()
+{
+    vector<ThreadPoolPtr> threadPools;
+    try
+    {
+        threadPools = _instance->threadPools();
+    }
+    catch(const CommunicatorDestroyedException&)
+    {
+        return string();
+    }
+
+    MetricFamilies families;
+    for(vector<ThreadPoolPtr>::const_iterator p = threadPools.begin(); p != threadPools.end(); ++p)
+    {
+        ThreadPoolStats stats = (*p)->getStats();
+        const string l = "{pool=\"" + escapeLabelValue((*p)->prefix()) + "\"}";
+        families.add("ice_thread_pool_size", "gauge", l, stats.size);
+        families.add("ice_thread_pool_size_max", "gauge", l, stats.sizeMax);
+        families.add("ice_thread_pool_threads", "gauge", l, stats.threads);
+        families.add("ice_thread_pool_in_use", "gauge", l, stats.inUse);
+        families.add("ice_thread_pool_in_use_io", "gauge", l, stats.inUseIO);
+    }
+    return families.str();
+}
+
+//
+// The entry point for the metrics exporter plugin built-in the Ice library
+//
+extern "C"
+{
+
+ICE_API Plugin*
+createIceMetricsExporter(const CommunicatorPtr& communicator, const string& name, const StringSeq& args)
+{
+    if(!args.empty())
+    {
+        Error out(communicator->getLogger());
+        out << "Plugin " << name << ": too many arguments";
+        return 0;
+    }
+    return new MetricsExporterPlugin(communicator);
+}
+
+}
+
+namespace Ice
+{
+
+ICE_API void
+registerIceMetricsExporter(bool loadOnInitialize)
+{
+    registerPluginFactory("IceMetricsExporter", createIceMetricsExporter, loadOnInitialize);
+}
+
+}
+
+//
+// Objective-C function to allow Objective-C programs to register plugin.
+//
+extern "C" ICE_API void
+ICEregisterIceMetricsExporter(bool loadOnInitialize)
+{
+    Ice::registerIceMetricsExporter(loadOnInitialize);
+}
@@ -114,46 +114,6 @@ public:
 };
 #endif
 
-void
-sortAddresses(vector<Address>& addrs, ProtocolSupport protocol, Ice::EndpointSelectionType selType, bool preferIPv6)
-{
-    if(selType == Ice::ICE_ENUM(EndpointSelectionType, Random))
-    {
-        IceUtilInternal::shuffle(addrs.begin(), addrs.end());
-    }
-
-    if(protocol == EnableBoth)
-    {
-#ifdef ICE_CPP11_COMPILER
-        if(preferIPv6)
-        {
-            stable_partition(addrs.begin(), addrs.end(),
-                             [](const Address& ss)
-                             {
-                                 return ss.saStorage.ss_family == AF_INET6;
-                             });
-        }
-        else
-        {
-            stable_partition(addrs.begin(), addrs.end(),
-                             [](const Address& ss)
-                             {
-                                 return ss.saStorage.ss_family != AF_INET6;
-                             });
-        }
-#else
-        if(preferIPv6)
-        {
-            stable_partition(addrs.begin(), addrs.end(), AddressIsIPv6());
-        }
-        else
-        {
-            stable_partition(addrs.begin(), addrs.end(), not1(AddressIsIPv6()));
-        }
-#endif
-    }
-}
-
 void
 setTcpNoDelay(SOCKET fd)
 {
@@ -184,6 +144,12 @@ createSocketImpl(bool udp, int family)
     {
         fd = socket(family, SOCK_DGRAM, IPPROTO_UDP);
     }
+#ifndef _WIN32
+    else if(family == AF_UNIX)
+    {
+        fd = socket(family, SOCK_STREAM, 0);
+    }
+#endif
     else
     {
         fd = socket(family, SOCK_STREAM, IPPROTO_TCP);
@@ -194,7 +160,11 @@ createSocketImpl(bool udp, int family)
         throw SocketException(__FILE__, __LINE__, getSocketErrno());
     }
 
+#ifndef _WIN32
+    if(!udp && family != AF_UNIX)
+#else
     if(!udp)
+#endif
     {
         setTcpNoDelay(fd);
         setKeepAlive(fd);
@@ -745,6 +715,23 @@ getAddressStorageSize(const Address& addr)
     {
         size = sizeof(sockaddr_in6);
     }
+#ifndef _WIN32
+    else if(addr.saStorage.ss_family == AF_UNIX)
+    {
+        //
+        // The name of an abstract socket starts with a null byte and
+        // isn't null terminated, the address length delimits it.
+        //
+        const char* path = addr.saUn.sun_path;
+        const size_t maxLength = sizeof(addr.saUn.sun_path);
+        size_t length = path[0] == '\0' ? 1 + strnlen(path + 1, maxLength - 1) : strnlen(path, maxLength) + 1;
+        if(length == 1)
+        {
+            length = 0; // Unnamed socket
+        }
+        size = static_cast<int>(offsetof(sockaddr_un, sun_path) + length);
+    }
+#endif
     return size;
 }
 
@@ -862,6 +849,47 @@ IceInternal::errorToStringDNS(int error)
 #endif
 }
 
+void
+IceInternal::sortAddresses(vector<Address>& addrs, ProtocolSupport protocol, Ice::EndpointSelectionType selType,
+                           bool preferIPv6)
+{
+    if(selType == Ice::ICE_ENUM(EndpointSelectionType, Random))
+    {
+        IceUtilInternal::shuffle(addrs.begin(), addrs.end());
+    }
+
+    if(protocol == EnableBoth)
+    {
+#ifdef ICE_CPP11_COMPILER
+        if(preferIPv6)
+        {
+            stable_partition(addrs.begin(), addrs.end(),
+                             [](const Address& ss)
+                             {
+                                 return ss.saStorage.ss_family == AF_INET6;
+                             });
+        }
+        else
+        {
+            stable_partition(addrs.begin(), addrs.end(),
+                             [](const Address& ss)
+                             {
+                                 return ss.saStorage.ss_family != AF_INET6;
+                             });
+        }
+#else
+        if(preferIPv6)
+        {
+            stable_partition(addrs.begin(), addrs.end(), AddressIsIPv6());
+        }
+        else
+        {
+            stable_partition(addrs.begin(), addrs.end(), not1(AddressIsIPv6()));
+        }
+#endif
+    }
+}
+
 vector<Address>
 IceInternal::getAddresses(const string& host, int port, ProtocolSupport protocol, Ice::EndpointSelectionType selType,
                           bool preferIPv6, bool canBlock)
@@ -1001,6 +1029,34 @@ IceInternal::getAddressForServer(const string& host, int port, ProtocolSupport p
     return addrs.empty() ? Address() : addrs[0];
 }
 
+#ifndef _WIN32
+Address
+IceInternal::getUnixSocketAddress(const string& path)
+{
+    //
+    // A path starting with '@' denotes a socket in the abstract namespace.
+    //
+    Address addr;
+    addr.saUn.sun_family = AF_UNIX;
+    if(path.empty() || path == "@" || path.size() >= sizeof(addr.saUn.sun_path) || path.find('\0') != string::npos)
+    {
+        throw SocketException(__FILE__, __LINE__, path.empty() ? EINVAL : ENAMETOOLONG);
+    }
+    memcpy(addr.saUn.sun_path, path.c_str(), path.size());
+    if(path[0] == '@')
+    {
+        addr.saUn.sun_path[0] = '\0';
+    }
+    return addr;
+}
+
+bool
+IceInternal::isUnixSocketAddress(const Address& addr)
+{
+    return addr.saStorage.ss_family == AF_UNIX;
+}
+#endif
+
 int
 IceInternal::compareAddress(const Address& addr1, const Address& addr2)
 {
@@ -1033,6 +1089,20 @@ IceInternal::compareAddress(const Address& addr1, const Address& addr2)
             return 1;
         }
     }
+#ifndef _WIN32
+    else if(addr1.saStorage.ss_family == AF_UNIX)
+    {
+        int res = memcmp(addr1.saUn.sun_path, addr2.saUn.sun_path, sizeof(addr1.saUn.sun_path));
+        if(res < 0)
+        {
+            return -1;
+        }
+        else if(res > 0)
+        {
+            return 1;
+        }
+    }
+#endif
     else
     {
         if(addr1.saIn6.sin6_port < addr2.saIn6.sin6_port)
@@ -1147,6 +1217,12 @@ IceInternal::closeSocket(SOCKET fd)
 string
 IceInternal::addrToString(const Address& addr)
 {
+#ifndef _WIN32
+    if(addr.saStorage.ss_family == AF_UNIX)
+    {
+        return inetAddrToString(addr);
+    }
+#endif
     ostringstream s;
     s << inetAddrToString(addr) << ':' << getPort(addr);
     return s.str();
@@ -1360,6 +1436,20 @@ IceInternal::getInterfacesForMulticast(const string& intf, ProtocolSupport proto
 string
 IceInternal::inetAddrToString(const Address& ss)
 {
+#ifndef _WIN32
+    if(ss.saStorage.ss_family == AF_UNIX)
+    {
+        const char* path = ss.saUn.sun_path;
+        const size_t maxLength = sizeof(ss.saUn.sun_path);
+        if(path[0] == '\0')
+        {
+            size_t length = strnlen(path + 1, maxLength - 1);
+            return length > 0 ? "@" + string(path + 1, length) : string();
+        }
+        return string(path, strnlen(path, maxLength));
+    }
+#endif
+
     int size = getAddressStorageSize(ss);
     if(size == 0)
     {
@@ -2016,8 +2106,17 @@ IceInternal::doAccept(SOCKET fd)
     int ret;
 #endif
 
+#ifndef _WIN32
+    Address addr;
+    socklen_t len = static_cast<socklen_t>(sizeof(sockaddr_storage));
+#endif
+
 repeatAccept:
+#ifndef _WIN32
+    if((ret = ::accept(fd, &addr.sa, &len)) == INVALID_SOCKET)
+#else
     if((ret = ::accept(fd, 0, 0)) == INVALID_SOCKET)
+#endif
     {
         if(acceptInterrupted())
         {
@@ -2027,6 +2126,12 @@ repeatAccept:
         throw SocketException(__FILE__, __LINE__, getSocketErrno());
     }
 
+#ifndef _WIN32
+    if(addr.saStorage.ss_family == AF_UNIX)
+    {
+        return ret;
+    }
+#endif
     setTcpNoDelay(ret);
     setKeepAlive(ret);
     return ret;
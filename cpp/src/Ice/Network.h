@@ -30,6 +30,7 @@ typedef int ssize_t;
 #   include <fcntl.h>
 #   include <sys/socket.h>
 #   include <sys/poll.h>
+#   include <sys/un.h>
 #   include <netinet/in.h>
 #   include <netinet/tcp.h>
 #   include <arpa/inet.h>
@@ -52,6 +53,13 @@ typedef int ssize_t;
 #   define ICE_USE_POLL 1
 #endif
 
+//
+// The unix transport requires Unix domain sockets.
+//
+#if !defined(_WIN32) && (!defined(__APPLE__) || TARGET_OS_IPHONE == 0)
+#   define ICE_HAS_UNIX_SOCKET 1
+#endif
+
 #if defined(_WIN32) || defined(__osf__)
 typedef int socklen_t;
 #endif
@@ -111,6 +119,9 @@ union Address
     sockaddr sa;
     sockaddr_in saIn;
     sockaddr_in6 saIn6;
+#ifndef _WIN32
+    sockaddr_un saUn;
+#endif
     sockaddr_storage saStorage;
 };
 
@@ -164,6 +175,9 @@ public:
     NativeInfo(SOCKET socketFd = INVALID_SOCKET) : _fd(socketFd)
 #if !defined(ICE_USE_IOCP)
         , _newFd(INVALID_SOCKET)
+#endif
+#if defined(ICE_USE_EPOLL)
+        , _readabilitySignalsAll(false)
 #endif
     {
     }
@@ -173,6 +187,20 @@ public:
         return _fd;
     }
 
+#if defined(ICE_USE_EPOLL)
+    //
+    // Returns true if the file descriptor is never writable and its
+    // readability signals the readiness of all the operations (this is
+    // the case for eventfd or epoll file descriptors). The selector
+    // waits for the file descriptor to be readable for any registered
+    // operation and reports all the registered operations when it is.
+    //
+    bool readabilitySignalsAll() const
+    {
+        return _readabilitySignalsAll;
+    }
+#endif
+
     void setReadyCallback(const ReadyCallbackPtr& callback);
 
     void ready(SocketOperation operation, bool value)
@@ -204,15 +232,23 @@ protected:
 #else
     SOCKET _newFd;
 #endif
+#if defined(ICE_USE_EPOLL)
+    bool _readabilitySignalsAll;
+#endif
 };
 typedef IceUtil::Handle<NativeInfo> NativeInfoPtr;
 
 ICE_API bool noMoreFds(int);
 ICE_API std::string errorToStringDNS(int);
+ICE_API void sortAddresses(std::vector<Address>&, ProtocolSupport, Ice::EndpointSelectionType, bool);
 ICE_API std::vector<Address> getAddresses(const std::string&, int, ProtocolSupport, Ice::EndpointSelectionType, bool,
                                           bool);
 ICE_API ProtocolSupport getProtocolSupport(const Address&);
 ICE_API Address getAddressForServer(const std::string&, int, ProtocolSupport, bool, bool);
+#ifndef _WIN32
+ICE_API Address getUnixSocketAddress(const std::string&);
+ICE_API bool isUnixSocketAddress(const Address&);
+#endif
 ICE_API int compareAddress(const Address&, const Address&);
 
 ICE_API bool isIPv6Supported();
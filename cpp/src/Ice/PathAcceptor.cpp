@@ -0,0 +1,170 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/PathAcceptor.h>
+
+#if defined(ICE_HAS_UNIX_SOCKET)
+
+#include <Ice/PathEndpointI.h>
+#include <Ice/ProtocolInstance.h>
+#include <Ice/LocalException.h>
+#include <Ice/LoggerUtil.h>
+
+#include <sys/stat.h>
+
+//
+// Use the system default for the listen() backlog or 511 if not defined.
+//
+#ifndef SOMAXCONN
+#  define SOMAXCONN 511
+#endif
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+IceUtil::Shared* IceInternal::upCast(PathAcceptor* p) { return p; }
+
+namespace
+{
+
+//
+// Returns true if the file is the socket file of a socket which was closed
+// without removing the file: connecting to the socket is refused. Connecting
+// to a file which isn't a socket is also refused, such files are never
+// considered stale.
+//
+bool
+isStaleSocketFile(const string& path, const Address& addr)
+{
+    struct stat buf;
+    if(::lstat(path.c_str(), &buf) == -1 || !S_ISSOCK(buf.st_mode))
+    {
+        return false;
+    }
+
+    //
+    // The socket is non-blocking to not wait for a listener with a full
+    // backlog, the connection attempt then fails with EAGAIN.
+    //
+    SOCKET fd = createSocket(false, addr);
+    setBlock(fd, false);
+    bool stale = ::connect(fd, &addr.sa, static_cast<socklen_t>(sizeof(addr.saUn))) == SOCKET_ERROR &&
+        connectionRefused();
+    closeSocketNoThrow(fd);
+    return stale;
+}
+
+}
+
+NativeInfoPtr
+IceInternal::PathAcceptor::getNativeInfo()
+{
+    return this;
+}
+
+void
+IceInternal::PathAcceptor::close()
+{
+    if(_fd != INVALID_SOCKET)
+    {
+        closeSocketNoThrow(_fd);
+        _fd = INVALID_SOCKET;
+    }
+
+    //
+    // Remove the socket file, sockets in the abstract namespace are
+    // removed with the socket.
+    //
+    if(_unlink)
+    {
+        ::unlink(_path.c_str());
+        _unlink = false;
+    }
+}
+
+EndpointIPtr
+IceInternal::PathAcceptor::listen()
+{
+    try
+    {
+        try
+        {
+            doBind(_fd, _addr);
+        }
+        catch(const SocketException& ex)
+        {
+            //
+            // The socket file might be left over by a process which didn't close
+            // the acceptor, remove it and bind again if no process listens on it.
+            //
+            if(ex.error != EADDRINUSE || _path[0] == '@' || !isStaleSocketFile(_path, _addr))
+            {
+                throw;
+            }
+
+            if(_instance->traceLevel() >= 1)
+            {
+                Trace out(_instance->logger(), _instance->traceCategory());
+                out << "removing stale socket file `" << _path << "'";
+            }
+            ::unlink(_path.c_str());
+
+            _fd = createSocket(false, _addr);
+            setBlock(_fd, false);
+            doBind(_fd, _addr);
+        }
+        _unlink = _path[0] != '@';
+        doListen(_fd, SOMAXCONN);
+    }
+    catch(...)
+    {
+        _fd = INVALID_SOCKET;
+        throw;
+    }
+    return _endpoint;
+}
+
+TransceiverPtr
+IceInternal::PathAcceptor::accept()
+{
+    return _endpoint->createTransceiver(doAccept(_fd));
+}
+
+string
+IceInternal::PathAcceptor::protocol() const
+{
+    return _instance->protocol();
+}
+
+string
+IceInternal::PathAcceptor::toString() const
+{
+    return _path;
+}
+
+string
+IceInternal::PathAcceptor::toDetailedString() const
+{
+    return "local address = " + toString();
+}
+
+IceInternal::PathAcceptor::PathAcceptor(const PathEndpointIPtr& endpoint, const ProtocolInstancePtr& instance,
+                                        const string& path) :
+    _endpoint(endpoint),
+    _instance(instance),
+    _path(path),
+    _addr(getUnixSocketAddress(path)),
+    _unlink(false)
+{
+    _fd = createSocket(false, _addr);
+    setBlock(_fd, false);
+}
+
+IceInternal::PathAcceptor::~PathAcceptor()
+{
+    assert(_fd == INVALID_SOCKET);
+}
+
+#endif
@@ -0,0 +1,50 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_PATH_ACCEPTOR_H
+#define ICE_PATH_ACCEPTOR_H
+
+#include <Ice/TransceiverF.h>
+#include <Ice/ProtocolInstanceF.h>
+#include <Ice/EndpointIF.h>
+#include <Ice/Acceptor.h>
+#include <Ice/Network.h>
+
+#if defined(ICE_HAS_UNIX_SOCKET)
+
+namespace IceInternal
+{
+
+class PathAcceptor : public Acceptor, public NativeInfo
+{
+public:
+
+    virtual NativeInfoPtr getNativeInfo();
+
+    virtual void close();
+    virtual EndpointIPtr listen();
+
+    virtual TransceiverPtr accept();
+    virtual std::string protocol() const;
+    virtual std::string toString() const;
+    virtual std::string toDetailedString() const;
+
+private:
+
+    PathAcceptor(const PathEndpointIPtr&, const ProtocolInstancePtr&, const std::string&);
+    virtual ~PathAcceptor();
+    friend class PathEndpointI;
+
+    const PathEndpointIPtr _endpoint;
+    const ProtocolInstancePtr _instance;
+    const std::string _path;
+    const Address _addr;
+    bool _unlink;
+};
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,104 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/PathConnector.h>
+
+#if defined(ICE_HAS_UNIX_SOCKET)
+
+#include <Ice/PathEndpointI.h>
+#include <Ice/ProtocolInstance.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+TransceiverPtr
+IceInternal::PathConnector::connect()
+{
+    return _endpoint->createTransceiver(_addr);
+}
+
+Short
+IceInternal::PathConnector::type() const
+{
+    return _instance->type();
+}
+
+string
+IceInternal::PathConnector::toString() const
+{
+    return addrToString(_addr);
+}
+
+bool
+IceInternal::PathConnector::operator==(const Connector& r) const
+{
+    const PathConnector* p = dynamic_cast<const PathConnector*>(&r);
+    if(!p || type() != p->type())
+    {
+        return false;
+    }
+
+    if(compareAddress(_addr, p->_addr) != 0)
+    {
+        return false;
+    }
+
+    if(_timeout != p->_timeout)
+    {
+        return false;
+    }
+
+    if(_connectionId != p->_connectionId)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool
+IceInternal::PathConnector::operator<(const Connector& r) const
+{
+    const PathConnector* p = dynamic_cast<const PathConnector*>(&r);
+    if(!p || type() != p->type())
+    {
+        return type() < r.type();
+    }
+
+    if(_timeout < p->_timeout)
+    {
+        return true;
+    }
+    else if(p->_timeout < _timeout)
+    {
+        return false;
+    }
+
+    if(_connectionId < p->_connectionId)
+    {
+        return true;
+    }
+    else if(p->_connectionId < _connectionId)
+    {
+        return false;
+    }
+    return compareAddress(_addr, p->_addr) < 0;
+}
+
+IceInternal::PathConnector::PathConnector(const PathEndpointIPtr& endpoint, const ProtocolInstancePtr& instance,
+                                          const Address& addr, Ice::Int timeout, const string& connectionId) :
+    _endpoint(endpoint),
+    _instance(instance),
+    _addr(addr),
+    _timeout(timeout),
+    _connectionId(connectionId)
+{
+}
+
+IceInternal::PathConnector::~PathConnector()
+{
+}
+
+#endif
@@ -0,0 +1,48 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_PATH_CONNECTOR_H
+#define ICE_PATH_CONNECTOR_H
+
+#include <Ice/TransceiverF.h>
+#include <Ice/ProtocolInstanceF.h>
+#include <Ice/EndpointIF.h>
+#include <Ice/Connector.h>
+#include <Ice/Network.h>
+
+#if defined(ICE_HAS_UNIX_SOCKET)
+
+namespace IceInternal
+{
+
+class PathConnector : public Connector
+{
+public:
+
+    virtual TransceiverPtr connect();
+
+    virtual Ice::Short type() const;
+    virtual std::string toString() const;
+
+    virtual bool operator==(const Connector&) const;
+    virtual bool operator<(const Connector&) const;
+
+private:
+
+    PathConnector(const PathEndpointIPtr&, const ProtocolInstancePtr&, const Address&, Ice::Int, const std::string&);
+    virtual ~PathConnector();
+    friend class PathEndpointI;
+
+    const PathEndpointIPtr _endpoint;
+    const ProtocolInstancePtr _instance;
+    const Address _addr;
+    const Ice::Int _timeout;
+    const std::string _connectionId;
+};
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,476 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/PathEndpointI.h>
+
+#if defined(ICE_HAS_UNIX_SOCKET)
+
+#include <Ice/PathAcceptor.h>
+#include <Ice/PathConnector.h>
+#include <Ice/OutputStream.h>
+#include <Ice/InputStream.h>
+#include <Ice/LocalException.h>
+#include <Ice/ProtocolInstance.h>
+#include <Ice/HashUtil.h>
+#include <Ice/UUID.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+#ifndef ICE_CPP11_MAPPING
+IceUtil::Shared* IceInternal::upCast(PathEndpointI* p) { return p; }
+#endif
+
+IceInternal::PathEndpointI::PathEndpointI(const ProtocolInstancePtr& instance, const string& path, Int timeout,
+                                          const string& connectionId, bool compress) :
+    _instance(instance),
+    _path(path),
+    _timeout(timeout),
+    _connectionId(connectionId),
+    _compress(compress),
+    _hashValue(0)
+{
+    hashInit();
+}
+
+IceInternal::PathEndpointI::PathEndpointI(const ProtocolInstancePtr& instance) :
+    _instance(instance),
+    _timeout(instance->defaultTimeout()),
+    _compress(false),
+    _hashValue(0)
+{
+}
+
+IceInternal::PathEndpointI::PathEndpointI(const ProtocolInstancePtr& instance, InputStream* s) :
+    _instance(instance),
+    _timeout(-1),
+    _compress(false),
+    _hashValue(0)
+{
+    s->read(const_cast<string&>(_path), false);
+    s->read(const_cast<Int&>(_timeout));
+    s->read(const_cast<bool&>(_compress));
+    hashInit();
+}
+
+void
+IceInternal::PathEndpointI::streamWriteImpl(OutputStream* s) const
+{
+    s->write(_path, false);
+    s->write(_timeout);
+    s->write(_compress);
+}
+
+Short
+IceInternal::PathEndpointI::type() const
+{
+    return _instance->type();
+}
+
+const string&
+IceInternal::PathEndpointI::protocol() const
+{
+    return _instance->protocol();
+}
+
+Int
+IceInternal::PathEndpointI::timeout() const
+{
+    return _timeout;
+}
+
+EndpointIPtr
+IceInternal::PathEndpointI::timeout(Int timeout) const
+{
+    if(timeout == _timeout)
+    {
+        return ICE_SHARED_FROM_CONST_THIS(PathEndpointI);
+    }
+    else
+    {
+        return createEndpoint(_path, timeout, _connectionId, _compress);
+    }
+}
+
+const string&
+IceInternal::PathEndpointI::connectionId() const
+{
+    return _connectionId;
+}
+
+EndpointIPtr
+IceInternal::PathEndpointI::connectionId(const string& connectionId) const
+{
+    if(connectionId == _connectionId)
+    {
+        return ICE_SHARED_FROM_CONST_THIS(PathEndpointI);
+    }
+    else
+    {
+        return createEndpoint(_path, _timeout, connectionId, _compress);
+    }
+}
+
+bool
+IceInternal::PathEndpointI::compress() const
+{
+    return _compress;
+}
+
+EndpointIPtr
+IceInternal::PathEndpointI::compress(bool compress) const
+{
+    if(compress == _compress)
+    {
+        return ICE_SHARED_FROM_CONST_THIS(PathEndpointI);
+    }
+    else
+    {
+        return createEndpoint(_path, _timeout, _connectionId, compress);
+    }
+}
+
+bool
+IceInternal::PathEndpointI::datagram() const
+{
+    return false;
+}
+
+bool
+IceInternal::PathEndpointI::secure() const
+{
+    return _instance->secure();
+}
+
+TransceiverPtr
+IceInternal::PathEndpointI::transceiver() const
+{
+    return 0;
+}
+
+void
+IceInternal::PathEndpointI::connectors_async(EndpointSelectionType, const EndpointI_connectorsPtr& callback) const
+{
+    vector<ConnectorPtr> connectors;
+    try
+    {
+        connectors.push_back(new PathConnector(ICE_SHARED_FROM_CONST_THIS(PathEndpointI), _instance,
+                                               getUnixSocketAddress(_path), _timeout, _connectionId));
+    }
+    catch(const Ice::LocalException& ex)
+    {
+        callback->exception(ex);
+        return;
+    }
+    callback->connectors(connectors);
+}
+
+AcceptorPtr
+IceInternal::PathEndpointI::acceptor(const string&) const
+{
+    return new PathAcceptor(ICE_SHARED_FROM_CONST_THIS(PathEndpointI), _instance, _path);
+}
+
+vector<EndpointIPtr>
+IceInternal::PathEndpointI::expandIfWildcard() const
+{
+    vector<EndpointIPtr> endps;
+    endps.push_back(ICE_SHARED_FROM_CONST_THIS(PathEndpointI));
+    return endps;
+}
+
+vector<EndpointIPtr>
+IceInternal::PathEndpointI::expandHost(EndpointIPtr&) const
+{
+    //
+    // Nothing to do here.
+    //
+    vector<EndpointIPtr> endps;
+    endps.push_back(ICE_SHARED_FROM_CONST_THIS(PathEndpointI));
+    return endps;
+}
+
+bool
+IceInternal::PathEndpointI::equivalent(const EndpointIPtr& endpoint) const
+{
+    const PathEndpointI* pathEndpointI = dynamic_cast<const PathEndpointI*>(endpoint.get());
+    if(!pathEndpointI)
+    {
+        return false;
+    }
+    return pathEndpointI->type() == type() && pathEndpointI->_path == _path;
+}
+
+Int
+IceInternal::PathEndpointI::hash() const
+{
+    return _hashValue;
+}
+
+string
+IceInternal::PathEndpointI::options() const
+{
+    //
+    // WARNING: Certain features, such as proxy validation in Glacier2,
+    // depend on the format of proxy strings. Changes to toString() and
+    // methods called to generate parts of the reference string could break
+    // these features. Please review for all features that depend on the
+    // format of proxyToString() before changing this and related code.
+    //
+    ostringstream s;
+
+    if(!_path.empty())
+    {
+        s << " --path ";
+        bool addQuote = _path.find_first_of(": \t\n\r") != string::npos;
+        if(addQuote)
+        {
+            s << "\"";
+        }
+        s << _path;
+        if(addQuote)
+        {
+            s << "\"";
+        }
+    }
+
+    if(_timeout == -1)
+    {
+        s << " -t infinite";
+    }
+    else
+    {
+        s << " -t " << _timeout;
+    }
+
+    if(_compress)
+    {
+        s << " -z";
+    }
+
+    return s.str();
+}
+
+bool
+#ifdef ICE_CPP11_MAPPING
+IceInternal::PathEndpointI::operator==(const Endpoint& r) const
+#else
+IceInternal::PathEndpointI::operator==(const LocalObject& r) const
+#endif
+{
+    const PathEndpointI* p = dynamic_cast<const PathEndpointI*>(&r);
+    if(!p)
+    {
+        return false;
+    }
+
+    if(this == p)
+    {
+        return true;
+    }
+
+    if(type() != p->type())
+    {
+        return false;
+    }
+
+    if(_path != p->_path)
+    {
+        return false;
+    }
+
+    if(_connectionId != p->_connectionId)
+    {
+        return false;
+    }
+
+    if(_timeout != p->_timeout)
+    {
+        return false;
+    }
+
+    if(_compress != p->_compress)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool
+#ifdef ICE_CPP11_MAPPING
+IceInternal::PathEndpointI::operator<(const Endpoint& r) const
+#else
+IceInternal::PathEndpointI::operator<(const LocalObject& r) const
+#endif
+{
+    const PathEndpointI* p = dynamic_cast<const PathEndpointI*>(&r);
+    if(!p)
+    {
+        const EndpointI* e = dynamic_cast<const EndpointI*>(&r);
+        if(!e)
+        {
+            return false;
+        }
+        return type() < e->type();
+    }
+
+    if(this == p)
+    {
+        return false;
+    }
+
+    if(type() < p->type())
+    {
+        return true;
+    }
+    else if(p->type() < type())
+    {
+        return false;
+    }
+
+    if(_path < p->_path)
+    {
+        return true;
+    }
+    else if(p->_path < _path)
+    {
+        return false;
+    }
+
+    if(_connectionId < p->_connectionId)
+    {
+        return true;
+    }
+    else if(p->_connectionId < _connectionId)
+    {
+        return false;
+    }
+
+    if(_timeout < p->_timeout)
+    {
+        return true;
+    }
+    else if(p->_timeout < _timeout)
+    {
+        return false;
+    }
+
+    if(!_compress && p->_compress)
+    {
+        return true;
+    }
+    else if(p->_compress < _compress)
+    {
+        return false;
+    }
+
+    return false;
+}
+
+void
+IceInternal::PathEndpointI::initWithOptions(vector<string>& args, bool oaEndpoint)
+{
+    EndpointI::initWithOptions(args);
+
+    if(_path.empty())
+    {
+#if defined(__linux__)
+        if(oaEndpoint)
+        {
+            //
+            // Generate a socket name in the abstract namespace for object
+            // adapters that don't specify a path.
+            //
+            const_cast<string&>(_path) = "@ice-" + _instance->protocol() + "-" + generateUUID();
+        }
+        else
+#endif
+        {
+            throw EndpointParseException(__FILE__, __LINE__, "a path must be specified using the --path option");
+        }
+    }
+
+    try
+    {
+        getUnixSocketAddress(_path);
+    }
+    catch(const Ice::SocketException&)
+    {
+        throw EndpointParseException(__FILE__, __LINE__, "invalid path `" + _path + "' in endpoint " + toString());
+    }
+
+    hashInit();
+}
+
+const string&
+IceInternal::PathEndpointI::path() const
+{
+    return _path;
+}
+
+bool
+IceInternal::PathEndpointI::checkOption(const string& option, const string& argument, const string& endpoint)
+{
+    if(option == "--path")
+    {
+        if(argument.empty())
+        {
+            throw EndpointParseException(__FILE__, __LINE__, "no argument provided for --path option in endpoint " +
+                                         endpoint);
+        }
+        const_cast<string&>(_path) = argument;
+    }
+    else if(option == "-t")
+    {
+        if(argument.empty())
+        {
+            throw EndpointParseException(__FILE__, __LINE__, "no argument provided for -t option in endpoint " +
+                                         endpoint);
+        }
+
+        if(argument == "infinite")
+        {
+            const_cast<Int&>(_timeout) = -1;
+        }
+        else
+        {
+            istringstream t(argument);
+            if(!(t >> const_cast<Int&>(_timeout)) || !t.eof() || _timeout < 1)
+            {
+                throw EndpointParseException(__FILE__, __LINE__, "invalid timeout value `" + argument +
+                                             "' in endpoint " + endpoint);
+            }
+        }
+    }
+    else if(option == "-z")
+    {
+        if(!argument.empty())
+        {
+            throw EndpointParseException(__FILE__, __LINE__, "unexpected argument `" + argument +
+                                         "' provided for -z option in " + endpoint);
+        }
+        const_cast<bool&>(_compress) = true;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+void
+IceInternal::PathEndpointI::hashInit()
+{
+    Int h = 5381;
+    hashAdd(h, type());
+    hashAdd(h, _path);
+    hashAdd(h, _timeout);
+    hashAdd(h, _connectionId);
+    hashAdd(h, _compress);
+    const_cast<Int&>(_hashValue) = h;
+}
+
+#endif
@@ -0,0 +1,102 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_PATH_ENDPOINT_I_H
+#define ICE_PATH_ENDPOINT_I_H
+
+#include <Ice/EndpointI.h>
+#include <Ice/ProtocolInstanceF.h>
+#include <Ice/Network.h> // For ICE_HAS_UNIX_SOCKET
+
+#if defined(ICE_HAS_UNIX_SOCKET)
+
+namespace IceInternal
+{
+
+//
+// The base class of the endpoints of transports which establish and accept
+// their connections with a Unix domain socket bound to a file-system path,
+// or to a name in the abstract namespace on Linux. The transports only
+// provide the endpoint information and the transceivers.
+//
+class PathEndpointI : public EndpointI
+#ifdef ICE_CPP11_MAPPING
+                    , public std::enable_shared_from_this<PathEndpointI>
+#endif
+{
+public:
+
+    virtual void streamWriteImpl(Ice::OutputStream*) const;
+
+    virtual Ice::Short type() const;
+    virtual const std::string& protocol() const;
+
+    virtual Ice::Int timeout() const;
+    virtual EndpointIPtr timeout(Ice::Int) const;
+    virtual const std::string& connectionId() const;
+    virtual EndpointIPtr connectionId(const ::std::string&) const;
+    virtual bool compress() const;
+    virtual EndpointIPtr compress(bool) const;
+    virtual bool datagram() const;
+    virtual bool secure() const;
+
+    virtual TransceiverPtr transceiver() const;
+    virtual void connectors_async(Ice::EndpointSelectionType, const EndpointI_connectorsPtr&) const;
+    virtual AcceptorPtr acceptor(const std::string&) const;
+    virtual std::vector<EndpointIPtr> expandIfWildcard() const;
+    virtual std::vector<EndpointIPtr> expandHost(EndpointIPtr&) const;
+    virtual bool equivalent(const EndpointIPtr&) const;
+    virtual ::Ice::Int hash() const;
+    virtual std::string options() const;
+
+#ifdef ICE_CPP11_MAPPING
+    virtual bool operator==(const Ice::Endpoint&) const;
+    virtual bool operator<(const Ice::Endpoint&) const;
+#else
+    virtual bool operator==(const Ice::LocalObject&) const;
+    virtual bool operator<(const Ice::LocalObject&) const;
+#endif
+
+    void initWithOptions(std::vector<std::string>&, bool);
+
+    const std::string& path() const;
+
+    //
+    // Create the transceiver of a connection established to the given
+    // address, or of an accepted connection.
+    //
+    virtual TransceiverPtr createTransceiver(const Address&) const = 0;
+    virtual TransceiverPtr createTransceiver(SOCKET) const = 0;
+
+protected:
+
+    virtual bool checkOption(const std::string&, const std::string&, const std::string&);
+
+    virtual EndpointIPtr createEndpoint(const std::string&, Ice::Int, const std::string&, bool) const = 0;
+
+    PathEndpointI(const ProtocolInstancePtr&, const std::string&, Ice::Int, const std::string&, bool);
+    PathEndpointI(const ProtocolInstancePtr&);
+    PathEndpointI(const ProtocolInstancePtr&, Ice::InputStream*);
+
+    //
+    // All members are const, because endpoints are immutable.
+    //
+    const ProtocolInstancePtr _instance;
+    const std::string _path;
+    const Ice::Int _timeout;
+    const std::string _connectionId;
+    const bool _compress;
+
+private:
+
+    void hashInit();
+
+    const Ice::Int _hashValue;
+};
+
+}
+
+#endif
+
+#endif
@@ -3,6 +3,7 @@
 //
 
 #include <Ice/PropertiesI.h>
+#include <Ice/PropertyAccessor.h>
 #include <IceUtil/StringUtil.h>
 #include <IceUtil/FileUtil.h>
 #include <Ice/Initialize.h>
@@ -17,38 +18,68 @@ using namespace std;
 using namespace Ice;
 using namespace IceInternal;
 
-string
-Ice::PropertiesI::getProperty(const string& key) ICE_NOEXCEPT
+namespace
 {
-    IceUtil::Mutex::Lock sync(*this);
 
-    map<string, PropertyValue>::iterator p = _properties.find(key);
-    if(p != _properties.end())
-    {
-        p->second.used = true;
-        return p->second.value;
-    }
-    else
+//
+// The maximum number of retired snapshots kept while readers still use them.
+//
+const size_t maxRetiredSnapshots = 16;
+
+Int
+toInt(const string& key, bool isInt, Int intValue, Int value)
+{
+    if(!isInt)
     {
-        return string();
+        Warning out(getProcessLogger());
+        out << "numeric property " << key << " set to non-numeric value, defaulting to " << value;
+        return value;
     }
+    return intValue;
 }
 
-string
-Ice::PropertiesI::getPropertyWithDefault(const string& key, const string& value) ICE_NOEXCEPT
+StringSeq
+toList(const string& key, const string& str, const StringSeq& value)
 {
-    IceUtil::Mutex::Lock sync(*this);
-
-    map<string, PropertyValue>::iterator p = _properties.find(key);
-    if(p != _properties.end())
+    StringSeq result;
+    if(!IceUtilInternal::splitString(str, ", \t\r\n", result))
     {
-        p->second.used = true;
-        return p->second.value;
+        Warning out(getProcessLogger());
+        out << "mismatched quotes in property " << key << "'s value, returning default value";
     }
-    else
+    if(result.size() == 0)
     {
-        return value;
+        result = value;
     }
+    return result;
+}
+
+}
+
+Ice::PropertiesI::PropertyValue::PropertyValue(const string& v, bool u) :
+    value(v),
+    isInt(false),
+    intValue(0),
+    used(u ? 1 : 0)
+{
+    istringstream is(value);
+    isInt = (is >> intValue) && is.eof();
+}
+
+string
+Ice::PropertiesI::getProperty(const string& key) ICE_NOEXCEPT
+{
+    Reader reader(this);
+    const PropertyValue* p = reader.find(key);
+    return p ? p->value : string();
+}
+
+string
+Ice::PropertiesI::getPropertyWithDefault(const string& key, const string& value) ICE_NOEXCEPT
+{
+    Reader reader(this);
+    const PropertyValue* p = reader.find(key);
+    return p ? p->value : value;
 }
 
 Int
@@ -60,23 +91,9 @@ Ice::PropertiesI::getPropertyAsInt(const string& key) ICE_NOEXCEPT
 Int
 Ice::PropertiesI::getPropertyAsIntWithDefault(const string& key, Int value) ICE_NOEXCEPT
 {
-    IceUtil::Mutex::Lock sync(*this);
-
-    map<string, PropertyValue>::iterator p = _properties.find(key);
-    if(p != _properties.end())
-    {
-        Int val = value;
-        p->second.used = true;
-        istringstream v(p->second.value);
-        if(!(v >> value) || !v.eof())
-        {
-            Warning out(getProcessLogger());
-            out << "numeric property " << key << " set to non-numeric value, defaulting to " << val;
-            return val;
-        }
-    }
-
-    return value;
+    Reader reader(this);
+    const PropertyValue* p = reader.find(key);
+    return p ? toInt(key, p->isInt, p->intValue, value) : value;
 }
 
 Ice::StringSeq
@@ -88,29 +105,9 @@ Ice::PropertiesI::getPropertyAsList(const string& key) ICE_NOEXCEPT
 Ice::StringSeq
 Ice::PropertiesI::getPropertyAsListWithDefault(const string& key, const StringSeq& value) ICE_NOEXCEPT
 {
-    IceUtil::Mutex::Lock sync(*this);
-
-    map<string, PropertyValue>::iterator p = _properties.find(key);
-    if(p != _properties.end())
-    {
-        p->second.used = true;
-
-        StringSeq result;
-        if(!IceUtilInternal::splitString(p->second.value, ", \t\r\n", result))
-        {
-            Warning out(getProcessLogger());
-            out << "mismatched quotes in property " << key << "'s value, returning default value";
-        }
-        if(result.size() == 0)
-        {
-            result = value;
-        }
-        return result;
-    }
-    else
-    {
-        return value;
-    }
+    Reader reader(this);
+    const PropertyValue* p = reader.find(key);
+    return p ? toList(key, p->value, value) : value;
 }
 
 PropertyDict
@@ -119,15 +116,18 @@ Ice::PropertiesI::getPropertiesForPrefix(const string& prefix) ICE_NOEXCEPT
     IceUtil::Mutex::Lock sync(*this);
 
     PropertyDict result;
-    for(map<string, PropertyValue>::iterator p = _properties.begin(); p != _properties.end(); ++p)
+    for(map<string, PropertyValuePtr>::const_iterator p = _properties.lower_bound(prefix); p != _properties.end(); ++p)
     {
-        if(prefix.empty() || p->first.compare(0, prefix.size(), prefix) == 0)
+        if(p->first.compare(0, prefix.size(), prefix) != 0)
         {
-            p->second.used = true;
-            result[p->first] = p->second.value;
+            break;
         }
+        if(!p->second->used)
+        {
+            p->second->used.exchange(1);
+        }
+        result[p->first] = p->second->value;
     }
-
     return result;
 }
 
@@ -215,18 +215,19 @@ Ice::PropertiesI::setProperty(const string& key, const string& value)
     //
     if(!value.empty())
     {
-        PropertyValue pv(value, false);
-        map<string, PropertyValue>::const_iterator p = _properties.find(currentKey);
+        bool used = false;
+        map<string, PropertyValuePtr>::const_iterator p = _properties.find(currentKey);
         if(p != _properties.end())
         {
-            pv.used = p->second.used;
+            used = p->second->used != 0;
         }
-        _properties[currentKey] = pv;
+        _properties[currentKey] = new PropertyValue(value, used);
     }
     else
     {
         _properties.erase(currentKey);
     }
+    retireSnapshot();
 }
 
 StringSeq
@@ -236,9 +237,9 @@ Ice::PropertiesI::getCommandLineOptions() ICE_NOEXCEPT
 
     StringSeq result;
     result.reserve(_properties.size());
-    for(map<string, PropertyValue>::const_iterator p = _properties.begin(); p != _properties.end(); ++p)
+    for(map<string, PropertyValuePtr>::const_iterator p = _properties.begin(); p != _properties.end(); ++p)
     {
-        result.push_back("--" + p->first + "=" + p->second.value);
+        result.push_back("--" + p->first + "=" + p->second->value);
     }
     return result;
 }
@@ -432,9 +433,9 @@ Ice::PropertiesI::getUnusedProperties()
 {
     IceUtil::Mutex::Lock sync(*this);
     set<string> unusedProperties;
-    for(map<string, PropertyValue>::const_iterator p = _properties.begin(); p != _properties.end(); ++p)
+    for(map<string, PropertyValuePtr>::const_iterator p = _properties.begin(); p != _properties.end(); ++p)
     {
-        if(!p->second.used)
+        if(!p->second->used)
         {
             unusedProperties.insert(p->first);
         }
@@ -443,24 +444,27 @@ Ice::PropertiesI::getUnusedProperties()
 }
 
 Ice::PropertiesI::PropertiesI(const PropertiesI* p) :
-    _properties(p->_properties)
+    _snapshot(0)
 {
+    copyProperties(p);
 }
 
-Ice::PropertiesI::PropertiesI()
+Ice::PropertiesI::PropertiesI() :
+    _snapshot(0)
 {
 }
 
-Ice::PropertiesI::PropertiesI(StringSeq& args, const PropertiesPtr& defaults)
+Ice::PropertiesI::PropertiesI(StringSeq& args, const PropertiesPtr& defaults) :
+    _snapshot(0)
 {
     if(defaults != 0)
     {
-        _properties = static_cast<PropertiesI*>(defaults.get())->_properties;
+        copyProperties(static_cast<PropertiesI*>(defaults.get()));
     }
 
     StringSeq::iterator q = args.begin();
 
-    map<string, PropertyValue>::iterator p = _properties.find("Ice.ProgramName");
+    map<string, PropertyValuePtr>::iterator p = _properties.find("Ice.ProgramName");
     if(p == _properties.end())
     {
         if(q != args.end())
@@ -473,13 +477,12 @@ Ice::PropertiesI::PropertiesI(StringSeq& args, const PropertiesPtr& defaults)
             string name = *q;
             replace(name.begin(), name.end(), '\\', '/');
 
-            PropertyValue pv(name, true);
-            _properties["Ice.ProgramName"] = pv;
+            _properties["Ice.ProgramName"] = new PropertyValue(name, true);
         }
     }
     else
     {
-        p->second.used = true;
+        p->second->used.exchange(1);
     }
 
     StringSeq tmp;
@@ -733,7 +736,284 @@ Ice::PropertiesI::loadConfig()
             load(IceUtilInternal::trim(*i));
         }
 
-        PropertyValue pv(value, true);
-        _properties["Ice.Config"] = pv;
+        IceUtil::Mutex::Lock sync(*this);
+        _properties["Ice.Config"] = new PropertyValue(value, true);
+        retireSnapshot();
+    }
+}
+
+size_t
+Ice::PropertiesI::getSlot(const string& key)
+{
+    IceUtil::Mutex::Lock sync(*this);
+    map<string, size_t>::const_iterator p = _slots.find(key);
+    if(p != _slots.end())
+    {
+        return p->second;
+    }
+
+    size_t slot = _slots.size();
+    _slots.insert(make_pair(key, slot));
+    _slotKeys.push_back(key);
+    retireSnapshot(); // The snapshot must be rebuilt to include the new slot.
+    return slot;
+}
+
+Ice::PropertiesI::Reader::Reader(PropertiesI* properties) :
+    _properties(properties),
+    _snapshot(0),
+    _locked(false)
+{
+    //
+    // Register the reader before loading the snapshot, a thread retiring the
+    // snapshot after it was loaded doesn't release it while the reader is
+    // registered.
+    //
+    _properties->_readers.fetch_add(1);
+    _snapshot = _properties->loadSnapshot();
+    if(_snapshot)
+    {
+        return;
+    }
+    _properties->_readers.fetch_sub(1);
+
+    //
+    // The properties were updated since the last snapshot was built, build
+    // a new one unless another thread already did. The reader keeps the mutex
+    // locked to use the snapshot or, if none could be built, the properties.
+    //
+    _properties->lock();
+    _locked = true;
+    try
+    {
+        _snapshot = _properties->buildSnapshot();
+    }
+    catch(...)
+    {
+        _properties->unlock();
+        throw;
+    }
+}
+
+Ice::PropertiesI::Reader::~Reader()
+{
+    if(_locked)
+    {
+        _properties->unlock();
+    }
+    else
+    {
+        _properties->_readers.fetch_sub(1);
+    }
+}
+
+const Ice::PropertiesI::PropertyValue*
+Ice::PropertiesI::Reader::find(const string& key)
+{
+    const PropertyValue* p = 0;
+    if(_snapshot)
+    {
+        PropertyMap::const_iterator q = _snapshot->properties.find(key);
+        p = q != _snapshot->properties.end() ? q->second.get() : 0;
+    }
+    else
+    {
+        map<string, PropertyValuePtr>::const_iterator q = _properties->_properties.find(key);
+        p = q != _properties->_properties.end() ? q->second.get() : 0;
+    }
+    if(p && !p->used)
+    {
+        p->used.exchange(1);
+    }
+    return p;
+}
+
+const Ice::PropertiesI::PropertyValue*
+Ice::PropertiesI::Reader::findSlot(size_t slot)
+{
+    if(!_snapshot)
+    {
+        return find(_properties->_slotKeys[slot]);
+    }
+    const PropertyValue* p = slot < _snapshot->slots.size() ? _snapshot->slots[slot].get() : 0;
+    if(p && !p->used)
+    {
+        p->used.exchange(1);
+    }
+    return p;
+}
+
+const Ice::PropertiesI::Snapshot*
+Ice::PropertiesI::loadSnapshot() const
+{
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+    return _snapshot.load();
+#else
+    IceUtil::Mutex::Lock sync(_snapshotMutex);
+    return _snapshot;
+#endif
+}
+
+const Ice::PropertiesI::Snapshot*
+Ice::PropertiesI::buildSnapshot()
+{
+    //
+    // Called with the mutex locked.
+    //
+    if(_current)
+    {
+        return _current.get();
+    }
+
+    releaseSnapshots();
+    if(_retired.size() >= maxRetiredSnapshots)
+    {
+        return 0;
+    }
+
+    SnapshotPtr snapshot = new Snapshot;
+#ifdef ICE_CPP11_COMPILER
+    snapshot->properties.reserve(_properties.size());
+#endif
+    snapshot->properties.insert(_properties.begin(), _properties.end());
+    snapshot->slots.resize(_slots.size());
+    for(map<string, size_t>::const_iterator p = _slots.begin(); p != _slots.end(); ++p)
+    {
+        map<string, PropertyValuePtr>::const_iterator q = _properties.find(p->first);
+        if(q != _properties.end())
+        {
+            snapshot->slots[p->second] = q->second;
+        }
+    }
+    _current = snapshot;
+
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+    _snapshot.store(_current.get());
+#else
+    IceUtil::Mutex::Lock sync(_snapshotMutex);
+    _snapshot = _current.get();
+#endif
+    return _current.get();
+}
+
+void
+Ice::PropertiesI::retireSnapshot()
+{
+    //
+    // Called with the mutex locked.
+    //
+    if(_current)
+    {
+        {
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+            _snapshot.store(0);
+#else
+            IceUtil::Mutex::Lock sync(_snapshotMutex);
+            _snapshot = 0;
+#endif
+        }
+        _retired.push_back(_current);
+        _current = 0;
+    }
+    releaseSnapshots();
+}
+
+void
+Ice::PropertiesI::releaseSnapshots()
+{
+    //
+    // Called with the mutex locked, after the retired snapshots were replaced.
+    // A reader which loaded one of them registered before loading it.
+    //
+    if(!_retired.empty() && _readers.load() == 0)
+    {
+        _retired.clear();
+    }
+}
+
+void
+Ice::PropertiesI::copyProperties(const PropertiesI* p)
+{
+    //
+    // The values are copied rather than shared, the used flag is specific to
+    // each property set.
+    //
+    for(map<string, PropertyValuePtr>::const_iterator q = p->_properties.begin(); q != p->_properties.end(); ++q)
+    {
+        _properties[q->first] = new PropertyValue(q->second->value, q->second->used != 0);
+    }
+}
+
+Ice::PropertyAccessor::PropertyAccessor() :
+    _impl(0),
+    _slot(0)
+{
+}
+
+Ice::PropertyAccessor::PropertyAccessor(const PropertiesPtr& properties, const string& key) :
+    _properties(properties),
+    _impl(dynamic_cast<PropertiesI*>(properties.get())),
+    _slot(_impl ? _impl->getSlot(key) : 0),
+    _key(key)
+{
+}
+
+const string&
+Ice::PropertyAccessor::getKey() const
+{
+    return _key;
+}
+
+string
+Ice::PropertyAccessor::get() const
+{
+    return getWithDefault(string());
+}
+
+string
+Ice::PropertyAccessor::getWithDefault(const string& value) const
+{
+    if(!_impl)
+    {
+        return _properties ? _properties->getPropertyWithDefault(_key, value) : value;
+    }
+    PropertiesI::Reader reader(_impl);
+    const PropertiesI::PropertyValue* p = reader.findSlot(_slot);
+    return p ? p->value : value;
+}
+
+Int
+Ice::PropertyAccessor::getAsInt() const
+{
+    return getAsIntWithDefault(0);
+}
+
+Int
+Ice::PropertyAccessor::getAsIntWithDefault(Int value) const
+{
+    if(!_impl)
+    {
+        return _properties ? _properties->getPropertyAsIntWithDefault(_key, value) : value;
+    }
+    PropertiesI::Reader reader(_impl);
+    const PropertiesI::PropertyValue* p = reader.findSlot(_slot);
+    return p ? toInt(_key, p->isInt, p->intValue, value) : value;
+}
+
+StringSeq
+Ice::PropertyAccessor::getAsList() const
+{
+    return getAsListWithDefault(StringSeq());
+}
+
+StringSeq
+Ice::PropertyAccessor::getAsListWithDefault(const StringSeq& value) const
+{
+    if(!_impl)
+    {
+        return _properties ? _properties->getPropertyAsListWithDefault(_key, value) : value;
     }
+    PropertiesI::Reader reader(_impl);
+    const PropertiesI::PropertyValue* p = reader.findSlot(_slot);
+    return p ? toList(_key, p->value, value) : value;
 }
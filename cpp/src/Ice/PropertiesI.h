@@ -6,10 +6,14 @@
 #define ICE_PROPERTIES_I_H
 
 #include <IceUtil/Mutex.h>
+#include <IceUtil/Atomic.h>
 #include <Ice/Properties.h>
 #include <Ice/StringConverter.h>
 
 #include <set>
+#ifdef ICE_CPP11_COMPILER
+#   include <unordered_map>
+#endif
 
 namespace Ice
 {
@@ -35,6 +39,12 @@ public:
 
     std::set<std::string> getUnusedProperties();
 
+    //
+    // Used by PropertyAccessor: a slot is allocated for each key with an
+    // accessor and the snapshot keeps the value of each slot in a vector.
+    //
+    size_t getSlot(const std::string&);
+
     PropertiesI(const PropertiesI*);
 
     PropertiesI();
@@ -42,27 +52,92 @@ public:
 
 private:
 
+    friend class PropertyAccessor;
+
     void parseLine(const std::string&, const StringConverterPtr&);
 
     void loadConfig();
 
-    struct PropertyValue
+    //
+    // Property values are immutable once set, only the used flag is updated
+    // when the property is read. The values are shared with the snapshots.
+    //
+    class PropertyValue : public IceUtil::Shared
+    {
+    public:
+
+        PropertyValue(const std::string&, bool);
+
+        const std::string value;
+        bool isInt;
+        Ice::Int intValue;
+        mutable IceUtilInternal::Atomic used;
+    };
+    typedef IceUtil::Handle<PropertyValue> PropertyValuePtr;
+
+#ifdef ICE_CPP11_COMPILER
+    typedef std::unordered_map<std::string, PropertyValuePtr> PropertyMap;
+#else
+    typedef std::map<std::string, PropertyValuePtr> PropertyMap;
+#endif
+
+    //
+    // An immutable copy of the properties, readers look up properties in the
+    // current snapshot without locking the mutex. Setting a property retires
+    // the snapshot and the next reader builds a new one.
+    //
+    class Snapshot : public IceUtil::Shared
     {
-        PropertyValue() :
-            used(false)
-        {
-        }
-
-        PropertyValue(const std::string& v, bool u) :
-            value(v),
-            used(u)
-        {
-        }
-
-        std::string value;
-        bool used;
+    public:
+
+        PropertyMap properties;
+        std::vector<PropertyValuePtr> slots;
     };
-    std::map<std::string, PropertyValue> _properties;
+    typedef IceUtil::Handle<Snapshot> SnapshotPtr;
+
+    //
+    // A reader is registered while it uses the current snapshot, the retired
+    // snapshots are released once no reader is registered. If there's no
+    // snapshot and too many retired snapshots are still in use, the reader
+    // locks the mutex and looks up the properties instead.
+    //
+    class Reader : public IceUtil::noncopyable
+    {
+    public:
+
+        Reader(PropertiesI*);
+        ~Reader();
+
+        const PropertyValue* find(const std::string&);
+        const PropertyValue* findSlot(size_t);
+
+    private:
+
+        PropertiesI* _properties;
+        const Snapshot* _snapshot;
+        bool _locked;
+    };
+    friend class Reader;
+
+    const Snapshot* loadSnapshot() const;
+    const Snapshot* buildSnapshot();
+    void retireSnapshot();
+    void releaseSnapshots();
+    void copyProperties(const PropertiesI*);
+
+    std::map<std::string, PropertyValuePtr> _properties;
+    std::map<std::string, size_t> _slots;
+    std::vector<std::string> _slotKeys;
+
+#ifdef ICE_CPP11_COMPILER_HAS_ATOMIC
+    std::atomic<const Snapshot*> _snapshot;
+#else
+    const Snapshot* _snapshot;
+    IceUtil::Mutex _snapshotMutex;
+#endif
+    SnapshotPtr _current;
+    std::vector<SnapshotPtr> _retired;
+    IceUtilInternal::Atomic _readers;
 };
 
 }
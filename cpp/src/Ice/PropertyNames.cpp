@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Dec 11 11:59:14 2023
+// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Oct 19 05:16:07 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -58,6 +58,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.StackSize", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("Ice.Admin.MessageSizeMax", false, 0),
@@ -113,6 +114,9 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Default.Timeout", false, 0),
     IceInternal::Property("Ice.EventLog.Source", false, 0),
     IceInternal::Property("Ice.FactoryAssemblies", false, 0),
+    IceInternal::Property("Ice.HostResolver.CacheTTL", false, 0),
+    IceInternal::Property("Ice.HostResolver.NegativeCacheTTL", false, 0),
+    IceInternal::Property("Ice.HostResolver.Size", false, 0),
     IceInternal::Property("Ice.HTTPProxyHost", false, 0),
     IceInternal::Property("Ice.HTTPProxyPort", false, 0),
     IceInternal::Property("Ice.ImplicitContext", false, 0),
@@ -141,6 +145,8 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ProgramName", false, 0),
     IceInternal::Property("Ice.RetryIntervals", false, 0),
     IceInternal::Property("Ice.ServerIdleTime", false, 0),
+    IceInternal::Property("Ice.SHM.RcvSize", false, 0),
+    IceInternal::Property("Ice.SHM.SndSize", false, 0),
     IceInternal::Property("Ice.SOCKSProxyHost", false, 0),
     IceInternal::Property("Ice.SOCKSProxyPort", false, 0),
     IceInternal::Property("Ice.StdErr", false, 0),
@@ -151,6 +157,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Client.SizeWarn", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.StackSize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.Serialize", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.MessageBatchSize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadPriority", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.Size", false, 0),
@@ -158,6 +165,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Server.SizeWarn", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.StackSize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.Serialize", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.MessageBatchSize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.ThreadPriority", false, 0),
     IceInternal::Property("Ice.ThreadPriority", false, 0),
@@ -196,6 +204,8 @@ const IceInternal::PropertyArray
 
 const IceInternal::Property IceMXPropsData[] =
 {
+    IceInternal::Property("IceMX.Exporter.Host", false, 0),
+    IceInternal::Property("IceMX.Exporter.Port", false, 0),
     IceInternal::Property("IceMX.Metrics.*.GroupBy", false, 0),
     IceInternal::Property("IceMX.Metrics.*.Map", false, 0),
     IceInternal::Property("IceMX.Metrics.*.RetainDetached", false, 0),
@@ -244,6 +254,7 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.MessageSizeMax", false, 0),
@@ -281,6 +292,7 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceDiscovery.Reply.MessageSizeMax", false, 0),
@@ -318,6 +330,7 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceDiscovery.Locator.MessageSizeMax", false, 0),
@@ -325,6 +338,9 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Timeout", false, 0),
     IceInternal::Property("IceDiscovery.RetryCount", false, 0),
     IceInternal::Property("IceDiscovery.LatencyMultiplier", false, 0),
+    IceInternal::Property("IceDiscovery.BatchSize", false, 0),
+    IceInternal::Property("IceDiscovery.BatchDelay", false, 0),
+    IceInternal::Property("IceDiscovery.CacheTimeout", false, 0),
     IceInternal::Property("IceDiscovery.Address", false, 0),
     IceInternal::Property("IceDiscovery.Port", false, 0),
     IceInternal::Property("IceDiscovery.Interface", false, 0),
@@ -371,6 +387,7 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.MessageSizeMax", false, 0),
@@ -408,6 +425,7 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.MessageSizeMax", false, 0),
@@ -505,6 +523,7 @@ const IceInternal::Property IceBridgePropsData[] =
     IceInternal::Property("IceBridge.Source.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceBridge.Source.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceBridge.Source.MessageSizeMax", false, 0),
@@ -560,6 +579,7 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGridAdmin.Server.MessageSizeMax", false, 0),
@@ -600,6 +620,7 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.MessageSizeMax", false, 0),
@@ -637,6 +658,7 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.MessageSizeMax", false, 0),
@@ -684,6 +706,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.MessageSizeMax", false, 0),
@@ -722,14 +745,17 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Node.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Node.AdapterLatencyPeriod", false, 0),
     IceInternal::Property("IceGrid.Node.AllowRunningServersAsRoot", false, 0),
     IceInternal::Property("IceGrid.Node.AllowEndpointsOverride", false, 0),
     IceInternal::Property("IceGrid.Node.CollocateRegistry", false, 0),
     IceInternal::Property("IceGrid.Node.Data", false, 0),
     IceInternal::Property("IceGrid.Node.DisableOnFailure", false, 0),
+    IceInternal::Property("IceGrid.Node.MaxConcurrentActivations", false, 0),
     IceInternal::Property("IceGrid.Node.Name", false, 0),
     IceInternal::Property("IceGrid.Node.Output", false, 0),
     IceInternal::Property("IceGrid.Node.ProcessorSocketCount", false, 0),
@@ -800,6 +826,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.MessageSizeMax", false, 0),
@@ -847,6 +874,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.MessageSizeMax", false, 0),
@@ -886,6 +914,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.MessageSizeMax", false, 0),
@@ -928,9 +957,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.LMDB.GroupCommitWindow", false, 0),
     IceInternal::Property("IceGrid.Registry.LMDB.MapSize", false, 0),
     IceInternal::Property("IceGrid.Registry.LMDB.Path", false, 0),
     IceInternal::Property("IceGrid.Registry.NodeSessionTimeout", false, 0),
@@ -982,6 +1013,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.MessageSizeMax", false, 0),
@@ -1020,6 +1052,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.MessageSizeMax", false, 0),
@@ -1048,6 +1081,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Trace.Subscriber", false, 0),
     IceInternal::Property("IceGrid.Registry.Trace.Topic", false, 0),
     IceInternal::Property("IceGrid.Registry.Trace.TopicManager", false, 0),
+    IceInternal::Property("IceGrid.Registry.UpdateConcurrency", false, 0),
     IceInternal::Property("IceGrid.Registry.UserAccounts", false, 0),
 };
 
@@ -1091,10 +1125,12 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IcePatch2.MessageSizeMax", false, 0),
     IceInternal::Property("IcePatch2.Directory", false, 0),
+    IceInternal::Property("IcePatch2.FileCacheSize", false, 0),
     IceInternal::Property("IcePatch2.InstanceName", false, 0),
 };
 
@@ -1105,7 +1141,10 @@ const IceInternal::PropertyArray
 const IceInternal::Property IcePatch2ClientPropsData[] =
 {
     IceInternal::Property("IcePatch2Client.ChunkSize", false, 0),
+    IceInternal::Property("IcePatch2Client.DecompressThreads", false, 0),
     IceInternal::Property("IcePatch2Client.Directory", false, 0),
+    IceInternal::Property("IcePatch2Client.DownloadFiles", false, 0),
+    IceInternal::Property("IcePatch2Client.DownloadWindow", false, 0),
     IceInternal::Property("IcePatch2Client.Proxy", false, 0),
     IceInternal::Property("IcePatch2Client.Remove", false, 0),
     IceInternal::Property("IcePatch2Client.Thorough", false, 0),
@@ -1227,6 +1266,7 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.StackSize", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("Glacier2.Client.MessageSizeMax", false, 0),
@@ -1302,6 +1342,7 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.StackSize", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.MessageBatchSize", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("Glacier2.Server.MessageSizeMax", false, 0),
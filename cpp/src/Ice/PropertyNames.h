@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Dec 11 11:59:14 2023
+// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Oct 19 05:16:07 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -892,14 +892,15 @@ ICE_OBJECT_PRX::ice_getEndpointSelection() const
 ObjectPrxPtr
 ICE_OBJECT_PRX::ice_endpointSelection(EndpointSelectionType newType) const
 {
-    if(newType == _reference->getEndpointSelection())
+    ReferencePtr ref = _reference->changeEndpointSelection(newType);
+    if(ref == _reference)
     {
         return CONST_POINTER_CAST_OBJECT_PRX;
     }
     else
     {
         ObjectPrxPtr proxy = _newInstance();
-        proxy->setup(_reference->changeEndpointSelection(newType));
+        proxy->setup(ref);
         return proxy;
     }
 }
@@ -903,6 +903,7 @@ IceInternal::RoutableReference::RoutableReference(const InstancePtr& instance,
                                                   bool cacheConnection,
                                                   bool preferSecure,
                                                   EndpointSelectionType endpointSelection,
+                                                  bool balanced,
                                                   int locatorCacheTimeout,
                                                   int invocationTimeout,
                                                   const Ice::Context& ctx) :
@@ -915,6 +916,7 @@ IceInternal::RoutableReference::RoutableReference(const InstancePtr& instance,
     _cacheConnection(cacheConnection),
     _preferSecure(preferSecure),
     _endpointSelection(endpointSelection),
+    _balanced(balanced),
     _locatorCacheTimeout(locatorCacheTimeout),
     _overrideTimeout(false),
     _timeout(-1)
@@ -1112,12 +1114,13 @@ IceInternal::RoutableReference::changePreferSecure(bool newPreferSecure) const
 ReferencePtr
 IceInternal::RoutableReference::changeEndpointSelection(EndpointSelectionType newType) const
 {
-    if(newType == _endpointSelection)
+    if(newType == _endpointSelection && !_balanced)
     {
         return RoutableReferencePtr(const_cast<RoutableReference*>(this));
     }
     RoutableReferencePtr r = RoutableReferencePtr::dynamicCast(getInstance()->referenceFactory()->copy(this));
     r->_endpointSelection = newType;
+    r->_balanced = false;
     return r;
 }
 
@@ -1288,7 +1291,15 @@ IceInternal::RoutableReference::toProperty(const string& prefix) const
     properties[prefix + ".CollocationOptimized"] = _collocationOptimized ? "1" : "0";
     properties[prefix + ".ConnectionCached"] = _cacheConnection ? "1" : "0";
     properties[prefix + ".PreferSecure"] = _preferSecure ? "1" : "0";
-    properties[prefix + ".EndpointSelection"] = _endpointSelection == ICE_ENUM(EndpointSelectionType, Random) ? "Random" : "Ordered";
+    if(_balanced)
+    {
+        properties[prefix + ".EndpointSelection"] = "Balanced";
+    }
+    else
+    {
+        properties[prefix + ".EndpointSelection"] =
+            _endpointSelection == ICE_ENUM(EndpointSelectionType, Random) ? "Random" : "Ordered";
+    }
     {
         ostringstream s;
         s << _locatorCacheTimeout;
@@ -1360,6 +1371,10 @@ IceInternal::RoutableReference::operator==(const Reference& r) const
     {
         return false;
     }
+    if(_balanced != rhs->_balanced)
+    {
+        return false;
+    }
     if(_connectionId != rhs->_connectionId)
     {
         return false;
@@ -1456,6 +1471,14 @@ IceInternal::RoutableReference::operator<(const Reference& r) const
     {
         return false;
     }
+    if(!_balanced && rhs->_balanced)
+    {
+        return true;
+    }
+    else if(rhs->_balanced < _balanced)
+    {
+        return false;
+    }
     if(_connectionId < rhs->_connectionId)
     {
         return true;
@@ -1549,6 +1572,27 @@ IceInternal::RoutableReference::getBatchRequestQueue() const
     return new BatchRequestQueue(getInstance(), getMode() == Reference::ModeBatchDatagram);
 }
 
+bool
+IceInternal::RoutableReference::getBalanced() const
+{
+    return _balanced;
+}
+
+vector<EndpointIPtr>
+IceInternal::RoutableReference::getBalancedEndpoints() const
+{
+    //
+    // Invocations are only balanced over the endpoints of direct proxies. The endpoints
+    // of indirect proxies can change with each locator lookup and routed invocations
+    // are all sent to the router.
+    //
+    if(_routerInfo || _endpoints.empty())
+    {
+        return vector<EndpointIPtr>();
+    }
+    return filterEndpoints(_endpoints);
+}
+
 void
 IceInternal::RoutableReference::getConnection(const GetConnectionCallbackPtr& callback) const
 {
@@ -1873,6 +1917,7 @@ IceInternal::RoutableReference::RoutableReference(const RoutableReference& r) :
     _cacheConnection(r._cacheConnection),
     _preferSecure(r._preferSecure),
     _endpointSelection(r._endpointSelection),
+    _balanced(r._balanced),
     _locatorCacheTimeout(r._locatorCacheTimeout),
     _overrideTimeout(r._overrideTimeout),
     _timeout(r._timeout),
@@ -241,7 +241,7 @@ public:
     RoutableReference(const InstancePtr&, const Ice::CommunicatorPtr&, const Ice::Identity&, const std::string&, Mode,
                       bool, const Ice::ProtocolVersion&, const Ice::EncodingVersion&, const std::vector<EndpointIPtr>&,
                       const std::string&, const LocatorInfoPtr&, const RouterInfoPtr&, bool, bool, bool,
-                      Ice::EndpointSelectionType, int, int, const Ice::Context&);
+                      Ice::EndpointSelectionType, bool, int, int, const Ice::Context&);
 
     virtual std::vector<EndpointIPtr> getEndpoints() const;
     virtual std::string getAdapterId() const;
@@ -286,6 +286,13 @@ public:
     virtual RequestHandlerPtr getRequestHandler(const Ice::ObjectPrxPtr&) const;
     virtual BatchRequestQueuePtr getBatchRequestQueue() const;
 
+    //
+    // Balanced is an endpoint selection of Ice for C++ only, it's set with the
+    // EndpointSelection proxy property and reset by changeEndpointSelection.
+    //
+    bool getBalanced() const;
+    std::vector<EndpointIPtr> getBalancedEndpoints() const;
+
     void getConnection(const GetConnectionCallbackPtr&) const;
     void getConnectionNoRouterInfo(const GetConnectionCallbackPtr&) const;
 
@@ -311,6 +318,7 @@ private:
     bool _cacheConnection;
     bool _preferSecure;
     Ice::EndpointSelectionType _endpointSelection;
+    bool _balanced;
     int _locatorCacheTimeout;
 
     bool _overrideTimeout;
@@ -750,6 +750,7 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
     bool cacheConnection = true;
     bool preferSecure = defaultsAndOverrides->defaultPreferSecure;
     Ice::EndpointSelectionType endpointSelection = defaultsAndOverrides->defaultEndpointSelection;
+    bool balanced = defaultsAndOverrides->defaultBalanced;
     int locatorCacheTimeout = defaultsAndOverrides->defaultLocatorCacheTimeout;
     int invocationTimeout = defaultsAndOverrides->defaultInvocationTimeout;
     Ice::Context ctx;
@@ -810,6 +811,7 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
         if(!properties->getProperty(property).empty())
         {
             string type = properties->getProperty(property);
+            balanced = false;
             if(type == "Random")
             {
                 endpointSelection = ICE_ENUM(EndpointSelectionType, Random);
@@ -818,10 +820,15 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
             {
                 endpointSelection = ICE_ENUM(EndpointSelectionType, Ordered);
             }
+            else if(type == "Balanced")
+            {
+                endpointSelection = ICE_ENUM(EndpointSelectionType, Random);
+                balanced = true;
+            }
             else
             {
                 throw EndpointSelectionTypeParseException(__FILE__, __LINE__, "illegal value `" + type +
-                                                          "'; expected `Random' or `Ordered'");
+                                                          "'; expected `Random', `Ordered' or `Balanced'");
             }
         }
 
@@ -882,6 +889,7 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
                                  cacheConnection,
                                  preferSecure,
                                  endpointSelection,
+                                 balanced,
                                  locatorCacheTimeout,
                                  invocationTimeout,
                                  ctx);
@@ -5,6 +5,7 @@
 #include <Ice/RegisterPluginsInit.h>
 #include <Ice/CommunicatorF.h>
 #include <Ice/Initialize.h>
+#include <Ice/Network.h> // For ICE_HAS_UNIX_SOCKET
 
 extern "C"
 {
@@ -13,6 +14,13 @@ Ice::Plugin* createStringConverter(const Ice::CommunicatorPtr&, const std::strin
 Ice::Plugin* createIceUDP(const Ice::CommunicatorPtr&, const std::string&, const Ice::StringSeq&);
 Ice::Plugin* createIceTCP(const Ice::CommunicatorPtr&, const std::string&, const Ice::StringSeq&);
 Ice::Plugin* createIceWS(const Ice::CommunicatorPtr&, const std::string&, const Ice::StringSeq&);
+Ice::Plugin* createIceMetricsExporter(const Ice::CommunicatorPtr&, const std::string&, const Ice::StringSeq&);
+#if defined(ICE_HAS_SHM)
+Ice::Plugin* createIceSHM(const Ice::CommunicatorPtr&, const std::string&, const Ice::StringSeq&);
+#endif
+#if defined(ICE_HAS_UNIX_SOCKET)
+Ice::Plugin* createIceUNIX(const Ice::CommunicatorPtr&, const std::string&, const Ice::StringSeq&);
+#endif
 
 }
 
@@ -21,12 +29,23 @@ IceInternal::RegisterPluginsInit::RegisterPluginsInit()
     Ice::registerPluginFactory("IceTCP", createIceTCP, true);
 
     //
-    // Only include the UDP and WS transport plugins with non-static builds or Gem/PyPI/Swift
+    // The metrics exporter is only loaded if Ice.Plugin.IceMetricsExporter is set.
+    //
+    Ice::registerPluginFactory("IceMetricsExporter", createIceMetricsExporter, false);
+
+    //
+    // Only include the UDP, WS, SHM and UNIX transport plugins with non-static builds or Gem/PyPI/Swift
     // builds.
     //
 #if !defined(ICE_STATIC_LIBS) || defined(ICE_GEM) || defined(ICE_PYPI) || defined(ICE_SWIFT)
     Ice::registerPluginFactory("IceUDP", createIceUDP, true);
     Ice::registerPluginFactory("IceWS", createIceWS, true);
+#   if defined(ICE_HAS_SHM)
+    Ice::registerPluginFactory("IceSHM", createIceSHM, true);
+#   endif
+#   if defined(ICE_HAS_UNIX_SOCKET)
+    Ice::registerPluginFactory("IceUNIX", createIceUNIX, true);
+#   endif
 #endif
 
     //
@@ -6,6 +6,7 @@
 #include <Ice/CollocatedRequestHandler.h>
 #include <Ice/ConnectRequestHandler.h>
 #include <Ice/CollocatedRequestHandler.h>
+#include <Ice/BalancedRequestHandler.h>
 #include <Ice/Reference.h>
 #include <Ice/ObjectAdapterFactory.h>
 #include <Ice/Instance.h>
@@ -29,6 +30,19 @@ IceInternal::RequestHandlerFactory::getRequestHandler(const RoutableReferencePtr
         }
     }
 
+    if(ref->getBalanced() && ref->getCacheConnection())
+    {
+        //
+        // Distribute the invocations over connections to several endpoints if the
+        // reference has more than one usable endpoint.
+        //
+        vector<EndpointIPtr> endpoints = ref->getBalancedEndpoints();
+        if(endpoints.size() > 1)
+        {
+            return proxy->_setRequestHandler(ICE_MAKE_SHARED(BalancedRequestHandler, ref, endpoints));
+        }
+    }
+
     ConnectRequestHandlerPtr handler;
     bool connect = false;
     if(ref->getCacheConnection())
@@ -21,6 +21,31 @@ using namespace IceInternal;
 namespace
 {
 struct timespec zeroTimeout = { 0, 0 };
+}
+#elif defined(ICE_USE_EPOLL)
+namespace
+{
+
+uint32_t
+toEpollEvents(const NativeInfoPtr& nativeInfo, SocketOperation status)
+{
+    if(nativeInfo->readabilitySignalsAll())
+    {
+        return status ? static_cast<uint32_t>(EPOLLIN) : 0;
+    }
+
+    uint32_t events = 0;
+    if(status & SocketOperationRead)
+    {
+        events |= EPOLLIN;
+    }
+    if(status & SocketOperationWrite)
+    {
+        events |= EPOLLOUT;
+    }
+    return events;
+}
+
 }
 #endif
 
@@ -368,14 +393,7 @@ Selector::enable(EventHandler* handler, SocketOperation status)
         epoll_event event;
         memset(&event, 0, sizeof(epoll_event));
         event.data.ptr = handler;
-        if(newStatus & SocketOperationRead)
-        {
-            event.events |= EPOLLIN;
-        }
-        if(newStatus & SocketOperationWrite)
-        {
-            event.events |= EPOLLOUT;
-        }
+        event.events = toEpollEvents(nativeInfo, newStatus);
         if(epoll_ctl(_queueFd, previous ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event) != 0)
         {
             Ice::Error out(_instance->initializationData().logger);
@@ -421,14 +439,7 @@ Selector::disable(EventHandler* handler, SocketOperation status)
         epoll_event event;
         memset(&event, 0, sizeof(epoll_event));
         event.data.ptr = handler;
-        if(newStatus & SocketOperationRead)
-        {
-            event.events |= EPOLLIN;
-        }
-        if(newStatus & SocketOperationWrite)
-        {
-            event.events |= EPOLLOUT;
-        }
+        event.events = toEpollEvents(nativeInfo, newStatus);
         if(epoll_ctl(_queueFd, newStatus ? EPOLL_CTL_MOD : EPOLL_CTL_DEL, fd, &event) != 0)
         {
             Ice::Error out(_instance->initializationData().logger);
@@ -599,6 +610,18 @@ Selector::finishSelect(vector<pair<EventHandler*, SocketOperation> >& handlers)
                                                  SocketOperationRead : SocketOperationNone) |
                                                 ((ev.events & (EPOLLOUT | EPOLLERR)) ?
                                                  SocketOperationWrite : SocketOperationNone));
+        if(p.first && (ev.events & EPOLLIN))
+        {
+            //
+            // If the readability of the handler file descriptor signals the readiness of all
+            // the operations, report all the enabled operations.
+            //
+            SocketOperation enabled = static_cast<SocketOperation>(p.first->_registered & ~p.first->_disabled);
+            if(p.second != enabled && p.first->getNativeInfo()->readabilitySignalsAll())
+            {
+                p.second = enabled;
+            }
+        }
 #elif defined(ICE_USE_KQUEUE)
         struct kevent& ev = _events[static_cast<size_t>(i)];
         if(ev.flags & EV_ERROR)
@@ -924,7 +947,8 @@ Selector::updateSelectorForEventHandler(EventHandler* handler,
     SocketOperation previous = handler->_registered;
     previous = static_cast<SocketOperation>(previous & ~add);
     previous = static_cast<SocketOperation>(previous | remove);
-    SOCKET fd = handler->getNativeInfo()->fd();
+    NativeInfoPtr nativeInfo = handler->getNativeInfo();
+    SOCKET fd = nativeInfo->fd();
     assert(fd != INVALID_SOCKET);
     epoll_event event;
     memset(&event, 0, sizeof(epoll_event));
@@ -935,14 +959,7 @@ Selector::updateSelectorForEventHandler(EventHandler* handler,
         status = static_cast<SocketOperation>(status & ~handler->_disabled);
         previous = static_cast<SocketOperation>(previous & ~handler->_disabled);
     }
-    if(status & SocketOperationRead)
-    {
-        event.events |= EPOLLIN;
-    }
-    if(status & SocketOperationWrite)
-    {
-        event.events |= EPOLLOUT;
-    }
+    event.events = toEpollEvents(nativeInfo, status);
     int op;
     if(!previous && status)
     {
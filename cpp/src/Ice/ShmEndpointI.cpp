@@ -0,0 +1,140 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/ShmEndpointI.h>
+
+#if defined(ICE_HAS_SHM)
+
+#include <Ice/ShmTransceiver.h>
+#include <Ice/ProtocolInstance.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+#ifndef ICE_CPP11_MAPPING
+IceUtil::Shared* IceInternal::upCast(ShmEndpointI* p) { return p; }
+#endif
+
+extern "C"
+{
+
+Plugin*
+createIceSHM(const CommunicatorPtr& c, const string&, const StringSeq&)
+{
+    return new EndpointFactoryPlugin(c, new ShmEndpointFactory(new ProtocolInstance(c, SHMEndpointType, "shm", false)));
+}
+
+}
+
+namespace Ice
+{
+
+ICE_API void
+registerIceSHM(bool loadOnInitialize)
+{
+    Ice::registerPluginFactory("IceSHM", createIceSHM, loadOnInitialize);
+}
+
+}
+
+//
+// Objective-C function to allow Objective-C programs to register plugin.
+//
+extern "C" ICE_API void
+ICEregisterIceSHM(bool loadOnInitialize)
+{
+    Ice::registerIceSHM(loadOnInitialize);
+}
+
+IceInternal::ShmEndpointI::ShmEndpointI(const ProtocolInstancePtr& instance, const string& path, Int timeout,
+                                        const string& connectionId, bool compress) :
+    PathEndpointI(instance, path, timeout, connectionId, compress)
+{
+}
+
+IceInternal::ShmEndpointI::ShmEndpointI(const ProtocolInstancePtr& instance) :
+    PathEndpointI(instance)
+{
+}
+
+IceInternal::ShmEndpointI::ShmEndpointI(const ProtocolInstancePtr& instance, InputStream* s) :
+    PathEndpointI(instance, s)
+{
+}
+
+EndpointInfoPtr
+IceInternal::ShmEndpointI::getInfo() const ICE_NOEXCEPT
+{
+    SHMEndpointInfoPtr info = ICE_MAKE_SHARED(InfoI<Ice::SHMEndpointInfo>, ICE_SHARED_FROM_CONST_THIS(ShmEndpointI));
+    info->path = _path;
+    return info;
+}
+
+TransceiverPtr
+IceInternal::ShmEndpointI::createTransceiver(const Address& addr) const
+{
+    return new ShmTransceiver(_instance, addr);
+}
+
+TransceiverPtr
+IceInternal::ShmEndpointI::createTransceiver(SOCKET fd) const
+{
+    return new ShmTransceiver(_instance, fd);
+}
+
+EndpointIPtr
+IceInternal::ShmEndpointI::createEndpoint(const string& path, Int timeout, const string& connectionId,
+                                          bool compress) const
+{
+    return ICE_MAKE_SHARED(ShmEndpointI, _instance, path, timeout, connectionId, compress);
+}
+
+IceInternal::ShmEndpointFactory::ShmEndpointFactory(const ProtocolInstancePtr& instance) : _instance(instance)
+{
+}
+
+IceInternal::ShmEndpointFactory::~ShmEndpointFactory()
+{
+}
+
+Short
+IceInternal::ShmEndpointFactory::type() const
+{
+    return _instance->type();
+}
+
+string
+IceInternal::ShmEndpointFactory::protocol() const
+{
+    return _instance->protocol();
+}
+
+EndpointIPtr
+IceInternal::ShmEndpointFactory::create(vector<string>& args, bool oaEndpoint) const
+{
+    ShmEndpointIPtr endpt = ICE_MAKE_SHARED(ShmEndpointI, _instance);
+    endpt->initWithOptions(args, oaEndpoint);
+    return endpt;
+}
+
+EndpointIPtr
+IceInternal::ShmEndpointFactory::read(InputStream* s) const
+{
+    return ICE_MAKE_SHARED(ShmEndpointI, _instance, s);
+}
+
+void
+IceInternal::ShmEndpointFactory::destroy()
+{
+    _instance = 0;
+}
+
+EndpointFactoryPtr
+IceInternal::ShmEndpointFactory::clone(const ProtocolInstancePtr& instance) const
+{
+    return new ShmEndpointFactory(instance);
+}
+
+#endif
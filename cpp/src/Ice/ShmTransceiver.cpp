@@ -0,0 +1,1016 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/ShmTransceiver.h>
+
+#if defined(ICE_HAS_SHM)
+
+#include <Ice/Connection.h>
+#include <Ice/ProtocolInstance.h>
+#include <Ice/Properties.h>
+#include <Ice/Buffer.h>
+#include <Ice/LocalException.h>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+namespace IceInternal
+{
+
+//
+// The header of a ring, each field is on its own cache line to avoid
+// false sharing between the producer and the consumer.
+//
+struct ShmRingHeader
+{
+    Ice::Long head; // Written by the producer.
+    char pad1[56];
+    Ice::Long tail; // Written by the consumer.
+    char pad2[56];
+    Ice::Int readerWaiting; // Set by the consumer, cleared by the producer.
+    char pad3[60];
+    Ice::Int writerWaiting; // Set by the producer, cleared by the consumer.
+    char pad4[60];
+};
+
+}
+
+namespace
+{
+
+const Ice::Int shmMagic = 0x4963654d; // "IceM"
+const Ice::Int shmVersion = 1;
+
+//
+// The segment starts with the segment header followed by the header of
+// the server to client ring and the header of the client to server ring.
+// The data of the rings starts at the next page.
+//
+struct ShmSegmentHeader
+{
+    Ice::Int magic;
+    Ice::Int version;
+    Ice::Long ringSize[2];
+    char pad[40];
+    ShmRingHeader rings[2];
+};
+
+const size_t shmDataOffset = 4096;
+const size_t shmMinRingSize = 64 * 1024;
+const size_t shmMaxRingSize = 256 * 1024 * 1024;
+const Ice::Int shmDefaultRingSize = 1024 * 1024;
+
+//
+// The message exchanged over the local socket to establish the connection.
+// The client sends the sizes of its receive and send buffers, the server
+// replies with the segment and the doorbells.
+//
+struct ShmHello
+{
+    Ice::Int magic;
+    Ice::Int version;
+    Ice::Int rcvSize;
+    Ice::Int sndSize;
+};
+
+size_t
+getRingSize(Ice::Int requested)
+{
+    size_t size = shmMinRingSize;
+    while(size < static_cast<size_t>(max(requested, 0)) && size < shmMaxRingSize)
+    {
+        size *= 2;
+    }
+    return size;
+}
+
+bool
+isValidRingSize(Ice::Long size)
+{
+    return size >= static_cast<Ice::Long>(shmMinRingSize) && size <= static_cast<Ice::Long>(shmMaxRingSize) &&
+        (size & (size - 1)) == 0;
+}
+
+void
+closeFd(SOCKET& fd)
+{
+    if(fd != INVALID_SOCKET)
+    {
+        ::close(fd);
+        fd = INVALID_SOCKET;
+    }
+}
+
+}
+
+IceUtil::Shared* IceInternal::upCast(ShmTransceiver* p) { return p; }
+
+IceInternal::ShmRing::ShmRing() :
+    _header(0),
+    _data(0),
+    _size(0),
+    _position(0)
+{
+}
+
+void
+IceInternal::ShmRing::init(ShmRingHeader* header, Ice::Byte* data, size_t size)
+{
+    _header = header;
+    _data = data;
+    _size = size;
+    _position = 0;
+}
+
+size_t
+IceInternal::ShmRing::size() const
+{
+    return _size;
+}
+
+size_t
+IceInternal::ShmRing::write(const Ice::Byte* buf, size_t length, bool& notify)
+{
+    size_t n = min(length, space());
+    if(n == 0)
+    {
+        return 0;
+    }
+
+    size_t offset = static_cast<size_t>(_position) & (_size - 1);
+    size_t first = min(n, _size - offset);
+    memcpy(_data + offset, buf, first);
+    memcpy(_data, buf + first, n - first);
+    _position += static_cast<Ice::Long>(n);
+    __atomic_store_n(&_header->head, _position, __ATOMIC_RELEASE);
+
+    //
+    // The fence orders the publication of the head with the load of the
+    // consumer flag, it pairs with the fence of waitForData().
+    //
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&_header->readerWaiting, __ATOMIC_RELAXED))
+    {
+        __atomic_store_n(&_header->readerWaiting, 0, __ATOMIC_RELAXED);
+        notify = true;
+    }
+    return n;
+}
+
+bool
+IceInternal::ShmRing::waitForSpace()
+{
+    __atomic_store_n(&_header->writerWaiting, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if(space() == 0)
+    {
+        return true;
+    }
+    __atomic_store_n(&_header->writerWaiting, 0, __ATOMIC_RELAXED);
+    return false;
+}
+
+size_t
+IceInternal::ShmRing::read(Ice::Byte* buf, size_t length, bool& notify)
+{
+    size_t n = min(length, available());
+    if(n == 0)
+    {
+        return 0;
+    }
+
+    size_t offset = static_cast<size_t>(_position) & (_size - 1);
+    size_t first = min(n, _size - offset);
+    memcpy(buf, _data + offset, first);
+    memcpy(buf + first, _data, n - first);
+    _position += static_cast<Ice::Long>(n);
+    __atomic_store_n(&_header->tail, _position, __ATOMIC_RELEASE);
+
+    //
+    // Pairs with the fence of waitForSpace().
+    //
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if(__atomic_load_n(&_header->writerWaiting, __ATOMIC_RELAXED))
+    {
+        __atomic_store_n(&_header->writerWaiting, 0, __ATOMIC_RELAXED);
+        notify = true;
+    }
+    return n;
+}
+
+bool
+IceInternal::ShmRing::waitForData()
+{
+    __atomic_store_n(&_header->readerWaiting, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if(available() == 0)
+    {
+        return true;
+    }
+    __atomic_store_n(&_header->readerWaiting, 0, __ATOMIC_RELAXED);
+    return false;
+}
+
+bool
+IceInternal::ShmRing::empty() const
+{
+    return available() == 0;
+}
+
+size_t
+IceInternal::ShmRing::available() const
+{
+    Ice::Long n = __atomic_load_n(&_header->head, __ATOMIC_ACQUIRE) - _position;
+    if(n < 0 || n > static_cast<Ice::Long>(_size))
+    {
+        throw ProtocolException(__FILE__, __LINE__, "invalid shared memory ring position");
+    }
+    return static_cast<size_t>(n);
+}
+
+size_t
+IceInternal::ShmRing::space() const
+{
+    Ice::Long n = _position - __atomic_load_n(&_header->tail, __ATOMIC_ACQUIRE);
+    if(n < 0 || n > static_cast<Ice::Long>(_size))
+    {
+        throw ProtocolException(__FILE__, __LINE__, "invalid shared memory ring position");
+    }
+    return _size - static_cast<size_t>(n);
+}
+
+NativeInfoPtr
+IceInternal::ShmTransceiver::getNativeInfo()
+{
+    return this;
+}
+
+SocketOperation
+IceInternal::ShmTransceiver::initialize(Buffer&, Buffer&)
+{
+    if(_state == StateNeedConnect)
+    {
+        //
+        // doConnect closes the socket if the connection fails.
+        //
+        SOCKET fd = _socket;
+        _socket = INVALID_SOCKET;
+        bool connected = doConnect(fd, _addr, Address());
+        _socket = fd;
+        _desc = fdToString(_socket, 0, _addr);
+        if(!connected)
+        {
+            _state = StateConnectPending;
+            return waitFor(SocketOperationConnect);
+        }
+        _state = StateSendHello;
+    }
+    else if(_state == StateConnectPending)
+    {
+        doFinishConnect(_socket);
+        _desc = fdToString(_socket, 0, _addr);
+        _state = StateSendHello;
+    }
+
+    if(_state == StateSendHello)
+    {
+        if(!sendHello())
+        {
+            return waitFor(SocketOperationWrite);
+        }
+        _state = StateReceiveSegment;
+    }
+    else if(_state == StateReceiveHello)
+    {
+        if(!receiveHello())
+        {
+            return waitFor(SocketOperationRead);
+        }
+
+        ShmHello hello;
+        memcpy(&hello, _hello, sizeof(hello));
+        if(hello.magic != shmMagic || hello.version != shmVersion)
+        {
+            throw ProtocolException(__FILE__, __LINE__, "invalid shared memory connection request");
+        }
+        createSegment(getRingSize(max(_sndSize, hello.rcvSize)), getRingSize(max(_rcvSize, hello.sndSize)));
+        _state = StateSendSegment;
+    }
+
+    if(_state == StateSendSegment)
+    {
+        if(!sendSegment())
+        {
+            return waitFor(SocketOperationWrite);
+        }
+        _state = StateConnected;
+    }
+    else if(_state == StateReceiveSegment)
+    {
+        if(!receiveSegment())
+        {
+            return waitFor(SocketOperationRead);
+        }
+        _state = StateConnected;
+    }
+
+    assert(_state == StateConnected);
+
+    //
+    // From now on, the epoll file descriptor is readable when the peer
+    // rings the doorbell or closes the socket.
+    //
+    epoll_event event;
+    memset(&event, 0, sizeof(epoll_event));
+    event.events = EPOLLIN;
+    event.data.fd = _doorbell;
+    if(epoll_ctl(_fd, EPOLL_CTL_ADD, _doorbell, &event) != 0)
+    {
+        throw SocketException(__FILE__, __LINE__, getSocketErrno());
+    }
+    waitFor(SocketOperationRead);
+    return SocketOperationNone;
+}
+
+SocketOperation
+IceInternal::ShmTransceiver::closing(bool initiator, const Ice::LocalException&)
+{
+    // If we are initiating the connection closure, wait for the peer
+    // to close the socket. Otherwise, close immediately.
+    return initiator ? SocketOperationRead : SocketOperationNone;
+}
+
+void
+IceInternal::ShmTransceiver::close()
+{
+    if(_segment)
+    {
+        munmap(_segment, _segmentSize);
+        _segment = 0;
+    }
+    closeFd(_segmentFd);
+    closeFd(_doorbell);
+    closeFd(_peerDoorbell);
+    if(_socket != INVALID_SOCKET)
+    {
+        closeSocketNoThrow(_socket);
+        _socket = INVALID_SOCKET;
+    }
+    closeFd(_fd);
+}
+
+SocketOperation
+IceInternal::ShmTransceiver::write(Buffer& buf)
+{
+    if(buf.i == buf.b.end())
+    {
+        return SocketOperationNone;
+    }
+
+    assert(_state == StateConnected);
+    while(true)
+    {
+        bool notify = false;
+        buf.i += _out.write(&*buf.i, static_cast<size_t>(buf.b.end() - buf.i), notify);
+        if(notify)
+        {
+            ringDoorbell();
+        }
+
+        if(buf.i == buf.b.end())
+        {
+            _writeWaiting = false;
+            setWriteReady(false);
+            return SocketOperationNone;
+        }
+
+        //
+        // The ring is full. The doorbell is shared by both directions, if
+        // draining it consumed a notification for incoming data, make sure
+        // the data is read.
+        //
+        bool rung = drainDoorbell();
+        if(rung && !_in.empty())
+        {
+            setReadReady(true);
+        }
+
+        if(_out.waitForSpace())
+        {
+            if(!rung)
+            {
+                checkSocket();
+            }
+            _writeWaiting = true;
+            setWriteReady(false);
+            return SocketOperationWrite;
+        }
+    }
+}
+
+SocketOperation
+IceInternal::ShmTransceiver::read(Buffer& buf)
+{
+    if(buf.i == buf.b.end())
+    {
+        return SocketOperationNone;
+    }
+
+    assert(_state == StateConnected);
+    while(true)
+    {
+        bool notify = false;
+        buf.i += _in.read(&*buf.i, static_cast<size_t>(buf.b.end() - buf.i), notify);
+        if(notify)
+        {
+            ringDoorbell();
+        }
+
+        if(buf.i == buf.b.end())
+        {
+            //
+            // The peer only rings the doorbell when we wait for data. Wait
+            // for data if the ring is empty, otherwise ask the thread pool
+            // to read again.
+            //
+            setReadReady(!_in.waitForData());
+            return SocketOperationNone;
+        }
+
+        //
+        // The ring is empty. If draining the doorbell consumed a
+        // notification for a pending write, make sure the write is
+        // retried.
+        //
+        bool rung = drainDoorbell();
+        if(rung && _writeWaiting)
+        {
+            setWriteReady(true);
+        }
+
+        if(_in.waitForData())
+        {
+            if(!rung)
+            {
+                checkSocket();
+            }
+            setReadReady(false);
+            return SocketOperationRead;
+        }
+    }
+}
+
+string
+IceInternal::ShmTransceiver::protocol() const
+{
+    return _instance->protocol();
+}
+
+string
+IceInternal::ShmTransceiver::toString() const
+{
+    return _desc;
+}
+
+string
+IceInternal::ShmTransceiver::toDetailedString() const
+{
+    return toString();
+}
+
+Ice::ConnectionInfoPtr
+IceInternal::ShmTransceiver::getInfo() const
+{
+    SHMConnectionInfoPtr info = ICE_MAKE_SHARED(SHMConnectionInfo);
+    info->rcvSize = static_cast<Int>(_in.size());
+    info->sndSize = static_cast<Int>(_out.size());
+    return info;
+}
+
+void
+IceInternal::ShmTransceiver::checkSendSize(const Buffer&)
+{
+}
+
+void
+IceInternal::ShmTransceiver::setBufferSize(int rcvSize, int sndSize)
+{
+    //
+    // The ring sizes are negotiated when the connection is established,
+    // they can't be changed afterwards.
+    //
+    _rcvSize = rcvSize;
+    _sndSize = sndSize;
+}
+
+IceInternal::ShmTransceiver::ShmTransceiver(const ProtocolInstancePtr& instance, const Address& addr) :
+    _instance(instance),
+    _addr(addr),
+    _incoming(false),
+    _state(StateNeedConnect),
+    _desc(addrToString(addr)),
+    _socket(createSocket(false, addr))
+{
+    init();
+}
+
+IceInternal::ShmTransceiver::ShmTransceiver(const ProtocolInstancePtr& instance, SOCKET fd) :
+    _instance(instance),
+    _incoming(true),
+    _state(StateReceiveHello),
+    _socket(fd)
+{
+    init();
+    try
+    {
+        _desc = fdToString(_socket);
+    }
+    catch(const Ice::Exception&)
+    {
+        close();
+        throw;
+    }
+}
+
+IceInternal::ShmTransceiver::~ShmTransceiver()
+{
+    assert(_fd == INVALID_SOCKET);
+}
+
+void
+IceInternal::ShmTransceiver::init()
+{
+    _doorbell = INVALID_SOCKET;
+    _peerDoorbell = INVALID_SOCKET;
+    _segmentFd = INVALID_SOCKET;
+    _segment = 0;
+    _segmentSize = 0;
+    _helloPos = 0;
+    _readReady = false;
+    _writeReady = false;
+    _writeWaiting = false;
+
+    PropertiesPtr properties = _instance->properties();
+    _rcvSize = properties->getPropertyAsIntWithDefault("Ice.SHM.RcvSize", shmDefaultRingSize);
+    _sndSize = properties->getPropertyAsIntWithDefault("Ice.SHM.SndSize", shmDefaultRingSize);
+
+    //
+    // The epoll file descriptor is never writable, the selector waits for
+    // it to be readable for all the operations.
+    //
+    _readabilitySignalsAll = true;
+    try
+    {
+        setBlock(_socket, false);
+
+        _fd = epoll_create1(EPOLL_CLOEXEC);
+        if(_fd == INVALID_SOCKET)
+        {
+            throw SocketException(__FILE__, __LINE__, getSocketErrno());
+        }
+
+        epoll_event event;
+        memset(&event, 0, sizeof(epoll_event));
+        event.events = EPOLLIN;
+        event.data.fd = _socket;
+        if(epoll_ctl(_fd, EPOLL_CTL_ADD, _socket, &event) != 0)
+        {
+            throw SocketException(__FILE__, __LINE__, getSocketErrno());
+        }
+    }
+    catch(const Ice::Exception&)
+    {
+        closeSocketNoThrow(_socket);
+        _socket = INVALID_SOCKET;
+        closeFd(_fd);
+        throw;
+    }
+}
+
+SocketOperation
+IceInternal::ShmTransceiver::waitFor(SocketOperation op)
+{
+    epoll_event event;
+    memset(&event, 0, sizeof(epoll_event));
+    event.events = (op & SocketOperationRead) ? EPOLLIN : EPOLLOUT;
+    event.data.fd = _socket;
+    if(epoll_ctl(_fd, EPOLL_CTL_MOD, _socket, &event) != 0)
+    {
+        throw SocketException(__FILE__, __LINE__, getSocketErrno());
+    }
+    return op;
+}
+
+bool
+IceInternal::ShmTransceiver::sendHello()
+{
+    if(_helloPos == 0)
+    {
+        ShmHello hello;
+        hello.magic = shmMagic;
+        hello.version = shmVersion;
+        hello.rcvSize = _rcvSize;
+        hello.sndSize = _sndSize;
+        memcpy(_hello, &hello, sizeof(hello));
+    }
+
+    while(_helloPos < sizeof(_hello))
+    {
+        ssize_t ret = ::send(_socket, _hello + _helloPos, sizeof(_hello) - _helloPos, MSG_NOSIGNAL);
+        if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+            if(wouldBlock())
+            {
+                return false;
+            }
+            if(connectionLost())
+            {
+                throw ConnectionLostException(__FILE__, __LINE__, getSocketErrno());
+            }
+            throw SocketException(__FILE__, __LINE__, getSocketErrno());
+        }
+        _helloPos += static_cast<size_t>(ret);
+    }
+    return true;
+}
+
+bool
+IceInternal::ShmTransceiver::receiveHello()
+{
+    while(_helloPos < sizeof(_hello))
+    {
+        ssize_t ret = ::recv(_socket, _hello + _helloPos, sizeof(_hello) - _helloPos, 0);
+        if(ret == 0)
+        {
+            throw ConnectionLostException(__FILE__, __LINE__, 0);
+        }
+        else if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+            if(wouldBlock())
+            {
+                return false;
+            }
+            if(connectionLost())
+            {
+                throw ConnectionLostException(__FILE__, __LINE__, getSocketErrno());
+            }
+            throw SocketException(__FILE__, __LINE__, getSocketErrno());
+        }
+        _helloPos += static_cast<size_t>(ret);
+    }
+    return true;
+}
+
+void
+IceInternal::ShmTransceiver::createSegment(size_t serverRingSize, size_t clientRingSize)
+{
+    assert(_incoming);
+
+    _segmentSize = shmDataOffset + serverRingSize + clientRingSize;
+
+    //
+    // The segment is sealed to ensure the client can't shrink it, which
+    // would cause SIGBUS errors when accessing the rings.
+    //
+    _segmentFd = memfd_create("ice-shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if(_segmentFd == INVALID_SOCKET ||
+       ftruncate(_segmentFd, static_cast<off_t>(_segmentSize)) != 0 ||
+       fcntl(_segmentFd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0)
+    {
+        throw SocketException(__FILE__, __LINE__, getSocketErrno());
+    }
+
+    void* segment = mmap(0, _segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, _segmentFd, 0);
+    if(segment == MAP_FAILED)
+    {
+        throw SocketException(__FILE__, __LINE__, getSocketErrno());
+    }
+    _segment = static_cast<Ice::Byte*>(segment);
+
+    ShmSegmentHeader* header = reinterpret_cast<ShmSegmentHeader*>(_segment);
+    header->magic = shmMagic;
+    header->version = shmVersion;
+    header->ringSize[0] = static_cast<Ice::Long>(serverRingSize);
+    header->ringSize[1] = static_cast<Ice::Long>(clientRingSize);
+
+    //
+    // Both sides start out waiting for data, the first message written
+    // to a ring rings the doorbell of its reader.
+    //
+    header->rings[0].readerWaiting = 1;
+    header->rings[1].readerWaiting = 1;
+
+    _out.init(&header->rings[0], _segment + shmDataOffset, serverRingSize);
+    _in.init(&header->rings[1], _segment + shmDataOffset + serverRingSize, clientRingSize);
+
+    _doorbell = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    _peerDoorbell = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(_doorbell == INVALID_SOCKET || _peerDoorbell == INVALID_SOCKET)
+    {
+        throw SocketException(__FILE__, __LINE__, getSocketErrno());
+    }
+}
+
+void
+IceInternal::ShmTransceiver::mapSegment()
+{
+    assert(!_incoming);
+
+    //
+    // Only sealed segments are accepted, the server can't shrink the
+    // segment once it's mapped.
+    //
+    struct stat st;
+    int seals = fcntl(_segmentFd, F_GET_SEALS);
+    if(seals == -1 || (seals & (F_SEAL_SHRINK | F_SEAL_GROW)) != (F_SEAL_SHRINK | F_SEAL_GROW) ||
+       fstat(_segmentFd, &st) != 0 || st.st_size < static_cast<off_t>(shmDataOffset))
+    {
+        throw ProtocolException(__FILE__, __LINE__, "invalid shared memory segment");
+    }
+
+    _segmentSize = static_cast<size_t>(st.st_size);
+    void* segment = mmap(0, _segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, _segmentFd, 0);
+    if(segment == MAP_FAILED)
+    {
+        throw SocketException(__FILE__, __LINE__, getSocketErrno());
+    }
+    _segment = static_cast<Ice::Byte*>(segment);
+
+    const ShmSegmentHeader* header = reinterpret_cast<const ShmSegmentHeader*>(_segment);
+    Ice::Long serverRingSize = header->ringSize[0];
+    Ice::Long clientRingSize = header->ringSize[1];
+    if(header->magic != shmMagic || header->version != shmVersion || !isValidRingSize(serverRingSize) ||
+       !isValidRingSize(clientRingSize) ||
+       static_cast<Ice::Long>(shmDataOffset) + serverRingSize + clientRingSize != static_cast<Ice::Long>(_segmentSize))
+    {
+        throw ProtocolException(__FILE__, __LINE__, "invalid shared memory segment");
+    }
+
+    ShmRingHeader* rings = reinterpret_cast<ShmSegmentHeader*>(_segment)->rings;
+    _in.init(&rings[0], _segment + shmDataOffset, static_cast<size_t>(serverRingSize));
+    _out.init(&rings[1], _segment + shmDataOffset + serverRingSize, static_cast<size_t>(clientRingSize));
+}
+
+bool
+IceInternal::ShmTransceiver::sendSegment()
+{
+    ShmHello hello;
+    memset(&hello, 0, sizeof(hello));
+    hello.magic = shmMagic;
+    hello.version = shmVersion;
+
+    //
+    // Send the segment, the doorbell of the client and our doorbell.
+    //
+    int fds[3] = { _segmentFd, _peerDoorbell, _doorbell };
+    char control[CMSG_SPACE(sizeof(fds))];
+    memset(control, 0, sizeof(control));
+
+    iovec iov;
+    iov.iov_base = &hello;
+    iov.iov_len = sizeof(hello);
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    while(true)
+    {
+        ssize_t ret = ::sendmsg(_socket, &msg, MSG_NOSIGNAL);
+        if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+            if(wouldBlock())
+            {
+                return false;
+            }
+            if(connectionLost())
+            {
+                throw ConnectionLostException(__FILE__, __LINE__, getSocketErrno());
+            }
+            throw SocketException(__FILE__, __LINE__, getSocketErrno());
+        }
+        else if(static_cast<size_t>(ret) != sizeof(hello))
+        {
+            throw SocketException(__FILE__, __LINE__, 0);
+        }
+        break;
+    }
+
+    //
+    // The segment stays mapped, its file descriptor is no longer needed.
+    //
+    closeFd(_segmentFd);
+    return true;
+}
+
+bool
+IceInternal::ShmTransceiver::receiveSegment()
+{
+    ShmHello hello;
+    int fds[3];
+    char control[CMSG_SPACE(sizeof(fds))];
+
+    iovec iov;
+    iov.iov_base = &hello;
+    iov.iov_len = sizeof(hello);
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t ret;
+    while(true)
+    {
+        ret = ::recvmsg(_socket, &msg, MSG_CMSG_CLOEXEC);
+        if(ret == 0)
+        {
+            throw ConnectionLostException(__FILE__, __LINE__, 0);
+        }
+        else if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+            if(wouldBlock())
+            {
+                return false;
+            }
+            if(connectionLost())
+            {
+                throw ConnectionLostException(__FILE__, __LINE__, getSocketErrno());
+            }
+            throw SocketException(__FILE__, __LINE__, getSocketErrno());
+        }
+        break;
+    }
+
+    //
+    // Collect the received file descriptors first to ensure they are
+    // closed if the message is invalid.
+    //
+    vector<int> received;
+    for(cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+        {
+            size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            const Ice::Byte* data = reinterpret_cast<const Ice::Byte*>(CMSG_DATA(cmsg));
+            for(size_t i = 0; i < count; ++i)
+            {
+                int fd;
+                memcpy(&fd, data + i * sizeof(int), sizeof(int));
+                received.push_back(fd);
+            }
+        }
+    }
+
+    if(static_cast<size_t>(ret) != sizeof(hello) || (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) ||
+       received.size() != 3 || hello.magic != shmMagic || hello.version != shmVersion)
+    {
+        for(vector<int>::iterator p = received.begin(); p != received.end(); ++p)
+        {
+            ::close(*p);
+        }
+        throw ProtocolException(__FILE__, __LINE__, "invalid shared memory connection reply");
+    }
+
+    _segmentFd = received[0];
+    _doorbell = received[1];
+    _peerDoorbell = received[2];
+    mapSegment();
+    closeFd(_segmentFd);
+    return true;
+}
+
+bool
+IceInternal::ShmTransceiver::drainDoorbell()
+{
+    while(true)
+    {
+        uint64_t value;
+        ssize_t ret = ::read(_doorbell, &value, sizeof(value));
+        if(ret == static_cast<ssize_t>(sizeof(value)))
+        {
+            return true;
+        }
+        else if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+            if(wouldBlock())
+            {
+                return false;
+            }
+        }
+        throw SocketException(__FILE__, __LINE__, getSocketErrno());
+    }
+}
+
+void
+IceInternal::ShmTransceiver::ringDoorbell()
+{
+    uint64_t value = 1;
+    while(::write(_peerDoorbell, &value, sizeof(value)) == SOCKET_ERROR)
+    {
+        if(interrupted())
+        {
+            continue;
+        }
+        if(wouldBlock())
+        {
+            return; // The counter is saturated, the peer is already notified.
+        }
+        throw SocketException(__FILE__, __LINE__, getSocketErrno());
+    }
+}
+
+void
+IceInternal::ShmTransceiver::checkSocket()
+{
+    //
+    // Nothing is sent over the socket once the connection is established,
+    // the socket is only readable if the peer closed the connection.
+    //
+    while(true)
+    {
+        char c;
+        ssize_t ret = ::recv(_socket, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+        if(ret == 0)
+        {
+            throw ConnectionLostException(__FILE__, __LINE__, 0);
+        }
+        else if(ret > 0)
+        {
+            throw ProtocolException(__FILE__, __LINE__, "unexpected data received on shared memory connection socket");
+        }
+        else if(interrupted())
+        {
+            continue;
+        }
+        else if(wouldBlock())
+        {
+            return;
+        }
+        else if(connectionLost())
+        {
+            throw ConnectionLostException(__FILE__, __LINE__, getSocketErrno());
+        }
+        throw SocketException(__FILE__, __LINE__, getSocketErrno());
+    }
+}
+
+void
+IceInternal::ShmTransceiver::setReadReady(bool value)
+{
+    if(_readReady != value)
+    {
+        _readReady = value;
+        ready(SocketOperationRead, value);
+    }
+}
+
+void
+IceInternal::ShmTransceiver::setWriteReady(bool value)
+{
+    if(_writeReady != value)
+    {
+        _writeReady = value;
+        ready(SocketOperationWrite, value);
+    }
+}
+
+#endif
@@ -0,0 +1,148 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_SHM_TRANSCEIVER_H
+#define ICE_SHM_TRANSCEIVER_H
+
+#include <Ice/ProtocolInstanceF.h>
+#include <Ice/Transceiver.h>
+#include <Ice/Network.h>
+
+#if defined(ICE_HAS_SHM)
+
+namespace IceInternal
+{
+
+class ShmEndpointI;
+struct ShmRingHeader;
+
+//
+// A single producer, single consumer byte ring in the shared memory
+// segment of a connection. The producer and consumer positions are
+// free-running counters, each side only trusts its own position and
+// validates the position published by the peer before using it.
+//
+class ShmRing
+{
+public:
+
+    ShmRing();
+
+    void init(ShmRingHeader*, Ice::Byte*, size_t);
+    size_t size() const;
+
+    //
+    // Producer side. write() sets notify to true if the consumer is
+    // waiting for data and must be notified.
+    //
+    size_t write(const Ice::Byte*, size_t, bool&);
+    bool waitForSpace();
+
+    //
+    // Consumer side. read() sets notify to true if the producer is
+    // waiting for space and must be notified.
+    //
+    size_t read(Ice::Byte*, size_t, bool&);
+    bool waitForData();
+    bool empty() const;
+
+private:
+
+    size_t available() const;
+    size_t space() const;
+
+    ShmRingHeader* _header;
+    Ice::Byte* _data;
+    size_t _size;
+    Ice::Long _position;
+};
+
+class ShmTransceiver : public Transceiver, public NativeInfo
+{
+public:
+
+    virtual NativeInfoPtr getNativeInfo();
+
+    virtual SocketOperation initialize(Buffer&, Buffer&);
+    virtual SocketOperation closing(bool, const Ice::LocalException&);
+    virtual void close();
+    virtual SocketOperation write(Buffer&);
+    virtual SocketOperation read(Buffer&);
+    virtual std::string protocol() const;
+    virtual std::string toString() const;
+    virtual std::string toDetailedString() const;
+    virtual Ice::ConnectionInfoPtr getInfo() const;
+    virtual void checkSendSize(const Buffer&);
+    virtual void setBufferSize(int rcvSize, int sndSize);
+
+private:
+
+    ShmTransceiver(const ProtocolInstancePtr&, const Address&);
+    ShmTransceiver(const ProtocolInstancePtr&, SOCKET);
+    virtual ~ShmTransceiver();
+
+    friend class ShmEndpointI;
+
+    enum State
+    {
+        StateNeedConnect,
+        StateConnectPending,
+        StateSendHello,
+        StateReceiveHello,
+        StateSendSegment,
+        StateReceiveSegment,
+        StateConnected
+    };
+
+    void init();
+    SocketOperation waitFor(SocketOperation);
+    bool sendHello();
+    bool receiveHello();
+    void createSegment(size_t, size_t);
+    void mapSegment();
+    bool sendSegment();
+    bool receiveSegment();
+    bool drainDoorbell();
+    void ringDoorbell();
+    void checkSocket();
+    void setReadReady(bool);
+    void setWriteReady(bool);
+
+    const ProtocolInstancePtr _instance;
+    const Address _addr;
+    const bool _incoming;
+
+    State _state;
+    std::string _desc;
+
+    //
+    // The local socket is only used to exchange the segment and the
+    // doorbells, and to detect the closure of the connection by the peer.
+    // The transceiver file descriptor is an epoll file descriptor which
+    // is readable when the socket or the doorbell is ready.
+    //
+    SOCKET _socket;
+    SOCKET _doorbell;
+    SOCKET _peerDoorbell;
+    SOCKET _segmentFd;
+    Ice::Byte* _segment;
+    size_t _segmentSize;
+
+    int _rcvSize;
+    int _sndSize;
+    Ice::Byte _hello[16];
+    size_t _helloPos;
+
+    ShmRing _in;
+    ShmRing _out;
+    bool _readReady;
+    bool _writeReady;
+    bool _writeWaiting;
+};
+
+}
+
+#endif
+
+#endif
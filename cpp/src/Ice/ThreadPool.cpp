@@ -283,11 +283,13 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
     _sizeMax(0),
     _sizeWarn(0),
     _serialize(_instance->initializationData().properties->getPropertyAsInt(_prefix + ".Serialize") > 0),
+    _messageBatchSize(0),
     _hasPriority(false),
     _priority(0),
     _serverIdleTime(timeout),
     _threadIdleTime(0),
     _stackSize(0),
+    _warnDispatch(_instance->initializationData().properties, "Ice.Warn.Dispatch"),
     _inUse(0),
 #if !defined(ICE_USE_IOCP)
     _inUseIO(0),
@@ -364,11 +366,20 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
         threadIdleTime = 0;
     }
 
+    int messageBatchSize = properties->getPropertyAsIntWithDefault(_prefix + ".MessageBatchSize", 1);
+    if(messageBatchSize < 1)
+    {
+        Warning out(_instance->initializationData().logger);
+        out << _prefix << ".MessageBatchSize < 1; MessageBatchSize adjusted to 1";
+        messageBatchSize = 1;
+    }
+
     const_cast<int&>(_size) = size;
     const_cast<int&>(_sizeMax) = sizeMax;
     const_cast<int&>(_sizeWarn) = sizeWarn;
     const_cast<int&>(_sizeIO) = min(sizeMax, nProcessors);
     const_cast<int&>(_threadIdleTime) = threadIdleTime;
+    const_cast<int&>(_messageBatchSize) = messageBatchSize;
 
 #ifdef ICE_USE_IOCP
     _selector.setup(_sizeIO);
@@ -589,7 +600,7 @@ IceInternal::ThreadPool::dispatchFromThisThread(const DispatchWorkItemPtr& workI
         }
         catch(const std::exception& ex)
         {
-            if(_instance->initializationData().properties->getPropertyAsIntWithDefault("Ice.Warn.Dispatch", 1) > 1)
+            if(_warnDispatch.getAsIntWithDefault(1) > 1)
             {
                 Warning out(_instance->initializationData().logger);
                 out << "dispatch exception:\n" << ex;
@@ -597,7 +608,7 @@ IceInternal::ThreadPool::dispatchFromThisThread(const DispatchWorkItemPtr& workI
         }
         catch(...)
         {
-            if(_instance->initializationData().properties->getPropertyAsIntWithDefault("Ice.Warn.Dispatch", 1) > 1)
+            if(_warnDispatch.getAsIntWithDefault(1) > 1)
             {
                 Warning out(_instance->initializationData().logger);
                 out << "dispatch exception:\nunknown c++ exception";
@@ -646,6 +657,23 @@ IceInternal::ThreadPool::prefix() const
     return _prefix;
 }
 
+ThreadPoolStats
+IceInternal::ThreadPool::getStats()
+{
+    Lock sync(*this);
+    ThreadPoolStats stats;
+    stats.size = _size;
+    stats.sizeMax = _sizeMax;
+    stats.threads = static_cast<int>(_threads.size());
+    stats.inUse = _inUse;
+#if defined(ICE_USE_IOCP)
+    stats.inUseIO = 0;
+#else
+    stats.inUseIO = _inUseIO;
+#endif
+    return stats;
+}
+
 #ifdef ICE_SWIFT
 
 dispatch_queue_t
@@ -16,6 +16,7 @@
 #include <Ice/InstanceF.h>
 #include <Ice/LoggerF.h>
 #include <Ice/PropertiesF.h>
+#include <Ice/PropertyAccessor.h>
 #include <Ice/EventHandler.h>
 #include <Ice/Selector.h>
 #include <Ice/InputStream.h>
@@ -61,6 +62,18 @@ private:
 };
 typedef IceUtil::Handle<DispatchWorkItem> DispatchWorkItemPtr;
 
+//
+// The thread counts of a thread pool, see ThreadPool::getStats.
+//
+struct ThreadPoolStats
+{
+    int size;
+    int sizeMax;
+    int threads;
+    int inUse;
+    int inUseIO;
+};
+
 class ThreadPool : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mutex>
 {
     class EventHandlerThread : public IceUtil::Thread
@@ -110,6 +123,13 @@ public:
 
     std::string prefix() const;
 
+    ThreadPoolStats getStats();
+
+    int messageBatchSize() const
+    {
+        return _messageBatchSize;
+    }
+
 #ifdef ICE_SWIFT
     dispatch_queue_t getDispatchQueue() const ICE_NOEXCEPT;
 #endif
@@ -155,11 +175,13 @@ private:
     const int _sizeMax; // Maximum number of threads.
     const int _sizeWarn; // If _inUse reaches _sizeWarn, a "low on threads" warning will be printed.
     const bool _serialize; // True if requests need to be serialized over the connection.
+    const int _messageBatchSize; // Maximum number of messages a connection reads and dispatches at once.
     const bool _hasPriority;
     const int _priority;
     const int _serverIdleTime;
     const int _threadIdleTime;
     const size_t _stackSize;
+    const Ice::PropertyAccessor _warnDispatch; // Ice.Warn.Dispatch, read when a dispatch raises an exception.
 
     std::set<EventHandlerThreadPtr> _threads; // All threads, running or not.
     int _inUse; // Number of threads that are currently in use.
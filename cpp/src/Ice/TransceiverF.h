@@ -24,6 +24,14 @@ class UdpTransceiver;
 ICE_API IceUtil::Shared* upCast(UdpTransceiver*);
 typedef Handle<UdpTransceiver> UdpTransceiverPtr;
 
+class ShmTransceiver;
+ICE_API IceUtil::Shared* upCast(ShmTransceiver*);
+typedef Handle<ShmTransceiver> ShmTransceiverPtr;
+
+class UnixTransceiver;
+ICE_API IceUtil::Shared* upCast(UnixTransceiver*);
+typedef Handle<UnixTransceiver> UnixTransceiverPtr;
+
 class WSTransceiver;
 ICE_API IceUtil::Shared* upCast(WSTransceiver*);
 typedef Handle<WSTransceiver> WSTransceiverPtr;
@@ -0,0 +1,141 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/UnixEndpointI.h>
+
+#if defined(ICE_HAS_UNIX_SOCKET)
+
+#include <Ice/UnixTransceiver.h>
+#include <Ice/ProtocolInstance.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+#ifndef ICE_CPP11_MAPPING
+IceUtil::Shared* IceInternal::upCast(UnixEndpointI* p) { return p; }
+#endif
+
+extern "C"
+{
+
+Plugin*
+createIceUNIX(const CommunicatorPtr& c, const string&, const StringSeq&)
+{
+    ProtocolInstancePtr instance = new ProtocolInstance(c, UNIXEndpointType, "unix", false);
+    return new EndpointFactoryPlugin(c, new UnixEndpointFactory(instance));
+}
+
+}
+
+namespace Ice
+{
+
+ICE_API void
+registerIceUNIX(bool loadOnInitialize)
+{
+    Ice::registerPluginFactory("IceUNIX", createIceUNIX, loadOnInitialize);
+}
+
+}
+
+//
+// Objective-C function to allow Objective-C programs to register plugin.
+//
+extern "C" ICE_API void
+ICEregisterIceUNIX(bool loadOnInitialize)
+{
+    Ice::registerIceUNIX(loadOnInitialize);
+}
+
+IceInternal::UnixEndpointI::UnixEndpointI(const ProtocolInstancePtr& instance, const string& path, Int timeout,
+                                          const string& connectionId, bool compress) :
+    PathEndpointI(instance, path, timeout, connectionId, compress)
+{
+}
+
+IceInternal::UnixEndpointI::UnixEndpointI(const ProtocolInstancePtr& instance) :
+    PathEndpointI(instance)
+{
+}
+
+IceInternal::UnixEndpointI::UnixEndpointI(const ProtocolInstancePtr& instance, InputStream* s) :
+    PathEndpointI(instance, s)
+{
+}
+
+EndpointInfoPtr
+IceInternal::UnixEndpointI::getInfo() const ICE_NOEXCEPT
+{
+    UNIXEndpointInfoPtr info = ICE_MAKE_SHARED(InfoI<Ice::UNIXEndpointInfo>, ICE_SHARED_FROM_CONST_THIS(UnixEndpointI));
+    info->path = _path;
+    return info;
+}
+
+TransceiverPtr
+IceInternal::UnixEndpointI::createTransceiver(const Address& addr) const
+{
+    return new UnixTransceiver(_instance, new StreamSocket(_instance, 0, addr, Address()));
+}
+
+TransceiverPtr
+IceInternal::UnixEndpointI::createTransceiver(SOCKET fd) const
+{
+    return new UnixTransceiver(_instance, new StreamSocket(_instance, fd));
+}
+
+EndpointIPtr
+IceInternal::UnixEndpointI::createEndpoint(const string& path, Int timeout, const string& connectionId,
+                                           bool compress) const
+{
+    return ICE_MAKE_SHARED(UnixEndpointI, _instance, path, timeout, connectionId, compress);
+}
+
+IceInternal::UnixEndpointFactory::UnixEndpointFactory(const ProtocolInstancePtr& instance) : _instance(instance)
+{
+}
+
+IceInternal::UnixEndpointFactory::~UnixEndpointFactory()
+{
+}
+
+Short
+IceInternal::UnixEndpointFactory::type() const
+{
+    return _instance->type();
+}
+
+string
+IceInternal::UnixEndpointFactory::protocol() const
+{
+    return _instance->protocol();
+}
+
+EndpointIPtr
+IceInternal::UnixEndpointFactory::create(vector<string>& args, bool oaEndpoint) const
+{
+    UnixEndpointIPtr endpt = ICE_MAKE_SHARED(UnixEndpointI, _instance);
+    endpt->initWithOptions(args, oaEndpoint);
+    return endpt;
+}
+
+EndpointIPtr
+IceInternal::UnixEndpointFactory::read(InputStream* s) const
+{
+    return ICE_MAKE_SHARED(UnixEndpointI, _instance, s);
+}
+
+void
+IceInternal::UnixEndpointFactory::destroy()
+{
+    _instance = 0;
+}
+
+EndpointFactoryPtr
+IceInternal::UnixEndpointFactory::clone(const ProtocolInstancePtr& instance) const
+{
+    return new UnixEndpointFactory(instance);
+}
+
+#endif
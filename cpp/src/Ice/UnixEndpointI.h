@@ -0,0 +1,60 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_UNIX_ENDPOINT_I_H
+#define ICE_UNIX_ENDPOINT_I_H
+
+#include <Ice/PathEndpointI.h>
+#include <Ice/EndpointFactory.h>
+#include <Ice/ProtocolInstanceF.h>
+#include <Ice/Network.h> // For ICE_HAS_UNIX_SOCKET
+
+#if defined(ICE_HAS_UNIX_SOCKET)
+
+namespace IceInternal
+{
+
+class UnixEndpointI : public PathEndpointI
+{
+public:
+
+    UnixEndpointI(const ProtocolInstancePtr&, const std::string&, Ice::Int, const std::string&, bool);
+    UnixEndpointI(const ProtocolInstancePtr&);
+    UnixEndpointI(const ProtocolInstancePtr&, Ice::InputStream*);
+
+    virtual Ice::EndpointInfoPtr getInfo() const ICE_NOEXCEPT;
+
+    virtual TransceiverPtr createTransceiver(const Address&) const;
+    virtual TransceiverPtr createTransceiver(SOCKET) const;
+
+protected:
+
+    virtual EndpointIPtr createEndpoint(const std::string&, Ice::Int, const std::string&, bool) const;
+};
+
+class UnixEndpointFactory : public EndpointFactory
+{
+public:
+
+    UnixEndpointFactory(const ProtocolInstancePtr&);
+    virtual ~UnixEndpointFactory();
+
+    virtual Ice::Short type() const;
+    virtual std::string protocol() const;
+    virtual EndpointIPtr create(std::vector<std::string>&, bool) const;
+    virtual EndpointIPtr read(Ice::InputStream*) const;
+    virtual void destroy();
+
+    virtual EndpointFactoryPtr clone(const ProtocolInstancePtr&) const;
+
+private:
+
+    ProtocolInstancePtr _instance;
+};
+
+}
+
+#endif
+
+#endif
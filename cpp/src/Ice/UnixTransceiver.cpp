@@ -0,0 +1,403 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/UnixTransceiver.h>
+
+#if defined(ICE_HAS_UNIX_SOCKET)
+
+#include <Ice/FileDescriptors.h>
+#include <Ice/ConnectionI.h>
+#include <Ice/Connection.h>
+#include <Ice/ProtocolInstance.h>
+#include <Ice/Buffer.h>
+#include <Ice/LocalException.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+namespace
+{
+
+//
+// The maximum number of descriptors sent with a single sendmsg() call
+// and the maximum number of received descriptors queued by a connection
+// until the application takes them.
+//
+const size_t maxFdsPerMessage = 64;
+const size_t maxReceivedFds = 1024;
+
+void
+closeFds(deque<int>& fds)
+{
+    for(deque<int>::const_iterator p = fds.begin(); p != fds.end(); ++p)
+    {
+        ::close(*p);
+    }
+    fds.clear();
+}
+
+UnixTransceiverPtr
+getUnixTransceiver(const ConnectionPtr& connection)
+{
+    ConnectionIPtr connectionI = ICE_DYNAMIC_CAST(ConnectionI, connection);
+    UnixTransceiver* transceiver = 0;
+    if(connectionI)
+    {
+        transceiver = dynamic_cast<UnixTransceiver*>(connectionI->transceiver().get());
+    }
+    if(!transceiver)
+    {
+        throw FeatureNotSupportedException(__FILE__, __LINE__, "file descriptor passing requires a unix connection");
+    }
+    return transceiver;
+}
+
+}
+
+IceUtil::Shared* IceInternal::upCast(UnixTransceiver* p) { return p; }
+
+void
+Ice::sendFileDescriptors(const ConnectionPtr& connection, const vector<int>& fds)
+{
+    getUnixTransceiver(connection)->sendFileDescriptors(fds);
+}
+
+vector<int>
+Ice::takeFileDescriptors(const ConnectionPtr& connection, size_t max)
+{
+    return getUnixTransceiver(connection)->takeFileDescriptors(max);
+}
+
+NativeInfoPtr
+IceInternal::UnixTransceiver::getNativeInfo()
+{
+    return _stream;
+}
+
+SocketOperation
+IceInternal::UnixTransceiver::initialize(Buffer& readBuffer, Buffer& writeBuffer)
+{
+    return _stream->connect(readBuffer, writeBuffer);
+}
+
+SocketOperation
+IceInternal::UnixTransceiver::closing(bool initiator, const Ice::LocalException&)
+{
+    // If we are initiating the connection closure, wait for the peer
+    // to close the connection. Otherwise, close immediately.
+    return initiator ? SocketOperationRead : SocketOperationNone;
+}
+
+void
+IceInternal::UnixTransceiver::close()
+{
+    _stream->close();
+
+    IceUtil::Mutex::Lock sync(_mutex);
+    _closed = true;
+    closeFds(_sendFds);
+    closeFds(_receivedFds);
+}
+
+SocketOperation
+IceInternal::UnixTransceiver::write(Buffer& buf)
+{
+    if(buf.i != buf.b.end())
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        while(!_sendFds.empty() && buf.i != buf.b.end())
+        {
+            if(!writeWithFileDescriptors(buf))
+            {
+                return SocketOperationWrite;
+            }
+        }
+    }
+    return _stream->write(buf);
+}
+
+SocketOperation
+IceInternal::UnixTransceiver::read(Buffer& buf)
+{
+    //
+    // Always read with recvmsg(): descriptors sent with bytes read with
+    // recv() would be discarded.
+    //
+    while(buf.i != buf.b.end())
+    {
+        ssize_t ret = readWithFileDescriptors(&*buf.i, static_cast<size_t>(buf.b.end() - buf.i));
+        if(ret == 0)
+        {
+            return SocketOperationRead;
+        }
+        buf.i += ret;
+    }
+    return SocketOperationNone;
+}
+
+string
+IceInternal::UnixTransceiver::protocol() const
+{
+    return _instance->protocol();
+}
+
+string
+IceInternal::UnixTransceiver::toString() const
+{
+    return _stream->toString();
+}
+
+string
+IceInternal::UnixTransceiver::toDetailedString() const
+{
+    return toString();
+}
+
+Ice::ConnectionInfoPtr
+IceInternal::UnixTransceiver::getInfo() const
+{
+    UNIXConnectionInfoPtr info = ICE_MAKE_SHARED(UNIXConnectionInfo);
+    SOCKET fd = _stream->fd();
+    if(fd != INVALID_SOCKET)
+    {
+        //
+        // The client socket is unnamed, the path is the local address of
+        // incoming connections and the remote address of outgoing ones.
+        //
+        Address addr;
+        fdToLocalAddress(fd, addr);
+        info->path = inetAddrToString(addr);
+        if(info->path.empty() && fdToRemoteAddress(fd, addr))
+        {
+            info->path = inetAddrToString(addr);
+        }
+        info->rcvSize = getRecvBufferSize(fd);
+        info->sndSize = getSendBufferSize(fd);
+    }
+    return info;
+}
+
+void
+IceInternal::UnixTransceiver::checkSendSize(const Buffer&)
+{
+}
+
+void
+IceInternal::UnixTransceiver::setBufferSize(int rcvSize, int sndSize)
+{
+    _stream->setBufferSize(rcvSize, sndSize);
+}
+
+void
+IceInternal::UnixTransceiver::sendFileDescriptors(const vector<int>& fds)
+{
+    //
+    // Duplicate all the descriptors before queuing them, so that none
+    // is queued if one of them is invalid.
+    //
+    deque<int> dups;
+    for(vector<int>::const_iterator p = fds.begin(); p != fds.end(); ++p)
+    {
+#ifdef F_DUPFD_CLOEXEC
+        int fd = fcntl(*p, F_DUPFD_CLOEXEC, 0);
+#else
+        int fd = dup(*p);
+#endif
+        if(fd < 0)
+        {
+            SocketException ex(__FILE__, __LINE__, getSocketErrno());
+            closeFds(dups);
+            throw ex;
+        }
+        dups.push_back(fd);
+    }
+
+    IceUtil::Mutex::Lock sync(_mutex);
+    if(_closed)
+    {
+        closeFds(dups);
+        throw ConnectionLostException(__FILE__, __LINE__, 0);
+    }
+    _sendFds.insert(_sendFds.end(), dups.begin(), dups.end());
+}
+
+vector<int>
+IceInternal::UnixTransceiver::takeFileDescriptors(size_t max)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    size_t count = min(max, _receivedFds.size());
+    vector<int> fds(_receivedFds.begin(), _receivedFds.begin() + static_cast<ptrdiff_t>(count));
+    _receivedFds.erase(_receivedFds.begin(), _receivedFds.begin() + static_cast<ptrdiff_t>(count));
+    return fds;
+}
+
+IceInternal::UnixTransceiver::UnixTransceiver(const ProtocolInstancePtr& instance, const StreamSocketPtr& stream) :
+    _instance(instance),
+    _stream(stream),
+    _closed(false)
+{
+}
+
+IceInternal::UnixTransceiver::~UnixTransceiver()
+{
+    assert(_sendFds.empty() && _receivedFds.empty());
+}
+
+bool
+IceInternal::UnixTransceiver::writeWithFileDescriptors(Buffer& buf)
+{
+    //
+    // The descriptors are attached to the first byte written by sendmsg()
+    // and are received with it. If more descriptors remain after this
+    // batch, only one byte is written so that the remaining batches are
+    // still sent with this message. Returns false if the socket isn't
+    // ready.
+    //
+    size_t count = min(_sendFds.size(), maxFdsPerMessage);
+    char control[CMSG_SPACE(sizeof(int) * maxFdsPerMessage)];
+    memset(control, 0, sizeof(control));
+
+    iovec iov;
+    iov.iov_base = &*buf.i;
+    iov.iov_len = _sendFds.size() > count ? 1 : static_cast<size_t>(buf.b.end() - buf.i);
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = CMSG_SPACE(sizeof(int) * count);
+
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * count);
+    Ice::Byte* data = reinterpret_cast<Ice::Byte*>(CMSG_DATA(cmsg));
+    for(size_t i = 0; i < count; ++i)
+    {
+        memcpy(data + i * sizeof(int), &_sendFds[i], sizeof(int));
+    }
+
+    while(true)
+    {
+        ssize_t ret = ::sendmsg(_stream->fd(), &msg, 0);
+        if(ret == 0)
+        {
+            throw Ice::ConnectionLostException(__FILE__, __LINE__, 0);
+        }
+        else if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+            if(wouldBlock())
+            {
+                return false;
+            }
+            if(connectionLost())
+            {
+                throw Ice::ConnectionLostException(__FILE__, __LINE__, getSocketErrno());
+            }
+            throw Ice::SocketException(__FILE__, __LINE__, getSocketErrno());
+        }
+
+        //
+        // The peer has its own copy of the descriptors now.
+        //
+        for(size_t i = 0; i < count; ++i)
+        {
+            ::close(_sendFds.front());
+            _sendFds.pop_front();
+        }
+        buf.i += ret;
+        return true;
+    }
+}
+
+ssize_t
+IceInternal::UnixTransceiver::readWithFileDescriptors(Ice::Byte* buf, size_t length)
+{
+    char control[CMSG_SPACE(sizeof(int) * maxFdsPerMessage)];
+
+    iovec iov;
+    iov.iov_base = buf;
+    iov.iov_len = length;
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+#ifdef MSG_CMSG_CLOEXEC
+    const int flags = MSG_CMSG_CLOEXEC;
+#else
+    const int flags = 0;
+#endif
+
+    ssize_t ret;
+    while(true)
+    {
+        ret = ::recvmsg(_stream->fd(), &msg, flags);
+        if(ret == 0)
+        {
+            throw Ice::ConnectionLostException(__FILE__, __LINE__, 0);
+        }
+        else if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+            if(wouldBlock())
+            {
+                return 0;
+            }
+            if(connectionLost())
+            {
+                throw Ice::ConnectionLostException(__FILE__, __LINE__, getSocketErrno());
+            }
+            throw Ice::SocketException(__FILE__, __LINE__, getSocketErrno());
+        }
+        break;
+    }
+
+    if(msg.msg_controllen > 0)
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        for(cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+            {
+                size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+                const Ice::Byte* data = reinterpret_cast<const Ice::Byte*>(CMSG_DATA(cmsg));
+                for(size_t i = 0; i < count; ++i)
+                {
+                    int fd;
+                    memcpy(&fd, data + i * sizeof(int), sizeof(int));
+                    _receivedFds.push_back(fd);
+                }
+            }
+        }
+
+        //
+        // The kernel discards the descriptors which don't fit in the
+        // control buffer, an Ice peer never sends that many.
+        //
+        if(msg.msg_flags & MSG_CTRUNC)
+        {
+            throw ProtocolException(__FILE__, __LINE__, "too many file descriptors received");
+        }
+        else if(_receivedFds.size() > maxReceivedFds)
+        {
+            throw ProtocolException(__FILE__, __LINE__, "too many file descriptors received and not taken");
+        }
+    }
+    return ret;
+}
+
+#endif
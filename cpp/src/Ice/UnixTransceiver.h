@@ -0,0 +1,72 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_UNIX_TRANSCEIVER_H
+#define ICE_UNIX_TRANSCEIVER_H
+
+#include <IceUtil/Mutex.h>
+#include <Ice/ProtocolInstanceF.h>
+#include <Ice/Transceiver.h>
+#include <Ice/Network.h>
+#include <Ice/StreamSocket.h>
+
+#if defined(ICE_HAS_UNIX_SOCKET)
+
+#include <deque>
+
+namespace IceInternal
+{
+
+class UnixEndpointI;
+
+class UnixTransceiver : public Transceiver
+{
+public:
+
+    virtual NativeInfoPtr getNativeInfo();
+
+    virtual SocketOperation initialize(Buffer&, Buffer&);
+    virtual SocketOperation closing(bool, const Ice::LocalException&);
+    virtual void close();
+    virtual SocketOperation write(Buffer&);
+    virtual SocketOperation read(Buffer&);
+    virtual std::string protocol() const;
+    virtual std::string toString() const;
+    virtual std::string toDetailedString() const;
+    virtual Ice::ConnectionInfoPtr getInfo() const;
+    virtual void checkSendSize(const Buffer&);
+    virtual void setBufferSize(int rcvSize, int sndSize);
+
+    void sendFileDescriptors(const std::vector<int>&);
+    std::vector<int> takeFileDescriptors(size_t);
+
+private:
+
+    UnixTransceiver(const ProtocolInstancePtr&, const StreamSocketPtr&);
+    virtual ~UnixTransceiver();
+
+    friend class UnixEndpointI;
+
+    bool writeWithFileDescriptors(Buffer&);
+    ssize_t readWithFileDescriptors(Ice::Byte*, size_t);
+
+    const ProtocolInstancePtr _instance;
+    const StreamSocketPtr _stream;
+
+    //
+    // The descriptors queued by sendFileDescriptors() and not sent yet,
+    // and the descriptors received and not taken yet. The mutex protects
+    // these queues, which are accessed by application threads.
+    //
+    IceUtil::Mutex _mutex;
+    bool _closed;
+    std::deque<int> _sendFds;
+    std::deque<int> _receivedFds;
+};
+
+}
+
+#endif
+
+#endif
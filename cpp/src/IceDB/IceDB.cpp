@@ -139,7 +139,12 @@ BadEnvException::ice_throw() const
     throw *this;
 }
 
-Env::Env(const string& path, MDB_dbi maxDbs, size_t mapSize, unsigned int maxReaders)
+Env::Env(const string& path, MDB_dbi maxDbs, size_t mapSize, unsigned int maxReaders) :
+    _groupCommit(false),
+    _committed(0),
+    _synced(0),
+    _syncing(false),
+    _flushNow(false)
 {
     int rc = mdb_env_create(&_menv);
     if(rc != MDB_SUCCESS)
@@ -223,6 +228,94 @@ Env::menv() const
     return _menv;
 }
 
+void
+Env::enableGroupCommit(int window)
+{
+    //
+    // With MDB_NOSYNC, commits don't flush the environment. LMDB keeps the database
+    // consistent if the file system preserves the write order, a system crash can
+    // only undo the transactions which weren't flushed yet. ReadWriteTxn::commit and
+    // DeferredSync::wait call sync to wait for the flush before acknowledging them.
+    //
+    const int rc = mdb_env_set_flags(_menv, MDB_NOSYNC, 1);
+    if(rc != MDB_SUCCESS)
+    {
+        throw LMDBException(__FILE__, __LINE__, rc);
+    }
+    _groupCommit = true;
+    _groupCommitWindow = IceUtil::Time::milliSeconds(window > 0 ? window : 0);
+}
+
+void
+Env::sync(IceUtil::Int64 commit, bool delay) const
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(_syncMonitor);
+    while(_synced < commit)
+    {
+        if(_syncing)
+        {
+            //
+            // Another thread is flushing the environment, the flush might not cover
+            // our commit if it started before it. Check again once it completes. If
+            // the caller can't wait for the group commit window, end it now.
+            //
+            if(!delay && !_flushNow)
+            {
+                _flushNow = true;
+                _syncMonitor.notifyAll();
+            }
+            _syncMonitor.wait();
+            continue;
+        }
+
+        //
+        // Flush the environment on behalf of all the commits done so far, including the
+        // commits done while this thread waits for the group commit window.
+        //
+        _syncing = true;
+        _flushNow = !delay;
+        if(_groupCommitWindow > IceUtil::Time())
+        {
+            const IceUtil::Time end = IceUtil::Time::now(IceUtil::Time::Monotonic) + _groupCommitWindow;
+            while(!_flushNow)
+            {
+                const IceUtil::Time timeout = end - IceUtil::Time::now(IceUtil::Time::Monotonic);
+                if(timeout <= IceUtil::Time())
+                {
+                    break;
+                }
+                _syncMonitor.timedWait(timeout);
+            }
+        }
+        _flushNow = false;
+        const IceUtil::Int64 committed = _committed;
+
+        lock.release();
+        const int rc = mdb_env_sync(_menv, 1);
+        lock.acquire();
+
+        _syncing = false;
+        _syncMonitor.notifyAll();
+        if(rc != MDB_SUCCESS)
+        {
+            throw LMDBException(__FILE__, __LINE__, rc);
+        }
+        _synced = committed;
+    }
+}
+
+IceUtil::Int64
+Env::committed() const
+{
+    if(!_groupCommit)
+    {
+        return 0; // The commit is already flushed.
+    }
+
+    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(_syncMonitor);
+    return ++_committed;
+}
+
 Txn::Txn(const Env& env, unsigned int flags)
 {
     const int rc = mdb_txn_begin(env.menv(), 0, flags, &_mtxn);
@@ -296,10 +389,41 @@ ReadWriteTxn::~ReadWriteTxn()
 }
 
 ReadWriteTxn::ReadWriteTxn(const Env& env) :
-    Txn(env, 0)
+    Txn(env, 0),
+    _env(env)
 {
 }
 
+void
+ReadWriteTxn::commit()
+{
+    Txn::commit();
+    _env.sync(_env.committed(), false);
+}
+
+void
+ReadWriteTxn::commit(DeferredSync& deferredSync)
+{
+    Txn::commit();
+    deferredSync._commit = _env.committed();
+}
+
+DeferredSync::DeferredSync(const Env& env) :
+    _env(env),
+    _commit(0)
+{
+}
+
+void
+DeferredSync::wait()
+{
+    if(_commit > 0)
+    {
+        _env.sync(_commit);
+        _commit = 0;
+    }
+}
+
 DbiBase::DbiBase(const Txn& txn, const std::string& name, unsigned int flags, MDB_cmp_func* cmp)
 {
     int rc = mdb_dbi_open(txn.mtxn(), name.c_str(), flags, &_mdbi);
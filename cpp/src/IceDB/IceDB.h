@@ -7,6 +7,9 @@
 
 #include <IceUtil/Exception.h>
 #include <IceUtil/FileUtil.h>
+#include <IceUtil/Monitor.h>
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Time.h>
 #include <Ice/Initialize.h>
 #include <Ice/OutputStream.h>
 #include <Ice/InputStream.h>
@@ -142,6 +145,8 @@ private:
 template<typename T, typename C, typename H>
 struct Codec;
 
+class DeferredSync;
+
 class ICE_DB_API Env
 {
 public:
@@ -153,13 +158,40 @@ public:
 
     MDB_env* menv() const;
 
+    //
+    // Enables group commit: the commit of a read-write transaction no longer
+    // flushes the environment, instead the threads which concurrently commit
+    // transactions share a single flush. The flush is delayed by the given
+    // window (in milliseconds) to let more commits join it.
+    //
+    void enableGroupCommit(int);
+
+    //
+    // Waits for the given commit to be flushed to disk. If delay is false, the
+    // flush doesn't wait for the group commit window, callers which hold locks
+    // don't sleep through it.
+    //
+    void sync(IceUtil::Int64, bool = true) const;
+
 private:
 
     // Not implemented: class is not copyable
     Env(const Env&);
     void operator=(const Env&);
 
+    friend class ReadWriteTxn;
+
+    IceUtil::Int64 committed() const;
+
     MDB_env* _menv;
+
+    bool _groupCommit;
+    IceUtil::Time _groupCommitWindow;
+    mutable IceUtil::Monitor<IceUtil::Mutex> _syncMonitor;
+    mutable IceUtil::Int64 _committed; // Number of commits waiting for or covered by a flush.
+    mutable IceUtil::Int64 _synced; // Number of commits covered by the last flush.
+    mutable bool _syncing;
+    mutable bool _flushNow; // Ends the group commit window of the flush in progress.
 };
 
 class ICE_DB_API Txn
@@ -168,7 +200,7 @@ public:
 
     virtual ~Txn();
 
-    void commit();
+    virtual void commit();
     void rollback();
 
     MDB_txn* mtxn() const;
@@ -205,6 +237,45 @@ public:
     virtual ~ReadWriteTxn();
 
     explicit ReadWriteTxn(const Env&);
+
+    //
+    // With group commit, commit() waits for the transaction to be flushed to
+    // disk, without waiting for the group commit window. commit(DeferredSync&)
+    // doesn't wait, the caller must call wait() on the DeferredSync before
+    // publishing or acknowledging the transaction.
+    //
+    virtual void commit();
+    void commit(DeferredSync&);
+
+private:
+
+    const Env& _env;
+};
+
+//
+// Defers the wait for the flush of transactions committed with group commit.
+// Callers wait for the flush before publishing the update, without holding the
+// locks needed by other writers, so that other threads can commit and join the
+// same flush in the meantime.
+//
+class ICE_DB_API DeferredSync
+{
+public:
+
+    explicit DeferredSync(const Env&);
+
+    void wait();
+
+private:
+
+    friend class ReadWriteTxn;
+
+    // Not implemented: class is not copyable
+    DeferredSync(const DeferredSync&);
+    void operator=(const DeferredSync&);
+
+    const Env& _env;
+    IceUtil::Int64 _commit;
 };
 
 class ICE_DB_API DbiBase
@@ -75,17 +75,113 @@ private:
     ObjectRequestPtr _request;
 };
 
+class AdapterBatchCallbackI : public IceUtil::Shared
+{
+public:
+
+    AdapterBatchCallbackI(const LookupIPtr& lookup, const vector<AdapterRequestPtr>& requests) :
+        _lookup(lookup), _requests(requests)
+    {
+    }
+
+    void
+    completed(const Ice::AsyncResultPtr& result)
+    {
+        try
+        {
+            result->throwLocalException();
+        }
+        catch(const Ice::LocalException& ex)
+        {
+            for(vector<AdapterRequestPtr>::const_iterator p = _requests.begin(); p != _requests.end(); ++p)
+            {
+                _lookup->adapterRequestException(*p, ex);
+            }
+        }
+    }
+
+private:
+
+    LookupIPtr _lookup;
+    const vector<AdapterRequestPtr> _requests;
+};
+
+class ObjectBatchCallbackI : public IceUtil::Shared
+{
+public:
+
+    ObjectBatchCallbackI(const LookupIPtr& lookup, const vector<ObjectRequestPtr>& requests) :
+        _lookup(lookup), _requests(requests)
+    {
+    }
+
+    void
+    completed(const Ice::AsyncResultPtr& result)
+    {
+        try
+        {
+            result->throwLocalException();
+        }
+        catch(const Ice::LocalException& ex)
+        {
+            for(vector<ObjectRequestPtr>::const_iterator p = _requests.begin(); p != _requests.end(); ++p)
+            {
+                _lookup->objectRequestException(*p, ex);
+            }
+        }
+    }
+
+private:
+
+    LookupIPtr _lookup;
+    const vector<ObjectRequestPtr> _requests;
+};
+
 }
 #endif
 
+namespace
+{
+
+class FlushTask : public IceUtil::TimerTask
+{
+public:
+
+    FlushTask(const LookupIPtr& lookup) : _lookup(lookup)
+    {
+    }
+
+    virtual void
+    runTimerTask()
+    {
+        _lookup->flush();
+    }
+
+private:
+
+    const LookupIPtr _lookup;
+};
+
+}
+
 IceDiscovery::Request::Request(const LookupIPtr& lookup, int retryCount) :
-    _lookup(lookup), _requestId(Ice::generateUUID()), _retryCount(retryCount), _lookupCount(0), _failureCount(0)
+    _lookup(lookup), _requestId(Ice::generateUUID()), _retryCount(retryCount), _lookupCount(0), _failureCount(0),
+    _batched(false)
 {
 }
 
 bool
 IceDiscovery::Request::retry()
 {
+    //
+    // Peers which don't support batched lookups ignore them, the first retry of a
+    // request sent with a batched lookup doesn't count against the retry count.
+    //
+    if(_batched)
+    {
+        _batched = false;
+        return true;
+    }
     return --_retryCount >= 0;
 }
 
@@ -102,6 +198,19 @@ IceDiscovery::Request::invoke(const string& domainId, const vector<pair<LookupPr
     }
 }
 
+void
+IceDiscovery::Request::invoked(const string& requestId, size_t lookupCount)
+{
+    //
+    // The request was sent with a batched lookup, the replies are sent to the batch
+    // request ID.
+    //
+    _requestId = requestId;
+    _lookupCount = lookupCount;
+    _failureCount = 0;
+    _batched = true;
+}
+
 bool
 IceDiscovery::Request::exception()
 {
@@ -131,7 +240,7 @@ AdapterRequest::AdapterRequest(const LookupIPtr& lookup, const std::string& adap
 bool
 AdapterRequest::retry()
 {
-    return _proxies.empty() && --_retryCount >= 0;
+    return _proxies.empty() && Request::retry();
 }
 
 bool
@@ -155,13 +264,14 @@ AdapterRequest::response(const Ice::ObjectPrxPtr& proxy, bool isReplicaGroup)
 void
 AdapterRequest::finished(const ObjectPrxPtr& proxy)
 {
+    ObjectPrxPtr result;
     if(proxy || _proxies.empty())
     {
-        RequestT<string, AdapterCB>::finished(proxy);
+        result = proxy;
     }
     else if(_proxies.size() == 1)
     {
-        RequestT<string, AdapterCB>::finished(*_proxies.begin());
+        result = *_proxies.begin();
     }
     else
     {
@@ -176,8 +286,14 @@ AdapterRequest::finished(const ObjectPrxPtr& proxy)
             Ice::EndpointSeq endpts = (*p)->ice_getEndpoints();
             copy(endpts.begin(), endpts.end(), back_inserter(endpoints));
         }
-        RequestT<string, AdapterCB>::finished(prx->ice_endpoints(endpoints));
+        result = prx->ice_endpoints(endpoints);
+    }
+
+    if(result)
+    {
+        _lookup->cacheAdapter(_id, result);
     }
+    RequestT<string, AdapterCB>::finished(result);
 }
 
 void
@@ -219,6 +335,16 @@ ObjectRequest::response(const Ice::ObjectPrxPtr& proxy)
     finished(proxy);
 }
 
+void
+ObjectRequest::finished(const ObjectPrxPtr& proxy)
+{
+    if(proxy)
+    {
+        _lookup->cacheObject(_id, proxy);
+    }
+    RequestT<Ice::Identity, ObjectCB>::finished(proxy);
+}
+
 void
 ObjectRequest::invokeWithLookup(const string& domainId, const LookupPrxPtr& lookup, const LookupReplyPrxPtr& lookupReply)
 {
@@ -255,6 +381,9 @@ LookupI::LookupI(const LocatorRegistryIPtr& registry, const LookupPrxPtr& lookup
     _retryCount(properties->getPropertyAsIntWithDefault("IceDiscovery.RetryCount", 3)),
     _latencyMultiplier(properties->getPropertyAsIntWithDefault("IceDiscovery.LatencyMultiplier", 1)),
     _domainId(properties->getProperty("IceDiscovery.DomainId")),
+    _batchSize(static_cast<size_t>(max(properties->getPropertyAsIntWithDefault("IceDiscovery.BatchSize", 1), 0))),
+    _batchDelay(IceUtil::Time::milliSeconds(properties->getPropertyAsIntWithDefault("IceDiscovery.BatchDelay", 5))),
+    _cacheTimeout(properties->getPropertyAsIntWithDefault("IceDiscovery.CacheTimeout", 0)),
     _timer(IceInternal::getInstanceTimer(lookup->ice_getCommunicator())),
     _warnOnce(true)
 {
@@ -293,6 +422,14 @@ LookupI::destroy()
         _timer->cancel(p->second);
     }
     _adapterRequests.clear();
+
+    if(_flushTask)
+    {
+        _timer->cancel(_flushTask);
+        _flushTask = ICE_NULLPTR;
+    }
+    _pendingObjectRequests.clear();
+    _pendingAdapterRequests.clear();
 }
 
 void
@@ -387,10 +524,112 @@ LookupI::findAdapterById(ICE_IN(string) domainId, ICE_IN(string) adapterId, ICE_
     }
 }
 
+void
+LookupI::findObjectsById(ICE_IN(string) domainId, ICE_IN(Ice::IdentitySeq) ids, ICE_IN(BatchLookupReplyPrxPtr) reply,
+                         const Ice::Current&)
+{
+    if(domainId != _domainId || _batchSize < 2)
+    {
+        return; // Ignore.
+    }
+
+    FoundObjectSeq objects;
+    for(Ice::IdentitySeq::const_iterator p = ids.begin(); p != ids.end(); ++p)
+    {
+        Ice::ObjectPrxPtr proxy = _registry->findObject(*p);
+        if(proxy)
+        {
+            FoundObject object;
+            object.id = *p;
+            object.prx = proxy;
+            objects.push_back(object);
+        }
+    }
+
+    if(!objects.empty())
+    {
+        //
+        // Reply to the multicast request with a single datagram for all the objects found.
+        //
+        try
+        {
+#ifdef ICE_CPP11_MAPPING
+            reply->foundObjectsByIdAsync(objects);
+#else
+            reply->begin_foundObjectsById(objects);
+#endif
+        }
+        catch(const Ice::LocalException&)
+        {
+            // Ignore.
+        }
+    }
+}
+
+void
+LookupI::findAdaptersById(ICE_IN(string) domainId, ICE_IN(Ice::StringSeq) adapterIds,
+                          ICE_IN(BatchLookupReplyPrxPtr) reply, const Ice::Current&)
+{
+    if(domainId != _domainId || _batchSize < 2)
+    {
+        return; // Ignore.
+    }
+
+    FoundAdapterSeq adapters;
+    for(Ice::StringSeq::const_iterator p = adapterIds.begin(); p != adapterIds.end(); ++p)
+    {
+        FoundAdapter adapter;
+        adapter.prx = _registry->findAdapter(*p, adapter.isReplicaGroup);
+        if(adapter.prx)
+        {
+            adapter.id = *p;
+            adapters.push_back(adapter);
+        }
+    }
+
+    if(!adapters.empty())
+    {
+        //
+        // Reply to the multicast request with a single datagram for all the adapters found.
+        //
+        try
+        {
+#ifdef ICE_CPP11_MAPPING
+            reply->foundAdaptersByIdAsync(adapters);
+#else
+            reply->begin_foundAdaptersById(adapters);
+#endif
+        }
+        catch(const Ice::LocalException&)
+        {
+            // Ignore.
+        }
+    }
+}
+
 void
 LookupI::findObject(const ObjectCB& cb, const Ice::Identity& id)
 {
     Lock sync(*this);
+    if(_cacheTimeout != 0)
+    {
+        map<Ice::Identity, pair<Ice::ObjectPrxPtr, IceUtil::Time> >::iterator q = _objectCache.find(id);
+        if(q != _objectCache.end())
+        {
+            if(_cacheTimeout < 0 ||
+               IceUtil::Time::now(IceUtil::Time::Monotonic) - q->second.second < IceUtil::Time::seconds(_cacheTimeout))
+            {
+#ifdef ICE_CPP11_MAPPING
+                cb.first(q->second.first);
+#else
+                cb->ice_response(q->second.first);
+#endif
+                return;
+            }
+            _objectCache.erase(q);
+        }
+    }
+
     map<Ice::Identity, ObjectRequestPtr>::iterator p = _objectRequests.find(id);
     if(p == _objectRequests.end())
     {
@@ -402,6 +641,13 @@ LookupI::findObject(const ObjectCB& cb, const Ice::Identity& id)
 
     if(p->second->addCallback(cb))
     {
+        if(_batchSize > 1)
+        {
+            _pendingObjectRequests.push_back(p->second);
+            scheduleFlush();
+            return;
+        }
+
         try
         {
             p->second->invoke(_domainId, _lookups);
@@ -419,6 +665,25 @@ void
 LookupI::findAdapter(const AdapterCB& cb, const std::string& adapterId)
 {
     Lock sync(*this);
+    if(_cacheTimeout != 0)
+    {
+        map<string, pair<Ice::ObjectPrxPtr, IceUtil::Time> >::iterator q = _adapterCache.find(adapterId);
+        if(q != _adapterCache.end())
+        {
+            if(_cacheTimeout < 0 ||
+               IceUtil::Time::now(IceUtil::Time::Monotonic) - q->second.second < IceUtil::Time::seconds(_cacheTimeout))
+            {
+#ifdef ICE_CPP11_MAPPING
+                cb.first(q->second.first);
+#else
+                cb->ice_response(q->second.first);
+#endif
+                return;
+            }
+            _adapterCache.erase(q);
+        }
+    }
+
     map<string, AdapterRequestPtr>::iterator p = _adapterRequests.find(adapterId);
     if(p == _adapterRequests.end())
     {
@@ -430,6 +695,13 @@ LookupI::findAdapter(const AdapterCB& cb, const std::string& adapterId)
 
     if(p->second->addCallback(cb))
     {
+        if(_batchSize > 1)
+        {
+            _pendingAdapterRequests.push_back(p->second);
+            scheduleFlush();
+            return;
+        }
+
         try
         {
             p->second->invoke(_domainId, _lookups);
@@ -443,6 +715,165 @@ LookupI::findAdapter(const AdapterCB& cb, const std::string& adapterId)
     }
 }
 
+void
+LookupI::flush()
+{
+    Lock sync(*this);
+    _flushTask = ICE_NULLPTR;
+
+    //
+    // Send the pending requests with batched lookups of at most _batchSize identities or
+    // adapter IDs each to keep the datagrams (and the datagrams of the replies) small.
+    //
+    for(size_t i = 0; i < _pendingObjectRequests.size(); i += _batchSize)
+    {
+        vector<ObjectRequestPtr>::const_iterator first = _pendingObjectRequests.begin() + i;
+        invokeObjectBatch(vector<ObjectRequestPtr>(first, first + min(_batchSize, _pendingObjectRequests.size() - i)));
+    }
+    _pendingObjectRequests.clear();
+
+    for(size_t i = 0; i < _pendingAdapterRequests.size(); i += _batchSize)
+    {
+        vector<AdapterRequestPtr>::const_iterator first = _pendingAdapterRequests.begin() + i;
+        invokeAdapterBatch(vector<AdapterRequestPtr>(first, first + min(_batchSize, _pendingAdapterRequests.size() - i)));
+    }
+    _pendingAdapterRequests.clear();
+}
+
+void
+LookupI::scheduleFlush()
+{
+    //
+    // Wait for the batch delay before sending the pending requests to give a chance to
+    // other requests to join the batch.
+    //
+    if(!_flushTask)
+    {
+        _flushTask = ICE_MAKE_SHARED(FlushTask, ICE_SHARED_FROM_THIS);
+        _timer->schedule(_flushTask, _batchDelay);
+    }
+}
+
+void
+LookupI::invokeObjectBatch(const vector<ObjectRequestPtr>& requests)
+{
+    Ice::Identity id;
+    id.name = Ice::generateUUID();
+    Ice::IdentitySeq ids;
+    for(vector<ObjectRequestPtr>::const_iterator p = requests.begin(); p != requests.end(); ++p)
+    {
+        ids.push_back((*p)->getId());
+        (*p)->invoked(id.name, _lookups.size());
+    }
+
+    try
+    {
+        for(vector<pair<LookupPrxPtr, LookupReplyPrxPtr> >::const_iterator p = _lookups.begin(); p != _lookups.end(); ++p)
+        {
+            BatchLookupPrxPtr lookup = ICE_UNCHECKED_CAST(BatchLookupPrx, p->first);
+            BatchLookupReplyPrxPtr reply = ICE_UNCHECKED_CAST(BatchLookupReplyPrx, p->second->ice_identity(id));
+#ifdef ICE_CPP11_MAPPING
+            auto self = ICE_SHARED_FROM_THIS;
+            lookup->findObjectsByIdAsync(_domainId, ids, reply, nullptr, [self, requests](exception_ptr ex)
+            {
+                try
+                {
+                    rethrow_exception(ex);
+                }
+                catch(const Ice::LocalException& e)
+                {
+                    for(const auto& request : requests)
+                    {
+                        self->objectRequestException(request, e);
+                    }
+                }
+            });
+#else
+            lookup->begin_findObjectsById(_domainId, ids, reply,
+                                          newCallback(new ObjectBatchCallbackI(this, requests),
+                                                      &ObjectBatchCallbackI::completed));
+#endif
+        }
+
+        //
+        // Each request keeps its own timer, the requests which are not resolved by the
+        // batched lookup are retried with the findObjectById lookup which is also answered
+        // by IceDiscovery clients that don't support batched lookups.
+        //
+        for(vector<ObjectRequestPtr>::const_iterator p = requests.begin(); p != requests.end(); ++p)
+        {
+            _timer->schedule(*p, _timeout);
+        }
+    }
+    catch(const Ice::LocalException&)
+    {
+        for(vector<ObjectRequestPtr>::const_iterator p = requests.begin(); p != requests.end(); ++p)
+        {
+            (*p)->finished(ICE_NULLPTR);
+            _objectRequests.erase((*p)->getId());
+        }
+    }
+}
+
+void
+LookupI::invokeAdapterBatch(const vector<AdapterRequestPtr>& requests)
+{
+    Ice::Identity id;
+    id.name = Ice::generateUUID();
+    Ice::StringSeq ids;
+    for(vector<AdapterRequestPtr>::const_iterator p = requests.begin(); p != requests.end(); ++p)
+    {
+        ids.push_back((*p)->getId());
+        (*p)->invoked(id.name, _lookups.size());
+    }
+
+    try
+    {
+        for(vector<pair<LookupPrxPtr, LookupReplyPrxPtr> >::const_iterator p = _lookups.begin(); p != _lookups.end(); ++p)
+        {
+            BatchLookupPrxPtr lookup = ICE_UNCHECKED_CAST(BatchLookupPrx, p->first);
+            BatchLookupReplyPrxPtr reply = ICE_UNCHECKED_CAST(BatchLookupReplyPrx, p->second->ice_identity(id));
+#ifdef ICE_CPP11_MAPPING
+            auto self = ICE_SHARED_FROM_THIS;
+            lookup->findAdaptersByIdAsync(_domainId, ids, reply, nullptr, [self, requests](exception_ptr ex)
+            {
+                try
+                {
+                    rethrow_exception(ex);
+                }
+                catch(const Ice::LocalException& e)
+                {
+                    for(const auto& request : requests)
+                    {
+                        self->adapterRequestException(request, e);
+                    }
+                }
+            });
+#else
+            lookup->begin_findAdaptersById(_domainId, ids, reply,
+                                           newCallback(new AdapterBatchCallbackI(this, requests),
+                                                       &AdapterBatchCallbackI::completed));
+#endif
+        }
+
+        //
+        // See comment in invokeObjectBatch.
+        //
+        for(vector<AdapterRequestPtr>::const_iterator p = requests.begin(); p != requests.end(); ++p)
+        {
+            _timer->schedule(*p, _timeout);
+        }
+    }
+    catch(const Ice::LocalException&)
+    {
+        for(vector<AdapterRequestPtr>::const_iterator p = requests.begin(); p != requests.end(); ++p)
+        {
+            (*p)->finished(ICE_NULLPTR);
+            _adapterRequests.erase((*p)->getId());
+        }
+    }
+}
+
 void
 LookupI::foundObject(const Ice::Identity& id, const string& requestId, const Ice::ObjectPrxPtr& proxy)
 {
@@ -575,6 +1006,24 @@ LookupI::objectRequestException(const ObjectRequestPtr& request, const LocalExce
     }
 }
 
+void
+LookupI::cacheObject(const Ice::Identity& id, const Ice::ObjectPrxPtr& proxy)
+{
+    if(_cacheTimeout != 0)
+    {
+        _objectCache[id] = make_pair(proxy, IceUtil::Time::now(IceUtil::Time::Monotonic));
+    }
+}
+
+void
+LookupI::cacheAdapter(const string& adapterId, const Ice::ObjectPrxPtr& proxy)
+{
+    if(_cacheTimeout != 0)
+    {
+        _adapterCache[adapterId] = make_pair(proxy, IceUtil::Time::now(IceUtil::Time::Monotonic));
+    }
+}
+
 LookupReplyI::LookupReplyI(const LookupIPtr& lookup) : _lookup(lookup)
 {
 }
@@ -592,6 +1041,24 @@ LookupReplyI::foundAdapterById(string adapterId, shared_ptr<ObjectPrx> proxy, bo
 {
     _lookup->foundAdapter(adapterId, current.id.name, proxy, isReplicaGroup);
 }
+
+void
+LookupReplyI::foundObjectsById(FoundObjectSeq objects, const Current& current)
+{
+    for(const auto& object : objects)
+    {
+        _lookup->foundObject(object.id, current.id.name, object.prx);
+    }
+}
+
+void
+LookupReplyI::foundAdaptersById(FoundAdapterSeq adapters, const Current& current)
+{
+    for(const auto& adapter : adapters)
+    {
+        _lookup->foundAdapter(adapter.id, current.id.name, adapter.prx, adapter.isReplicaGroup);
+    }
+}
 #else
 void
 LookupReplyI::foundObjectById(const Identity& id, const ObjectPrxPtr& proxy, const Current& current)
@@ -605,4 +1072,22 @@ LookupReplyI::foundAdapterById(const string& adapterId, const ObjectPrxPtr& prox
 {
     _lookup->foundAdapter(adapterId, current.id.name, proxy, isReplicaGroup);
 }
+
+void
+LookupReplyI::foundObjectsById(const FoundObjectSeq& objects, const Current& current)
+{
+    for(FoundObjectSeq::const_iterator p = objects.begin(); p != objects.end(); ++p)
+    {
+        _lookup->foundObject(p->id, current.id.name, p->prx);
+    }
+}
+
+void
+LookupReplyI::foundAdaptersById(const FoundAdapterSeq& adapters, const Current& current)
+{
+    for(FoundAdapterSeq::const_iterator p = adapters.begin(); p != adapters.end(); ++p)
+    {
+        _lookup->foundAdapter(p->id, current.id.name, p->prx, p->isReplicaGroup);
+    }
+}
 #endif
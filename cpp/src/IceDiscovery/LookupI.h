@@ -27,6 +27,7 @@ public:
 
     virtual bool retry();
     void invoke(const std::string&, const std::vector<std::pair<LookupPrxPtr, LookupReplyPrxPtr> >&);
+    void invoked(const std::string&, size_t);
     bool exception();
     std::string getRequestId() const;
 
@@ -37,10 +38,11 @@ protected:
     virtual void invokeWithLookup(const std::string&, const LookupPrxPtr&, const LookupReplyPrxPtr&) = 0;
 
     LookupIPtr _lookup;
-    const std::string _requestId;
+    std::string _requestId;
     int _retryCount;
     size_t _lookupCount;
     size_t _failureCount;
+    bool _batched;
 };
 ICE_DEFINE_PTR(RequestPtr, Request);
 
@@ -103,6 +105,8 @@ public:
 
     void response(const Ice::ObjectPrxPtr&);
 
+    virtual void finished(const Ice::ObjectPrxPtr&);
+
 private:
 
     virtual void invokeWithLookup(const std::string&, const LookupPrxPtr&, const LookupReplyPrxPtr&);
@@ -144,7 +148,7 @@ private:
 };
 ICE_DEFINE_PTR(AdapterRequestPtr, AdapterRequest);
 
-class LookupI : public Lookup,
+class LookupI : public BatchLookup,
                 private IceUtil::Mutex
 #ifdef ICE_CPP11_MAPPING
               , public std::enable_shared_from_this<LookupI>
@@ -163,8 +167,13 @@ public:
                                 const Ice::Current&);
     virtual void findAdapterById(ICE_IN(std::string), ICE_IN(std::string), ICE_IN(IceDiscovery::LookupReplyPrxPtr),
                                  const Ice::Current&);
+    virtual void findObjectsById(ICE_IN(std::string), ICE_IN(Ice::IdentitySeq),
+                                 ICE_IN(IceDiscovery::BatchLookupReplyPrxPtr), const Ice::Current&);
+    virtual void findAdaptersById(ICE_IN(std::string), ICE_IN(Ice::StringSeq),
+                                  ICE_IN(IceDiscovery::BatchLookupReplyPrxPtr), const Ice::Current&);
     void findObject(const ObjectCB&, const Ice::Identity&);
     void findAdapter(const AdapterCB&, const std::string&);
+    void flush();
 
     void foundObject(const Ice::Identity&, const std::string&, const Ice::ObjectPrxPtr&);
     void foundAdapter(const std::string&, const std::string&, const Ice::ObjectPrxPtr&, bool);
@@ -174,6 +183,12 @@ public:
     void objectRequestTimedOut(const ObjectRequestPtr&);
     void objectRequestException(const ObjectRequestPtr&, const Ice::LocalException&);
 
+    //
+    // Called with the lookup locked when a request completes with a proxy.
+    //
+    void cacheObject(const Ice::Identity&, const Ice::ObjectPrxPtr&);
+    void cacheAdapter(const std::string&, const Ice::ObjectPrxPtr&);
+
     const IceUtil::TimerPtr&
     timer()
     {
@@ -188,6 +203,10 @@ public:
 
 private:
 
+    void scheduleFlush();
+    void invokeObjectBatch(const std::vector<ObjectRequestPtr>&);
+    void invokeAdapterBatch(const std::vector<AdapterRequestPtr>&);
+
     LocatorRegistryIPtr _registry;
     LookupPrxPtr _lookup;
     std::vector<std::pair<LookupPrxPtr, LookupReplyPrxPtr> > _lookups;
@@ -195,6 +214,9 @@ private:
     const int _retryCount;
     const int _latencyMultiplier;
     const std::string _domainId;
+    const size_t _batchSize;
+    const IceUtil::Time _batchDelay;
+    const int _cacheTimeout;
 
     IceUtil::TimerPtr _timer;
     Ice::ObjectPrxPtr _wellKnownProxy;
@@ -202,9 +224,22 @@ private:
 
     std::map<Ice::Identity, ObjectRequestPtr> _objectRequests;
     std::map<std::string, AdapterRequestPtr> _adapterRequests;
+
+    //
+    // The requests waiting for the flush task to send them with batched lookups.
+    //
+    IceUtil::TimerTaskPtr _flushTask;
+    std::vector<ObjectRequestPtr> _pendingObjectRequests;
+    std::vector<AdapterRequestPtr> _pendingAdapterRequests;
+
+    //
+    // The proxies found by previous requests and the time they were found.
+    //
+    std::map<Ice::Identity, std::pair<Ice::ObjectPrxPtr, IceUtil::Time> > _objectCache;
+    std::map<std::string, std::pair<Ice::ObjectPrxPtr, IceUtil::Time> > _adapterCache;
 };
 
-class LookupReplyI : public LookupReply
+class LookupReplyI : public BatchLookupReply
 {
 public:
 
@@ -213,9 +248,13 @@ public:
 #ifdef ICE_CPP11_MAPPING
     virtual void foundObjectById(Ice::Identity, std::shared_ptr<Ice::ObjectPrx>, const Ice::Current&);
     virtual void foundAdapterById(std::string, std::shared_ptr<Ice::ObjectPrx>, bool, const Ice::Current&);
+    virtual void foundObjectsById(FoundObjectSeq, const Ice::Current&);
+    virtual void foundAdaptersById(FoundAdapterSeq, const Ice::Current&);
 #else
     virtual void foundObjectById(const Ice::Identity&, const Ice::ObjectPrx&, const Ice::Current&);
     virtual void foundAdapterById(const std::string&, const Ice::ObjectPrx&, bool, const Ice::Current&);
+    virtual void foundObjectsById(const FoundObjectSeq&, const Ice::Current&);
+    virtual void foundAdaptersById(const FoundAdapterSeq&, const Ice::Current&);
 #endif
 
 private:
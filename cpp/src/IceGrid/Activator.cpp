@@ -36,6 +36,15 @@
 #   include <grp.h> // for setgroups
 #endif
 
+//
+// posix_spawn is used to create the server processes if the file actions to
+// close the file descriptors and change the working directory are supported.
+//
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34))
+#   include <spawn.h>
+#   define ICE_GRID_POSIX_SPAWN
+#endif
+
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
@@ -100,6 +109,124 @@ reportChildError(int err, int fd, const char* cannot, const char* name, const Tr
     _exit(EXIT_FAILURE);
 }
 
+#   ifdef ICE_GRID_POSIX_SPAWN
+//
+// Create the server process with posix_spawn, the process is setup as it is
+// with fork and exec in Activator::createProcess.
+//
+Activator::Process
+spawnProcess(const string& name, const StringSeq& args, const string& pwd, const StringSeq& envs,
+             const TraceLevelsPtr& traceLevels)
+{
+    //
+    // The server environment is the node environment with the variables of
+    // the server descriptor. A variable without a value is removed from the
+    // environment, as it is with putenv.
+    //
+    StringSeq environment;
+    for(char** p = environ; *p != 0; ++p)
+    {
+        environment.push_back(*p);
+    }
+    for(StringSeq::const_iterator p = envs.begin(); p != envs.end(); ++p)
+    {
+        string::size_type pos = p->find('=');
+        const string prefix = p->substr(0, pos) + '=';
+        StringSeq::iterator q = environment.begin();
+        while(q != environment.end())
+        {
+            if(q->compare(0, prefix.size(), prefix) == 0)
+            {
+                q = environment.erase(q);
+            }
+            else
+            {
+                ++q;
+            }
+        }
+        if(pos != string::npos)
+        {
+            environment.push_back(*p);
+        }
+    }
+
+    int fds[2];
+    if(pipe(fds) != 0)
+    {
+        throw SyscallException(__FILE__, __LINE__, getSystemErrno());
+    }
+
+    IceInternal::ArgVector av(args);
+    IceInternal::ArgVector env(environment);
+
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+
+    //
+    // Unblock signals blocked by IceUtil::CtrlCHandler and assign a new
+    // process group for the process.
+    //
+    sigset_t sigs;
+    pthread_sigmask(SIG_SETMASK, 0, &sigs);
+    sigdelset(&sigs, SIGHUP);
+    sigdelset(&sigs, SIGINT);
+    sigdelset(&sigs, SIGTERM);
+    posix_spawnattr_setsigmask(&attr, &sigs);
+    posix_spawnattr_setpgroup(&attr, 0);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETPGROUP);
+
+    //
+    // Close all file descriptors, except for standard input, standard
+    // output, standard error, and the write side of the newly created pipe
+    // which is moved to descriptor 3.
+    //
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], 3);
+    posix_spawn_file_actions_addclosefrom_np(&actions, 4);
+    if(!pwd.empty())
+    {
+        posix_spawn_file_actions_addchdir_np(&actions, pwd.c_str());
+    }
+
+    pid_t pid;
+    int err = posix_spawnp(&pid, av.argv[0], &actions, &attr, av.argv, env.argv);
+
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attr);
+    close(fds[1]);
+
+    if(err != 0)
+    {
+        close(fds[0]);
+
+        //
+        // The error might come from any of the file actions, check the
+        // working directory to report the same error as the fork path.
+        //
+        ostringstream os;
+        if(!pwd.empty() && access(pwd.c_str(), X_OK) == -1)
+        {
+            os << "cannot change working directory to `" << pwd << "': " << IceUtilInternal::errorToString(errno);
+        }
+        else
+        {
+            os << "cannot execute `" << av.argv[0] << "': " << IceUtilInternal::errorToString(err);
+        }
+        const string message = os.str();
+
+        Ice::Warning out(traceLevels->logger);
+        out << "server activation failed for `" << name << "':\n" << message;
+        throw runtime_error(message);
+    }
+
+    Activator::Process process;
+    process.pid = pid;
+    process.pipeFd = fds[0];
+    return process;
+}
+#   endif
+
 #endif
 
 string
@@ -303,9 +430,11 @@ extern "C" void CALLBACK activatorWaitCallback(PVOID data, BOOLEAN)
 }
 #endif
 
-Activator::Activator(const TraceLevelsPtr& traceLevels) :
+Activator::Activator(const TraceLevelsPtr& traceLevels, int maxActivations) :
     _traceLevels(traceLevels),
-    _deactivating(false)
+    _deactivating(false),
+    _maxActivations(maxActivations),
+    _activations(0)
 {
 #ifdef _WIN32
     _hIntr = CreateEvent(
@@ -362,13 +491,118 @@ Activator::activate(const string& name,
                     const Ice::StringSeq& envs,
                     const ServerIPtr& server)
 {
+    {
+        IceUtil::Monitor< IceUtil::Mutex>::Lock sync(*this);
+
+        if(_deactivating)
+        {
+            throw runtime_error("The node is being shutdown.");
+        }
+
+        //
+        // The process is created without the activator lock to allow
+        // servers to be activated concurrently, up to the configured
+        // maximum number of concurrent activations.
+        //
+        while(_maxActivations > 0 && _activations >= _maxActivations)
+        {
+            wait();
+            if(_deactivating)
+            {
+                throw runtime_error("The node is being shutdown.");
+            }
+        }
+        ++_activations;
+    }
+
+    Process process;
+    try
+    {
+#ifndef _WIN32
+        process = createProcess(name, exePath, pwdPath, uid, gid, options, envs);
+#else
+        process = createProcess(name, exePath, pwdPath, options, envs);
+#endif
+    }
+    catch(...)
+    {
+        IceUtil::Monitor< IceUtil::Mutex>::Lock sync(*this);
+        activationCompleted();
+        throw;
+    }
+    process.server = server;
+
     IceUtil::Monitor< IceUtil::Mutex>::Lock sync(*this);
+    activationCompleted();
 
     if(_deactivating)
     {
+        //
+        // The node was shutdown while the process was created, destroy()
+        // doesn't know about this process so we terminate it here.
+        //
+#ifdef _WIN32
+        TerminateProcess(process.hnd, 0);
+        CloseHandle(process.hnd);
+#else
+        ::kill(process.pid, SIGKILL);
+        close(process.pipeFd);
+        waitPid(process.pid);
+#endif
         throw runtime_error("The node is being shutdown.");
     }
 
+#ifdef _WIN32
+    process.activator = this;
+    map<string, Process>::iterator it = _processes.insert(make_pair(name, process)).first;
+
+    Process* pp = &it->second;
+    if(!RegisterWaitForSingleObject(&pp->waithnd, pp->hnd, activatorWaitCallback, pp, INFINITE,
+                                    WT_EXECUTEDEFAULT | WT_EXECUTEONLYONCE))
+    {
+        TerminateProcess(pp->hnd, 0);
+
+        string message = IceUtilInternal::lastErrorToString();
+
+        Ice::Warning out(_traceLevels->logger);
+        out << "server activation failed for `" << name << "':\ncouldn't register wait callback\n" << message;
+
+        throw runtime_error(message);
+    }
+#else
+    _processes.insert(make_pair(name, process));
+
+    int flags = fcntl(process.pipeFd, F_GETFL);
+    flags |= O_NONBLOCK;
+    fcntl(process.pipeFd, F_SETFL, flags);
+
+    setInterrupt();
+#endif
+
+    //
+    // Don't print the following trace, this might interfere with the
+    // output of the started process if it fails with an error message.
+    //
+//  if(_traceLevels->activator > 0)
+//  {
+//      Ice::Trace out(_traceLevels->logger, _traceLevels->activatorCat);
+//      out << "activated server `" << name << "' (pid = " << process.pid << ")";
+//  }
+
+    return static_cast<Ice::Int>(process.pid);
+}
+
+Activator::Process
+Activator::createProcess(const string& name,
+                         const string& exePath,
+                         const string& pwdPath,
+#ifndef _WIN32
+                         uid_t uid,
+                         gid_t gid,
+#endif
+                         const Ice::StringSeq& options,
+                         const Ice::StringSeq& envs)
+{
     string path = exePath;
     if(path.empty())
     {
@@ -614,38 +848,34 @@ Activator::activate(const string& name,
     // keep the thread handle, so we close it now. The process handle will be closed later.
     //
     CloseHandle(pi.hThread);
-    process.activator = this;
     process.pid = pi.dwProcessId;
     process.hnd = pi.hProcess;
-    process.server = server;
-    map<string, Process>::iterator it = _processes.insert(make_pair(name, process)).first;
-
-    Process* pp = &it->second;
-    if(!RegisterWaitForSingleObject(&pp->waithnd, pp->hnd, activatorWaitCallback, pp, INFINITE,
-                                    WT_EXECUTEDEFAULT | WT_EXECUTEONLYONCE))
-    {
-        TerminateProcess(pp->hnd, 0);
-
-        string message = IceUtilInternal::lastErrorToString();
-
-        Ice::Warning out(_traceLevels->logger);
-        out << "server activation failed for `" << name << "':\ncouldn't register wait callback\n" << message;
-
-        throw runtime_error(message);
-    }
-
+    return process;
+#else
+#   ifdef ICE_GRID_POSIX_SPAWN
     //
-    // Don't print the following trace, this might interfer with the
-    // output of the started process if it fails with an error message.
+    // Use posix_spawn unless the server runs with a different user or
+    // group, posix_spawn can't change the user and groups of the child
+    // process. posix_spawn doesn't copy the page tables of the node like
+    // fork does, which is significantly faster with a large node. The
+    // fork path is also used if the server environment sets PATH for an
+    // executable without a directory: execvp searches the PATH of the
+    // child process whereas posix_spawnp searches the PATH of the node.
     //
-//     if(_traceLevels->activator > 0)
-//     {
-//         Ice::Trace out(_traceLevels->logger, _traceLevels->activatorCat);
-//         out << "activated server `" << name << "' (pid = " << pi.dwProcessId << ")";
-//     }
+    bool setsPath = false;
+    if(args[0].find('/') == string::npos)
+    {
+        for(StringSeq::const_iterator p = envs.begin(); p != envs.end(); ++p)
+        {
+            setsPath |= p->compare(0, 5, "PATH=") == 0;
+        }
+    }
+    if(getuid() != 0 && uid == getuid() && gid == getgid() && !setsPath)
+    {
+        return spawnProcess(name, args, pwd, envs, _traceLevels);
+    }
+#   endif
 
-    return static_cast<Ice::Int>(process.pid);
-#else
     struct passwd pwbuf;
     vector<char> buffer(4096); // 4KB initial buffer size
     struct passwd *pw;
@@ -904,31 +1134,12 @@ Activator::activate(const string& name,
         // pipe anymore.
         //
         close(errorFds[0]);
-
-        Process process;
-        process.pid = pid;
-        process.pipeFd = fds[0];
-        process.server = server;
-        _processes.insert(make_pair(name, process));
-
-        int flags = fcntl(process.pipeFd, F_GETFL);
-        flags |= O_NONBLOCK;
-        fcntl(process.pipeFd, F_SETFL, flags);
-
-        setInterrupt();
-
-    //
-    // Don't print the following trace, this might interfere with the
-    // output of the started process if it fails with an error message.
-    //
-//      if(_traceLevels->activator > 0)
-//      {
-//          Ice::Trace out(_traceLevels->logger, _traceLevels->activatorCat);
-//          out << "activated server `" << name << "' (pid = " << pid << ")";
-//      }
     }
 
-    return pid;
+    Process process;
+    process.pid = pid;
+    process.pipeFd = fds[0];
+    return process;
 #endif
 }
 
@@ -1261,7 +1472,7 @@ Activator::terminationListener()
                 }
             }
             _terminated.clear();
-            deactivated = _deactivating && _processes.empty();
+            deactivated = _deactivating && _processes.empty() && _activations == 0;
         }
 
         for(vector<Process>::const_iterator p = terminated.begin(); p != terminated.end(); ++p)
@@ -1352,7 +1563,7 @@ Activator::terminationListener()
             {
                 clearInterrupt();
 
-                if(_deactivating && _processes.empty())
+                if(_deactivating && _processes.empty() && _activations == 0)
                 {
                     return;
                 }
@@ -1413,7 +1624,7 @@ Activator::terminationListener()
             //
             // We are deactivating and there's no more active processes.
             //
-            deactivated = _deactivating && _processes.empty();
+            deactivated = _deactivating && _processes.empty() && _activations == 0;
         }
 
         for(vector<Process>::const_iterator p = terminated.begin(); p != terminated.end(); ++p)
@@ -1456,6 +1667,21 @@ Activator::terminationListener()
 #endif
 }
 
+void
+Activator::activationCompleted()
+{
+    //
+    // Called with the activator locked once a process is created or failed
+    // to be created.
+    //
+    --_activations;
+    notifyAll();
+    if(_deactivating)
+    {
+        setInterrupt(); // The termination listener might be waiting for activations to complete.
+    }
+}
+
 void
 Activator::clearInterrupt()
 {
@@ -42,7 +42,7 @@ public:
         ServerIPtr server;
     };
 
-    Activator(const TraceLevelsPtr&);
+    Activator(const TraceLevelsPtr&, int);
     virtual ~Activator();
 
     virtual int activate(const std::string&, const std::string&, const std::string&,
@@ -72,6 +72,13 @@ public:
 
 private:
 
+    Process createProcess(const std::string&, const std::string&, const std::string&,
+#ifndef _WIN32
+                          uid_t, gid_t,
+#endif
+                          const Ice::StringSeq&, const Ice::StringSeq&);
+    void activationCompleted();
+
     void terminationListener();
     void clearInterrupt();
     void setInterrupt();
@@ -83,6 +90,8 @@ private:
     TraceLevelsPtr _traceLevels;
     std::map<std::string, Process> _processes;
     bool _deactivating;
+    const int _maxActivations; // The maximum number of concurrent activations, no limit if 0 or less.
+    int _activations; // The number of processes being created.
 
 #ifdef _WIN32
     HANDLE _hIntr;
@@ -20,6 +20,17 @@ using namespace IceGrid;
 namespace IceGrid
 {
 
+//
+// With the latency load balancing policy, the second of the two randomly chosen
+// replicas is only used first if its latency is this many times lower. The
+// latencies reach the registry with the node keep alives, so they are seconds
+// old: preferring the lowest one, even by a small margin, sends all the clients
+// which resolve the replica group before the next report to the same replica.
+// With a ratio of 2 or more, a replica 1.5 times slower than the others is no
+// longer avoided.
+//
+const float latencyRatio = 1.5f;
+
 struct ReplicaLoadComp
 {
     bool operator()(const pair<float, ServerAdapterEntryPtr>& lhs, const pair<float, ServerAdapterEntryPtr>& rhs)
@@ -444,6 +455,32 @@ ServerAdapterEntry::getLeastLoadedNodeLoad(LoadSample loadSample) const
     return 999.9f;
 }
 
+float
+ServerAdapterEntry::getLatency() const
+{
+    try
+    {
+        return _server->getAdapterLatency(_id);
+    }
+    catch(const ServerNotExistException&)
+    {
+        // This might happen if the application is updated concurrently.
+    }
+    catch(const NodeNotExistException&)
+    {
+        // This might happen if the application is updated concurrently.
+    }
+    catch(const NodeUnreachableException&)
+    {
+    }
+    catch(const Ice::Exception& ex)
+    {
+        Ice::Error error(_cache.getTraceLevels()->logger);
+        error << "unexpected exception while getting adapter latency:\n" << ex;
+    }
+    return 999999.9f;
+}
+
 AdapterInfoSeq
 ServerAdapterEntry::getAdapterInfoNoEndpoints() const
 {
@@ -646,6 +683,7 @@ ReplicaGroupEntry::getLocatorAdapterInfo(LocatorAdapterInfoSeq& adapters, int& n
 {
     vector<ServerAdapterEntryPtr> replicas;
     bool adaptive = false;
+    bool latency = false;
     LoadSample loadSample = LoadSample1;
     {
         Lock sync(*this);
@@ -692,6 +730,12 @@ ReplicaGroupEntry::getLocatorAdapterInfo(LocatorAdapterInfoSeq& adapters, int& n
             replicas = _replicas;
             IceUtilInternal::shuffle(replicas.begin(), replicas.end());
         }
+        else if(LatencyLoadBalancingPolicyPtr::dynamicCast(_loadBalancing))
+        {
+            replicas = _replicas;
+            IceUtilInternal::shuffle(replicas.begin(), replicas.end());
+            latency = true;
+        }
     }
 
     int unreachable = 0;
@@ -713,6 +757,21 @@ ReplicaGroupEntry::getLocatorAdapterInfo(LocatorAdapterInfoSeq& adapters, int& n
             replicas.clear();
             transform(rl.begin(), rl.end(), back_inserter(replicas), TransformToReplica());
         }
+        else if(latency && replicas.size() > 1)
+        {
+            //
+            // Use first the replica with the lowest latency of the first two replicas (which
+            // are randomly chosen). Unlike ordering all the replicas by latency, this doesn't
+            // direct all the clients to the same replica while the latencies are not updated.
+            // A replica whose latency isn't known yet is preferred to get it measured.
+            //
+            float first = replicas[0]->getLatency();
+            float second = replicas[1]->getLatency();
+            if(first >= 0.0f && (second < 0.0f || second * latencyRatio < first))
+            {
+                swap(replicas[0], replicas[1]);
+            }
+        }
 
         //
         // Retrieve the proxy of each adapter from the server. The adapter
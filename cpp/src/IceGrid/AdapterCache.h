@@ -100,6 +100,7 @@ public:
     virtual AdapterPrx getProxy(const std::string&, bool) const;
 
     void getLocatorAdapterInfo(LocatorAdapterInfoSeq&) const;
+    float getLatency() const;
     const std::string& getReplicaGroupId() const { return _replicaGroupId; }
     int getPriority() const;
 
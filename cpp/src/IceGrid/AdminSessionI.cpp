@@ -244,6 +244,26 @@ AdminSessionI::setObserversByIdentity(const Ice::Identity& registryObserver,
     setupObserverSubscription(ObjectObserverTopicName, addForwarder(objectObserver, current), true);
 }
 
+void
+AdminSessionI::setApplicationUpdateObserver(const ApplicationUpdateObserverPrx& observer, const Ice::Current& current)
+{
+    Lock sync(*this);
+    if(_destroyed)
+    {
+        throw Ice::ObjectNotExistException(__FILE__, __LINE__, current.id, "", "");
+    }
+
+    if(observer)
+    {
+        _updateObserver = ApplicationUpdateObserverPrx::uncheckedCast(
+            observer->ice_timeout(_timeout * 1000)->ice_locator(_registry->getLocator())->ice_oneway());
+    }
+    else
+    {
+        _updateObserver = 0;
+    }
+}
+
 int
 AdminSessionI::startUpdate(const Ice::Current& current)
 {
@@ -446,6 +466,28 @@ AdminSessionI::removeFileIterator(const Ice::Identity& id, const Ice::Current&)
     _servantManager->remove(id);
 }
 
+void
+AdminSessionI::updateProgress(const string& application, int revision, int updated, int total)
+{
+    ApplicationUpdateObserverPrx observer;
+    {
+        Lock sync(*this);
+        observer = _updateObserver;
+    }
+
+    if(observer)
+    {
+        try
+        {
+            observer->begin_updateProgress(application, revision, updated, total);
+        }
+        catch(const Ice::LocalException&)
+        {
+            // Ignore, the progress is only informational.
+        }
+    }
+}
+
 void
 AdminSessionI::destroyImpl(bool shutdown)
 {
@@ -39,6 +39,8 @@ public:
     virtual void setObserversByIdentity(const Ice::Identity&, const Ice::Identity&, const Ice::Identity&,
                                         const Ice::Identity&, const Ice::Identity&, const Ice::Current&);
 
+    virtual void setApplicationUpdateObserver(const ApplicationUpdateObserverPrx&, const Ice::Current&);
+
     virtual int startUpdate(const Ice::Current&);
     virtual void finishUpdate(const Ice::Current&);
 
@@ -58,6 +60,8 @@ public:
 
     void removeFileIterator(const Ice::Identity&, const Ice::Current&);
 
+    void updateProgress(const std::string&, int, int, int);
+
 private:
 
     void setupObserverSubscription(TopicName, const Ice::ObjectPrx&, bool = false);
@@ -73,6 +77,7 @@ private:
     std::map<TopicName, std::pair<Ice::ObjectPrx, bool> > _observers;
     RegistryIPtr _registry;
     Ice::ObjectPrx _adminCallbackTemplate;
+    ApplicationUpdateObserverPrx _updateObserver;
 };
 typedef IceUtil::Handle<AdminSessionI> AdminSessionIPtr;
 
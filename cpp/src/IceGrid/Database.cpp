@@ -14,6 +14,7 @@
 #include <IceGrid/DescriptorHelper.h>
 #include <IceGrid/NodeSessionI.h>
 #include <IceGrid/ReplicaSessionI.h>
+#include <IceGrid/AdminSessionI.h>
 #include <IceGrid/Session.h>
 #include <IceGrid/Topics.h>
 #include <IceGrid/IceGrid.h>
@@ -212,6 +213,18 @@ Database::Database(const Ice::ObjectAdapterPtr& registryAdapter,
     _pluginFacade(RegistryPluginFacadeIPtr::dynamicCast(getRegistryPluginFacade())),
     _lock(0)
 {
+    //
+    // The updates are flushed before they are published to the observers, with
+    // the database lock held. The commits don't wait for the group commit window,
+    // they only share the flush in progress.
+    //
+    const int groupCommitWindow =
+        _communicator->getProperties()->getPropertyAsIntWithDefault("IceGrid.Registry.LMDB.GroupCommitWindow", -1);
+    if(groupCommitWindow >= 0)
+    {
+        _env.enableGroupCommit(groupCommitWindow);
+    }
+
     IceDB::ReadWriteTxn txn(_env);
 
     IceDB::IceContext context;
@@ -651,17 +664,7 @@ Database::addApplication(const ApplicationInfo& info, AdminSessionI* session, Ic
     {
         try
         {
-            for(ServerEntrySeq::const_iterator p = entries.begin(); p != entries.end(); ++p)
-            {
-                try
-                {
-                    (*p)->waitForSync();
-                }
-                catch(const NodeUnreachableException&)
-                {
-                    // Ignore.
-                }
-            }
+            waitForServersSync(entries, info.descriptor.name, info.revision, session);
         }
         catch(const DeploymentException&)
         {
@@ -2240,7 +2243,7 @@ Database::reload(const ApplicationHelper& oldApp,
         else
         {
             ServerEntryPtr server = _serverCache.get(p->first);
-            server->update(q->second, noRestart); // Just update the server revision on the node.
+            server->update(q->second, noRestart, true); // Just update the server revision on the node.
             entries.push_back(server);
         }
     }
@@ -2548,7 +2551,7 @@ Database::finishApplicationUpdate(const ApplicationUpdateInfo& update,
                                   const ApplicationInfo& oldApp,
                                   const ApplicationHelper& previousAppHelper,
                                   const ApplicationHelper& appHelper,
-                                  AdminSessionI* /*session*/,
+                                  AdminSessionI* session,
                                   bool noRestart,
                                   Ice::Long dbSerial)
 {
@@ -2614,17 +2617,7 @@ Database::finishApplicationUpdate(const ApplicationUpdateInfo& update,
     {
         try
         {
-            for(ServerEntrySeq::const_iterator p = entries.begin(); p != entries.end(); ++p)
-            {
-                try
-                {
-                    (*p)->waitForSync();
-                }
-                catch(const NodeUnreachableException&)
-                {
-                    // Ignore.
-                }
-            }
+            waitForServersSync(entries, update.descriptor.name, update.revision, session);
         }
         catch(const DeploymentException&)
         {
@@ -2686,6 +2679,41 @@ Database::finishApplicationUpdate(const ApplicationUpdateInfo& update,
     finishUpdating(update.descriptor.name);
 }
 
+void
+Database::waitForServersSync(const ServerEntrySeq& entries, const string& application, int revision,
+                             AdminSessionI* session)
+{
+    //
+    // Report the progress to the session performing the update, at most for every
+    // percent of the servers to update.
+    //
+    const int total = static_cast<int>(entries.size());
+    const int step = max(total / 100, 1);
+    int updated = 0;
+    if(session)
+    {
+        session->updateProgress(application, revision, updated, total);
+    }
+
+    for(ServerEntrySeq::const_iterator p = entries.begin(); p != entries.end(); ++p)
+    {
+        try
+        {
+            (*p)->waitForSync();
+        }
+        catch(const NodeUnreachableException&)
+        {
+            // Ignore.
+        }
+
+        ++updated;
+        if(session && (updated % step == 0 || updated == total))
+        {
+            session->updateProgress(application, revision, updated, total);
+        }
+    }
+}
+
 void
 Database::waitForUpdate(const string& name)
 {
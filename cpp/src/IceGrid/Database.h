@@ -180,6 +180,7 @@ private:
 
     void checkSessionLock(AdminSessionI*);
 
+    void waitForServersSync(const ServerEntrySeq&, const std::string&, int, AdminSessionI*);
     void waitForUpdate(const std::string&);
     void startUpdating(const std::string&, const std::string&, int);
     void finishUpdating(const std::string&);
@@ -3119,6 +3119,10 @@ ApplicationHelper::print(Output& out, const ApplicationInfo& info) const
             {
                 out << "adaptive" ;
             }
+            else if(LatencyLoadBalancingPolicyPtr::dynamicCast(p->loadBalancing))
+            {
+                out << "latency";
+            }
             else
             {
                 out << "<unknown load balancing policy>";
@@ -302,7 +302,8 @@ NodeService::startImpl(int argc, char* argv[], int& status)
     // Create the activator.
     //
     TraceLevelsPtr traceLevels = new TraceLevels(communicator(), "IceGrid.Node");
-    _activator = new Activator(traceLevels);
+    _activator = new Activator(traceLevels,
+                               properties->getPropertyAsIntWithDefault("IceGrid.Node.MaxConcurrentActivations", 4));
 
     //
     // Collocate the IceGrid registry if we need to.
@@ -488,6 +489,11 @@ NodeService::startImpl(int argc, char* argv[], int& status)
     //
     _node->getPlatformInfo().start();
 
+    //
+    // Start measuring the latency of the server adapters for the latency load balancing policy.
+    //
+    _node->startAdapterLatencyProbe();
+
     //
     // Ensures that the locator is reachable.
     //
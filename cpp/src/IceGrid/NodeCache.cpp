@@ -177,8 +177,10 @@ class LoadCB : public virtual IceUtil::Shared
 {
 public:
 
-    LoadCB(const TraceLevelsPtr& traceLevels, const ServerEntryPtr& server, const string& node, int timeout) :
-        _traceLevels(traceLevels), _server(server), _id(server->getId()), _node(node), _timeout(timeout)
+    LoadCB(const TraceLevelsPtr& traceLevels, const ServerEntryPtr& server, const NodeEntryPtr& entry,
+           const string& node, int timeout) :
+        _traceLevels(traceLevels), _server(server), _entry(entry), _id(server->getId()), _node(node),
+        _timeout(timeout)
     {
     }
 
@@ -191,6 +193,8 @@ public:
             out << "loaded `" << _id << "' on node `" << _node << "'";
         }
 
+        _entry->finishedUpdate();
+
         //
         // Add the node session timeout on the proxies to ensure the
         // timeout is large enough.
@@ -201,6 +205,8 @@ public:
     void
     exception(const Ice::Exception& lex)
     {
+        _entry->finishedUpdate();
+
         try
         {
             lex.ice_throw();
@@ -231,21 +237,89 @@ public:
         }
     }
 
+    void
+    reload(const ServerInfo& info, const SessionIPtr& session, int timeout, bool noRestart)
+    {
+        if(_traceLevels && _traceLevels->server > 1)
+        {
+            Ice::Trace out(_traceLevels->logger, _traceLevels->serverCat);
+            out << "couldn't update `" << _id << "' revision on node `" << _node << "', loading it";
+        }
+
+        _entry->finishedUpdate();
+        _entry->loadServer(_server, info, session, timeout, noRestart);
+    }
+
 private:
 
     const TraceLevelsPtr _traceLevels;
     const ServerEntryPtr _server;
+    const NodeEntryPtr _entry;
     const string _id;
     const string _node;
     const int _timeout;
 };
 
+typedef IceUtil::Handle<LoadCB> LoadCBPtr;
+
+class UpdateRevisionCB : public virtual IceUtil::Shared
+{
+public:
+
+    UpdateRevisionCB(const LoadCBPtr& cb, const ServerInfo& info, const SessionIPtr& session, int timeout,
+                     bool noRestart) :
+        _cb(cb), _info(info), _session(session), _timeout(timeout), _noRestart(noRestart)
+    {
+    }
+
+    void
+    response(const ServerPrx& server, const AdapterPrxDict& adapters, int at, int dt)
+    {
+        _cb->response(server, adapters, at, dt);
+    }
+
+    void
+    exception(const Ice::Exception& ex)
+    {
+        try
+        {
+            ex.ice_throw();
+        }
+        catch(const DeploymentException&)
+        {
+        }
+        catch(const Ice::OperationNotExistException&)
+        {
+        }
+        catch(const Ice::Exception&)
+        {
+            _cb->exception(ex);
+            return;
+        }
+
+        //
+        // The server isn't loaded on the node or the node doesn't
+        // support revision updates, load the server descriptor.
+        //
+        _cb->reload(_info, _session, _timeout, _noRestart);
+    }
+
+private:
+
+    const LoadCBPtr _cb;
+    const ServerInfo _info;
+    const SessionIPtr _session;
+    const int _timeout;
+    const bool _noRestart;
+};
+
 class DestroyCB : public virtual IceUtil::Shared
 {
 public:
 
-    DestroyCB(const TraceLevelsPtr& traceLevels, const ServerEntryPtr& server, const string& node) :
-        _traceLevels(traceLevels), _server(server), _id(server->getId()), _node(node)
+    DestroyCB(const TraceLevelsPtr& traceLevels, const ServerEntryPtr& server, const NodeEntryPtr& entry,
+              const string& node) :
+        _traceLevels(traceLevels), _server(server), _entry(entry), _id(server->getId()), _node(node)
     {
     }
 
@@ -257,12 +331,15 @@ public:
             Ice::Trace out(_traceLevels->logger, _traceLevels->serverCat);
             out << "unloaded `" << _id << "' on node `" << _node << "'";
         }
+        _entry->finishedUpdate();
         _server->destroyCallback();
     }
 
     void
     exception(const Ice::Exception& dex)
     {
+        _entry->finishedUpdate();
+
         try
         {
             dex.ice_throw();
@@ -296,6 +373,7 @@ private:
 
     const TraceLevelsPtr _traceLevels;
     const ServerEntryPtr _server;
+    const NodeEntryPtr _entry;
     const string _id;
     const string _node;
 };
@@ -305,7 +383,8 @@ private:
 NodeCache::NodeCache(const Ice::CommunicatorPtr& communicator, ReplicaCache& replicaCache, const string& replicaName) :
     _communicator(communicator),
     _replicaName(replicaName),
-    _replicaCache(replicaCache)
+    _replicaCache(replicaCache),
+    _updateConcurrency(communicator->getProperties()->getPropertyAsInt("IceGrid.Registry.UpdateConcurrency"))
 {
 }
 
@@ -331,6 +410,7 @@ NodeEntry::NodeEntry(NodeCache& cache, const std::string& name) :
     _cache(cache),
     _ref(0),
     _name(name),
+    _updates(0),
     _registering(false)
 {
 }
@@ -523,6 +603,14 @@ NodeEntry::getLoadInfoAndLoadFactor(const string& application, float& loadFactor
     return _session->getLoadInfo();
 }
 
+float
+NodeEntry::getAdapterLatency(const string& id) const
+{
+    Lock sync(*this);
+    checkSession();
+    return _session->getAdapterLatency(id);
+}
+
 NodeSessionIPtr
 NodeEntry::getSession() const
 {
@@ -552,6 +640,113 @@ NodeEntry::canRemove()
 void
 NodeEntry::loadServer(const ServerEntryPtr& entry, const ServerInfo& server, const SessionIPtr& session, int timeout,
                       bool noRestart)
+{
+    PendingUpdate update;
+    update.entry = entry;
+    update.info = server;
+    update.session = session;
+    update.timeout = timeout;
+    update.noRestart = noRestart;
+    update.revisionOnly = false;
+    update.destroy = false;
+    startUpdate(update);
+}
+
+void
+NodeEntry::updateServerRevision(const ServerEntryPtr& entry, const ServerInfo& server, const SessionIPtr& session,
+                                int timeout, bool noRestart)
+{
+    PendingUpdate update;
+    update.entry = entry;
+    update.info = server;
+    update.session = session;
+    update.timeout = timeout;
+    update.noRestart = noRestart;
+    update.revisionOnly = true;
+    update.destroy = false;
+    startUpdate(update);
+}
+
+void
+NodeEntry::destroyServer(const ServerEntryPtr& entry, const ServerInfo& info, int timeout, bool noRestart)
+{
+    PendingUpdate update;
+    update.entry = entry;
+    update.info = info;
+    update.timeout = timeout;
+    update.noRestart = noRestart;
+    update.revisionOnly = false;
+    update.destroy = true;
+    startUpdate(update);
+}
+
+void
+NodeEntry::startUpdate(const PendingUpdate& update)
+{
+    {
+        Lock sync(*this);
+        if(_cache.getUpdateConcurrency() > 0 && _updates >= _cache.getUpdateConcurrency())
+        {
+            //
+            // Too many load or destroy requests are already in progress with this node, the
+            // update is sent once one of these requests completes.
+            //
+            _pendingUpdates.push_back(update);
+            return;
+        }
+        ++_updates;
+    }
+
+    if(!sendUpdate(update))
+    {
+        finishedUpdate(); // The update failed right away, send the next pending update if any.
+    }
+}
+
+void
+NodeEntry::finishedUpdate()
+{
+    while(true)
+    {
+        PendingUpdate update;
+        {
+            Lock sync(*this);
+            if(_pendingUpdates.empty())
+            {
+                --_updates;
+                return;
+            }
+            update = _pendingUpdates.front();
+            _pendingUpdates.pop_front();
+        }
+
+        if(sendUpdate(update))
+        {
+            return;
+        }
+    }
+}
+
+bool
+NodeEntry::sendUpdate(const PendingUpdate& update)
+{
+    if(update.destroy)
+    {
+        return destroyServerImpl(update.entry, update.info, update.timeout, update.noRestart);
+    }
+    else if(update.revisionOnly)
+    {
+        return updateServerRevisionImpl(update.entry, update.info, update.session, update.timeout, update.noRestart);
+    }
+    else
+    {
+        return loadServerImpl(update.entry, update.info, update.session, update.timeout, update.noRestart);
+    }
+}
+
+bool
+NodeEntry::loadServerImpl(const ServerEntryPtr& entry, const ServerInfo& server, const SessionIPtr& session,
+                          int timeout, bool noRestart)
 {
     try
     {
@@ -607,7 +802,7 @@ NodeEntry::loadServer(const ServerEntryPtr& entry, const ServerInfo& server, con
         {
             node->begin_loadServerWithoutRestart(desc, _cache.getReplicaName(),
                                                  newCallback_Node_loadServerWithoutRestart(
-                                                     new LoadCB(_cache.getTraceLevels(), entry, _name, sessionTimeout),
+                                                     new LoadCB(_cache.getTraceLevels(), entry, this, _name, sessionTimeout),
                                                      &LoadCB::response,
                                                      &LoadCB::exception));
         }
@@ -615,19 +810,57 @@ NodeEntry::loadServer(const ServerEntryPtr& entry, const ServerInfo& server, con
         {
             node->begin_loadServer(desc, _cache.getReplicaName(),
                                    newCallback_Node_loadServer(
-                                       new LoadCB(_cache.getTraceLevels(), entry, _name, sessionTimeout),
+                                       new LoadCB(_cache.getTraceLevels(), entry, this, _name, sessionTimeout),
                                        &LoadCB::response,
                                        &LoadCB::exception));
         }
+        return true;
     }
     catch(const NodeUnreachableException& ex)
     {
         entry->exception(ex);
+        return false;
     }
 }
 
-void
-NodeEntry::destroyServer(const ServerEntryPtr& entry, const ServerInfo& info, int timeout, bool noRestart)
+bool
+NodeEntry::updateServerRevisionImpl(const ServerEntryPtr& entry, const ServerInfo& server, const SessionIPtr& session,
+                                    int timeout, bool noRestart)
+{
+    try
+    {
+        NodePrx node;
+        int sessionTimeout;
+        {
+            Lock sync(*this);
+            checkSession();
+            node = _session->getNode();
+            sessionTimeout = _session->getTimeout(Ice::emptyCurrent);
+        }
+
+        if(_cache.getTraceLevels() && _cache.getTraceLevels()->server > 2)
+        {
+            Ice::Trace out(_cache.getTraceLevels()->logger, _cache.getTraceLevels()->serverCat);
+            out << "updating `" << server.descriptor->id << "' revision on node `" << _name << "'";
+        }
+
+        LoadCBPtr cb = new LoadCB(_cache.getTraceLevels(), entry, this, _name, sessionTimeout);
+        node->begin_updateServerRevision(server.descriptor->id, server.uuid, server.revision, _cache.getReplicaName(),
+                                         newCallback_Node_updateServerRevision(
+                                             new UpdateRevisionCB(cb, server, session, timeout, noRestart),
+                                             &UpdateRevisionCB::response,
+                                             &UpdateRevisionCB::exception));
+        return true;
+    }
+    catch(const NodeUnreachableException& ex)
+    {
+        entry->exception(ex);
+        return false;
+    }
+}
+
+bool
+NodeEntry::destroyServerImpl(const ServerEntryPtr& entry, const ServerInfo& info, int timeout, bool noRestart)
 {
     try
     {
@@ -660,7 +893,7 @@ NodeEntry::destroyServer(const ServerEntryPtr& entry, const ServerInfo& info, in
             node->begin_destroyServerWithoutRestart(info.descriptor->id, info.uuid, info.revision,
                                                     _cache.getReplicaName(),
                                                     newCallback_Node_destroyServerWithoutRestart(
-                                                        new DestroyCB(_cache.getTraceLevels(), entry, _name),
+                                                        new DestroyCB(_cache.getTraceLevels(), entry, this, _name),
                                                         &DestroyCB::response,
                                                         &DestroyCB::exception));
         }
@@ -668,14 +901,16 @@ NodeEntry::destroyServer(const ServerEntryPtr& entry, const ServerInfo& info, in
         {
             node->begin_destroyServer(info.descriptor->id, info.uuid, info.revision, _cache.getReplicaName(),
                                       newCallback_Node_destroyServer(
-                                          new DestroyCB(_cache.getTraceLevels(), entry, _name),
+                                          new DestroyCB(_cache.getTraceLevels(), entry, this, _name),
                                           &DestroyCB::response,
                                           &DestroyCB::exception));
         }
+        return true;
     }
     catch(const NodeUnreachableException& ex)
     {
         entry->exception(ex);
+        return false;
     }
 }
 
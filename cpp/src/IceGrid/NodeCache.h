@@ -10,6 +10,8 @@
 #include <IceGrid/Cache.h>
 #include <IceGrid/Internal.h>
 
+#include <deque>
+
 namespace IceGrid
 {
 
@@ -45,6 +47,7 @@ public:
     InternalNodeInfoPtr getInfo() const;
     ServerEntrySeq getServers() const;
     LoadInfo getLoadInfoAndLoadFactor(const std::string&, float&) const;
+    float getAdapterLatency(const std::string&) const;
     NodeSessionIPtr getSession() const;
 
     Ice::ObjectPrx getAdminProxy() const;
@@ -52,6 +55,7 @@ public:
     bool canRemove();
 
     void loadServer(const ServerEntryPtr&, const ServerInfo&, const SessionIPtr&, int, bool);
+    void updateServerRevision(const ServerEntryPtr&, const ServerInfo&, const SessionIPtr&, int, bool);
     void destroyServer(const ServerEntryPtr&, const ServerInfo&, int, bool);
 
     ServerInfo getServerInfo(const ServerInfo&, const SessionIPtr&);
@@ -65,8 +69,27 @@ public:
     void finishedRegistration();
     void finishedRegistration(const Ice::Exception&);
 
+    void finishedUpdate();
+
 private:
 
+    struct PendingUpdate
+    {
+        ServerEntryPtr entry;
+        ServerInfo info;
+        SessionIPtr session;
+        int timeout;
+        bool noRestart;
+        bool revisionOnly;
+        bool destroy;
+    };
+
+    void startUpdate(const PendingUpdate&);
+    bool sendUpdate(const PendingUpdate&);
+    bool loadServerImpl(const ServerEntryPtr&, const ServerInfo&, const SessionIPtr&, int, bool);
+    bool updateServerRevisionImpl(const ServerEntryPtr&, const ServerInfo&, const SessionIPtr&, int, bool);
+    bool destroyServerImpl(const ServerEntryPtr&, const ServerInfo&, int, bool);
+
     ServerDescriptorPtr getServerDescriptor(const ServerInfo&, const SessionIPtr&);
     InternalServerDescriptorPtr getInternalServerDescriptor(const ServerInfo&) const;
 
@@ -77,6 +100,8 @@ private:
     NodeSessionIPtr _session;
     std::map<std::string, ServerEntryPtr> _servers;
     std::map<std::string, NodeDescriptor> _descriptors;
+    int _updates;
+    std::deque<PendingUpdate> _pendingUpdates;
 
     mutable bool _registering;
     mutable NodePrx _proxy;
@@ -94,12 +119,14 @@ public:
     const Ice::CommunicatorPtr& getCommunicator() const { return _communicator; }
     const std::string& getReplicaName() const { return _replicaName; }
     ReplicaCache& getReplicaCache() const { return _replicaCache; }
+    int getUpdateConcurrency() const { return _updateConcurrency; }
 
 private:
 
     const Ice::CommunicatorPtr _communicator;
     const std::string _replicaName;
     ReplicaCache& _replicaCache;
+    const int _updateConcurrency;
 };
 
 };
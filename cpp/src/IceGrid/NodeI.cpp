@@ -242,6 +242,57 @@ private:
     ServerDynamicInfo _info;
 };
 
+class AdapterLatencyTask : public IceUtil::TimerTask
+{
+public:
+
+    AdapterLatencyTask(const NodeIPtr& node) : _node(node)
+    {
+    }
+
+    virtual void
+    runTimerTask()
+    {
+        _node->probeAdapterLatencies();
+    }
+
+private:
+
+    const NodeIPtr _node;
+};
+
+class AdapterMetricsCB : public IceUtil::Shared
+{
+public:
+
+    AdapterMetricsCB(const NodeIPtr& node, const map<string, string>& adapters) :
+        _node(node),
+        _adapters(adapters)
+    {
+    }
+
+    void
+    response(const IceMX::MetricsView& view, Ice::Long)
+    {
+        _node->updateAdapterLatencies(_adapters, view);
+    }
+
+    void
+    exception(const Ice::Exception&)
+    {
+        //
+        // The server is unreachable, didn't answer before the next probe or doesn't
+        // provide the metrics of its adapters, forget their latency.
+        //
+        _node->forgetAdapterLatencies(_adapters);
+    }
+
+private:
+
+    const NodeIPtr _node;
+    const map<string, string> _adapters;
+};
+
 class UpdateAdapter : public NodeI::Update
 {
 public:
@@ -308,6 +359,7 @@ NodeI::NodeI(const Ice::ObjectAdapterPtr& adapter,
     _redirectErrToOut(false),
     _allowEndpointsOverride(false),
     _waitTime(0),
+    _adapterLatencyPeriod(0),
     _instanceName(instanceName),
     _userAccountMapper(mapper),
     _platform("IceGrid.Node", _communicator, _traceLevels),
@@ -321,6 +373,8 @@ NodeI::NodeI(const Ice::ObjectAdapterPtr& adapter,
     const_cast<string&>(_serversDir) = _dataDir + "/servers";
     const_cast<string&>(_tmpDir) = _dataDir + "/tmp";
     const_cast<Ice::Int&>(_waitTime) = props->getPropertyAsIntWithDefault("IceGrid.Node.WaitTime", 60);
+    const_cast<Ice::Int&>(_adapterLatencyPeriod) =
+        props->getPropertyAsIntWithDefault("IceGrid.Node.AdapterLatencyPeriod", 5);
     const_cast<string&>(_outputDir) = props->getProperty("IceGrid.Node.Output");
     const_cast<bool&>(_redirectErrToOut) = props->getPropertyAsInt("IceGrid.Node.RedirectErrToOut") > 0;
     const_cast<bool&>(_allowEndpointsOverride) = props->getPropertyAsInt("IceGrid.Node.AllowEndpointsOverride") > 0;
@@ -415,6 +469,46 @@ NodeI::loadServerWithoutRestart_async(const AMD_Node_loadServerWithoutRestartPtr
     loadServer(new LoadServerCB(amdCB), descriptor, replicaName, true, current);
 }
 
+void
+NodeI::updateServerRevision_async(const AMD_Node_updateServerRevisionPtr& amdCB,
+                                  const string& serverId,
+                                  const string& uuid,
+                                  int revision,
+                                  const string& replicaName,
+                                  const Ice::Current& current)
+{
+    Lock sync(*this);
+    ++_serial;
+
+    ServerIPtr server;
+    try
+    {
+        server = ServerIPtr::dynamicCast(_adapter->find(createServerIdentity(serverId)));
+    }
+    catch(const Ice::ObjectAdapterDeactivatedException&)
+    {
+        //
+        // We throw an object not exist exception to avoid dispatch
+        // warnings, see loadServer() below.
+        //
+        throw Ice::ObjectNotExistException(__FILE__, __LINE__, current.id, current.facet, current.operation);
+    }
+
+    if(!server)
+    {
+        throw DeploymentException("server `" + serverId + "' is not loaded");
+    }
+
+    try
+    {
+        server->updateRevision(amdCB, uuid, revision, replicaName);
+    }
+    catch(const Ice::ObjectNotExistException&)
+    {
+        throw DeploymentException("server `" + serverId + "' is not loaded");
+    }
+}
+
 void
 NodeI::destroyServer_async(const AMD_Node_destroyServerPtr& amdCB,
                            const string& serverId,
@@ -817,6 +911,12 @@ NodeI::getOutputDir() const
     return _outputDir;
 }
 
+Ice::Int
+NodeI::getAdapterLatencyPeriod() const
+{
+    return _adapterLatencyPeriod;
+}
+
 bool
 NodeI::getRedirectErrToOut() const
 {
@@ -1075,6 +1175,165 @@ NodeI::removeServer(const ServerIPtr& server, const std::string& application)
     }
 }
 
+void
+NodeI::startAdapterLatencyProbe()
+{
+    if(_adapterLatencyPeriod > 0)
+    {
+        _timer->scheduleRepeated(new AdapterLatencyTask(this), IceUtil::Time::seconds(_adapterLatencyPeriod));
+    }
+}
+
+void
+NodeI::probeAdapterLatencies()
+{
+    set<ServerIPtr> servers;
+    {
+        IceUtil::Mutex::Lock sync(_serversLock);
+        for(map<string, set<ServerIPtr> >::const_iterator p = _serversByApplication.begin();
+            p != _serversByApplication.end(); ++p)
+        {
+            servers.insert(p->second.begin(), p->second.end());
+        }
+    }
+
+    //
+    // The latency of an adapter is computed from the IceMX dispatch metrics of its
+    // server, collected by the IceGrid metrics view (see ServerI::getProperties).
+    //
+    set<string> probed;
+    for(set<ServerIPtr>::const_iterator p = servers.begin(); p != servers.end(); ++p)
+    {
+        Ice::ObjectPrx admin = (*p)->getProcess();
+        map<string, string> adapters = (*p)->getAdapterIds();
+        if(!admin || adapters.empty())
+        {
+            continue;
+        }
+
+        for(map<string, string>::const_iterator q = adapters.begin(); q != adapters.end(); ++q)
+        {
+            probed.insert(q->second);
+        }
+
+        try
+        {
+            IceMX::MetricsAdminPrx metrics = IceMX::MetricsAdminPrx::uncheckedCast(
+                admin->ice_facet("Metrics")->ice_invocationTimeout(_adapterLatencyPeriod * 1000));
+            metrics->begin_getMetricsView("IceGrid",
+                                          IceMX::newCallback_MetricsAdmin_getMetricsView(
+                                              new AdapterMetricsCB(this, adapters),
+                                              &AdapterMetricsCB::response,
+                                              &AdapterMetricsCB::exception));
+        }
+        catch(const Ice::LocalException&)
+        {
+            // Ignore, the node is being shutdown.
+        }
+    }
+
+    //
+    // Forget the latency of the adapters which are no longer active.
+    //
+    IceUtil::Mutex::Lock sync(_latencyMutex);
+    map<string, AdapterLatency>::iterator p = _adapterLatencies.begin();
+    while(p != _adapterLatencies.end())
+    {
+        if(probed.find(p->first) == probed.end())
+        {
+            _adapterLatencies.erase(p++);
+        }
+        else
+        {
+            ++p;
+        }
+    }
+}
+
+void
+NodeI::updateAdapterLatencies(const map<string, string>& adapters, const IceMX::MetricsView& view)
+{
+    IceMX::MetricsView::const_iterator d = view.find("Dispatch");
+    if(d == view.end())
+    {
+        forgetAdapterLatencies(adapters);
+        return;
+    }
+
+    IceUtil::Mutex::Lock sync(_latencyMutex);
+    for(IceMX::MetricsMap::const_iterator p = d->second.begin(); p != d->second.end(); ++p)
+    {
+        //
+        // The dispatch metrics are grouped by adapter name.
+        //
+        map<string, string>::const_iterator q = adapters.find((*p)->id);
+        if(q == adapters.end())
+        {
+            continue; // The Ice.Admin adapter or an adapter without id.
+        }
+
+        const Ice::Long completed = (*p)->total - (*p)->current;
+        map<string, AdapterLatency>::iterator r = _adapterLatencies.find(q->second);
+        if(r == _adapterLatencies.end() || completed < r->second.completed)
+        {
+            //
+            // First sample or the server was restarted, the next sample computes the latency.
+            //
+            AdapterLatency latency;
+            latency.completed = completed;
+            latency.lifetime = (*p)->totalLifetime;
+            latency.latency = r == _adapterLatencies.end() ? -1.0f : r->second.latency;
+            _adapterLatencies[q->second] = latency;
+            continue;
+        }
+
+        //
+        // The average lifetime of the dispatches completed since the last sample. If there
+        // was no dispatch, the adapter keeps its latency.
+        //
+        if(completed > r->second.completed)
+        {
+            const float sample = static_cast<float>((*p)->totalLifetime - r->second.lifetime) /
+                static_cast<float>(completed - r->second.completed) / 1000.0f;
+            if(r->second.latency < 0.0f)
+            {
+                r->second.latency = sample;
+            }
+            else
+            {
+                r->second.latency = 0.7f * r->second.latency + 0.3f * sample; // Exponentially weighted moving average
+            }
+            r->second.completed = completed;
+            r->second.lifetime = (*p)->totalLifetime;
+        }
+    }
+}
+
+void
+NodeI::forgetAdapterLatencies(const map<string, string>& adapters)
+{
+    IceUtil::Mutex::Lock sync(_latencyMutex);
+    for(map<string, string>::const_iterator p = adapters.begin(); p != adapters.end(); ++p)
+    {
+        _adapterLatencies.erase(p->second);
+    }
+}
+
+AdapterLatencyDict
+NodeI::getAdapterLatencies() const
+{
+    IceUtil::Mutex::Lock sync(_latencyMutex);
+    AdapterLatencyDict latencies;
+    for(map<string, AdapterLatency>::const_iterator p = _adapterLatencies.begin(); p != _adapterLatencies.end(); ++p)
+    {
+        if(p->second.latency >= 0.0f)
+        {
+            latencies.insert(make_pair(p->first, p->second.latency));
+        }
+    }
+    return latencies;
+}
+
 Ice::Identity
 NodeI::createServerIdentity(const string& name) const
 {
@@ -71,6 +71,13 @@ public:
                                                 const std::string&,
                                                 const Ice::Current&);
 
+    virtual void updateServerRevision_async(const AMD_Node_updateServerRevisionPtr&,
+                                            const std::string&,
+                                            const std::string&,
+                                            int,
+                                            const std::string&,
+                                            const Ice::Current&);
+
     virtual void destroyServer_async(const AMD_Node_destroyServerPtr&,
                                      const std::string&,
                                      const std::string&,
@@ -119,6 +126,7 @@ public:
 
     std::string getOutputDir() const;
     bool getRedirectErrToOut() const;
+    Ice::Int getAdapterLatencyPeriod() const;
     bool allowEndpointsOverride() const;
 
     NodeSessionPrx registerWithRegistry(const InternalRegistryPrx&);
@@ -135,6 +143,12 @@ public:
     void addServer(const ServerIPtr&, const std::string&);
     void removeServer(const ServerIPtr&, const std::string&);
 
+    void startAdapterLatencyProbe();
+    void probeAdapterLatencies();
+    void updateAdapterLatencies(const std::map<std::string, std::string>&, const IceMX::MetricsView&);
+    void forgetAdapterLatencies(const std::map<std::string, std::string>&);
+    AdapterLatencyDict getAdapterLatencies() const;
+
     Ice::Identity createServerIdentity(const std::string&) const;
     std::string getServerAdminCategory() const;
 
@@ -166,6 +180,7 @@ private:
     const bool _redirectErrToOut;
     const bool _allowEndpointsOverride;
     const Ice::Int _waitTime;
+    const Ice::Int _adapterLatencyPeriod;
     const std::string _instanceName;
     const UserAccountMapperPrx _userAccountMapper;
     mutable PlatformInfo _platform;
@@ -185,6 +200,16 @@ private:
 
     std::map<NodeObserverPrx, std::deque<UpdatePtr> > _observerUpdates;
 
+    struct AdapterLatency
+    {
+        Ice::Long completed; // Number of dispatches completed at the last sample
+        Ice::Long lifetime; // Total lifetime of these dispatches in microseconds
+        float latency; // Average dispatch latency in milliseconds, negative if unknown
+    };
+
+    mutable IceUtil::Mutex _latencyMutex;
+    std::map<std::string, AdapterLatency> _adapterLatencies;
+
     IceUtil::Mutex _serversLock;
     std::map<std::string, std::set<ServerIPtr> > _serversByApplication;
     std::set<std::string> _patchInProgress;
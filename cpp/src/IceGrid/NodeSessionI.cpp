@@ -195,6 +195,18 @@ NodeSessionI::keepAlive(const LoadInfo& load, const Ice::Current&)
     }
 }
 
+void
+NodeSessionI::reportAdapterLatencies(const AdapterLatencyDict& latencies, const Ice::Current&)
+{
+    Lock sync(*this);
+    if(_destroy)
+    {
+        throw Ice::ObjectNotExistException(__FILE__, __LINE__);
+    }
+
+    _adapterLatencies = latencies;
+}
+
 void
 NodeSessionI::setReplicaObserver(const ReplicaObserverPrx& observer, const Ice::Current&)
 {
@@ -342,6 +354,14 @@ NodeSessionI::getLoadInfo() const
     return _load;
 }
 
+float
+NodeSessionI::getAdapterLatency(const string& id) const
+{
+    Lock sync(*this);
+    AdapterLatencyDict::const_iterator p = _adapterLatencies.find(id);
+    return p != _adapterLatencies.end() ? p->second : -1.0f;
+}
+
 NodeSessionPrx
 NodeSessionI::getProxy() const
 {
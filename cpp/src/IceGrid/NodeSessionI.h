@@ -54,6 +54,7 @@ public:
     NodeSessionI(const DatabasePtr&, const NodePrx&, const InternalNodeInfoPtr&, int, const LoadInfo&);
 
     virtual void keepAlive(const LoadInfo&, const Ice::Current&);
+    virtual void reportAdapterLatencies(const AdapterLatencyDict&, const Ice::Current&);
     virtual void setReplicaObserver(const ReplicaObserverPrx&, const Ice::Current&);
     virtual int getTimeout(const Ice::Current&) const;
     virtual NodeObserverPrx getObserver(const Ice::Current&) const;
@@ -71,6 +72,7 @@ public:
     const NodePrx& getNode() const;
     const InternalNodeInfoPtr& getInfo() const;
     const LoadInfo& getLoadInfo() const;
+    float getAdapterLatency(const std::string&) const;
     NodeSessionPrx getProxy() const;
 
     bool isDestroyed() const;
@@ -90,6 +92,7 @@ private:
     ReplicaObserverPrx _replicaObserver;
     IceUtil::Time _timestamp;
     LoadInfo _load;
+    AdapterLatencyDict _adapterLatencies;
     bool _destroy;
     std::set<PatcherFeedbackPtr> _feedbacks;
 };
@@ -207,6 +207,16 @@ NodeSessionKeepAliveThread::keepAlive(const NodeSessionPrx& session)
     try
     {
         session->keepAlive(_node->getPlatformInfo().getLoadInfo());
+
+        //
+        // Report the adapter latencies with a oneway invocation, registries which don't
+        // support the latency load balancing policy just ignore it.
+        //
+        AdapterLatencyDict latencies = _node->getAdapterLatencies();
+        if(!latencies.empty())
+        {
+            NodeSessionPrx::uncheckedCast(session->ice_oneway())->reportAdapterLatencies(latencies);
+        }
         return true;
     }
     catch(const Ice::LocalException& ex)
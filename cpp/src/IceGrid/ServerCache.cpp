@@ -360,6 +360,7 @@ ServerEntry::ServerEntry(ServerCache& cache, const string& id) :
     _deactivationTimeout(-1),
     _synchronizing(false),
     _updated(false),
+    _revisionOnly(false),
     _noRestart(false)
 {
 }
@@ -422,7 +423,7 @@ ServerEntry::addSyncCallback(const SynchronizationCallbackPtr& callback)
 }
 
 void
-ServerEntry::update(const ServerInfo& info, bool noRestart)
+ServerEntry::update(const ServerInfo& info, bool noRestart, bool revisionOnly)
 {
     Lock sync(*this);
 
@@ -431,6 +432,13 @@ ServerEntry::update(const ServerInfo& info, bool noRestart)
 
     _updated = true;
 
+    //
+    // If the descriptor didn't change and the server is loaded on the
+    // same node, the node only needs to update the server revision.
+    //
+    revisionOnly = revisionOnly && _loaded.get() && !_destroy.get() && _loaded->node == info.node;
+    const string sessionId = revisionOnly ? _loaded->sessionId : string();
+
     if(!_destroy.get())
     {
         if(_loaded.get() && descriptor->node != _loaded->node)
@@ -452,6 +460,7 @@ ServerEntry::update(const ServerInfo& info, bool noRestart)
         _allocatable = true;
         _load->sessionId = _allocationSession ? _allocationSession->getId() : string("");
     }
+    _revisionOnly = revisionOnly && _load->sessionId == sessionId;
 }
 
 void
@@ -477,6 +486,7 @@ ServerEntry::destroy(bool noRestart)
     }
 
     _noRestart = noRestart;
+    _revisionOnly = false;
     _load.reset();
     _loaded.reset();
     _allocatable = false;
@@ -665,6 +675,28 @@ ServerEntry::getLoad(LoadSample sample) const
     }
 }
 
+float
+ServerEntry::getAdapterLatency(const string& adapterId) const
+{
+    string node;
+    {
+        Lock sync(*this);
+        if(_loaded.get())
+        {
+            node = _loaded->node;
+        }
+        else if(_load.get())
+        {
+            node = _load->node;
+        }
+        else
+        {
+            throw ServerNotExistException();
+        }
+    }
+    return _cache.getNodeCache().get(node)->getAdapterLatency(adapterId);
+}
+
 void
 ServerEntry::syncImpl()
 {
@@ -673,6 +705,7 @@ ServerEntry::syncImpl()
     ServerInfo destroy;
     int timeout = -1;
     bool noRestart = false;
+    bool revisionOnly = false;
 
     {
         Lock sync(*this);
@@ -706,6 +739,8 @@ ServerEntry::syncImpl()
         }
 
         noRestart = _noRestart;
+        revisionOnly = _revisionOnly;
+        _revisionOnly = false;
         _synchronizing = true;
     }
 
@@ -724,7 +759,15 @@ ServerEntry::syncImpl()
     {
         try
         {
-            _cache.getNodeCache().get(load.node)->loadServer(this, load, session, timeout, noRestart);
+            NodeEntryPtr node = _cache.getNodeCache().get(load.node);
+            if(revisionOnly)
+            {
+                node->updateServerRevision(this, load, session, timeout, noRestart);
+            }
+            else
+            {
+                node->loadServer(this, load, session, timeout, noRestart);
+            }
         }
         catch(const NodeNotExistException&)
         {
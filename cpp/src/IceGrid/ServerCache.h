@@ -73,7 +73,7 @@ public:
 
     bool addSyncCallback(const SynchronizationCallbackPtr&);
 
-    void update(const ServerInfo&, bool);
+    void update(const ServerInfo&, bool, bool = false);
 
     void destroy(bool);
 
@@ -87,6 +87,7 @@ public:
     AdapterPrx getAdapter(const std::string&, bool);
     AdapterPrx getAdapter(int&, int&, const std::string&, bool);
     float getLoad(LoadSample) const;
+    float getAdapterLatency(const std::string&) const;
 
     bool canRemove();
     CheckUpdateResultPtr checkUpdate(const ServerInfo&, bool);
@@ -122,6 +123,7 @@ private:
 
     bool _synchronizing;
     bool _updated;
+    bool _revisionOnly;
     IceInternal::UniquePtr<Ice::Exception> _exception;
     bool _noRestart;
     std::vector<SynchronizationCallbackPtr> _callbacks;
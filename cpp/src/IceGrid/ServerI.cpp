@@ -930,6 +930,38 @@ ServerI::getProcess() const
     }
 }
 
+map<string, string>
+ServerI::getAdapterIds() const
+{
+    Lock sync(*this);
+
+    map<string, string> adapters;
+    if(!_desc)
+    {
+        return adapters;
+    }
+
+    //
+    // The adapter names are only known from the <name>.AdapterId properties of
+    // the server configuration file.
+    //
+    const string suffix = ".AdapterId";
+    PropertyDescriptorSeqDict::const_iterator p = _desc->properties.find("config");
+    if(p != _desc->properties.end())
+    {
+        for(PropertyDescriptorSeq::const_iterator q = p->second.begin(); q != p->second.end(); ++q)
+        {
+            if(q->name.size() > suffix.size() &&
+               q->name.compare(q->name.size() - suffix.size(), suffix.size(), suffix) == 0 &&
+               _adapters.find(q->value) != _adapters.end())
+            {
+                adapters[q->name.substr(0, q->name.size() - suffix.size())] = q->value;
+            }
+        }
+    }
+    return adapters;
+}
+
 void
 ServerI::setEnabled(bool enabled, const ::Ice::Current&)
 {
@@ -1313,6 +1345,36 @@ ServerI::load(const AMD_Node_loadServerPtr& amdCB, const InternalServerDescripto
     return nextCommand();
 }
 
+void
+ServerI::updateRevision(const AMD_Node_updateServerRevisionPtr& amdCB, const string& uuid, int revision,
+                        const string& replicaName)
+{
+    Lock sync(*this);
+    checkDestroyed();
+    checkRevision(replicaName, uuid, revision);
+
+    //
+    // Only the revision of a loaded server is updated here, a server
+    // being loaded or destroyed must be loaded with its descriptor.
+    //
+    if(!_desc || _load || _destroy || _desc->uuid != uuid)
+    {
+        throw DeploymentException("server `" + _id + "' is not loaded");
+    }
+
+    if(_desc->revision != revision)
+    {
+        updateRevision(uuid, revision);
+    }
+
+    AdapterPrxDict adapters;
+    for(ServerAdapterDict::const_iterator p = _adapters.begin(); p != _adapters.end(); ++p)
+    {
+        adapters.insert(make_pair(p->first, p->second->getProxy()));
+    }
+    amdCB->ice_response(_this, adapters, _activationTimeout, _deactivationTimeout);
+}
+
 bool
 ServerI::checkUpdate(const InternalServerDescriptorPtr& desc, bool noRestart, const Ice::Current&)
 {
@@ -3199,6 +3261,25 @@ ServerI::getProperties(const InternalServerDescriptorPtr& desc)
         }
     }
 
+    //
+    // Collect the dispatch metrics of the object adapters which are members of
+    // a replica group, the node reports their latency for the latency load
+    // balancing policy.
+    //
+    if(_node->getAdapterLatencyPeriod() > 0 && getProperty(props, "IceMX.Metrics.IceGrid.Map.Dispatch.GroupBy").empty())
+    {
+        const string suffix = ".ReplicaGroupId";
+        for(PropertyDescriptorSeq::const_iterator p = props.begin(); p != props.end(); ++p)
+        {
+            if(!p->value.empty() && p->name.size() > suffix.size() &&
+               p->name.compare(p->name.size() - suffix.size(), suffix.size(), suffix) == 0)
+            {
+                props.push_back(createProperty("IceMX.Metrics.IceGrid.Map.Dispatch.GroupBy", "parent"));
+                break;
+            }
+        }
+    }
+
     //
     // Add the locator proxy property and the node properties override
     //
@@ -97,6 +97,7 @@ public:
 
     void start(ServerActivation, const AMD_Server_startPtr& = AMD_Server_startPtr());
     ServerCommandPtr load(const AMD_Node_loadServerPtr&, const InternalServerDescriptorPtr&, const std::string&, bool);
+    void updateRevision(const AMD_Node_updateServerRevisionPtr&, const std::string&, int, const std::string&);
     bool checkUpdate(const InternalServerDescriptorPtr&, bool, const Ice::Current&);
     void checkRemove(bool, const Ice::Current&);
     ServerCommandPtr destroy(const AMD_Node_destroyServerPtr&, const std::string&, int, const std::string&, bool);
@@ -121,6 +122,11 @@ public:
     //
     Ice::ObjectPrx getProcess() const;
 
+    //
+    // The ids of the server object adapters, indexed by adapter name
+    //
+    std::map<std::string, std::string> getAdapterIds() const;
+
     PropertyDescriptorSeqDict getProperties(const InternalServerDescriptorPtr&);
 
     void updateRuntimePropertiesCallback(const InternalServerDescriptorPtr&);
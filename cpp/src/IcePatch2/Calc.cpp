@@ -105,6 +105,9 @@ usage(const string& appName)
         "-Z, --no-compress       Never compress files.\n"
         "-i, --case-insensitive  Files must not differ in case only.\n"
         "-V, --verbose           Verbose mode.\n"
+        "--incremental           Reuse the checksums cached by the previous run for\n"
+        "                        the files whose size and modification time didn't\n"
+        "                        change.\n"
         ;
 }
 
@@ -128,6 +131,7 @@ main(int argc, char* argv[])
     int compress = 1;
     bool verbose;
     bool caseInsensitive;
+    bool incremental;
 
     IceUtilInternal::Options opts;
     opts.addOpt("h", "help");
@@ -136,6 +140,7 @@ main(int argc, char* argv[])
     opts.addOpt("Z", "no-compress");
     opts.addOpt("V", "verbose");
     opts.addOpt("i", "case-insensitive");
+    opts.addOpt("", "incremental");
 
     vector<string> args;
     try
@@ -177,6 +182,7 @@ main(int argc, char* argv[])
     }
     verbose = opts.isSet("verbose");
     caseInsensitive = opts.isSet("case-insensitive");
+    incremental = opts.isSet("incremental");
 
     if(args.empty())
     {
@@ -236,7 +242,7 @@ main(int argc, char* argv[])
         if(fileSeq.empty())
         {
             CalcCB calcCB;
-            if(!getFileInfoSeq(absDataDir, compress, verbose ? &calcCB : 0, infoSeq))
+            if(!getFileInfoSeq(absDataDir, compress, verbose ? &calcCB : 0, infoSeq, incremental))
             {
                 return EXIT_FAILURE;
             }
@@ -250,7 +256,8 @@ main(int argc, char* argv[])
                 LargeFileInfoSeq partialInfoSeq;
 
                 CalcCB calcCB;
-                if(!getFileInfoSeqSubDir(absDataDir, *p, compress, verbose ? &calcCB : 0, partialInfoSeq))
+                if(!getFileInfoSeqSubDir(absDataDir, *p, compress, verbose ? &calcCB : 0, partialInfoSeq,
+                                         incremental))
                 {
                     return EXIT_FAILURE;
                 }
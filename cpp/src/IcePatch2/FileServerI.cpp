@@ -5,12 +5,14 @@
 #include <IceUtil/DisableWarnings.h>
 #include <IceUtil/FileUtil.h>
 #include <IceUtil/StringUtil.h>
+#include <IceUtil/StringConverter.h>
 #include <IcePatch2/FileServerI.h>
 
 #ifdef _WIN32
 #   include <io.h>
 #else
 #   include <unistd.h>
+#   include <sys/mman.h>
 #endif
 
 using namespace std;
@@ -18,8 +20,116 @@ using namespace Ice;
 using namespace IcePatch2;
 using namespace IcePatch2Internal;
 
-IcePatch2::FileServerI::FileServerI(const std::string& dataDir, const LargeFileInfoSeq& infoSeq) :
-    _dataDir(dataDir), _tree0(FileTree0())
+namespace
+{
+
+//
+// The interval in milliseconds after which a cached file is checked again for
+// changes of the data directory.
+//
+const int checkInterval = 1000;
+
+//
+// The nanoseconds of the modification time, if the platform provides them.
+//
+long
+getMtimeNsec(const IceUtilInternal::structstat& buf)
+{
+#if defined(__APPLE__)
+    return buf.st_mtimespec.tv_nsec;
+#elif defined(__linux__) || defined(__sun) || defined(__FreeBSD__)
+    return buf.st_mtim.tv_nsec;
+#else
+    return 0;
+#endif
+}
+
+}
+
+IcePatch2::MappedFile::MappedFile(const string& path, const IceUtilInternal::structstat& buf) :
+    _data(0),
+    _size(static_cast<Long>(buf.st_size)),
+    _ino(static_cast<Long>(buf.st_ino)),
+    _mtime(buf.st_mtime),
+    _mtimeNsec(getMtimeNsec(buf))
+{
+    if(_size == 0)
+    {
+        return; // Empty files can't be mapped.
+    }
+
+#ifdef _WIN32
+    HANDLE file = CreateFileW(IceUtil::stringToWstring(path).c_str(), GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, 0, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, 0);
+    if(file == INVALID_HANDLE_VALUE)
+    {
+        throw FileAccessException("cannot open `" + path + "' for reading: " + IceUtilInternal::lastErrorToString());
+    }
+    HANDLE mapping = CreateFileMappingW(file, 0, PAGE_READONLY, 0, 0, 0);
+    CloseHandle(file);
+    if(mapping == 0)
+    {
+        throw FileAccessException("cannot map `" + path + "': " + IceUtilInternal::lastErrorToString());
+    }
+    _data = static_cast<const Byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    CloseHandle(mapping);
+    if(_data == 0)
+    {
+        throw FileAccessException("cannot map `" + path + "': " + IceUtilInternal::lastErrorToString());
+    }
+#else
+    if(static_cast<Long>(static_cast<size_t>(_size)) != _size)
+    {
+        throw FileAccessException("cannot map `" + path + "': file too large");
+    }
+
+    int fd = IceUtilInternal::open(path, O_RDONLY);
+    if(fd == -1)
+    {
+        throw FileAccessException("cannot open `" + path + "' for reading: " + IceUtilInternal::errorToString(errno));
+    }
+    //
+    // The file must not be truncated while it's mapped, see the MappedFile
+    // class comment.
+    //
+    void* data = mmap(0, static_cast<size_t>(_size), PROT_READ, MAP_SHARED, fd, 0);
+    IceUtilInternal::close(fd); // The mapping doesn't need the file descriptor.
+    if(data == MAP_FAILED)
+    {
+        throw FileAccessException("cannot map `" + path + "': " + IceUtilInternal::errorToString(errno));
+    }
+    _data = static_cast<const Byte*>(data);
+#endif
+}
+
+IcePatch2::MappedFile::~MappedFile()
+{
+    if(_data != 0)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(_data);
+#else
+        munmap(const_cast<Byte*>(_data), static_cast<size_t>(_size));
+#endif
+    }
+}
+
+bool
+IcePatch2::MappedFile::isCurrent(const IceUtilInternal::structstat& buf) const
+{
+    //
+    // A file renamed over the mapped file has a different inode, even if it has
+    // the same size and was written within the same second.
+    //
+    return static_cast<Long>(buf.st_size) == _size &&
+        static_cast<Long>(buf.st_ino) == _ino &&
+        buf.st_mtime == _mtime &&
+        getMtimeNsec(buf) == _mtimeNsec;
+}
+
+IcePatch2::FileServerI::FileServerI(const std::string& dataDir, const LargeFileInfoSeq& infoSeq, int cacheSize) :
+    _dataDir(dataDir), _tree0(FileTree0()), _cacheSize(static_cast<size_t>(max(cacheSize, 0)))
 {
     FileTree0& tree0 = const_cast<FileTree0&>(_tree0);
     getFileTree0(infoSeq, tree0);
@@ -72,15 +182,8 @@ IcePatch2::FileServerI::getFileCompressed_async(const AMD_FileServer_getFileComp
     try
     {
         vector<Byte> buffer;
-        getFileCompressedInternal(pa, pos, num, buffer, false);
-        if(buffer.empty())
-        {
-            cb->ice_response(make_pair<const Byte*, const Byte*>(0, 0));
-        }
-        else
-        {
-            cb->ice_response(make_pair<const Byte*, const Byte*>(&buffer[0], &buffer[0] + buffer.size()));
-        }
+        MappedFilePtr file;
+        cb->ice_response(getFileCompressedInternal(pa, pos, num, buffer, file, false));
     }
     catch(const std::exception& ex)
     {
@@ -95,16 +198,8 @@ IcePatch2::FileServerI::getLargeFileCompressed_async(const AMD_FileServer_getLar
     try
     {
         vector<Byte> buffer;
-        getFileCompressedInternal(pa, pos, num, buffer, true);
-        if(buffer.empty())
-        {
-            cb->ice_response(make_pair<const Byte*, const Byte*>(0, 0));
-        }
-        else
-        {
-            cb->ice_response(make_pair<const Byte*, const Byte*>(&buffer[0], &buffer[0] + buffer.size()));
-        }
-
+        MappedFilePtr file;
+        cb->ice_response(getFileCompressedInternal(pa, pos, num, buffer, file, true));
     }
     catch(const std::exception& ex)
     {
@@ -112,9 +207,9 @@ IcePatch2::FileServerI::getLargeFileCompressed_async(const AMD_FileServer_getLar
     }
 }
 
-void
+pair<const Byte*, const Byte*>
 IcePatch2::FileServerI::getFileCompressedInternal(const std::string& pa, Ice::Long pos, Ice::Int num,
-                                                  vector<Byte>& buffer, bool largeFile) const
+                                                  vector<Byte>& buffer, MappedFilePtr& file, bool largeFile) const
 {
     if(IceUtilInternal::isAbsolutePath(pa))
     {
@@ -132,10 +227,33 @@ IcePatch2::FileServerI::getFileCompressedInternal(const std::string& pa, Ice::Lo
 
     if(num <= 0 || pos < 0)
     {
-        return;
+        return pair<const Byte*, const Byte*>(static_cast<const Byte*>(0), static_cast<const Byte*>(0));
     }
 
     string absolutePath = _dataDir + '/' + path + ".bz2";
+
+    //
+    // Send the chunk directly from the mapped file if it's available, otherwise read
+    // the chunk from the file.
+    //
+    file = getMappedFile(absolutePath);
+    if(file)
+    {
+        if(!largeFile && file->size() > 0x7FFFFFFF)
+        {
+            ostringstream os;
+            os << "cannot encode size `" << file->size() << "' for file `" << path << "' as Ice::Int" << endl;
+            throw FileAccessException(os.str());
+        }
+
+        if(pos >= file->size())
+        {
+            return pair<const Byte*, const Byte*>(static_cast<const Byte*>(0), static_cast<const Byte*>(0));
+        }
+        const Byte* begin = file->data() + pos;
+        return make_pair(begin, begin + min(static_cast<Long>(num), file->size() - pos));
+    }
+
     int fd = IceUtilInternal::open(absolutePath, O_RDONLY|O_BINARY);
     if(fd == -1)
     {
@@ -190,4 +308,92 @@ IcePatch2::FileServerI::getFileCompressedInternal(const std::string& pa, Ice::Lo
     }
 
     IceUtilInternal::close(fd);
+
+    //
+    // Only return the bytes read, the chunk is shorter at the end of the file.
+    //
+    buffer.resize(static_cast<size_t>(r));
+    if(buffer.empty())
+    {
+        return pair<const Byte*, const Byte*>(static_cast<const Byte*>(0), static_cast<const Byte*>(0));
+    }
+    return make_pair(&buffer[0], &buffer[0] + buffer.size());
+}
+
+MappedFilePtr
+IcePatch2::FileServerI::getMappedFile(const string& absolutePath) const
+{
+    if(_cacheSize == 0)
+    {
+        return 0;
+    }
+
+    const IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    {
+        IceUtil::Mutex::Lock sync(_cacheMutex);
+        map<string, CacheEntry>::iterator p = _cache.find(absolutePath);
+        if(p != _cache.end())
+        {
+            //
+            // Drop the mapping if the file changed since it was mapped.
+            //
+            bool current = true;
+            if(now - p->second.checked >= IceUtil::Time::milliSeconds(checkInterval))
+            {
+                IceUtilInternal::structstat buf;
+                current = IceUtilInternal::stat(absolutePath, &buf) == 0 && p->second.file->isCurrent(buf);
+                p->second.checked = now;
+            }
+            if(current)
+            {
+                _lru.splice(_lru.begin(), _lru, p->second.lru);
+                return p->second.file;
+            }
+            _lru.erase(p->second.lru);
+            _cache.erase(p);
+        }
+    }
+
+    //
+    // Map the file outside the synchronization. If the file can't be mapped, the chunk
+    // is read from the file which reports the error if the file can't be read either.
+    //
+    MappedFilePtr file;
+    try
+    {
+        IceUtilInternal::structstat buf;
+        if(IceUtilInternal::stat(absolutePath, &buf) == -1)
+        {
+            return 0;
+        }
+        file = new MappedFile(absolutePath, buf);
+    }
+    catch(const FileAccessException&)
+    {
+        return 0;
+    }
+
+    IceUtil::Mutex::Lock sync(_cacheMutex);
+    map<string, CacheEntry>::iterator p = _cache.find(absolutePath);
+    if(p != _cache.end())
+    {
+        return p->second.file; // Another thread mapped the file concurrently.
+    }
+
+    CacheEntry& entry = _cache[absolutePath];
+    entry.file = file;
+    entry.checked = now;
+    _lru.push_front(absolutePath);
+    entry.lru = _lru.begin();
+
+    //
+    // Evict the least recently used files. The mapping of an evicted file is released
+    // once the chunks sent from it are marshaled.
+    //
+    while(_cache.size() > _cacheSize)
+    {
+        _cache.erase(_lru.back());
+        _lru.pop_back();
+    }
+    return file;
 }
@@ -5,17 +5,62 @@
 #ifndef ICE_PATCH2_FILE_SERVER_I_H
 #define ICE_PATCH2_FILE_SERVER_I_H
 
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Time.h>
+#include <IceUtil/FileUtil.h>
 #include <IcePatch2Lib/Util.h>
 #include <IcePatch2/FileServer.h>
 
+#include <list>
+#include <map>
+
 namespace IcePatch2
 {
 
+//
+// A compressed file of the data directory mapped in memory, the chunks of the
+// file are sent directly from the mapping.
+//
+// The cache is only enabled if IcePatch2.FileCacheSize is set. The compressed
+// files must then be replaced by renaming a new file over them, as icepatch2calc
+// does, and never rewritten in place: the mapping keeps the previous file alive
+// until it's released, but reading a mapped page past the end of a file
+// truncated in place raises SIGBUS.
+//
+class MappedFile : public IceUtil::Shared
+{
+public:
+
+    MappedFile(const std::string&, const IceUtilInternal::structstat&);
+    ~MappedFile();
+
+    bool isCurrent(const IceUtilInternal::structstat&) const;
+
+    const Ice::Byte* data() const
+    {
+        return _data;
+    }
+
+    Ice::Long size() const
+    {
+        return _size;
+    }
+
+private:
+
+    const Ice::Byte* _data;
+    const Ice::Long _size;
+    const Ice::Long _ino;
+    const time_t _mtime;
+    const long _mtimeNsec;
+};
+typedef IceUtil::Handle<MappedFile> MappedFilePtr;
+
 class FileServerI : public FileServer
 {
 public:
 
-    FileServerI(const std::string&, const LargeFileInfoSeq&);
+    FileServerI(const std::string&, const LargeFileInfoSeq&, int);
 
     FileInfoSeq getFileInfoSeq(Ice::Int, const Ice::Current&) const;
 
@@ -40,15 +85,32 @@ public:
 
 private:
 
-    void
+    std::pair<const Ice::Byte*, const Ice::Byte*>
     getFileCompressedInternal(const std::string&,
                               Ice::Long,
                               Ice::Int,
                               std::vector<Ice::Byte>&,
+                              MappedFilePtr&,
                               bool) const;
 
+    MappedFilePtr getMappedFile(const std::string&) const;
+
     const std::string _dataDir;
     const IcePatch2Internal::FileTree0 _tree0;
+
+    //
+    // The most recently used mapped files, up to _cacheSize files.
+    //
+    struct CacheEntry
+    {
+        MappedFilePtr file;
+        IceUtil::Time checked;
+        std::list<std::string>::iterator lru;
+    };
+    const size_t _cacheSize;
+    mutable IceUtil::Mutex _cacheMutex;
+    mutable std::map<std::string, CacheEntry> _cache;
+    mutable std::list<std::string> _lru;
 };
 
 }
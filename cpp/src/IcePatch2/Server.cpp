@@ -131,7 +131,12 @@ IcePatch2::PatcherService::start(int argc, char* argv[], int& status)
     Identity id;
     id.category = instanceName;
     id.name = "server";
-    adapter->add(new FileServerI(dataDir, infoSeq), id);
+    //
+    // The cached files are mapped in memory, with the cache enabled the data
+    // directory must be updated by renaming new files over the previous ones
+    // (see MappedFile).
+    //
+    adapter->add(new FileServerI(dataDir, infoSeq, properties->getPropertyAsInt("IcePatch2.FileCacheSize")), id);
 
     adapter->activate();
 
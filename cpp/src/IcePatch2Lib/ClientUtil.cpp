@@ -7,6 +7,7 @@
 #include <IcePatch2/ClientUtil.h>
 #include <IcePatch2Lib/Util.h>
 #include <list>
+#include <deque>
 #include <iterator>
 
 using namespace std;
@@ -28,18 +29,23 @@ IcePatch2::PatcherFeedback::~PatcherFeedback()
 namespace
 {
 
-class Decompressor : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+//
+// Decompresses the downloaded files with a pool of threads.
+//
+class Decompressor : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
 {
 public:
 
     Decompressor(const string&);
     virtual ~Decompressor();
 
+    void start(int);
     void destroy();
+    void join();
     void add(const LargeFileInfo&);
     void exception() const;
     void log(FILE* fp);
-    virtual void run();
+    void run();
 
 private:
 
@@ -49,9 +55,66 @@ private:
     list<LargeFileInfo> _files;
     LargeFileInfoSeq _filesDone;
     bool _destroy;
+    vector<IceUtil::ThreadPtr> _threads;
 };
 typedef IceUtil::Handle<Decompressor> DecompressorPtr;
 
+class DecompressorThread : public IceUtil::Thread
+{
+public:
+
+    DecompressorThread(const DecompressorPtr& decompressor) :
+        _decompressor(decompressor)
+    {
+    }
+
+    virtual void run()
+    {
+        _decompressor->run();
+    }
+
+private:
+
+    const DecompressorPtr _decompressor;
+};
+
+//
+// Requests the chunks of the files ahead of the chunk being written, with up to
+// `window' chunks in flight across at most `maxFiles' files. The chunks are
+// returned in the order of the files and of the positions in the files.
+//
+class ChunkDownloader
+{
+public:
+
+    ChunkDownloader(const FileServerPrx&, bool, Int, int, int, const LargeFileInfoSeq&);
+
+    ByteSeq next(LargeFileInfoSeq::const_iterator, Long);
+
+private:
+
+    void fill();
+
+    struct Request
+    {
+        LargeFileInfoSeq::const_iterator file;
+        Long pos;
+        AsyncResultPtr result;
+    };
+
+    const FileServerPrx _server;
+    const bool _useSmallFileAPI;
+    const Int _chunkSize;
+    const size_t _window;
+    const size_t _maxFiles;
+    const LargeFileInfoSeq& _files;
+
+    deque<Request> _requests;
+    size_t _requestedFiles; // Number of files with chunks in _requests.
+    LargeFileInfoSeq::const_iterator _file; // The file of the next chunk to request.
+    Long _pos; // The position of the next chunk to request.
+};
+
 class PatcherI : public Patcher
 {
 public:
@@ -87,6 +150,10 @@ private:
 
     FILE* _log;
     bool _useSmallFileAPI;
+
+    int _downloadWindow;
+    int _downloadFiles;
+    int _decompressThreads;
 };
 
 Decompressor::Decompressor(const string& dataDir) :
@@ -100,12 +167,41 @@ Decompressor::~Decompressor()
     assert(_destroy);
 }
 
+void
+Decompressor::start(int threads)
+{
+    for(int i = 0; i < threads; ++i)
+    {
+        IceUtil::ThreadPtr thread = new DecompressorThread(this);
+#if defined(__hppa)
+        //
+        // The thread stack size is only 64KB only HP-UX and that's not
+        // enough for this thread.
+        //
+        thread->start(256 * 1024); // 256KB
+#else
+        thread->start();
+#endif
+        _threads.push_back(thread);
+    }
+}
+
 void
 Decompressor::destroy()
 {
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
     _destroy = true;
-    notify();
+    notifyAll();
+}
+
+void
+Decompressor::join()
+{
+    for(vector<IceUtil::ThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+    _threads.clear();
 }
 
 void
@@ -187,12 +283,90 @@ Decompressor::run()
         {
             IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
             _destroy = true;
-            _exception = ex.what();
+            if(_exception.empty())
+            {
+                _exception = ex.what();
+            }
+            notifyAll();
             return;
         }
     }
 }
 
+ChunkDownloader::ChunkDownloader(const FileServerPrx& server, bool useSmallFileAPI, Int chunkSize, int window,
+                                 int maxFiles, const LargeFileInfoSeq& files) :
+    _server(server),
+    _useSmallFileAPI(useSmallFileAPI),
+    _chunkSize(chunkSize),
+    _window(static_cast<size_t>(window)),
+    _maxFiles(static_cast<size_t>(maxFiles)),
+    _files(files),
+    _requestedFiles(0),
+    _file(files.begin()),
+    _pos(0)
+{
+}
+
+ByteSeq
+ChunkDownloader::next(LargeFileInfoSeq::const_iterator file, Long pos)
+{
+    if(_requests.empty() || _requests.front().file != file || _requests.front().pos != pos)
+    {
+        //
+        // The chunks requested ahead don't follow this chunk, this only occurs if the
+        // server returned a smaller chunk than requested. Request again from this chunk.
+        //
+        _requests.clear();
+        _requestedFiles = 0;
+        _file = file;
+        _pos = pos;
+        fill();
+    }
+
+    Request request = _requests.front();
+    _requests.pop_front();
+    if(_requests.empty() || _requests.front().file != request.file)
+    {
+        --_requestedFiles;
+    }
+    fill();
+
+    return _useSmallFileAPI ? _server->end_getFileCompressed(request.result) :
+                              _server->end_getLargeFileCompressed(request.result);
+}
+
+void
+ChunkDownloader::fill()
+{
+    while(_requests.size() < _window && _file != _files.end())
+    {
+        if(_pos >= _file->size) // Directory, empty file or all the chunks requested.
+        {
+            ++_file;
+            _pos = 0;
+            continue;
+        }
+
+        if(_requests.empty() || _requests.back().file != _file)
+        {
+            if(_requestedFiles == _maxFiles)
+            {
+                break;
+            }
+            ++_requestedFiles;
+        }
+
+        Request request;
+        request.file = _file;
+        request.pos = _pos;
+        request.result = _useSmallFileAPI ?
+            _server->begin_getFileCompressed(_file->path, static_cast<Int>(_pos), _chunkSize) :
+            _server->begin_getLargeFileCompressed(_file->path, _pos, _chunkSize);
+        _requests.push_back(request);
+        _pos += _chunkSize;
+    }
+}
+
 PatcherI::PatcherI(const CommunicatorPtr& communicator, const PatcherFeedbackPtr& feedback) :
     _feedback(feedback),
     _dataDir(communicator->getProperties()->getPropertyWithDefault("IcePatch2Client.Directory", ".")),
@@ -200,7 +374,10 @@ PatcherI::PatcherI(const CommunicatorPtr& communicator, const PatcherFeedbackPtr
     _chunkSize(communicator->getProperties()->getPropertyAsIntWithDefault("IcePatch2Client.ChunkSize", 100)),
     _remove(communicator->getProperties()->getPropertyAsIntWithDefault("IcePatch2Client.Remove", 1)),
     _log(0),
-    _useSmallFileAPI(false)
+    _useSmallFileAPI(false),
+    _downloadWindow(1),
+    _downloadFiles(1),
+    _decompressThreads(1)
 {
     const char* clientProxyProperty = "IcePatch2Client.Proxy";
     string clientProxy = communicator->getProperties()->getProperty(clientProxyProperty);
@@ -229,7 +406,10 @@ PatcherI::PatcherI(const FileServerPrx& server,
     _thorough(thorough),
     _chunkSize(chunkSize),
     _remove(remove),
-    _useSmallFileAPI(false)
+    _useSmallFileAPI(false),
+    _downloadWindow(1),
+    _downloadFiles(1),
+    _decompressThreads(1)
 {
     init(server);
 }
@@ -633,6 +813,15 @@ PatcherI::init(const FileServerPrx& server)
         const_cast<string&>(_dataDir) = simplify(cwd + '/' + _dataDir);
     }
 
+    //
+    // The number of chunks downloaded concurrently, the number of files they can span
+    // and the number of threads decompressing the downloaded files.
+    //
+    PropertiesPtr properties = communicator->getProperties();
+    _downloadWindow = max(properties->getPropertyAsIntWithDefault("IcePatch2Client.DownloadWindow", 8), 1);
+    _downloadFiles = max(properties->getPropertyAsIntWithDefault("IcePatch2Client.DownloadFiles", 4), 1);
+    _decompressThreads = max(properties->getPropertyAsIntWithDefault("IcePatch2Client.DecompressThreads", 2), 1);
+
     const_cast<FileServerPrx&>(_serverCompress) = FileServerPrx::uncheckedCast(server->ice_compress(true));
     const_cast<FileServerPrx&>(_serverNoCompress) = FileServerPrx::uncheckedCast(server->ice_compress(false));
 }
@@ -694,15 +883,7 @@ bool
 PatcherI::updateFiles(const LargeFileInfoSeq& files)
 {
     DecompressorPtr decompressor = new Decompressor(_dataDir);
-#if defined(__hppa)
-    //
-    // The thread stack size is only 64KB only HP-UX and that's not
-    // enough for this thread.
-    //
-    decompressor->start(256 * 1024); // 256KB
-#else
-    decompressor->start();
-#endif
+    decompressor->start(_decompressThreads);
     bool result;
 
     try
@@ -712,13 +893,13 @@ PatcherI::updateFiles(const LargeFileInfoSeq& files)
     catch(...)
     {
         decompressor->destroy();
-        decompressor->getThreadControl().join();
+        decompressor->join();
         decompressor->log(_log);
         throw;
     }
 
     decompressor->destroy();
-    decompressor->getThreadControl().join();
+    decompressor->join();
     decompressor->log(_log);
     decompressor->exception();
 
@@ -739,8 +920,8 @@ PatcherI::updateFilesInternal(const LargeFileInfoSeq& files, const DecompressorP
         }
     }
 
-    AsyncResultPtr curCB;
-    AsyncResultPtr nxtCB;
+    ChunkDownloader downloader(_serverNoCompress, _useSmallFileAPI, _chunkSize, _downloadWindow, _downloadFiles,
+                               files);
 
     for(LargeFileInfoSeq::const_iterator p = files.begin(); p != files.end(); ++p)
     {
@@ -799,48 +980,11 @@ PatcherI::updateFilesInternal(const LargeFileInfoSeq& files, const DecompressorP
 
                     while(pos < p->size)
                     {
-                        if(!curCB)
-                        {
-                            assert(!nxtCB);
-                            curCB = _useSmallFileAPI ?
-                                _serverNoCompress->begin_getFileCompressed(p->path, static_cast<Ice::Int>(pos), _chunkSize) :
-                                _serverNoCompress->begin_getLargeFileCompressed(p->path, pos, _chunkSize);
-                        }
-                        else
-                        {
-                            assert(nxtCB);
-                            swap(nxtCB, curCB);
-                        }
-
-                        if(pos + _chunkSize < p->size)
-                        {
-                            nxtCB = _useSmallFileAPI ?
-                                _serverNoCompress->begin_getFileCompressed(p->path, static_cast<Ice::Int>(pos + _chunkSize), _chunkSize) :
-                                _serverNoCompress->begin_getLargeFileCompressed(p->path, pos + _chunkSize, _chunkSize);
-                        }
-                        else
-                        {
-                            LargeFileInfoSeq::const_iterator q = p + 1;
-
-                            while(q != files.end() && q->size <= 0)
-                            {
-                                ++q;
-                            }
-
-                            if(q != files.end())
-                            {
-                                nxtCB = _useSmallFileAPI ?
-                                    _serverNoCompress->begin_getFileCompressed(q->path, 0, _chunkSize) :
-                                    _serverNoCompress->begin_getLargeFileCompressed(q->path, 0, _chunkSize);
-                            }
-                        }
-
                         ByteSeq bytes;
 
                         try
                         {
-                            bytes = _useSmallFileAPI ? _serverNoCompress->end_getFileCompressed(curCB) :
-                                                       _serverNoCompress->end_getLargeFileCompressed(curCB);
+                            bytes = downloader.next(p, pos);
                         }
                         catch(const FileAccessException& ex)
                         {
@@ -28,6 +28,9 @@
 #endif
 
 #include <iterator>
+#include <fstream>
+#include <deque>
+#include <map>
 
 // Ignore macOS OpenSSL deprecation warnings
 #ifdef __APPLE__
@@ -743,11 +746,455 @@ IcePatch2Internal::setFileFlags(const string&, const LargeFileInfo&)
 namespace
 {
 
-static bool
-getFileInfoSeqInternal(const string& basePath, const string& relPath, int compress, GetFileInfoSeqCB* cb,
-                       LargeFileInfoSeq& infoSeq)
+//
+// The checksum of a regular file, computed by the checksum threads while the
+// directory is scanned.
+//
+struct ChecksumJob
+{
+    string path;
+    string relPath;
+    Long size;
+    bool doCompress;
+    Long mtime; // The modification time of the file when it was scanned.
+    size_t index; // The index of the file info in the scanned sequence.
+    LargeFileInfo info;
+};
+
+class ChecksumQueue : public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    ChecksumQueue() :
+        _next(0),
+        _done(0),
+        _finished(false)
+    {
+    }
+
+    void add(const ChecksumJob& job)
+    {
+        Lock sync(*this);
+        _jobs.push_back(job); // Doesn't invalidate the references to the jobs being computed.
+        notify();
+    }
+
+    void finish()
+    {
+        Lock sync(*this);
+        _finished = true;
+        notifyAll();
+    }
+
+    void cancel()
+    {
+        Lock sync(*this);
+        _finished = true;
+        _next = _jobs.size(); // Skip the jobs not yet started.
+        notifyAll();
+    }
+
+    ChecksumJob* next()
+    {
+        Lock sync(*this);
+        while(!_finished && _error.empty() && _next == _jobs.size())
+        {
+            wait();
+        }
+        if(!_error.empty() || _next == _jobs.size())
+        {
+            return 0;
+        }
+        return &_jobs[_next++];
+    }
+
+    void completed(const ChecksumJob& job)
+    {
+        Lock sync(*this);
+        _completed.push_back(job.relPath);
+        ++_done;
+        notifyAll();
+    }
+
+    //
+    // Returns the files whose checksum was computed since the previous call. If block
+    // is true, waits for a checksum unless all the queued checksums were computed.
+    //
+    void takeCompleted(vector<string>& relPaths, bool block)
+    {
+        Lock sync(*this);
+        while(block && _completed.empty() && _error.empty() && _done < _jobs.size())
+        {
+            wait();
+        }
+        relPaths.clear();
+        relPaths.swap(_completed);
+    }
+
+    void failed(const string& error)
+    {
+        Lock sync(*this);
+        if(_error.empty())
+        {
+            _error = error;
+        }
+        notifyAll();
+    }
+
+    const deque<ChecksumJob>& jobs() const
+    {
+        return _jobs;
+    }
+
+    const string& error() const
+    {
+        return _error;
+    }
+
+private:
+
+    deque<ChecksumJob> _jobs;
+    vector<string> _completed;
+    size_t _next;
+    size_t _done;
+    bool _finished;
+    string _error;
+};
+
+void
+computeChecksum(const string& path, const string& relPath, Long size, bool doCompress, LargeFileInfo& info)
+{
+    const string pathBZ2 = path + ".bz2";
+    IceUtilInternal::structstat bufBZ2;
+
+    ByteSeq bytesSHA;
+
+    if(relPath.size() == 0 && size == 0)
+    {
+        bytesSHA.resize(20);
+        fill(bytesSHA.begin(), bytesSHA.end(), Byte(0));
+    }
+    else
+    {
+        IceInternal::SHA1 hasher;
+        if(relPath.size() != 0)
+        {
+            hasher.update(reinterpret_cast<const IceUtil::Byte*>(relPath.c_str()), relPath.size());
+        }
+
+        if(size != 0)
+        {
+            int fd = IceUtilInternal::open(path.c_str(), O_BINARY|O_RDONLY);
+            if(fd == -1)
+            {
+                throw runtime_error("cannot open `" + path + "' for reading:\n" + IceUtilInternal::lastErrorToString());
+            }
+
+            const string pathBZ2Temp = path + ".bz2temp";
+            FILE* stdioFile = 0;
+            int bzError = 0;
+            BZFILE* bzFile = 0;
+            if(doCompress)
+            {
+                stdioFile = IceUtilInternal::fopen(simplify(pathBZ2Temp), "wb");
+                if(!stdioFile)
+                {
+                    IceUtilInternal::close(fd);
+                    throw runtime_error("cannot open `" + pathBZ2Temp + "' for writing:\n" + IceUtilInternal::lastErrorToString());
+                }
+
+                bzFile = BZ2_bzWriteOpen(&bzError, stdioFile, 5, 0, 0);
+                if(bzError != BZ_OK)
+                {
+                    string reason = "BZ2_bzWriteOpen failed";
+                    if(bzError == BZ_IO_ERROR)
+                    {
+                        reason += ": " + IceUtilInternal::lastErrorToString();
+                    }
+                    fclose(stdioFile);
+                    IceUtilInternal::close(fd);
+                    throw runtime_error(reason);
+                }
+            }
+
+            size_t bytesLeft = static_cast<size_t>(size);
+            while(bytesLeft > 0)
+            {
+                ByteSeq bytes(min(bytesLeft, static_cast<size_t>(1024 * 1024)));
+                if(
+#if defined(_MSC_VER)
+                    _read(fd, &bytes[0], static_cast<unsigned int>(bytes.size()))
+#else
+                    read(fd, &bytes[0], static_cast<unsigned int>(bytes.size()))
+#endif
+                    == -1)
+                {
+                    if(doCompress)
+                    {
+                        fclose(stdioFile);
+                    }
+
+                    IceUtilInternal::close(fd);
+                    throw runtime_error("cannot read from `" + path + "':\n" + IceUtilInternal::lastErrorToString());
+                }
+                bytesLeft -= static_cast<unsigned int>(bytes.size());
+                if(doCompress)
+                {
+                    BZ2_bzWrite(&bzError, bzFile, const_cast<Byte*>(&bytes[0]), static_cast<int>(bytes.size()));
+                    if(bzError != BZ_OK)
+                    {
+                        string reason = "BZ2_bzWrite failed";
+                        if(bzError == BZ_IO_ERROR)
+                        {
+                            reason += ": " + IceUtilInternal::lastErrorToString();
+                        }
+                        BZ2_bzWriteClose(&bzError, bzFile, 0, 0, 0);
+                        fclose(stdioFile);
+                        IceUtilInternal::close(fd);
+                        throw runtime_error(reason);
+                    }
+                }
+
+                hasher.update(reinterpret_cast<IceUtil::Byte*>(&bytes[0]), bytes.size());
+            }
+
+            IceUtilInternal::close(fd);
+
+            if(doCompress)
+            {
+                BZ2_bzWriteClose(&bzError, bzFile, 0, 0, 0);
+                if(bzError != BZ_OK)
+                {
+                    string reason = "BZ2_bzWriteClose failed";
+                    if(bzError == BZ_IO_ERROR)
+                    {
+                        reason += ": " + IceUtilInternal::lastErrorToString();
+                    }
+                    fclose(stdioFile);
+                    throw runtime_error(reason);
+                }
+
+                fclose(stdioFile);
+
+                rename(pathBZ2Temp, pathBZ2);
+
+                if(IceUtilInternal::stat(pathBZ2, &bufBZ2) == -1)
+                {
+                    throw runtime_error("cannot stat `" + pathBZ2 + "':\n" + IceUtilInternal::lastErrorToString());
+                }
+
+                info.size = bufBZ2.st_size;
+            }
+        }
+        hasher.finalize(bytesSHA);
+    }
+
+    info.checksum.swap(bytesSHA);
+}
+
+class ChecksumThread : public IceUtil::Thread
+{
+public:
+
+    ChecksumThread(ChecksumQueue& queue) :
+        _queue(queue)
+    {
+    }
+
+    virtual void run()
+    {
+        ChecksumJob* job;
+        while((job = _queue.next()) != 0)
+        {
+            try
+            {
+                computeChecksum(job->path, job->relPath, job->size, job->doCompress, job->info);
+                _queue.completed(*job);
+            }
+            catch(const std::exception& ex)
+            {
+                _queue.failed(ex.what());
+            }
+        }
+    }
+
+private:
+
+    ChecksumQueue& _queue;
+};
+
+//
+// Computes the checksums with a thread per core while the directory is scanned.
+//
+class ChecksumThreads
+{
+public:
+
+    ChecksumThreads()
+    {
+        int threads;
+#ifdef _WIN32
+        SYSTEM_INFO sysInfo;
+        GetSystemInfo(&sysInfo);
+        threads = static_cast<int>(sysInfo.dwNumberOfProcessors);
+#else
+        threads = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+#endif
+        for(int i = 0; i < max(threads, 1); ++i)
+        {
+            IceUtil::ThreadPtr thread = new ChecksumThread(_queue);
+            thread->start();
+            _threads.push_back(thread);
+        }
+    }
+
+    ~ChecksumThreads()
+    {
+        //
+        // The scan was interrupted if the threads weren't joined yet.
+        //
+        _queue.cancel();
+        join();
+    }
+
+    ChecksumQueue& queue()
+    {
+        return _queue;
+    }
+
+    void join()
+    {
+        _queue.finish();
+        for(vector<IceUtil::ThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+        {
+            (*p)->getThreadControl().join();
+        }
+        _threads.clear();
+    }
+
+private:
+
+    ChecksumQueue _queue;
+    vector<IceUtil::ThreadPtr> _threads;
+};
+
+//
+// The checksum of a file computed by a previous scan, along with the size and
+// modification time of the file when it was computed.
+//
+struct CachedChecksum
+{
+    ByteSeq checksum;
+    Long size;
+    Long mtime;
+};
+
+//
+// The cache of the checksums used by the incremental mode, saved in the data
+// directory next to the checksum file.
+//
+const char* checksumCacheFile = "IcePatch2.cache";
+
+void
+loadChecksumCache(const string& basePath, map<string, CachedChecksum>& cache)
+{
+    const string path = simplify(basePath + '/' + checksumCacheFile);
+    ifstream is(IceUtilInternal::streamFilename(path).c_str());
+    string line;
+    while(getline(is, line))
+    {
+        //
+        // Lines which can't be parsed are ignored, their files are checksummed again.
+        //
+        istringstream ls(line);
+        string relPath;
+        string checksum;
+        CachedChecksum cached;
+        if(getline(ls, relPath, '\t') && getline(ls, checksum, '\t') && ls >> cached.size >> cached.mtime)
+        {
+            try
+            {
+                cached.checksum = stringToBytes(checksum);
+                cache[IceUtilInternal::unescapeString(relPath, 0, relPath.size(), "")] = cached;
+            }
+            catch(const IceUtil::IllegalArgumentException&)
+            {
+            }
+        }
+    }
+}
+
+void
+saveChecksumCache(const string& basePath, const map<string, CachedChecksum>& cache)
+{
+    const string path = simplify(basePath + '/' + checksumCacheFile);
+    FILE* fp = IceUtilInternal::fopen(path, "w");
+    if(!fp)
+    {
+        throw runtime_error("cannot open `" + path + "' for writing:\n" + IceUtilInternal::lastErrorToString());
+    }
+    for(map<string, CachedChecksum>::const_iterator p = cache.begin(); p != cache.end(); ++p)
+    {
+        if(fprintf(fp, "%s\t%s\t" ICE_INT64_FORMAT "\t" ICE_INT64_FORMAT "\n",
+                   escapeString(p->first, "", IceUtilInternal::Compat).c_str(),
+                   bytesToString(p->second.checksum).c_str(),
+                   p->second.size,
+                   p->second.mtime) < 0)
+        {
+            fclose(fp);
+            throw runtime_error("error writing `" + path + "':\n" + IceUtilInternal::lastErrorToString());
+        }
+    }
+    fclose(fp);
+}
+
+struct ScanContext
 {
-    if(relPath == checksumFile || relPath == logFile)
+    int compress;
+    GetFileInfoSeqCB* cb;
+    ChecksumQueue* queue;
+
+    //
+    // With the incremental mode, the files whose size and modification time match
+    // the cache reuse their cached checksum.
+    //
+    bool incremental;
+    map<string, CachedChecksum> cache;
+    map<string, CachedChecksum> scanned; // The cached checksums of the scanned files.
+};
+
+//
+// Reports the files whose checksum was computed to the callback. Once the scan is
+// done, all waits for the remaining checksums.
+//
+bool
+reportChecksums(ScanContext& ctx, bool all)
+{
+    if(!ctx.cb)
+    {
+        return true;
+    }
+
+    vector<string> relPaths;
+    do
+    {
+        ctx.queue->takeCompleted(relPaths, all);
+        for(vector<string>::const_iterator p = relPaths.begin(); p != relPaths.end(); ++p)
+        {
+            if(!ctx.cb->checksum(*p))
+            {
+                return false;
+            }
+        }
+    }
+    while(all && !relPaths.empty());
+    return true;
+}
+
+bool
+getFileInfoSeqInternal(const string& basePath, const string& relPath, ScanContext& ctx, LargeFileInfoSeq& infoSeq)
+{
+    if(relPath == checksumFile || relPath == logFile || relPath == checksumCacheFile)
     {
         return true;
     }
@@ -760,7 +1207,7 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
 
         if(ignoreSuffix(pathWithoutSuffix))
         {
-            if(cb && !cb->remove(relPath))
+            if(ctx.cb && !ctx.cb->remove(relPath))
             {
                 return false;
             }
@@ -774,7 +1221,7 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
             {
                 if(errno == ENOENT)
                 {
-                    if(cb && !cb->remove(relPath))
+                    if(ctx.cb && !ctx.cb->remove(relPath))
                     {
                         return false;
                     }
@@ -788,7 +1235,7 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
             }
             else if(buf.st_size == 0)
             {
-                if(cb && !cb->remove(relPath))
+                if(ctx.cb && !ctx.cb->remove(relPath))
                 {
                     return false;
                 }
@@ -832,7 +1279,7 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
             StringSeq content = readDirectory(path);
             for(StringSeq::const_iterator p = content.begin(); p != content.end() ; ++p)
             {
-                if(!getFileInfoSeqInternal(basePath, simplify(relPath + '/' + *p), compress, cb, infoSeq))
+                if(!getFileInfoSeqInternal(basePath, simplify(relPath + '/' + *p), ctx, infoSeq))
                 {
                     return false;
                 }
@@ -852,16 +1299,16 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
             IceUtilInternal::structstat bufBZ2;
             const string pathBZ2 = path + ".bz2";
             bool doCompress = false;
-            if(buf.st_size != 0 && compress > 0)
+            if(buf.st_size != 0 && ctx.compress > 0)
             {
                 //
                 // compress == 0: Never compress.
                 // compress == 1: Compress if necessary.
                 // compress >= 2: Always compress.
                 //
-                if(compress >= 2 || IceUtilInternal::stat(pathBZ2, &bufBZ2) == -1 || buf.st_mtime >= bufBZ2.st_mtime)
+                if(ctx.compress >= 2 || IceUtilInternal::stat(pathBZ2, &bufBZ2) == -1 || buf.st_mtime >= bufBZ2.st_mtime)
                 {
-                    if(cb && !cb->compress(relPath))
+                    if(ctx.cb && !ctx.cb->compress(relPath))
                     {
                         return false;
                     }
@@ -874,136 +1321,42 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
                 }
             }
 
-            if(cb && !cb->checksum(relPath))
-            {
-                return false;
-            }
-
-            ByteSeq bytesSHA;
-
-            if(relPath.size() == 0 && buf.st_size == 0)
-            {
-                bytesSHA.resize(20);
-                fill(bytesSHA.begin(), bytesSHA.end(), Byte(0));
-            }
-            else
+            if(!doCompress && ctx.incremental)
             {
-                IceInternal::SHA1 hasher;
-                if(relPath.size() != 0)
-                {
-                    hasher.update(reinterpret_cast<const IceUtil::Byte*>(relPath.c_str()), relPath.size());
-                }
-
-                if(buf.st_size != 0)
+                //
+                // Reuse the cached checksum if the size and modification time of the
+                // file didn't change since it was computed.
+                //
+                map<string, CachedChecksum>::const_iterator p = ctx.cache.find(relPath);
+                if(p != ctx.cache.end() && p->second.size == static_cast<Long>(buf.st_size) &&
+                   p->second.mtime == static_cast<Long>(buf.st_mtime))
                 {
-                    int fd = IceUtilInternal::open(path.c_str(), O_BINARY|O_RDONLY);
-                    if(fd == -1)
-                    {
-                        throw runtime_error("cannot open `" + path + "' for reading:\n" + IceUtilInternal::lastErrorToString());
-                    }
-
-                    const string pathBZ2Temp = path + ".bz2temp";
-                    FILE* stdioFile = 0;
-                    int bzError = 0;
-                    BZFILE* bzFile = 0;
-                    if(doCompress)
-                    {
-                        stdioFile = IceUtilInternal::fopen(simplify(pathBZ2Temp), "wb");
-                        if(!stdioFile)
-                        {
-                            IceUtilInternal::close(fd);
-                            throw runtime_error("cannot open `" + pathBZ2Temp + "' for writing:\n" + IceUtilInternal::lastErrorToString());
-                        }
-
-                        bzFile = BZ2_bzWriteOpen(&bzError, stdioFile, 5, 0, 0);
-                        if(bzError != BZ_OK)
-                        {
-                            string reason = "BZ2_bzWriteOpen failed";
-                            if(bzError == BZ_IO_ERROR)
-                            {
-                                reason += ": " + IceUtilInternal::lastErrorToString();
-                            }
-                            fclose(stdioFile);
-                            IceUtilInternal::close(fd);
-                            throw runtime_error(reason);
-                        }
-                    }
-
-                    size_t bytesLeft = static_cast<size_t>(buf.st_size);
-                    while(bytesLeft > 0)
-                    {
-                        ByteSeq bytes(min(bytesLeft, static_cast<size_t>(1024 * 1024)));
-                        if(
-#if defined(_MSC_VER)
-                            _read(fd, &bytes[0], static_cast<unsigned int>(bytes.size()))
-#else
-                            read(fd, &bytes[0], static_cast<unsigned int>(bytes.size()))
-#endif
-                            == -1)
-                        {
-                            if(doCompress)
-                            {
-                                fclose(stdioFile);
-                            }
-
-                            IceUtilInternal::close(fd);
-                            throw runtime_error("cannot read from `" + path + "':\n" + IceUtilInternal::lastErrorToString());
-                        }
-                        bytesLeft -= static_cast<unsigned int>(bytes.size());
-                        if(doCompress)
-                        {
-                            BZ2_bzWrite(&bzError, bzFile, const_cast<Byte*>(&bytes[0]), static_cast<int>(bytes.size()));
-                            if(bzError != BZ_OK)
-                            {
-                                string reason = "BZ2_bzWrite failed";
-                                if(bzError == BZ_IO_ERROR)
-                                {
-                                    reason += ": " + IceUtilInternal::lastErrorToString();
-                                }
-                                BZ2_bzWriteClose(&bzError, bzFile, 0, 0, 0);
-                                fclose(stdioFile);
-                                IceUtilInternal::close(fd);
-                                throw runtime_error(reason);
-                            }
-                        }
-
-                        hasher.update(reinterpret_cast<IceUtil::Byte*>(&bytes[0]), bytes.size());
-                    }
-
-                    IceUtilInternal::close(fd);
-
-                    if(doCompress)
-                    {
-                        BZ2_bzWriteClose(&bzError, bzFile, 0, 0, 0);
-                        if(bzError != BZ_OK)
-                        {
-                            string reason = "BZ2_bzWriteClose failed";
-                            if(bzError == BZ_IO_ERROR)
-                            {
-                                reason += ": " + IceUtilInternal::lastErrorToString();
-                            }
-                            fclose(stdioFile);
-                            throw runtime_error(reason);
-                        }
-
-                        fclose(stdioFile);
-
-                        rename(pathBZ2Temp, pathBZ2);
-
-                        if(IceUtilInternal::stat(pathBZ2, &bufBZ2) == -1)
-                        {
-                            throw runtime_error("cannot stat `" + pathBZ2 + "':\n" + IceUtilInternal::lastErrorToString());
-                        }
-
-                        info.size = bufBZ2.st_size;
-                    }
+                    info.checksum = p->second.checksum;
+                    infoSeq.push_back(info);
+                    ctx.scanned.insert(*p);
+                    return true;
                 }
-                hasher.finalize(bytesSHA);
             }
 
-            info.checksum.swap(bytesSHA);
+            ChecksumJob job;
+            job.path = path;
+            job.relPath = relPath;
+            job.size = static_cast<Long>(buf.st_size);
+            job.mtime = static_cast<Long>(buf.st_mtime);
+            job.doCompress = doCompress;
+            job.index = infoSeq.size();
+            job.info = info;
+            ctx.queue->add(job);
 
             infoSeq.push_back(info);
+
+            //
+            // The checksums are reported once computed by the checksum threads.
+            //
+            if(!reportChecksums(ctx, false))
+            {
+                return false;
+            }
         }
     }
 
@@ -1019,21 +1372,81 @@ IcePatch2Internal::GetFileInfoSeqCB::~GetFileInfoSeqCB()
 
 bool
 IcePatch2Internal::getFileInfoSeq(const string& basePath, int compress, GetFileInfoSeqCB* cb,
-                                  LargeFileInfoSeq& infoSeq)
+                                  LargeFileInfoSeq& infoSeq, bool incremental)
 {
-    return getFileInfoSeqSubDir(basePath, ".", compress, cb, infoSeq);
+    return getFileInfoSeqSubDir(basePath, ".", compress, cb, infoSeq, incremental);
 }
 
 bool
 IcePatch2Internal::getFileInfoSeqSubDir(const string& basePa, const string& relPa, int compress, GetFileInfoSeqCB* cb,
-                                        LargeFileInfoSeq& infoSeq)
+                                        LargeFileInfoSeq& infoSeq, bool incremental)
 {
     const string basePath = simplify(basePa);
     const string relPath = simplify(relPa);
 
-    if(!getFileInfoSeqInternal(basePath, relPath, compress, cb, infoSeq))
+    ScanContext ctx;
+    ctx.compress = compress;
+    ctx.cb = cb;
+    ctx.incremental = incremental;
+    const Long scanTime = static_cast<Long>(time(0));
+    if(incremental)
     {
-        return false;
+        loadChecksumCache(basePath, ctx.cache);
+    }
+
+    {
+        ChecksumThreads threads;
+        ctx.queue = &threads.queue();
+        if(!getFileInfoSeqInternal(basePath, relPath, ctx, infoSeq) || !reportChecksums(ctx, true))
+        {
+            return false;
+        }
+        threads.join();
+
+        if(!threads.queue().error().empty())
+        {
+            throw runtime_error(threads.queue().error());
+        }
+
+        const deque<ChecksumJob>& jobs = threads.queue().jobs();
+        for(deque<ChecksumJob>::const_iterator p = jobs.begin(); p != jobs.end(); ++p)
+        {
+            infoSeq[p->index] = p->info;
+
+            //
+            // Don't cache the checksum of a file modified during the scan, it could be
+            // modified again without changing its modification time.
+            //
+            if(p->mtime < scanTime)
+            {
+                CachedChecksum cached;
+                cached.checksum = p->info.checksum;
+                cached.size = p->size;
+                cached.mtime = p->mtime;
+                ctx.scanned[p->relPath] = cached;
+            }
+        }
+    }
+
+    if(incremental)
+    {
+        //
+        // Replace the cached checksums of the scanned directory.
+        //
+        map<string, CachedChecksum>::iterator p = ctx.cache.begin();
+        while(p != ctx.cache.end())
+        {
+            if(relPath == "." || p->first == relPath || p->first.compare(0, relPath.size() + 1, relPath + '/') == 0)
+            {
+                ctx.cache.erase(p++);
+            }
+            else
+            {
+                ++p;
+            }
+        }
+        ctx.cache.insert(ctx.scanned.begin(), ctx.scanned.end());
+        saveChecksumCache(basePath, ctx.cache);
     }
 
     sort(infoSeq.begin(), infoSeq.end(), FileInfoLess());
@@ -59,6 +59,13 @@ PersistentInstance::PersistentInstance(
         dbContext.encoding.minor = 1;
         dbContext.encoding.major = 1;
 
+        const int groupCommitWindow =
+            communicator->getProperties()->getPropertyAsIntWithDefault(name + ".LMDB.GroupCommitWindow", -1);
+        if(groupCommitWindow >= 0)
+        {
+            _dbEnv.enableGroupCommit(groupCommitWindow);
+        }
+
         IceDB::ReadWriteTxn txn(_dbEnv);
 
         _lluMap = LLUMap(txn, "llu", dbContext, MDB_CREATE);
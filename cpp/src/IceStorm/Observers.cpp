@@ -10,9 +10,77 @@ using namespace std;
 using namespace IceStorm;
 using namespace IceStormElection;
 
+namespace
+{
+
+//
+// The maximum number of updates sent to an observer with a single call.
+//
+const Ice::Long maxBatchSize = 128;
+
+class UpdateCallback : public IceUtil::Shared
+{
+public:
+
+    UpdateCallback(const ObserversPtr& observers, int id, Ice::Long last, bool batch) :
+        _observers(observers), _id(id), _last(last), _batch(batch)
+    {
+    }
+
+    void response()
+    {
+        _observers->completed(_id, _last);
+    }
+
+    void exception(const Ice::Exception& ex)
+    {
+        _observers->failed(_id, _last, _batch, ex);
+    }
+
+private:
+
+    const ObserversPtr _observers;
+    const int _id;
+    const Ice::Long _last;
+    const bool _batch;
+};
+typedef IceUtil::Handle<UpdateCallback> UpdateCallbackPtr;
+
+void
+sendUpdate(const ReplicaObserverPrx& observer, const ReplicaUpdate& update, const UpdateCallbackPtr& cb)
+{
+    switch(update.kind)
+    {
+    case CreateTopicUpdate:
+        observer->begin_createTopic(update.llu, update.topic,
+                                    newCallback_ReplicaObserver_createTopic(cb, &UpdateCallback::response,
+                                                                            &UpdateCallback::exception));
+        break;
+    case DestroyTopicUpdate:
+        observer->begin_destroyTopic(update.llu, update.topic,
+                                     newCallback_ReplicaObserver_destroyTopic(cb, &UpdateCallback::response,
+                                                                              &UpdateCallback::exception));
+        break;
+    case AddSubscriberUpdate:
+        observer->begin_addSubscriber(update.llu, update.topic, update.record,
+                                      newCallback_ReplicaObserver_addSubscriber(cb, &UpdateCallback::response,
+                                                                                &UpdateCallback::exception));
+        break;
+    case RemoveSubscriberUpdate:
+        observer->begin_removeSubscriber(update.llu, update.topic, update.subscribers,
+                                         newCallback_ReplicaObserver_removeSubscriber(cb, &UpdateCallback::response,
+                                                                                      &UpdateCallback::exception));
+        break;
+    }
+}
+
+}
+
 Observers::Observers(const InstancePtr& instance) :
     _traceLevels(instance->traceLevels()),
-    _majority(0)
+    _majority(0),
+    _first(1),
+    _last(0)
 {
 }
 
@@ -50,6 +118,7 @@ Observers::check()
                 _reapedMutex.lock();
                 _reaped.push_back(id);
                 _reapedMutex.unlock();
+                notifyAll();
                 continue;
             }
             ++p;
@@ -63,6 +132,9 @@ Observers::clear()
 {
     Lock sync(*this);
     _observers.clear();
+    _updates.clear();
+    _first = _last + 1;
+    notifyAll();
 }
 
 void
@@ -82,8 +154,11 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
 
     Lock sync(*this);
     _observers.clear();
+    _updates.clear();
+    _first = _last + 1;
 
     vector<ObserverInfo> observers;
+    vector<Ice::AsyncResultPtr> results;
 
     for(set<GroupNodeInfo>::const_iterator p = slaves.begin(); p != slaves.end(); ++p)
     {
@@ -93,8 +168,8 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
 
             ReplicaObserverPrx observer = ReplicaObserverPrx::uncheckedCast(p->observer);
 
-            Ice::AsyncResultPtr result = observer->begin_init(llu, content);
-            observers.push_back(ObserverInfo(p->id, observer, result));
+            results.push_back(observer->begin_init(llu, content));
+            observers.push_back(ObserverInfo(p->id, observer, _last));
         }
         catch(const Ice::Exception& ex)
         {
@@ -107,19 +182,18 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
         }
     }
 
-    for(vector<ObserverInfo>::iterator p = observers.begin(); p != observers.end(); ++p)
+    for(vector<ObserverInfo>::size_type i = 0; i < observers.size(); ++i)
     {
         try
         {
-            p->observer->end_init(p->result);
-            p->result = 0;
+            observers[i].observer->end_init(results[i]);
         }
         catch(const Ice::Exception& ex)
         {
             if(_traceLevels->replication > 0)
             {
                 Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
-                out << "init on " << p->id << " failed with exception " << ex;
+                out << "init on " << observers[i].id << " failed with exception " << ex;
             }
             throw;
         }
@@ -131,80 +205,226 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
 void
 Observers::createTopic(const LogUpdate& llu, const string& name)
 {
-    Lock sync(*this);
-    for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
-    {
-        p->result = p->observer->begin_createTopic(llu, name);
-    }
-    wait("createTopic");
+    ReplicaUpdate update;
+    update.kind = CreateTopicUpdate;
+    update.llu = llu;
+    update.topic = name;
+    replicate(update);
 }
 
 void
 Observers::destroyTopic(const LogUpdate& llu, const string& id)
 {
-    Lock sync(*this);
-    for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
-    {
-        p->result = p->observer->begin_destroyTopic(llu, id);
-    }
-    wait("destroyTopic");
+    ReplicaUpdate update;
+    update.kind = DestroyTopicUpdate;
+    update.llu = llu;
+    update.topic = id;
+    replicate(update);
 }
 
 void
 Observers::addSubscriber(const LogUpdate& llu, const string& name, const SubscriberRecord& rec)
+{
+    ReplicaUpdate update;
+    update.kind = AddSubscriberUpdate;
+    update.llu = llu;
+    update.topic = name;
+    update.record = rec;
+    replicate(update);
+}
+
+void
+Observers::removeSubscriber(const LogUpdate& llu, const string& name, const Ice::IdentitySeq& id)
+{
+    ReplicaUpdate update;
+    update.kind = RemoveSubscriberUpdate;
+    update.llu = llu;
+    update.topic = name;
+    update.subscribers = id;
+    replicate(update);
+}
+
+void
+Observers::completed(int id, Ice::Long last)
 {
     Lock sync(*this);
     for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
     {
-        p->result = p->observer->begin_addSubscriber(llu, name, rec);
+        if(p->id == id)
+        {
+            if(p->pending == last)
+            {
+                p->acked = last;
+                p->pending = 0;
+            }
+            break;
+        }
     }
-    wait("addSubscriber");
+    flush();
+    notifyAll();
 }
 
 void
-Observers::removeSubscriber(const LogUpdate& llu, const string& name, const Ice::IdentitySeq& id)
+Observers::failed(int id, Ice::Long last, bool batch, const Ice::Exception& ex)
 {
     Lock sync(*this);
     for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
     {
-        p->result = p->observer->begin_removeSubscriber(llu, name, id);
+        if(p->id == id)
+        {
+            if(batch && p->legacy)
+            {
+                break; // The updates of this batch were sent again with the per-update operations.
+            }
+
+            if(batch && dynamic_cast<const Ice::OperationNotExistException*>(&ex))
+            {
+                //
+                // The observer runs a version without the update operation, none of the
+                // batches in flight were applied. Send the unacknowledged updates again
+                // with the per-update operations.
+                //
+                if(_traceLevels->replication > 0)
+                {
+                    Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+                    out << "update not supported by " << id << ", using the per-update operations";
+                }
+                p->legacy = true;
+                p->sent = p->acked;
+                p->pending = 0;
+                flush();
+                notifyAll();
+                return;
+            }
+
+            if(p->pending == last)
+            {
+                if(_traceLevels->replication > 0)
+                {
+                    Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+                    out << "update on " << id << " failed with exception " << ex;
+                }
+                reap(id);
+                notifyAll();
+                return;
+            }
+            break; // The observer was initialized again since the update was sent.
+        }
     }
-    wait("removeSubscriber");
 }
 
 void
-Observers::wait(const string& op)
+Observers::replicate(const ReplicaUpdate& update)
 {
-    vector<ObserverInfo>::iterator p = _observers.begin();
-    while(p != _observers.end())
+    Lock sync(*this);
+    _updates.push_back(update);
+    const Ice::Long seq = ++_last;
+    flush();
+
+    //
+    // Wait for all the observers to acknowledge the update, the observers which
+    // fail to apply it are reaped.
+    //
+    while(true)
     {
-        try
+        vector<ObserverInfo>::const_iterator p = _observers.begin();
+        while(p != _observers.end() && p->acked >= seq)
         {
-            p->result->waitForCompleted();
-            p->result->throwLocalException();
+            ++p;
         }
-        catch(const Ice::Exception& ex)
+        if(p == _observers.end())
         {
-            if(_traceLevels->replication > 0)
-            {
-                Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
-                out << op << ": " << ex;
-            }
-            int id = p->id;
-            p = _observers.erase(p);
-
-            IceUtil::Mutex::Lock sync(_reapedMutex);
-            _reaped.push_back(id);
-            continue;
+            break;
         }
-        ++p;
+        wait();
     }
+
     // If we now no longer have the majority of observers we raise.
     if(_observers.size() < _majority)
     {
-        // TODO: Trace here?
-        //Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
-        //out << op;
         throw Ice::UnknownException(__FILE__, __LINE__);
     }
 }
+
+void
+Observers::flush()
+{
+    //
+    // Release the updates acknowledged by all the observers.
+    //
+    Ice::Long acked = _last;
+    for(vector<ObserverInfo>::const_iterator p = _observers.begin(); p != _observers.end(); ++p)
+    {
+        acked = min(acked, p->acked);
+    }
+    while(_first <= acked)
+    {
+        _updates.pop_front();
+        ++_first;
+    }
+
+    //
+    // Send the queued updates to the observers without a batch in flight. The
+    // updates queued while a batch is in flight are sent with a single batch once
+    // it completes. Only one batch is in flight for an observer: the replica
+    // dispatches with a multi-threaded thread pool and two batches in flight
+    // could be applied out of order. Legacy observers get a single update at a
+    // time.
+    //
+    vector<int> failed;
+    for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
+    {
+        if(p->sent < _last && p->pending == 0)
+        {
+            const Ice::Long last = p->legacy ? p->sent + 1 : min(_last, p->sent + maxBatchSize);
+            try
+            {
+                UpdateCallbackPtr cb = new UpdateCallback(this, p->id, last, !p->legacy);
+                if(p->legacy)
+                {
+                    sendUpdate(p->observer, _updates[static_cast<size_t>(last - _first)], cb);
+                }
+                else
+                {
+                    ReplicaUpdateSeq batch(_updates.begin() + static_cast<ptrdiff_t>(p->sent + 1 - _first),
+                                           _updates.begin() + static_cast<ptrdiff_t>(last + 1 - _first));
+                    p->observer->begin_update(batch, newCallback_ReplicaObserver_update(cb, &UpdateCallback::response,
+                                                                                        &UpdateCallback::exception));
+                }
+            }
+            catch(const Ice::Exception& ex)
+            {
+                if(_traceLevels->replication > 0)
+                {
+                    Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+                    out << "error calling update on " << p->id << ", exception: " << ex;
+                }
+                failed.push_back(p->id);
+                continue;
+            }
+            p->pending = last;
+            p->sent = last;
+        }
+    }
+
+    for(vector<int>::const_iterator p = failed.begin(); p != failed.end(); ++p)
+    {
+        reap(*p);
+    }
+}
+
+void
+Observers::reap(int id)
+{
+    for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
+    {
+        if(p->id == id)
+        {
+            _observers.erase(p);
+            break;
+        }
+    }
+
+    IceUtil::Mutex::Lock sync(_reapedMutex);
+    _reaped.push_back(id);
+}
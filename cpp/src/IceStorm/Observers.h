@@ -10,6 +10,8 @@
 #include <IceStorm/Election.h>
 #include <IceStorm/Replica.h>
 
+#include <deque>
+
 #ifdef __SUNPRO_CC
 #  pragma error_messages(off,hidef)
 #endif
@@ -25,7 +27,15 @@ typedef IceUtil::Handle<TraceLevels> TraceLevelsPtr;
 namespace IceStormElection
 {
 
-class Observers : public IceUtil::Shared, public IceUtil::Mutex
+//
+// Observers replicates the updates of the master to the replica observers. The
+// updates are queued and sent to each observer in batches, with a single batch in
+// flight for each observer. An observer acknowledges all the updates of a batch
+// when it returns from the update call, and the caller of an update waits until
+// all the observers acknowledged it. Observers which don't implement the update
+// operation get the updates one at a time with the per-update operations.
+//
+class Observers : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
 {
 public:
     Observers(const IceStorm::InstancePtr&);
@@ -43,21 +53,32 @@ public:
     void removeSubscriber(const LogUpdate&, const std::string&, const Ice::IdentitySeq&);
     void getReapedSlaves(std::vector<int>&);
 
+    void completed(int, Ice::Long);
+    void failed(int, Ice::Long, bool, const Ice::Exception&);
+
 private:
 
-    void wait(const std::string&);
+    void replicate(const ReplicaUpdate&);
+    void flush();
+    void reap(int);
 
     const IceStorm::TraceLevelsPtr _traceLevels;
     unsigned int _majority;
     struct ObserverInfo
     {
-        ObserverInfo(int i, const ReplicaObserverPrx& o, const Ice::AsyncResultPtr& r = 0) :
-            id(i), observer(o), result (r) {}
+        ObserverInfo(int i, const ReplicaObserverPrx& o, Ice::Long s) :
+            id(i), observer(o), legacy(false), sent(s), acked(s), pending(0) {}
         int id;
         ReplicaObserverPrx observer;
-        ::Ice::AsyncResultPtr result;
+        bool legacy; // True if the observer doesn't implement the update operation.
+        Ice::Long sent; // Sequence number of the last update sent to the observer.
+        Ice::Long acked; // All the updates up to this sequence number are acknowledged.
+        Ice::Long pending; // The last sequence number of the batch in flight, 0 if none.
     };
     std::vector<ObserverInfo> _observers;
+    std::deque<ReplicaUpdate> _updates; // The updates not yet acknowledged by all the observers.
+    Ice::Long _first; // Sequence number of the first update in _updates.
+    Ice::Long _last; // Sequence number of the last queued update.
     IceUtil::Mutex _reapedMutex;
     std::vector<int> _reaped;
 };
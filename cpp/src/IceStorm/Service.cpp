@@ -525,7 +525,8 @@ ServiceI::validateProperties(const string& name, const PropertiesPtr& properties
         "Send.QueueSizeMaxPolicy",
         "Discard.Interval",
         "LMDB.Path",
-        "LMDB.MapSize"
+        "LMDB.MapSize",
+        "LMDB.GroupCommitWindow"
     };
 
     vector<string> unknownProps;
@@ -27,6 +27,20 @@ logError(const Ice::CommunicatorPtr& com, const IceDB::LMDBException& ex)
     error << "LMDB error: " << ex;
 }
 
+void
+waitForSync(IceDB::DeferredSync& deferredSync, const Ice::CommunicatorPtr& com)
+{
+    try
+    {
+        deferredSync.wait();
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        logError(com, ex);
+        throw; // will become UnknownException in caller
+    }
+}
+
 //
 // The servant has a 1-1 association with a topic. It is used to
 // receive events from Publishers.
@@ -504,6 +518,7 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
 
     TraceLevelsPtr traceLevels = _instance->traceLevels();
 
+    IceUtil::Mutex::Lock updateSync(_updateMutex);
     IceUtil::Mutex::Lock sync(_subscribersMutex);
     if(traceLevels->topic > 0)
     {
@@ -540,10 +555,12 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
     {
         throw AlreadySubscribed();
     }
+    sync.release();
 
     LogUpdate llu;
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
+    IceDB::DeferredSync deferredSync(_instance->dbEnv());
     try
     {
         IceDB::ReadWriteTxn txn(_instance->dbEnv());
@@ -556,7 +573,7 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
 
         llu = getIncrementedLLU(txn, _lluMap);
 
-        txn.commit();
+        txn.commit(deferredSync);
     }
     catch(const IceDB::LMDBException& ex)
     {
@@ -564,6 +581,14 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
         throw; // will become UnknownException in caller
     }
 
+    //
+    // Wait for the subscription to be flushed to disk before publishing
+    // it. The subscribers mutex isn't held, events are still forwarded
+    // and the updates of other topics can join the same group commit.
+    //
+    waitForSync(deferredSync, _instance->communicator());
+
+    sync.acquire();
     _subscribers.push_back(subscriber);
 
     _instance->observers()->addSubscriber(llu, _name, record);
@@ -587,9 +612,10 @@ TopicImpl::unsubscribe(const Ice::ObjectPrx& subscriber)
 
     Ice::Identity id = subscriber->ice_getIdentity();
 
-    IceUtil::Mutex::Lock sync(_subscribersMutex);
+    IceUtil::Mutex::Lock updateSync(_updateMutex);
     if(traceLevels->topic > 0)
     {
+        IceUtil::Mutex::Lock sync(_subscribersMutex);
         Ice::Trace out(traceLevels->logger, traceLevels->topicCat);
         out << _name << ": unsubscribe: " << _instance->communicator()->identityToString(id);
 
@@ -630,6 +656,7 @@ TopicImpl::link(const TopicPrx& topic, Ice::Int cost)
             << " cost " << cost;
     }
 
+    IceUtil::Mutex::Lock updateSync(_updateMutex);
     IceUtil::Mutex::Lock sync(_subscribersMutex);
 
     Ice::Identity id = topic->ice_getIdentity();
@@ -648,11 +675,13 @@ TopicImpl::link(const TopicPrx& topic, Ice::Int cost)
         string name = IceStormInternal::identityToTopicName(id);
         throw LinkExists(name);
     }
+    sync.release();
 
     LogUpdate llu;
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
 
+    IceDB::DeferredSync deferredSync(_instance->dbEnv());
     try
     {
         IceDB::ReadWriteTxn txn(_instance->dbEnv());
@@ -665,7 +694,7 @@ TopicImpl::link(const TopicPrx& topic, Ice::Int cost)
 
         llu = getIncrementedLLU(txn, _lluMap);
 
-        txn.commit();
+        txn.commit(deferredSync);
     }
     catch(const IceDB::LMDBException& ex)
     {
@@ -673,6 +702,9 @@ TopicImpl::link(const TopicPrx& topic, Ice::Int cost)
         throw; // will become UnknownException in caller
     }
 
+    waitForSync(deferredSync, _instance->communicator());
+
+    sync.acquire();
     _subscribers.push_back(subscriber);
 
     _instance->observers()->addSubscriber(llu, _name, record);
@@ -681,6 +713,7 @@ TopicImpl::link(const TopicPrx& topic, Ice::Int cost)
 void
 TopicImpl::unlink(const TopicPrx& topic)
 {
+    IceUtil::Mutex::Lock updateSync(_updateMutex);
     IceUtil::Mutex::Lock sync(_subscribersMutex);
     if(_destroyed)
     {
@@ -709,6 +742,7 @@ TopicImpl::unlink(const TopicPrx& topic)
         Ice::Trace out(traceLevels->logger, traceLevels->topicCat);
         out << _name << " unlink " << _instance->communicator()->identityToString(id);
     }
+    sync.release();
 
     Ice::IdentitySeq ids;
     ids.push_back(id);
@@ -718,7 +752,7 @@ TopicImpl::unlink(const TopicPrx& topic)
 void
 TopicImpl::reap(const Ice::IdentitySeq& ids)
 {
-    IceUtil::Mutex::Lock sync(_subscribersMutex);
+    IceUtil::Mutex::Lock updateSync(_updateMutex);
 
     TraceLevelsPtr traceLevels = _instance->traceLevels();
     if(traceLevels->topic > 0)
@@ -790,6 +824,7 @@ TopicImpl::getSubscribers() const
 void
 TopicImpl::destroy()
 {
+    IceUtil::Mutex::Lock updateSync(_updateMutex);
     IceUtil::Mutex::Lock sync(_subscribersMutex);
 
     if(_destroyed)
@@ -835,6 +870,7 @@ TopicImpl::getContent() const
 void
 TopicImpl::update(const SubscriberRecordSeq& records)
 {
+    IceUtil::Mutex::Lock updateSync(_updateMutex);
     IceUtil::Mutex::Lock sync(_subscribersMutex);
 
     // We do this with two scans. The first runs through the subscribers
@@ -999,7 +1035,7 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
         }
         if(!unlock.getMaster())
         {
-            IceUtil::Mutex::Lock sync(_subscribersMutex);
+            IceUtil::Mutex::Lock updateSync(_updateMutex);
             removeSubscribers(reap);
             return;
         }
@@ -1023,6 +1059,7 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
 void
 TopicImpl::observerAddSubscriber(const LogUpdate& llu, const SubscriberRecord& record)
 {
+    IceUtil::Mutex::Lock updateSync(_updateMutex);
     IceUtil::Mutex::Lock sync(_subscribersMutex);
 
     TraceLevelsPtr traceLevels = _instance->traceLevels();
@@ -1059,8 +1096,10 @@ TopicImpl::observerAddSubscriber(const LogUpdate& llu, const SubscriberRecord& r
         }
         return;
     }
+    sync.release();
 
     SubscriberPtr subscriber = Subscriber::create(_instance, record);
+    IceDB::DeferredSync deferredSync(_instance->dbEnv());
     try
     {
         IceDB::ReadWriteTxn txn(_instance->dbEnv());
@@ -1074,7 +1113,7 @@ TopicImpl::observerAddSubscriber(const LogUpdate& llu, const SubscriberRecord& r
         // Update the LLU.
         _lluMap.put(txn, lluDbKey, llu);
 
-        txn.commit();
+        txn.commit(deferredSync);
     }
     catch(const IceDB::LMDBException& ex)
     {
@@ -1082,6 +1121,9 @@ TopicImpl::observerAddSubscriber(const LogUpdate& llu, const SubscriberRecord& r
         throw; // will become UnknownException in caller
     }
 
+    waitForSync(deferredSync, _instance->communicator());
+
+    sync.acquire();
     _subscribers.push_back(subscriber);
 }
 
@@ -1104,9 +1146,10 @@ TopicImpl::observerRemoveSubscriber(const LogUpdate& llu, const Ice::IdentitySeq
         out << " llu: " << llu.generation << "/" << llu.iteration;
     }
 
-    IceUtil::Mutex::Lock sync(_subscribersMutex);
+    IceUtil::Mutex::Lock updateSync(_updateMutex);
 
     // First remove from the database.
+    IceDB::DeferredSync deferredSync(_instance->dbEnv());
     try
     {
         IceDB::ReadWriteTxn txn(_instance->dbEnv());
@@ -1122,17 +1165,19 @@ TopicImpl::observerRemoveSubscriber(const LogUpdate& llu, const Ice::IdentitySeq
 
         _lluMap.put(txn, lluDbKey, llu);
 
-        txn.commit();
+        txn.commit(deferredSync);
     }
     catch(const IceDB::LMDBException& ex)
     {
         logError(_instance->communicator(), ex);
         throw; // will become UnknownException in caller
     }
+    waitForSync(deferredSync, _instance->communicator());
 
     // Then remove the subscriber from the subscribers list. If the
     // subscriber had a local failure and was removed from the
     // subscriber list it could already be gone. That's not a problem.
+    IceUtil::Mutex::Lock sync(_subscribersMutex);
     for(Ice::IdentitySeq::const_iterator id = ids.begin(); id != ids.end(); ++id)
     {
         vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), *id);
@@ -1147,6 +1192,7 @@ TopicImpl::observerRemoveSubscriber(const LogUpdate& llu, const Ice::IdentitySeq
 void
 TopicImpl::observerDestroyTopic(const LogUpdate& llu)
 {
+    IceUtil::Mutex::Lock updateSync(_updateMutex);
     IceUtil::Mutex::Lock sync(_subscribersMutex);
 
     if(_destroyed)
@@ -1258,10 +1304,11 @@ TopicImpl::destroyInternal(const LogUpdate& origLLU, bool master)
 void
 TopicImpl::removeSubscribers(const Ice::IdentitySeq& ids)
 {
-    // First update the database
+    // Called with the update mutex locked. First update the database.
 
     LogUpdate llu;
     bool found = false;
+    IceDB::DeferredSync deferredSync(_instance->dbEnv());
     try
     {
         IceDB::ReadWriteTxn txn(_instance->dbEnv());
@@ -1281,7 +1328,7 @@ TopicImpl::removeSubscribers(const Ice::IdentitySeq& ids)
         if(found)
         {
             llu = getIncrementedLLU(txn, _lluMap);
-            txn.commit();
+            txn.commit(deferredSync);
         }
         else
         {
@@ -1296,12 +1343,15 @@ TopicImpl::removeSubscribers(const Ice::IdentitySeq& ids)
 
     if(found)
     {
+        waitForSync(deferredSync, _instance->communicator());
+
         // Then remove the subscriber from the subscribers list. Its
         // possible that some of these subscribers have already been
         // removed (consider, for example, a concurrent reap call from two
         // replicas on the same subscriber). To avoid sending unnecessary
         // observer updates keep track of the observers that are actually
         // removed.
+        IceUtil::Mutex::Lock sync(_subscribersMutex);
         for(Ice::IdentitySeq::const_iterator id = ids.begin(); id != ids.end(); ++id)
         {
             vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), *id);
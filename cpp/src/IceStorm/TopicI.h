@@ -82,6 +82,13 @@ private:
 
     Ice::ObjectPtr _servant; // The topic implementation servant.
 
+    //
+    // Mutex serializing the updates of the topic. It's locked before the
+    // subscribers mutex and held while waiting for the database flush, the
+    // updates are only applied to the subscribers once they are durable.
+    //
+    IceUtil::Mutex _updateMutex;
+
     // Mutex protecting the subscribers.
     IceUtil::Mutex _subscribersMutex;
 
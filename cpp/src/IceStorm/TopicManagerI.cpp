@@ -200,6 +200,28 @@ public:
         }
     }
 
+    virtual void update(const ReplicaUpdateSeq& updates, const Ice::Current& current)
+    {
+        for(ReplicaUpdateSeq::const_iterator p = updates.begin(); p != updates.end(); ++p)
+        {
+            switch(p->kind)
+            {
+            case CreateTopicUpdate:
+                createTopic(p->llu, p->topic, current);
+                break;
+            case DestroyTopicUpdate:
+                destroyTopic(p->llu, p->topic, current);
+                break;
+            case AddSubscriberUpdate:
+                addSubscriber(p->llu, p->topic, p->record, current);
+                break;
+            case RemoveSubscriberUpdate:
+                removeSubscriber(p->llu, p->topic, p->subscribers, current);
+                break;
+            }
+        }
+    }
+
 private:
 
     const PersistentInstancePtr _instance;
@@ -656,6 +656,95 @@ emitOpNameResult(IceUtilInternal::Output& H, const OperationPtr& p, int useWstri
     }
 }
 
+//
+// Writes a switch statement on the characters of the string `s', which returns the
+// position of the string in the given list of strings of the same length or -1.
+//
+void
+writeStringSwitch(Output& out, const vector<pair<string, int> >& strings)
+{
+    assert(!strings.empty());
+    if(strings.size() == 1)
+    {
+        out << nl << "return s == \"" << strings.front().first << "\" ? " << strings.front().second << " : -1;";
+        return;
+    }
+
+    //
+    // Switch on the character which splits the strings in the most groups. The strings
+    // are distinct and have the same length, so there's always a character which splits
+    // them in at least two groups.
+    //
+    const size_t length = strings.front().first.size();
+    size_t pos = 0;
+    size_t count = 0;
+    for(size_t i = 0; i < length; ++i)
+    {
+        set<char> chars;
+        for(vector<pair<string, int> >::const_iterator p = strings.begin(); p != strings.end(); ++p)
+        {
+            chars.insert(p->first[i]);
+        }
+        if(chars.size() > count)
+        {
+            pos = i;
+            count = chars.size();
+        }
+    }
+    assert(count > 1);
+
+    map<char, vector<pair<string, int> > > groups;
+    for(vector<pair<string, int> >::const_iterator p = strings.begin(); p != strings.end(); ++p)
+    {
+        groups[p->first[pos]].push_back(*p);
+    }
+
+    out << nl << "switch(s[" << pos << "])";
+    out << sb;
+    for(map<char, vector<pair<string, int> > >::const_iterator p = groups.begin(); p != groups.end(); ++p)
+    {
+        out << nl << "case '" << p->first << "':";
+        out << sb;
+        writeStringSwitch(out, p->second);
+        out << eb;
+    }
+    out << eb;
+    out << nl << "return -1;";
+}
+
+//
+// Writes a function returning the position of its string parameter in the given list of
+// strings or -1. The string is looked up with a switch statement on its length followed
+// by switch statements on its characters, so it's compared with at most one string of
+// the list.
+//
+void
+writeStringLookup(Output& out, const string& name, const StringList& strings)
+{
+    map<size_t, vector<pair<string, int> > > lengths;
+    int i = 0;
+    for(StringList::const_iterator p = strings.begin(); p != strings.end(); ++p)
+    {
+        lengths[p->size()].push_back(make_pair(*p, i++));
+    }
+
+    out << sp << nl << "int";
+    out << nl << name << "(const ::std::string& s)";
+    out << sb;
+    out << nl << "switch(s.size())";
+    out << sb;
+    for(map<size_t, vector<pair<string, int> > >::const_iterator p = lengths.begin(); p != lengths.end(); ++p)
+    {
+        out << nl << "case " << p->first << ':';
+        out << sb;
+        writeStringSwitch(out, p->second);
+        out << eb;
+    }
+    out << eb;
+    out << nl << "return -1;";
+    out << eb;
+}
+
 }
 
 Slice::Gen::Gen(const string& base, const string& headerExtension, const string& sourceExtension,
@@ -3130,6 +3219,7 @@ Slice::Gen::ObjectVisitor::visitClassDefStart(const ClassDefPtr& p)
         H << nl << "static const ::std::string& ice_staticId();";
 
         string flatName = "iceC" + p->flattenedScope() + p->name() + "_ids";
+        string idIndexName = "iceC" + p->flattenedScope() + p->name() + "_idIndex";
 
         C << sp << nl << "namespace";
         C << nl << "{";
@@ -3145,13 +3235,14 @@ Slice::Gen::ObjectVisitor::visitClassDefStart(const ClassDefPtr& p)
             }
         }
         C << eb << ';';
+        writeStringLookup(C, idIndexName, ids);
         C << sp << nl << "}";
 
         C << sp;
         C << nl << "bool" << nl << scoped.substr(2)
           << "::ice_isA(const ::std::string& s, const " << getUnqualified("::Ice::Current&", scope) << ") const";
         C << sb;
-        C << nl << "return ::std::binary_search(" << flatName << ", " << flatName << " + " << ids.size() << ", s);";
+        C << nl << "return " << idIndexName << "(s) != -1;";
         C << eb;
 
         C << sp;
@@ -3244,21 +3335,10 @@ Slice::Gen::ObjectVisitor::visitClassDefEnd(const ClassDefPtr& p)
               << getUnqualified("::Ice::Current&", scope) << ");";
             H << nl << "/// \\endcond";
 
-            string flatName = "iceC" + p->flattenedScope() + p->name() + "_all";
+            string flatName = "iceC" + p->flattenedScope() + p->name() + "_operationIndex";
             C << sp << nl << "namespace";
             C << nl << "{";
-            C << nl << "const ::std::string " << flatName << "[] =";
-            C << sb;
-
-            for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end();)
-            {
-                C << nl << '"' << *q << '"';
-                if(++q != allOpNames.end())
-                {
-                    C << ',';
-                }
-            }
-            C << eb << ';';
+            writeStringLookup(C, flatName, allOpNames);
             C << sp << nl << "}";
             C << sp;
             C << nl << "/// \\cond INTERNAL";
@@ -3266,17 +3346,7 @@ Slice::Gen::ObjectVisitor::visitClassDefEnd(const ClassDefPtr& p)
             C << nl << scoped.substr(2) << "::_iceDispatch(::IceInternal::Incoming& in, const "
               << getUnqualified("::Ice::Current&", scope) << " current)";
             C << sb;
-
-            C << nl << "::std::pair<const ::std::string*, const ::std::string*> r = "
-              << "::std::equal_range(" << flatName << ", " << flatName << " + " << allOpNames.size()
-              << ", current.operation);";
-            C << nl << "if(r.first == r.second)";
-            C << sb;
-            C << nl << "throw " << getUnqualified("::Ice::OperationNotExistException", scope)
-              << "(__FILE__, __LINE__, current.id, " << "current.facet, current.operation);";
-            C << eb;
-            C << sp;
-            C << nl << "switch(r.first - " << flatName << ')';
+            C << nl << "switch(" << flatName << "(current.operation))";
             C << sb;
             int i = 0;
             for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end(); ++q)
@@ -3288,7 +3358,6 @@ Slice::Gen::ObjectVisitor::visitClassDefEnd(const ClassDefPtr& p)
             }
             C << nl << "default:";
             C << sb;
-            C << nl << "assert(false);";
             C << nl << "throw " << getUnqualified("::Ice::OperationNotExistException", scope)
               << "(__FILE__, __LINE__, current.id, " << "current.facet, current.operation);";
             C << eb;
@@ -3351,15 +3420,13 @@ Slice::Gen::ObjectVisitor::visitClassDefEnd(const ClassDefPtr& p)
                   << "::ice_operationAttributes(const ::std::string& opName) const";
                 C << sb;
 
-                C << nl << "::std::pair<const ::std::string*, const ::std::string*> r = "
-                  << "::std::equal_range(" << flatName << ", " << flatName << " + " << allOpNames.size()
-                  << ", opName);";
-                C << nl << "if(r.first == r.second)";
+                C << nl << "int i = " << flatName << "(opName);";
+                C << nl << "if(i == -1)";
                 C << sb;
                 C << nl << "return -1;";
                 C << eb;
 
-                C << nl << "return " << opAttrFlatName << "[r.first - " << flatName << "];";
+                C << nl << "return " << opAttrFlatName << "[i];";
                 C << eb;
             }
         }
@@ -5589,6 +5656,12 @@ Slice::Gen::MetaDataVisitor::visitOperation(const OperationPtr& p)
         metaData.remove("cpp:noexcept");
     }
 
+    if(cl->isLocal() && p->hasMetaData("cpp:arena"))
+    {
+        dc->warning(InvalidMetaData, p->file(), p->line(), "ignoring metadata `cpp:arena' for local interface");
+        metaData.remove("cpp:arena");
+    }
+
     TypePtr returnType = p->returnType();
     if(!returnType)
     {
@@ -5689,7 +5762,7 @@ Slice::Gen::MetaDataVisitor::validate(const SyntaxTreeBasePtr& cont, const Strin
             cpp11 = true;
         }
 
-        if(operation && (s == "cpp:const" || s == "cpp:noexcept"))
+        if(operation && (s == "cpp:const" || s == "cpp:noexcept" || s == "cpp:arena"))
         {
             continue;
         }
@@ -6201,6 +6274,7 @@ Slice::Gen::Cpp11DeclVisitor::visitClassDefStart(const ClassDefPtr& p)
             }
         }
         C << eb << ';';
+        writeStringLookup(C, "iceC" + p->flattenedScope() + p->name() + "_idIndex", ids);
 
         StringList allOpNames;
 #ifdef ICE_CPP11_COMPILER
@@ -6219,17 +6293,10 @@ Slice::Gen::Cpp11DeclVisitor::visitClassDefStart(const ClassDefPtr& p)
         allOpNames.sort();
         allOpNames.unique();
 
-        C << nl << "const ::std::string iceC" << p->flattenedScope() << p->name() << "_ops[] =";
-        C << sb;
-        for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end();)
+        if(!allOps.empty())
         {
-            C << nl << '"' << *q << '"';
-            if(++q != allOpNames.end())
-            {
-                C << ',';
-            }
+            writeStringLookup(C, "iceC" + p->flattenedScope() + p->name() + "_operationIndex", allOpNames);
         }
-        C << eb << ';';
     }
 
     return true;
@@ -7184,6 +7251,10 @@ Slice::Gen::Cpp11ProxyVisitor::visitOperation(const OperationPtr& p)
         C << nl << "read = [response](::Ice::InputStream* istr)";
         C << sb;
         C << nl << "istr->startEncapsulation();";
+        if(p->returnsClasses(false) && p->hasMetaData("cpp:arena"))
+        {
+            C << nl << "istr->setArenaAllocation(true);";
+        }
         writeAllocateCode(C, outParams, p, true, clScope, _useWstring | TypeContextInParam | TypeContextCpp11);
         writeUnmarshalCode(C, outParams, p, true, _useWstring | TypeContextInParam | TypeContextCpp11);
 
@@ -7311,6 +7382,10 @@ Slice::Gen::Cpp11ProxyVisitor::visitOperation(const OperationPtr& p)
         C << "," << nl << "[](" << getUnqualified("::Ice::InputStream*", clScope) << " istr)";
         C << sb;
         C << nl << futureT << " v;";
+        if(p->returnsClasses(false) && p->hasMetaData("cpp:arena"))
+        {
+            C << nl << "istr->setArenaAllocation(true);";
+        }
         writeUnmarshalCode(C, outParams, p, false, _useWstring | TypeContextCpp11, "", returnValueS, "v");
 
         if(p->returnsClasses(false))
@@ -7330,6 +7405,10 @@ Slice::Gen::Cpp11ProxyVisitor::visitOperation(const OperationPtr& p)
         C << "," << nl << "[](" << getUnqualified("::Ice::InputStream*", clScope) << " istr)";
         C << sb;
 
+        if(p->returnsClasses(false) && p->hasMetaData("cpp:arena"))
+        {
+            C << nl << "istr->setArenaAllocation(true);";
+        }
         writeAllocateCode(C, outParams, p, true, clScope, _useWstring | TypeContextCpp11);
         writeUnmarshalCode(C, outParams, p, true, _useWstring | TypeContextCpp11);
 
@@ -8062,7 +8141,7 @@ Slice::Gen::Cpp11InterfaceVisitor::visitClassDefStart(const ClassDefPtr& p)
     C << nl << "bool" << nl << scoped.substr(2) << "::ice_isA(::std::string s, const "
       << getUnqualified("::Ice::Current&", scope) << ") const";
     C << sb;
-    C << nl << "return ::std::binary_search(" << flatName << ", " << flatName << " + " << ids.size() << ", s);";
+    C << nl << "return iceC" << p->flattenedScope() << p->name() << "_idIndex(s) != -1;";
     C << eb;
 
     C << sp;
@@ -8127,7 +8206,7 @@ Slice::Gen::Cpp11InterfaceVisitor::visitClassDefEnd(const ClassDefPtr& p)
         allOpNames.sort();
         allOpNames.unique();
 
-        string flatName = "iceC" + p->flattenedScope() + p->name() + "_ops";
+        string flatName = "iceC" + p->flattenedScope() + p->name() + "_operationIndex";
 
         H << sp;
         H << nl << "/// \\cond INTERNAL";
@@ -8142,16 +8221,7 @@ Slice::Gen::Cpp11InterfaceVisitor::visitClassDefEnd(const ClassDefPtr& p)
           << getUnqualified("::Ice::Current&", scope) << " current)";
         C << sb;
 
-        C << nl << "::std::pair<const ::std::string*, const ::std::string*> r = "
-          << "::std::equal_range(" << flatName << ", " << flatName << " + " << allOpNames.size()
-          << ", current.operation);";
-        C << nl << "if(r.first == r.second)";
-        C << sb;
-        C << nl << "throw " << getUnqualified("::Ice::OperationNotExistException", scope)
-          << "(__FILE__, __LINE__, current.id, current.facet, current.operation);";
-        C << eb;
-        C << sp;
-        C << nl << "switch(r.first - " << flatName << ')';
+        C << nl << "switch(" << flatName << "(current.operation))";
         C << sb;
         int i = 0;
         for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end(); ++q)
@@ -8163,7 +8233,6 @@ Slice::Gen::Cpp11InterfaceVisitor::visitClassDefEnd(const ClassDefPtr& p)
         }
         C << nl << "default:";
         C << sb;
-        C << nl << "assert(false);";
         C << nl << "throw " << getUnqualified("::Ice::OperationNotExistException", scope)
           << "(__FILE__, __LINE__, current.id, current.facet, current.operation);";
         C << eb;
@@ -8403,6 +8472,10 @@ Slice::Gen::Cpp11InterfaceVisitor::visitOperation(const OperationPtr& p)
     if(!inParams.empty())
     {
         C << nl << "auto istr = inS.startReadParams();";
+        if(p->sendsClasses(false) && p->hasMetaData("cpp:arena"))
+        {
+            C << nl << "istr->setArenaAllocation(true);";
+        }
         writeAllocateCode(C, inParams, 0, true, classScope, _useWstring | TypeContextInParam | TypeContextCpp11);
         writeUnmarshalCode(C, inParams, 0, true, _useWstring | TypeContextInParam | TypeContextCpp11);
         if(p->sendsClasses(false))
@@ -135,6 +135,12 @@ Test::TestHelper::TestHelper(bool registerPlugins) :
         Ice::registerIceSSL(false);
         Ice::registerIceWS(true);
         Ice::registerIceUDP(true);
+#   if !defined(_WIN32) && (!defined(__APPLE__) || TARGET_OS_IPHONE == 0)
+        Ice::registerIceUNIX(true);
+#   endif
+#   ifdef ICE_HAS_SHM
+        Ice::registerIceSHM(true);
+#   endif
 #   ifdef ICE_HAS_BT
         Ice::registerIceBT(false);
 #   endif
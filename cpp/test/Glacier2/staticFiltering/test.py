@@ -225,6 +225,20 @@ class Glacier2StaticFilteringTestSuite(Glacier2TestSuite):
                         (False, 'cata/fooa:tcp -h 127.0.0.1 -p 12010'),
                         (True, '"a funny id/that might mess it up" @ myadapter'),
                         (False, '"a funny id/that might mess it up":tcp -h 127.0.0.1 -p 12010')], []),
+                ('testing address filter with a number at the end of the host',
+                        ('127.0.0.[1]', '', '', '', '', ''),
+                        [(True, 'hello1:tcp -h 127.0.0.1 -p 12010'),
+                        (False, 'hello2:tcp -h 127.0.0.10 -p 12010'),
+                        (False, 'hello3:tcp -h localhost -p 12010')], []),
+                ('testing reject address filter with a number at the end of the host',
+                        ('', '127.0.0.[2-9,10-255]', '', '', '', ''),
+                        [(True, 'hello1:tcp -h 127.0.0.1 -p 12010'),
+                        (False, 'hello2:tcp -h 127.0.0.2 -p 12010'),
+                        (False, 'hello3:tcp -h 127.0.0.10 -p 12010')], []),
+                ('testing address filter with a number past the end of the host',
+                        ('*127.0.0.1[0-9] localhost', '', '', '', '', ''),
+                        [(False, 'hello1:tcp -h 127.0.0.1 -p 12010'),
+                        (True, 'hello2:tcp -h localhost -p 12010')], []),
                 ]
 
         if not limitedTests:
@@ -290,7 +304,7 @@ class Glacier2StaticFilteringTestSuite(Glacier2TestSuite):
             current.writeln("WARNING: You are running this test with SSL disabled and the network ")
             current.writeln("         configuration for this host does not permit the other tests ")
             current.writeln("         to run correctly.")
-        elif len(testcases) < 6:
+        elif limitedTests:
             current.writeln("WARNING: The network configuration for this host does not permit all ")
             current.writeln("         tests to run correctly, some tests have been disabled.")
 
@@ -536,6 +536,58 @@ allTests(Test::TestHelper* helper)
     }
     cout << "ok" << endl;
 
+    cout << "testing balanced endpoint selection... " << flush;
+    {
+        vector<RemoteObjectAdapterPrxPtr> adapters;
+        adapters.push_back(com->createObjectAdapter("AdapterBalanced11", "default"));
+        adapters.push_back(com->createObjectAdapter("AdapterBalanced12", "default"));
+        adapters.push_back(com->createObjectAdapter("AdapterBalanced13", "default"));
+
+        //
+        // Balanced is only supported by Ice for C++, it's set with the proxy properties.
+        //
+        Ice::PropertiesPtr properties = communicator->getProperties();
+        properties->setProperty("Balanced", communicator->proxyToString(createTestIntfPrx(adapters)));
+        properties->setProperty("Balanced.EndpointSelection", "Balanced");
+        TestIntfPrxPtr test = ICE_UNCHECKED_CAST(TestIntfPrx, communicator->propertyToProxy("Balanced"));
+        test(test->ice_getEndpointSelection() == Ice::ICE_ENUM(EndpointSelectionType, Random));
+        test(communicator->proxyToProperty(test, "Balanced")["Balanced.EndpointSelection"] == "Balanced");
+        Ice::ObjectPrxPtr random = test->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Random));
+        test(communicator->proxyToProperty(random, "Random")["Random.EndpointSelection"] == "Random");
+
+        //
+        // Invocations are distributed over the endpoints without closing the connections.
+        //
+        set<string> names;
+        names.insert("AdapterBalanced11");
+        names.insert("AdapterBalanced12");
+        names.insert("AdapterBalanced13");
+        while(!names.empty())
+        {
+            names.erase(test->getAdapterName());
+        }
+        test(test->ice_getCachedConnection());
+
+        //
+        // Endpoints which can't be reached are no longer used.
+        //
+        com->deactivateObjectAdapter(adapters[0]);
+
+        names.insert("AdapterBalanced12");
+        names.insert("AdapterBalanced13");
+        while(!names.empty())
+        {
+            names.erase(test->getAdapterName());
+        }
+        for(int i = 0; i < 10; ++i)
+        {
+            test(test->getAdapterName() != "AdapterBalanced11");
+        }
+
+        deactivate(com, adapters);
+    }
+    cout << "ok" << endl;
+
     cout << "testing per request binding with single endpoint... " << flush;
     {
         RemoteObjectAdapterPrxPtr adapter = com->createObjectAdapter("Adapter41", "default");
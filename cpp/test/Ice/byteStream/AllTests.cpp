@@ -0,0 +1,160 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+vector<Ice::Byte>
+encodeChunk(const Ice::CommunicatorPtr& communicator, const string& stream, Ice::Int chunk, bool last)
+{
+    Ice::OutputStream out(communicator);
+    out.startEncapsulation();
+    out.write(stream);
+    out.write(chunk);
+    out.write(last);
+    out.write(vector<Ice::Byte>());
+    out.endEncapsulation();
+    vector<Ice::Byte> inEncaps;
+    out.finished(inEncaps);
+    return inEncaps;
+}
+
+}
+
+TestIntfPrxPtr
+allTests(Test::TestHelper* helper)
+{
+    Ice::CommunicatorPtr communicator = helper->communicator();
+    TestIntfPrxPtr intf = ICE_CHECKED_CAST(TestIntfPrx, communicator->stringToProxy("test:" +
+                                                                                    helper->getTestEndpoint()));
+    test(intf);
+    Ice::ObjectPrxPtr stream = communicator->stringToProxy("stream:" + helper->getTestEndpoint());
+
+    vector<Ice::Byte> data(100 * 1024 + 17);
+    for(size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<Ice::Byte>(i % 251);
+    }
+
+    cout << "testing byte stream... " << flush;
+    {
+        Ice::ByteStreamWriterPtr writer = ICE_MAKE_SHARED(Ice::ByteStreamWriter, stream, "upload", 1024, 4);
+        writer->write(data);
+        test(intf->getSize(writer->getId()) == -1);
+        writer->close();
+        test(intf->getSize(writer->getId()) == static_cast<Ice::Long>(data.size()));
+    }
+    {
+        //
+        // Write with sizes which aren't multiples of the chunk size.
+        //
+        Ice::ByteStreamWriterPtr writer = ICE_MAKE_SHARED(Ice::ByteStreamWriter, stream, "upload", 1000, 2);
+        size_t pos = 0;
+        size_t sz = 1;
+        while(pos < data.size())
+        {
+            size_t n = min(sz, data.size() - pos);
+            writer->write(&data[pos], &data[pos] + n);
+            pos += n;
+            sz = sz * 3 + 1;
+        }
+        writer->close();
+        writer->close();
+        test(intf->getSize(writer->getId()) == static_cast<Ice::Long>(data.size()));
+    }
+    {
+        Ice::ByteStreamWriterPtr writer = ICE_MAKE_SHARED(Ice::ByteStreamWriter, stream, "upload");
+        writer->close();
+        test(intf->getSize(writer->getId()) == 0);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing byte stream failure... " << flush;
+    {
+        Ice::ByteStreamWriterPtr writer = ICE_MAKE_SHARED(Ice::ByteStreamWriter, stream, "fail", 1024, 4);
+        try
+        {
+            writer->write(data);
+            writer->close();
+            test(false);
+        }
+        catch(const Ice::UnknownException&)
+        {
+        }
+
+        try
+        {
+            writer->write(data);
+            test(false);
+        }
+        catch(const Ice::UnknownException&)
+        {
+        }
+        catch(const IceUtil::IllegalArgumentException&)
+        {
+        }
+        test(intf->getSize(writer->getId()) == -1);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing byte stream expiration... " << flush;
+    {
+        //
+        // A chunk of an unknown stream which can't be one of the first chunks of a new
+        // stream is rejected.
+        //
+        vector<Ice::Byte> outEncaps;
+        try
+        {
+            stream->ice_invoke("upload", Ice::ICE_ENUM(OperationMode, Normal),
+                               encodeChunk(communicator, "unknown", 100, true), outEncaps);
+            test(false);
+        }
+        catch(const Ice::UnknownException&)
+        {
+        }
+        test(intf->getSize("unknown") == -1);
+
+        //
+        // A chunk received out of order is rejected once its stream expired.
+        //
+        Ice::ObjectPrxPtr idleStream = communicator->stringToProxy("idleStream:" + helper->getTestEndpoint());
+#ifdef ICE_CPP11_MAPPING
+        auto result = idleStream->ice_invokeAsync("upload", Ice::OperationMode::Normal,
+                                                  encodeChunk(communicator, "idle", 1, true));
+#else
+        Ice::AsyncResultPtr result = idleStream->begin_ice_invoke("upload", Ice::Normal,
+                                                                  encodeChunk(communicator, "idle", 1, true));
+#endif
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(2500));
+
+        //
+        // The idle streams are discarded when a chunk is received.
+        //
+        Ice::ByteStreamWriterPtr writer = ICE_MAKE_SHARED(Ice::ByteStreamWriter, idleStream, "upload");
+        writer->close();
+        try
+        {
+#ifdef ICE_CPP11_MAPPING
+            result.get();
+#else
+            idleStream->end_ice_invoke(outEncaps, result);
+#endif
+            test(false);
+        }
+        catch(const Ice::UnknownException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    return intf;
+}
@@ -0,0 +1,28 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    TestIntfPrxPtr allTests(Test::TestHelper*);
+    TestIntfPrxPtr intf = allTests(this);
+    intf->shutdown();
+}
+
+DEFINE_TEST(Client)
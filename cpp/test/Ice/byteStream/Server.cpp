@@ -0,0 +1,43 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <TestI.h>
+
+using namespace std;
+
+class Server : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Server::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+
+    //
+    // Dispatch with several threads so that chunks might be dispatched out of order, and
+    // dispatch pipelined chunks in batches.
+    //
+    communicator->getProperties()->setProperty("TestAdapter.Endpoints", getTestEndpoint());
+    communicator->getProperties()->setProperty("TestAdapter.ThreadPool.Size", "4");
+    communicator->getProperties()->setProperty("TestAdapter.ThreadPool.SizeWarn", "0");
+    communicator->getProperties()->setProperty("TestAdapter.ThreadPool.MessageBatchSize", "8");
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    StreamIPtr stream = ICE_MAKE_SHARED(StreamI);
+    adapter->add(stream, Ice::stringToIdentity("stream"));
+    adapter->add(ICE_MAKE_SHARED(StreamI, 1), Ice::stringToIdentity("idleStream"));
+    adapter->add(ICE_MAKE_SHARED(TestIntfI, stream), Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    serverReady();
+
+    communicator->waitForShutdown();
+}
+
+DEFINE_TEST(Server)
@@ -0,0 +1,62 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+StreamI::StreamI(int idleTimeout) : Ice::ByteStreamServant(16, idleTimeout)
+{
+}
+
+void
+StreamI::received(const string& stream, const pair<const Ice::Byte*, const Ice::Byte*>& data, bool last,
+                  const Ice::Current& current)
+{
+    if(current.operation == "fail")
+    {
+        throw Ice::UnknownException(__FILE__, __LINE__, "stream failure");
+    }
+
+    IceUtil::Mutex::Lock sync(_mutex);
+    Ice::Long& offset = _received[stream];
+    for(const Ice::Byte* p = data.first; p != data.second; ++p, ++offset)
+    {
+        if(*p != static_cast<Ice::Byte>(offset % 251))
+        {
+            throw Ice::UnknownException(__FILE__, __LINE__, "unexpected stream data");
+        }
+    }
+
+    if(last)
+    {
+        _completed[stream] = offset;
+        _received.erase(stream);
+    }
+}
+
+Ice::Long
+StreamI::getSize(const string& stream)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    map<string, Ice::Long>::const_iterator p = _completed.find(stream);
+    return p == _completed.end() ? -1 : p->second;
+}
+
+TestIntfI::TestIntfI(const StreamIPtr& stream) : _stream(stream)
+{
+}
+
+Ice::Long
+TestIntfI::getSize(ICE_IN(string) stream, const Ice::Current&)
+{
+    return _stream->getSize(stream);
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
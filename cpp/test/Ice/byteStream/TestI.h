@@ -0,0 +1,44 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Ice/ByteStream.h>
+#include <Test.h>
+
+class StreamI : public Ice::ByteStreamServant
+{
+public:
+
+    StreamI(int = 60);
+
+    virtual void received(const std::string&, const std::pair<const Ice::Byte*, const Ice::Byte*>&, bool,
+                          const Ice::Current&);
+
+    Ice::Long getSize(const std::string&);
+
+private:
+
+    IceUtil::Mutex _mutex;
+    std::map<std::string, Ice::Long> _received;
+    std::map<std::string, Ice::Long> _completed;
+};
+ICE_DEFINE_PTR(StreamIPtr, StreamI);
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    TestIntfI(const StreamIPtr&);
+
+    virtual Ice::Long getSize(ICE_IN(std::string), const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    const StreamIPtr _stream;
+};
+
+#endif
@@ -0,0 +1,133 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+TestIntfPrxPtr
+allTests(Test::TestHelper* helper)
+{
+    Ice::CommunicatorPtr communicator = helper->communicator();
+    TestIntfPrxPtr intf = ICE_CHECKED_CAST(TestIntfPrx, communicator->stringToProxy("test:" +
+                                                                                    helper->getTestEndpoint()));
+    test(intf);
+    TestIntfPrxPtr oneway = intf->ice_oneway();
+    TestControllerPrxPtr controller =
+        ICE_CHECKED_CAST(TestControllerPrx, communicator->stringToProxy("controller:" +
+                                                                        helper->getTestEndpoint(1)));
+    test(controller);
+
+    cout << "testing dispatch order of pipelined oneways and twoways... " << flush;
+    {
+        //
+        // The requests are sent while the adapter is on hold, they are read and
+        // dispatched in batches once the adapter is activated.
+        //
+        const int count = 100;
+        controller->holdAdapter();
+#ifdef ICE_CPP11_MAPPING
+        vector<pair<int, future<int> > > results;
+#else
+        vector<pair<int, Ice::AsyncResultPtr> > results;
+#endif
+        for(int i = 0; i < count; ++i)
+        {
+            if(i % 4 == 3)
+            {
+#ifdef ICE_CPP11_MAPPING
+                results.push_back(make_pair(i, intf->opTwowayAsync(i)));
+#else
+                results.push_back(make_pair(i, intf->begin_opTwoway(i)));
+#endif
+            }
+            else
+            {
+                oneway->opOneway(i);
+            }
+        }
+        controller->resumeAdapter();
+
+#ifdef ICE_CPP11_MAPPING
+        for(vector<pair<int, future<int> > >::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            test(p->second.get() == p->first);
+        }
+#else
+        for(vector<pair<int, Ice::AsyncResultPtr> >::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            test(intf->end_opTwoway(p->second) == p->first);
+        }
+#endif
+
+        //
+        // The last request is a twoway, all the requests are dispatched once it returns.
+        //
+        Ice::IntSeq calls = controller->getCalls();
+        test(calls.size() == static_cast<size_t>(count));
+        for(int i = 0; i < count; ++i)
+        {
+            test(calls[static_cast<size_t>(i)] == i);
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing read error in a batch... " << flush;
+    {
+        //
+        // The message with the payload exceeds the MessageSizeMax of the adapter, the
+        // server closes the connection when it reads it but still dispatches the
+        // messages read before it in the same batch.
+        //
+        const int count = 5;
+        Ice::ConnectionPtr connection = intf->ice_getConnection();
+        controller->holdAdapter();
+        for(int i = 0; i < count; ++i)
+        {
+            oneway->opOneway(i);
+        }
+        oneway->opWithPayload(Ice::ByteSeq(20 * 1024));
+        controller->resumeAdapter();
+
+        Ice::IntSeq calls;
+        for(int i = 0; i < 100 && calls.size() < static_cast<size_t>(count); ++i)
+        {
+            Ice::IntSeq c = controller->getCalls();
+            calls.insert(calls.end(), c.begin(), c.end());
+            if(calls.size() < static_cast<size_t>(count))
+            {
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(50));
+            }
+        }
+        test(calls.size() == static_cast<size_t>(count));
+        for(int i = 0; i < count; ++i)
+        {
+            test(calls[static_cast<size_t>(i)] == i);
+        }
+
+        //
+        // Wait for the connection to be closed, the next invocation establishes a new one.
+        //
+        while(true)
+        {
+            try
+            {
+                connection->throwException();
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+            }
+            catch(const Ice::LocalException&)
+            {
+                break;
+            }
+        }
+        test(intf->opTwoway(count) == count);
+        test(controller->getCalls() == Ice::IntSeq(1, count));
+    }
+    cout << "ok" << endl;
+
+    return intf;
+}
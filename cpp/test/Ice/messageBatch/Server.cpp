@@ -0,0 +1,56 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <TestI.h>
+
+using namespace std;
+
+class Server : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Server::run(int argc, char** argv)
+{
+    Ice::PropertiesPtr properties = createTestProperties(argc, argv);
+
+    //
+    // The connection is closed when a message exceeds the MessageSizeMax of
+    // TestAdapter, don't warn about it.
+    //
+    properties->setProperty("Ice.Warn.Connections", "0");
+    Ice::CommunicatorHolder communicator = initialize(argc, argv, properties);
+
+    //
+    // Dispatch pipelined messages in batches, with several threads but serialized
+    // so that the dispatch order is the order of the messages on the connection.
+    //
+    communicator->getProperties()->setProperty("TestAdapter.Endpoints", getTestEndpoint());
+    communicator->getProperties()->setProperty("TestAdapter.MessageSizeMax", "10");
+    communicator->getProperties()->setProperty("TestAdapter.ThreadPool.Size", "4");
+    communicator->getProperties()->setProperty("TestAdapter.ThreadPool.SizeWarn", "0");
+    communicator->getProperties()->setProperty("TestAdapter.ThreadPool.Serialize", "1");
+    communicator->getProperties()->setProperty("TestAdapter.ThreadPool.MessageBatchSize", "8");
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    TestIntfIPtr intf = ICE_MAKE_SHARED(TestIntfI);
+    adapter->add(intf, Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    communicator->getProperties()->setProperty("ControllerAdapter.Endpoints", getTestEndpoint(1));
+    communicator->getProperties()->setProperty("ControllerAdapter.ThreadPool.Size", "1");
+    Ice::ObjectAdapterPtr adapter2 = communicator->createObjectAdapter("ControllerAdapter");
+    adapter2->add(ICE_MAKE_SHARED(TestControllerI, adapter, intf), Ice::stringToIdentity("controller"));
+    adapter2->activate();
+
+    serverReady();
+
+    communicator->waitForShutdown();
+}
+
+DEFINE_TEST(Server)
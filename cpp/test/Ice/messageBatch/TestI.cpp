@@ -0,0 +1,67 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+void
+TestIntfI::opOneway(Ice::Int n, const Ice::Current&)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    _calls.push_back(n);
+}
+
+Ice::Int
+TestIntfI::opTwoway(Ice::Int n, const Ice::Current&)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    _calls.push_back(n);
+    return n;
+}
+
+void
+TestIntfI::opWithPayload(ICE_IN(Ice::ByteSeq), const Ice::Current&)
+{
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
+
+Ice::IntSeq
+TestIntfI::getCalls()
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    Ice::IntSeq calls;
+    calls.swap(_calls);
+    return calls;
+}
+
+TestControllerI::TestControllerI(const Ice::ObjectAdapterPtr& adapter, const TestIntfIPtr& intf) :
+    _adapter(adapter),
+    _intf(intf)
+{
+}
+
+void
+TestControllerI::holdAdapter(const Ice::Current&)
+{
+    _adapter->hold();
+}
+
+void
+TestControllerI::resumeAdapter(const Ice::Current&)
+{
+    _adapter->activate();
+}
+
+Ice::IntSeq
+TestControllerI::getCalls(const Ice::Current&)
+{
+    return _intf->getCalls();
+}
@@ -0,0 +1,46 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    virtual void opOneway(Ice::Int, const Ice::Current&);
+    virtual Ice::Int opTwoway(Ice::Int, const Ice::Current&);
+    virtual void opWithPayload(ICE_IN(Ice::ByteSeq), const Ice::Current&);
+
+    virtual void shutdown(const Ice::Current&);
+
+    Ice::IntSeq getCalls();
+
+private:
+
+    IceUtil::Mutex _mutex;
+    Ice::IntSeq _calls;
+};
+ICE_DEFINE_PTR(TestIntfIPtr, TestIntfI);
+
+class TestControllerI : public Test::TestController
+{
+public:
+
+    TestControllerI(const Ice::ObjectAdapterPtr&, const TestIntfIPtr&);
+
+    virtual void holdAdapter(const Ice::Current&);
+    virtual void resumeAdapter(const Ice::Current&);
+
+    virtual Ice::IntSeq getCalls(const Ice::Current&);
+
+private:
+
+    const Ice::ObjectAdapterPtr _adapter;
+    const TestIntfIPtr _intf;
+};
+
+#endif
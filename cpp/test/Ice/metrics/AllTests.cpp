@@ -3,6 +3,7 @@
 //
 
 #include <Ice/Ice.h>
+#include <Ice/Network.h>
 #include <TestHelper.h>
 #include <InstrumentationI.h>
 #include <Test.h>
@@ -200,6 +201,66 @@ public:
     }
 };
 
+//
+// Sends a GET request to the metrics exporter and returns the response, with
+// the body decoded if it's sent with the chunked transfer encoding.
+//
+string
+scrapeMetrics(int port, const string& path, const string& version = "1.1")
+{
+    IceInternal::Address addr =
+        IceInternal::getAddressForServer("127.0.0.1", port, IceInternal::EnableIPv4, false, true);
+    SOCKET fd = IceInternal::createSocket(false, addr);
+    IceInternal::setBlock(fd, true);
+    IceInternal::doConnect(fd, addr, IceInternal::Address());
+
+    string request = "GET " + path + " HTTP/" + version + "\r\nHost: 127.0.0.1\r\n\r\n";
+#ifdef _WIN32
+    test(::send(fd, request.c_str(), static_cast<int>(request.size()), 0) == static_cast<int>(request.size()));
+#else
+    test(::send(fd, request.c_str(), request.size(), 0) == static_cast<ssize_t>(request.size()));
+#endif
+
+    string response;
+    char buf[4096];
+    while(true)
+    {
+        ssize_t ret = ::recv(fd, buf, sizeof(buf), 0);
+        if(ret <= 0)
+        {
+            break;
+        }
+        response.append(buf, static_cast<size_t>(ret));
+    }
+    IceInternal::closeSocket(fd);
+
+    string::size_type pos = response.find("\r\n\r\n");
+    test(pos != string::npos);
+    pos += 4;
+    if(response.substr(0, pos).find("\r\nTransfer-Encoding: chunked\r\n") == string::npos)
+    {
+        return response;
+    }
+
+    string body;
+    while(true)
+    {
+        string::size_type eol = response.find("\r\n", pos);
+        test(eol != string::npos);
+        size_t size = strtoul(response.substr(pos, eol - pos).c_str(), 0, 16);
+        pos = eol + 2;
+        test(response.size() >= pos + size + 2 && response.compare(pos + size, 2, "\r\n") == 0);
+        if(size == 0)
+        {
+            test(pos + 2 == response.size());
+            break;
+        }
+        body += response.substr(pos, size);
+        pos += size + 2;
+    }
+    return response.substr(0, response.find("\r\n\r\n") + 4) + body;
+}
+
 string
 getPort(const Ice::PropertiesAdminPrxPtr& p)
 {
@@ -984,7 +1045,113 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
         testAttribute(clientMetrics, clientProps, update.get(), "EndpointLookup", "endpointCompress", "false", c);
         testAttribute(clientMetrics, clientProps, update.get(), "EndpointLookup", "endpointHost", "localhost", c);
         testAttribute(clientMetrics, clientProps, update.get(), "EndpointLookup", "endpointPort", port, c);
+        testAttribute(clientMetrics, clientProps, update.get(), "EndpointLookup", "cache", "miss", c);
+
+        cout << "ok" << endl;
+
+        cout << "testing endpoint lookup cache metrics... " << flush;
+        {
+            Ice::InitializationData initData;
+            initData.properties = communicator->getProperties()->clone();
+            Ice::PropertyDict mx = initData.properties->getPropertiesForPrefix("IceMX.");
+            for(Ice::PropertyDict::const_iterator p = mx.begin(); p != mx.end(); ++p)
+            {
+                initData.properties->setProperty(p->first, "");
+            }
+            initData.properties->setProperty("Ice.Admin.InstanceName", "lookup");
+            initData.properties->setProperty("Ice.HostResolver.Size", "4");
+            initData.properties->setProperty("Ice.HostResolver.CacheTTL", "60");
+            initData.properties->setProperty("Ice.HostResolver.NegativeCacheTTL", "60");
+            initData.properties->setProperty("IceMX.Metrics.View.Map.EndpointLookup.GroupBy", "endpointHost/cache");
+            initData.properties->setProperty("IceMX.Metrics.View.Map.Thread.GroupBy", "id");
+            Ice::CommunicatorHolder ich(initData);
+            IceMX::MetricsAdminPrxPtr lookupMetrics =
+                ICE_CHECKED_CAST(IceMX::MetricsAdminPrx, ich->getAdmin(), "Metrics");
+
+            //
+            // The resolver runs Ice.HostResolver.Size threads.
+            //
+            std::map<string, IceMX::MetricsPtr> threads = toMap(lookupMetrics->getMetricsView("View", timestamp)["Thread"]);
+            for(int i = 0; i < 4; ++i)
+            {
+                ostringstream os;
+                os << "Ice.HostResolver-" << i;
+                test(threads.find(os.str()) != threads.end());
+            }
+            test(threads.find("Ice.HostResolver") == threads.end());
 
+            //
+            // Concurrent lookups of the same host and port wait for the result of a single
+            // DNS query, or find the addresses in the cache once the query completed.
+            //
+            Ice::ObjectPrxPtr lookupPrx = ich->stringToProxy("metrics:" + protocol + " -h localhost -t 500 -p " + port);
+#ifdef ICE_CPP11_MAPPING
+            vector<future<void>> results;
+            for(int i = 0; i < 10; ++i)
+            {
+                results.push_back(lookupPrx->ice_connectionId(to_string(i))->ice_pingAsync());
+            }
+            for(auto& r : results)
+            {
+                r.get();
+            }
+#else
+            vector<Ice::AsyncResultPtr> results;
+            for(int i = 0; i < 10; ++i)
+            {
+                ostringstream os;
+                os << i;
+                results.push_back(lookupPrx->ice_connectionId(os.str())->begin_ice_ping());
+            }
+            for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+            {
+                (*p)->getProxy()->end_ice_ping(*p);
+            }
+#endif
+            std::map<string, IceMX::MetricsPtr> lookups =
+                toMap(lookupMetrics->getMetricsView("View", timestamp)["EndpointLookup"]);
+            test(lookups["localhost/miss"] && lookups["localhost/miss"]->total == 1);
+            Ice::Long merged = lookups["localhost/merged"] ? lookups["localhost/merged"]->total : 0;
+            Ice::Long hits = lookups["localhost/hit"] ? lookups["localhost/hit"]->total : 0;
+            test(merged + hits == 9);
+
+            //
+            // The addresses of new connections are found in the cache.
+            //
+            lookupPrx->ice_connectionId("cached")->ice_ping();
+            lookups = toMap(lookupMetrics->getMetricsView("View", timestamp)["EndpointLookup"]);
+            test(lookups["localhost/miss"]->total == 1);
+            test(lookups["localhost/hit"] && lookups["localhost/hit"]->total == hits + 1);
+
+            //
+            // Failed lookups are found in the negative cache, the invocation is retried once.
+            //
+            bool dnsException = false;
+            for(int i = 0; i < 2; ++i)
+            {
+                try
+                {
+                    ich->stringToProxy("test:tcp -t 500 -h unknownfoo.zeroc.com -p " + port)->ice_ping();
+                    test(false);
+                }
+                catch(const Ice::DNSException&)
+                {
+                    dnsException = true;
+                }
+                catch(const Ice::LocalException&)
+                {
+                    // Some DNS servers don't fail on unknown DNS names.
+                }
+            }
+            lookups = toMap(lookupMetrics->getMetricsView("View", timestamp)["EndpointLookup"]);
+            test(lookups["unknownfoo.zeroc.com/miss"] && lookups["unknownfoo.zeroc.com/miss"]->total == 1);
+            test(lookups["unknownfoo.zeroc.com/hit"] && lookups["unknownfoo.zeroc.com/hit"]->total == 3);
+            if(dnsException)
+            {
+                test(lookups["unknownfoo.zeroc.com/miss"]->failures == 1);
+                test(lookups["unknownfoo.zeroc.com/hit"]->failures == 3);
+            }
+        }
         cout << "ok" << endl;
 #endif
     }
@@ -1053,6 +1220,7 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
     IceMX::DispatchMetricsPtr dm1 = ICE_DYNAMIC_CAST(IceMX::DispatchMetrics, map["op"]);
     test(dm1->current <= 1 && dm1->total == 1 && dm1->failures == 0 && dm1->userException == 0);
     test(dm1->size == 21 && dm1->replySize == 7);
+    test(!dm1->latency);
 
     dm1 = ICE_DYNAMIC_CAST(IceMX::DispatchMetrics, map["opWithUserException"]);
     test(dm1->current <= 1 && dm1->total == 1 && dm1->failures == 0 && dm1->userException == 1);
@@ -1110,6 +1278,55 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
     testAttribute(serverMetrics, serverProps, update.get(), "Dispatch", "context.entry2", "", op);
     testAttribute(serverMetrics, serverProps, update.get(), "Dispatch", "context.entry3", "", op);
 
+    props["IceMX.Metrics.View.Map.Dispatch.GroupBy"] = "operation";
+    props["IceMX.Metrics.View.Map.Dispatch.Histogram"] = "1";
+    updateProps(clientProps, serverProps, update.get(), props, "Dispatch");
+    metrics->op();
+    metrics->op();
+    metrics->op();
+    waitForCurrent(serverMetrics, "View", "Dispatch", 0);
+    map = toMap(serverMetrics->getMetricsView("View", timestamp)["Dispatch"]);
+    dm1 = ICE_DYNAMIC_CAST(IceMX::DispatchMetrics, map["op"]);
+    test(dm1->total == 3 && dm1->latency);
+    {
+        Ice::Long count = 0;
+        Ice::Long upperBound = -1;
+        for(IceMX::LatencyHistogram::const_iterator p = dm1->latency->begin(); p != dm1->latency->end(); ++p)
+        {
+            test(p->upperBound > upperBound && p->count > 0);
+            upperBound = p->upperBound;
+            count += p->count;
+        }
+        test(count == 3 && upperBound >= dm1->totalLifetime / 3);
+    }
+    props.erase("IceMX.Metrics.View.Map.Dispatch.Histogram");
+
+    cout << "ok" << endl;
+
+    cout << "testing metrics exporter... " << flush;
+    {
+        string response = scrapeMetrics(helper->getTestPort(2), "/metrics");
+        test(response.find("HTTP/1.1 200 OK\r\n") == 0);
+        test(response.find("\r\nTransfer-Encoding: chunked\r\n") != string::npos);
+        test(response.find("\r\n\r\n# TYPE ice_thread_pool_") != string::npos);
+        test(response.find("ice_thread_pool_threads{pool=\"Ice.ThreadPool.Client\"} ") != string::npos);
+        test(response.find("# TYPE ice_dispatch_total counter\n") != string::npos);
+        test(response.find("ice_dispatch_total{view=\"View\",id=\"op\"} 3\n") != string::npos);
+        test(response.find("# TYPE ice_dispatch_latency_microseconds histogram\n") != string::npos);
+        test(response.find("ice_dispatch_latency_microseconds_bucket{view=\"View\",id=\"op\",le=\"+Inf\"} 3\n") !=
+             string::npos);
+        test(response.find("ice_dispatch_latency_microseconds_count{view=\"View\",id=\"op\"} 3\n") != string::npos);
+
+        //
+        // The body of the response to an HTTP/1.0 request is delimited by the connection closure.
+        //
+        string response10 = scrapeMetrics(helper->getTestPort(2), "/metrics", "1.0");
+        test(response10.find("HTTP/1.1 200 OK\r\n") == 0);
+        test(response10.find("Transfer-Encoding") == string::npos);
+        test(response10.find("ice_dispatch_total{view=\"View\",id=\"op\"} 3\n") != string::npos);
+
+        test(scrapeMetrics(helper->getTestPort(2), "/").find("HTTP/1.1 404 Not Found\r\n") == 0);
+    }
     cout << "ok" << endl;
 
     cout << "testing invocation metrics... " << flush;
@@ -1667,6 +1884,44 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
         test(im1->current <= 1 && im1->total == 3 && im1->failures == 0 && im1->retry == 0);
         test(im1->remotes.size() == 1); // The first operation got sent over a connection
     }
+
+    //
+    // Invocations on equal proxies share the same metrics object.
+    //
+    props["IceMX.Metrics.View.Map.Invocation.GroupBy"] = "id";
+    updateProps(clientProps, serverProps, update.get(), props, "Invocation");
+    {
+        Test::MetricsPrxPtr metrics2 =
+            ICE_UNCHECKED_CAST(Test::MetricsPrx, communicator->stringToProxy(communicator->proxyToString(metrics)));
+        metrics->op();
+        metrics2->op();
+        metrics->op();
+        metrics->ice_encodingVersion(Ice::Encoding_1_0)->op();
+
+        map = toMap(clientMetrics->getMetricsView("View", timestamp)["Invocation"]);
+        test(map.size() == 2);
+        for(std::map<string, IceMX::MetricsPtr>::const_iterator p = map.begin(); p != map.end(); ++p)
+        {
+            test(p->second->total == (p->first.find("-e 1.0") == string::npos ? 3 : 1));
+        }
+
+        //
+        // Invocations on fixed proxies are not cached but are still counted
+        // with the invocations on the equal routable proxies.
+        //
+        if(!collocated)
+        {
+            Ice::ObjectPrxPtr fixed = metrics->ice_getConnection()->createProxy(metrics->ice_getIdentity());
+            Test::MetricsPrxPtr metrics3 = ICE_UNCHECKED_CAST(Test::MetricsPrx, fixed);
+            metrics3->op();
+            metrics3->op();
+
+            map = toMap(clientMetrics->getMetricsView("View", timestamp)["Invocation"]);
+            test(map.size() == 3); // Including the ice_getConnection invocation.
+            test(map["metrics -t -e 1.1 [op]"] && map["metrics -t -e 1.1 [op]"]->total == 5);
+        }
+    }
+    props["IceMX.Metrics.View.Map.Invocation.GroupBy"] = "operation";
     cout << "ok" << endl;
 
     cout << "testing metrics view enable/disable..." << flush;
@@ -27,6 +27,10 @@ Collocated::run(int argc, char** argv)
     initData.properties->setProperty("Ice.Admin.DelayCreation", "1");
     initData.properties->setProperty("Ice.Warn.Connections", "0");
     initData.properties->setProperty("Ice.Warn.Dispatch", "0");
+    initData.properties->setProperty("Ice.Plugin.IceMetricsExporter", "1");
+    ostringstream exporterPort;
+    exporterPort << getTestPort(initData.properties, 2);
+    initData.properties->setProperty("IceMX.Exporter.Port", exporterPort.str());
     CommunicatorObserverIPtr observer = ICE_MAKE_SHARED(CommunicatorObserverI);
     initData.observer = observer;
     Ice::CommunicatorHolder communicator = initialize(argc, argv, initData);
@@ -23,6 +23,10 @@ ServerAMD::run(int argc, char** argv)
     properties->setProperty("Ice.Admin.InstanceName", "server");
     properties->setProperty("Ice.Warn.Connections", "0");
     properties->setProperty("Ice.Warn.Dispatch", "0");
+    properties->setProperty("Ice.Plugin.IceMetricsExporter", "1");
+    ostringstream exporterPort;
+    exporterPort << getTestPort(properties, 2);
+    properties->setProperty("IceMX.Exporter.Port", exporterPort.str());
     properties->setProperty("Ice.MessageSizeMax", "50000");
     Ice::CommunicatorHolder communicator = initialize(argc, argv, properties);
 
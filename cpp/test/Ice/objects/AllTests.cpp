@@ -482,6 +482,105 @@ allTests(Test::TestHelper* helper)
     initial->setRecursive(ICE_MAKE_SHARED(Recursive));
     cout << "ok" << endl;
 
+    cout << "testing arena allocation... " << flush;
+    {
+        //
+        // With the cpp:arena metadata, the server and the client allocate the
+        // unmarshaled instances in an arena with the C++11 mapping.
+        //
+        RecursivePtr chain = ICE_MAKE_SHARED(Recursive);
+        RecursivePtr p = chain;
+        for(int i = 0; i < 50; ++i)
+        {
+            p->v = ICE_MAKE_SHARED(Recursive);
+            p = p->v;
+        }
+        RecursivePtr r = initial->opRecursive(chain);
+        int length = 0;
+        for(p = r; p; p = p->v)
+        {
+            ++length;
+        }
+        test(length == 51);
+
+#ifdef ICE_CPP11_MAPPING
+        auto marshal = [&communicator](const ValueSeq& values)
+        {
+            Ice::OutputStream out(communicator);
+            out.startEncapsulation();
+            out.write(values);
+            out.writePendingValues();
+            out.endEncapsulation();
+            vector<Ice::Byte> data;
+            out.finished(data);
+            return data;
+        };
+
+        auto unmarshal = [&communicator](const vector<Ice::Byte>& data)
+        {
+            Ice::InputStream in(communicator, data);
+            in.startEncapsulation();
+            in.setArenaAllocation(true);
+            ValueSeq values;
+            in.read(values);
+            in.readPendingValues();
+            in.endEncapsulation();
+            return values;
+        };
+
+        //
+        // Shared instances are unmarshaled once.
+        //
+        auto a = make_shared<Recursive>();
+        auto b = make_shared<Recursive>();
+        a->v = b;
+        b->v = make_shared<Recursive>();
+        ValueSeq values = unmarshal(marshal(ValueSeq{ a, b, nullptr }));
+        test(values.size() == 3 && !values[2]);
+        auto a2 = dynamic_pointer_cast<Recursive>(values[0]);
+        test(a2 && a2->v == values[1] && a2->v->v && !a2->v->v->v);
+
+        //
+        // Cycles must be broken to release the instances and the arena.
+        //
+        b->v = a;
+        values = unmarshal(marshal(ValueSeq{ a }));
+        b->v = nullptr;
+        a2 = dynamic_pointer_cast<Recursive>(values[0]);
+        test(a2->v->v == a2);
+        weak_ptr<Recursive> weak = a2;
+        a2->v->v = nullptr;
+        a2 = nullptr;
+        values.clear();
+        test(weak.expired());
+
+        //
+        // The instances retained by the application remain valid after the other
+        // instances allocated in the same arena are released.
+        //
+        values = unmarshal(marshal(ValueSeq{ chain }));
+        weak = dynamic_pointer_cast<Recursive>(values[0]);
+        p = weak.lock();
+        for(int i = 0; i < 25; ++i)
+        {
+            p = p->v;
+        }
+        values.clear();
+        test(weak.expired());
+        for(int i = 0; i < 10; ++i)
+        {
+            values = unmarshal(marshal(ValueSeq{ chain }));
+        }
+        length = 0;
+        for(; p; p = p->v)
+        {
+            ++length;
+        }
+        test(length == 26);
+#endif
+    }
+    cout << "ok" << endl;
+
     cout << "testing compact ID..." << flush;
     try
     {
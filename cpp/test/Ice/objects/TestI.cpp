@@ -201,6 +201,12 @@ InitialI::acceptsClassCycles(const Ice::Current& c)
     return c.adapter->getCommunicator()->getProperties()->getPropertyAsInt("Ice.AcceptClassCycles") > 0;
 }
 
+RecursivePtr
+InitialI::opRecursive(ICE_IN(RecursivePtr) r, const Ice::Current&)
+{
+    return r;
+}
+
 #ifdef ICE_CPP11_MAPPING
 InitialI::GetMBMarshaledResult
 InitialI::getMB(const Ice::Current& current)
@@ -96,6 +96,8 @@ public:
     virtual void setCycle(ICE_IN(Test::RecursivePtr), const Ice::Current&);
     virtual bool acceptsClassCycles(const Ice::Current&);
 
+    virtual Test::RecursivePtr opRecursive(ICE_IN(Test::RecursivePtr), const Ice::Current&);
+
 #ifdef ICE_CPP11_MAPPING
     virtual GetMBMarshaledResult getMB(const Ice::Current&);
     virtual void getAMDMBAsync(std::function<void(const GetAMDMBMarshaledResult&)>,
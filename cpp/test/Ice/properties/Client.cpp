@@ -30,6 +30,41 @@ public:
     }
 };
 
+class ReaderThread : public IceUtil::Thread
+{
+public:
+
+    ReaderThread(const Ice::PropertiesPtr& properties) :
+        _properties(properties),
+        _accessor(properties, "Test.Counter")
+    {
+    }
+
+    virtual void
+    run()
+    {
+        //
+        // The updates are published in order, a reader never sees an older
+        // value after a newer one.
+        //
+        int last = 0;
+        while(last < 1000)
+        {
+            int value = _accessor.getAsInt();
+            test(value >= last);
+            int value2 = _properties->getPropertyAsInt("Test.Counter");
+            test(value2 >= value);
+            last = value2;
+        }
+    }
+
+private:
+
+    const Ice::PropertiesPtr _properties;
+    const Ice::PropertyAccessor _accessor;
+};
+typedef IceUtil::Handle<ReaderThread> ReaderThreadPtr;
+
 }
 
 class Client : public Test::TestHelper
@@ -121,6 +156,64 @@ Client::run(int argc, char** argv)
         }
         cout << "ok" << endl;
     }
+
+    {
+        cout << "testing property accessors... " << flush;
+        Ice::PropertiesPtr properties = Ice::createProperties();
+        properties->setProperty("Test.Int", "10");
+        properties->setProperty("Test.List", "a b c");
+
+        Ice::PropertyAccessor intAccessor(properties, "Test.Int");
+        Ice::PropertyAccessor listAccessor(properties, "Test.List");
+        Ice::PropertyAccessor unsetAccessor(properties, "Test.Unset");
+        test(intAccessor.getKey() == "Test.Int");
+        test(intAccessor.get() == "10");
+        test(intAccessor.getAsInt() == 10);
+        test(listAccessor.getAsList().size() == 3);
+        test(unsetAccessor.get().empty());
+        test(unsetAccessor.getWithDefault("default") == "default");
+        test(unsetAccessor.getAsIntWithDefault(5) == 5);
+
+        properties->setProperty("Test.Int", "20");
+        properties->setProperty("Test.Unset", "set");
+        test(intAccessor.getAsInt() == 20);
+        test(unsetAccessor.get() == "set");
+
+        properties->setProperty("Test.Int", "");
+        test(intAccessor.get().empty());
+        test(intAccessor.getAsIntWithDefault(7) == 7);
+        test(properties->getProperty("Test.Int").empty());
+        test(Ice::PropertyAccessor().get().empty());
+        cout << "ok" << endl;
+    }
+
+    {
+        cout << "testing concurrent property reads... " << flush;
+        Ice::PropertiesPtr properties = Ice::createProperties();
+        vector<IceUtil::ThreadControl> threads;
+        for(int i = 0; i < 4; ++i)
+        {
+            threads.push_back((new ReaderThread(properties))->start());
+        }
+        for(int i = 1; i <= 1000; ++i)
+        {
+            ostringstream os;
+            os << i;
+            properties->setProperty("Test.Counter", os.str());
+
+            //
+            // Reading the property builds a new snapshot, the snapshots replaced
+            // while the readers use them are released or the readers lock the
+            // property set.
+            //
+            test(properties->getPropertyAsInt("Test.Counter") == i);
+        }
+        for(vector<IceUtil::ThreadControl>::iterator p = threads.begin(); p != threads.end(); ++p)
+        {
+            p->join();
+        }
+        cout << "ok" << endl;
+    }
 }
 
 DEFINE_TEST(Client)
@@ -0,0 +1,200 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <TestHelper.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+Ice::ByteSeq
+createSeq(size_t size, int seed)
+{
+    Ice::ByteSeq seq(size);
+    for(size_t i = 0; i < seq.size(); ++i)
+    {
+        seq[i] = static_cast<Ice::Byte>((i + static_cast<size_t>(seed)) % 251);
+    }
+    return seq;
+}
+
+}
+
+TestIntfPrxPtr
+allTests(Test::TestHelper* helper)
+{
+    Ice::CommunicatorPtr communicator = helper->communicator();
+
+    ostringstream os;
+    os << "@ice-test-shm-" << helper->getTestPort(0);
+    const string path = os.str();
+    const string endpoint = "shm --path " + path;
+
+    cout << "testing endpoint parsing... " << flush;
+    {
+        try
+        {
+            communicator->stringToProxy("test:shm");
+            test(false);
+        }
+        catch(const Ice::EndpointParseException&)
+        {
+        }
+
+        try
+        {
+            communicator->stringToProxy("test:shm --path");
+            test(false);
+        }
+        catch(const Ice::EndpointParseException&)
+        {
+        }
+
+        Ice::ObjectPrxPtr prx = communicator->stringToProxy("test:shm --path /tmp/ice.sock -t 1000 -z");
+        string str = communicator->proxyToString(prx);
+        test(str == "test -t -e 1.1:shm --path /tmp/ice.sock -t 1000 -z");
+        test(Ice::targetEqualTo(communicator->stringToProxy(str), prx));
+
+        prx = communicator->stringToProxy("test:shm --path \"/tmp/ice test.sock\"");
+        test(Ice::targetEqualTo(communicator->stringToProxy(communicator->proxyToString(prx)), prx));
+    }
+    cout << "ok" << endl;
+
+    TestIntfPrxPtr intf = ICE_CHECKED_CAST(TestIntfPrx, communicator->stringToProxy("test:" + endpoint));
+    test(intf);
+
+    cout << "testing connection information... " << flush;
+    {
+        Ice::EndpointInfoPtr info = intf->ice_getConnection()->getEndpoint()->getInfo();
+        Ice::SHMEndpointInfoPtr shmInfo = ICE_DYNAMIC_CAST(Ice::SHMEndpointInfo, info);
+        test(shmInfo);
+        test(shmInfo->path == path);
+        test(shmInfo->type() == Ice::SHMEndpointType);
+        test(!shmInfo->datagram() && !shmInfo->secure());
+
+        Ice::SHMConnectionInfoPtr connectionInfo =
+            ICE_DYNAMIC_CAST(Ice::SHMConnectionInfo, intf->ice_getConnection()->getInfo());
+        test(connectionInfo);
+        test(connectionInfo->rcvSize == 65536);
+        test(connectionInfo->sndSize == 65536);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing invocations... " << flush;
+    {
+        intf->ice_ping();
+        test(intf->echo(Ice::ByteSeq()).empty());
+
+        //
+        // Messages smaller than, equal to and larger than the rings.
+        //
+        const size_t sizes[] = { 1, 1000, 65536 - 100, 65536, 65536 + 1, 300 * 1024, 1000 * 1024 };
+        for(size_t i = 0; i < sizeof(sizes) / sizeof(size_t); ++i)
+        {
+            Ice::ByteSeq seq = createSeq(sizes[i], static_cast<int>(i));
+            test(intf->echo(seq) == seq);
+        }
+
+        //
+        // Many small messages to wrap around the rings many times.
+        //
+        Ice::ByteSeq seq = createSeq(1017, 3);
+        for(int i = 0; i < 500; ++i)
+        {
+            test(intf->echo(seq) == seq);
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing concurrent invocations... " << flush;
+    {
+        const int count = 50;
+        vector<Ice::ByteSeq> seqs;
+        for(int i = 0; i < count; ++i)
+        {
+            seqs.push_back(createSeq(static_cast<size_t>(i * 7919 % (200 * 1024)), i));
+        }
+
+#ifdef ICE_CPP11_MAPPING
+        vector<future<Ice::ByteSeq> > results;
+        for(int i = 0; i < count; ++i)
+        {
+            results.push_back(intf->echoAsync(seqs[static_cast<size_t>(i)]));
+        }
+        for(int i = 0; i < count; ++i)
+        {
+            test(results[static_cast<size_t>(i)].get() == seqs[static_cast<size_t>(i)]);
+        }
+#else
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < count; ++i)
+        {
+            results.push_back(intf->begin_echo(seqs[static_cast<size_t>(i)]));
+        }
+        for(int i = 0; i < count; ++i)
+        {
+            test(intf->end_echo(results[static_cast<size_t>(i)]) == seqs[static_cast<size_t>(i)]);
+        }
+#endif
+    }
+    cout << "ok" << endl;
+
+    cout << "testing connection closure... " << flush;
+    {
+        //
+        // Closure initiated by the client.
+        //
+        Ice::ConnectionPtr connection = intf->ice_getConnection();
+        connection->close(ICE_SCOPED_ENUM(Ice::ConnectionClose, GracefullyWithWait));
+        try
+        {
+            intf->ice_ping();
+        }
+        catch(const Ice::ConnectionManuallyClosedException&)
+        {
+        }
+        intf->ice_ping();
+        test(intf->ice_getConnection() != connection);
+
+        //
+        // Closure initiated by the server.
+        //
+        connection = intf->ice_getConnection();
+        intf->ice_oneway()->closeConnection();
+        while(true)
+        {
+            try
+            {
+                connection->getInfo();
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+            }
+            catch(const Ice::LocalException&)
+            {
+                break;
+            }
+        }
+        intf->ice_ping();
+        test(intf->ice_getConnection() != connection);
+
+        //
+        // Connecting to an endpoint without a listener.
+        //
+        try
+        {
+            communicator->stringToProxy("test:shm --path @ice-test-shm-unknown")->ice_ping();
+            test(false);
+        }
+        catch(const Ice::ConnectFailedException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    return intf;
+}
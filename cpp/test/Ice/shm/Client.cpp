@@ -0,0 +1,36 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::PropertiesPtr properties = createTestProperties(argc, argv);
+
+    //
+    // Use small rings to exercise the wrap around and the flow control
+    // of the rings with large messages.
+    //
+    properties->setProperty("Ice.SHM.RcvSize", "65536");
+    properties->setProperty("Ice.SHM.SndSize", "65536");
+    Ice::CommunicatorHolder communicator = initialize(argc, argv, properties);
+    TestIntfPrxPtr allTests(Test::TestHelper*);
+    TestIntfPrxPtr intf = allTests(this);
+    intf->shutdown();
+}
+
+DEFINE_TEST(Client)
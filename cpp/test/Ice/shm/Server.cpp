@@ -0,0 +1,40 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <TestI.h>
+
+using namespace std;
+
+class Server : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Server::run(int argc, char** argv)
+{
+    Ice::PropertiesPtr properties = createTestProperties(argc, argv);
+    properties->setProperty("Ice.SHM.RcvSize", "65536");
+    properties->setProperty("Ice.SHM.SndSize", "65536");
+    Ice::CommunicatorHolder communicator = initialize(argc, argv, properties);
+
+    ostringstream endpoint;
+    endpoint << "shm --path @ice-test-shm-" << getTestPort(0);
+    communicator->getProperties()->setProperty("TestAdapter.Endpoints", endpoint.str());
+    communicator->getProperties()->setProperty("TestAdapter.ThreadPool.Size", "4");
+    communicator->getProperties()->setProperty("TestAdapter.ThreadPool.SizeWarn", "0");
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    adapter->add(ICE_MAKE_SHARED(TestIntfI), Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    serverReady();
+
+    communicator->waitForShutdown();
+}
+
+DEFINE_TEST(Server)
@@ -0,0 +1,19 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    virtual Ice::ByteSeq echo(ICE_IN(Ice::ByteSeq), const Ice::Current&);
+    virtual void closeConnection(const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+};
+
+#endif
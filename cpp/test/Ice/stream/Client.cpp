@@ -944,6 +944,50 @@ allTests(Test::TestHelper* helper)
 #endif
     }
 
+    {
+        //
+        // A large graph with shared instances, with both encodings.
+        //
+        const Ice::EncodingVersion encodings[] = { Ice::Encoding_1_0, Ice::Encoding_1_1 };
+        for(size_t e = 0; e < sizeof(encodings) / sizeof(encodings[0]); ++e)
+        {
+            MyClassS arr;
+            for(int i = 0; i < 10000; ++i)
+            {
+                if(i % 3 == 2)
+                {
+                    arr.push_back(arr[static_cast<size_t>(i / 2)]);
+                }
+                else
+                {
+                    MyClassPtr c = ICE_MAKE_SHARED(MyClass);
+                    c->s.e = ICE_ENUM(MyEnum, enum2);
+                    c->seq4.push_back(i);
+                    arr.push_back(c);
+                }
+            }
+            Ice::OutputStream out(communicator, encodings[e]);
+            out.startEncapsulation();
+            out.write(arr);
+            out.writePendingValues();
+            out.endEncapsulation();
+            out.finished(data);
+
+            Ice::InputStream in(communicator, encodings[e], data);
+            in.startEncapsulation();
+            MyClassS arr2;
+            in.read(arr2);
+            in.readPendingValues();
+            in.endEncapsulation();
+            test(arr2.size() == arr.size());
+            for(size_t i = 0; i < arr2.size(); ++i)
+            {
+                test(arr2[i]->seq4 == arr[i]->seq4);
+                test(i == 0 || (arr2[i] == arr2[i / 2]) == (i % 3 == 2));
+            }
+        }
+    }
+
 #ifndef ICE_CPP11_MAPPING
     //
     // No support for interfaces-as-values in C++11.
@@ -0,0 +1,355 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <TestHelper.h>
+#include <Test.h>
+
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+Ice::ByteSeq
+createSeq(size_t size, int seed)
+{
+    Ice::ByteSeq seq(size);
+    for(size_t i = 0; i < seq.size(); ++i)
+    {
+        seq[i] = static_cast<Ice::Byte>((i + static_cast<size_t>(seed)) % 251);
+    }
+    return seq;
+}
+
+int
+createPipe(const Ice::ByteSeq& data)
+{
+    int fds[2];
+    test(::pipe(fds) == 0);
+    test(::write(fds[1], &data[0], data.size()) == static_cast<ssize_t>(data.size()));
+    ::close(fds[1]);
+    return fds[0];
+}
+
+}
+
+TestIntfPrxPtr
+allTests(Test::TestHelper* helper)
+{
+    Ice::CommunicatorPtr communicator = helper->communicator();
+
+    ostringstream os;
+    os << "@ice-test-unix-" << helper->getTestPort(0);
+    const string path = os.str();
+    const string endpoint = "unix --path " + path;
+
+    cout << "testing endpoint parsing... " << flush;
+    {
+        try
+        {
+            communicator->stringToProxy("test:unix");
+            test(false);
+        }
+        catch(const Ice::EndpointParseException&)
+        {
+        }
+
+        try
+        {
+            communicator->stringToProxy("test:unix --path");
+            test(false);
+        }
+        catch(const Ice::EndpointParseException&)
+        {
+        }
+
+        Ice::ObjectPrxPtr prx = communicator->stringToProxy("test:unix --path /tmp/ice.sock -t 1000 -z");
+        string str = communicator->proxyToString(prx);
+        test(str == "test -t -e 1.1:unix --path /tmp/ice.sock -t 1000 -z");
+        test(Ice::targetEqualTo(communicator->stringToProxy(str), prx));
+
+        prx = communicator->stringToProxy("test:unix --path \"/tmp/ice test.sock\"");
+        test(Ice::targetEqualTo(communicator->stringToProxy(communicator->proxyToString(prx)), prx));
+    }
+    cout << "ok" << endl;
+
+    TestIntfPrxPtr intf = ICE_CHECKED_CAST(TestIntfPrx, communicator->stringToProxy("test:" + endpoint));
+    test(intf);
+
+    cout << "testing connection information... " << flush;
+    {
+        Ice::EndpointInfoPtr info = intf->ice_getConnection()->getEndpoint()->getInfo();
+        Ice::UNIXEndpointInfoPtr unixInfo = ICE_DYNAMIC_CAST(Ice::UNIXEndpointInfo, info);
+        test(unixInfo);
+        test(unixInfo->path == path);
+        test(unixInfo->type() == Ice::UNIXEndpointType);
+        test(!unixInfo->datagram() && !unixInfo->secure());
+
+        Ice::UNIXConnectionInfoPtr connectionInfo =
+            ICE_DYNAMIC_CAST(Ice::UNIXConnectionInfo, intf->ice_getConnection()->getInfo());
+        test(connectionInfo);
+        test(connectionInfo->path == path);
+        test(!connectionInfo->incoming);
+        test(connectionInfo->rcvSize > 0);
+        test(connectionInfo->sndSize > 0);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing invocations... " << flush;
+    {
+        intf->ice_ping();
+        test(intf->echo(Ice::ByteSeq()).empty());
+
+        const size_t sizes[] = { 1, 1000, 65536, 300 * 1024, 1000 * 1024 };
+        for(size_t i = 0; i < sizeof(sizes) / sizeof(size_t); ++i)
+        {
+            Ice::ByteSeq seq = createSeq(sizes[i], static_cast<int>(i));
+            test(intf->echo(seq) == seq);
+        }
+
+        Ice::ByteSeq seq = createSeq(1017, 3);
+        for(int i = 0; i < 500; ++i)
+        {
+            test(intf->echo(seq) == seq);
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing concurrent invocations... " << flush;
+    {
+        const int count = 50;
+        vector<Ice::ByteSeq> seqs;
+        for(int i = 0; i < count; ++i)
+        {
+            seqs.push_back(createSeq(static_cast<size_t>(i * 7919 % (200 * 1024)), i));
+        }
+
+#ifdef ICE_CPP11_MAPPING
+        vector<future<Ice::ByteSeq> > results;
+        for(int i = 0; i < count; ++i)
+        {
+            results.push_back(intf->echoAsync(seqs[static_cast<size_t>(i)]));
+        }
+        for(int i = 0; i < count; ++i)
+        {
+            test(results[static_cast<size_t>(i)].get() == seqs[static_cast<size_t>(i)]);
+        }
+#else
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < count; ++i)
+        {
+            results.push_back(intf->begin_echo(seqs[static_cast<size_t>(i)]));
+        }
+        for(int i = 0; i < count; ++i)
+        {
+            test(intf->end_echo(results[static_cast<size_t>(i)]) == seqs[static_cast<size_t>(i)]);
+        }
+#endif
+    }
+    cout << "ok" << endl;
+
+    cout << "testing file descriptor passing... " << flush;
+    {
+        Ice::ConnectionPtr connection = intf->ice_getConnection();
+
+        //
+        // Client to server, with one descriptor and with more descriptors
+        // than sent with a single sendmsg() call.
+        //
+        const int counts[] = { 1, 3, 100 };
+        for(size_t i = 0; i < sizeof(counts) / sizeof(int); ++i)
+        {
+            Ice::ByteSeq expected;
+            vector<int> fds;
+            for(int j = 0; j < counts[i]; ++j)
+            {
+                Ice::ByteSeq seq = createSeq(static_cast<size_t>(1 + j * 31), j);
+                fds.push_back(createPipe(seq));
+                expected.insert(expected.end(), seq.begin(), seq.end());
+            }
+            Ice::sendFileDescriptors(connection, fds);
+            for(vector<int>::const_iterator p = fds.begin(); p != fds.end(); ++p)
+            {
+                ::close(*p);
+            }
+            test(intf->readFileDescriptors(counts[i]) == expected);
+        }
+
+        //
+        // Server to client.
+        //
+        Ice::ByteSeq seq = createSeq(1000, 7);
+        intf->sendFileDescriptor(seq);
+        vector<int> fds = Ice::takeFileDescriptors(connection, 10);
+        test(fds.size() == 1);
+        Ice::ByteSeq data(seq.size() + 1);
+        test(::read(fds[0], &data[0], data.size()) == static_cast<ssize_t>(seq.size()));
+        data.resize(seq.size());
+        test(data == seq);
+        ::close(fds[0]);
+        test(Ice::takeFileDescriptors(connection, 10).empty());
+
+        try
+        {
+            Ice::sendFileDescriptors(connection, vector<int>(1, -1));
+            test(false);
+        }
+        catch(const Ice::SocketException&)
+        {
+        }
+
+        try
+        {
+            TestIntfPrxPtr tcp = ICE_UNCHECKED_CAST(TestIntfPrx,
+                                                  communicator->stringToProxy("test:" + helper->getTestEndpoint(0)));
+            Ice::sendFileDescriptors(tcp->ice_getConnection(), vector<int>(1, 0));
+            test(false);
+        }
+        catch(const Ice::FeatureNotSupportedException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing connection closure... " << flush;
+    {
+        //
+        // Closure initiated by the client.
+        //
+        Ice::ConnectionPtr connection = intf->ice_getConnection();
+        connection->close(ICE_SCOPED_ENUM(Ice::ConnectionClose, GracefullyWithWait));
+        try
+        {
+            intf->ice_ping();
+        }
+        catch(const Ice::ConnectionManuallyClosedException&)
+        {
+        }
+        intf->ice_ping();
+        test(intf->ice_getConnection() != connection);
+
+        //
+        // Closure initiated by the server.
+        //
+        connection = intf->ice_getConnection();
+        intf->ice_oneway()->closeConnection();
+        while(true)
+        {
+            try
+            {
+                connection->getInfo();
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+            }
+            catch(const Ice::LocalException&)
+            {
+                break;
+            }
+        }
+        intf->ice_ping();
+        test(intf->ice_getConnection() != connection);
+
+        //
+        // Connecting to an endpoint without a listener.
+        //
+        try
+        {
+            communicator->stringToProxy("test:unix --path @ice-test-unix-unknown")->ice_ping();
+            test(false);
+        }
+        catch(const Ice::ConnectFailedException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing stale socket files... " << flush;
+    {
+        ostringstream os;
+        os << "ice-test-unix-" << helper->getTestPort(0) << ".sock";
+        const string file = os.str();
+        ::unlink(file.c_str());
+
+        //
+        // Leave a socket file behind as a process which exits without closing
+        // its object adapter.
+        //
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        test(fd != -1);
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strcpy(addr.sun_path, file.c_str());
+        test(::bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == 0);
+        ::close(fd);
+        test(::access(file.c_str(), F_OK) == 0);
+
+        //
+        // The stale socket file is replaced.
+        //
+        Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("StaleAdapter",
+                                                                                     "unix --path " + file);
+        adapter->activate();
+        Ice::ObjectPrxPtr prx = communicator->stringToProxy("stale:unix --path " + file);
+        prx = prx->ice_collocationOptimized(false);
+        try
+        {
+            prx->ice_ping();
+            test(false);
+        }
+        catch(const Ice::ObjectNotExistException&)
+        {
+        }
+
+        //
+        // The socket file of a listening adapter isn't replaced.
+        //
+        try
+        {
+            communicator->createObjectAdapterWithEndpoints("StaleAdapter2", "unix --path " + file);
+            test(false);
+        }
+        catch(const Ice::SocketException&)
+        {
+        }
+        prx->ice_getConnection()->close(ICE_SCOPED_ENUM(Ice::ConnectionClose, GracefullyWithWait));
+        try
+        {
+            prx->ice_ping();
+            test(false);
+        }
+        catch(const Ice::ObjectNotExistException&)
+        {
+        }
+
+        adapter->destroy();
+        test(::access(file.c_str(), F_OK) == -1);
+
+        //
+        // A file which isn't a socket is never removed.
+        //
+        fd = ::open(file.c_str(), O_CREAT | O_WRONLY, 0600);
+        test(fd != -1);
+        ::close(fd);
+        try
+        {
+            communicator->createObjectAdapterWithEndpoints("StaleAdapter3", "unix --path " + file);
+            test(false);
+        }
+        catch(const Ice::SocketException&)
+        {
+        }
+        test(::access(file.c_str(), F_OK) == 0);
+        ::unlink(file.c_str());
+    }
+    cout << "ok" << endl;
+
+    return intf;
+}
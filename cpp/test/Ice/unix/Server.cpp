@@ -0,0 +1,41 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <TestI.h>
+
+using namespace std;
+
+class Server : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Server::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+
+    //
+    // The TCP endpoint is used to check that file descriptors can't be
+    // passed over other transports.
+    //
+    ostringstream endpoints;
+    endpoints << "unix --path @ice-test-unix-" << getTestPort(0) << ":" << getTestEndpoint(0);
+    communicator->getProperties()->setProperty("TestAdapter.Endpoints", endpoints.str());
+    communicator->getProperties()->setProperty("TestAdapter.ThreadPool.Size", "4");
+    communicator->getProperties()->setProperty("TestAdapter.ThreadPool.SizeWarn", "0");
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    adapter->add(ICE_MAKE_SHARED(TestIntfI), Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    serverReady();
+
+    communicator->waitForShutdown();
+}
+
+DEFINE_TEST(Server)
@@ -0,0 +1,69 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+#include <TestHelper.h>
+
+#include <unistd.h>
+
+using namespace std;
+
+Ice::ByteSeq
+TestIntfI::echo(ICE_IN(Ice::ByteSeq) seq, const Ice::Current&)
+{
+    return seq;
+}
+
+Ice::ByteSeq
+TestIntfI::readFileDescriptors(int count, const Ice::Current& current)
+{
+    //
+    // The descriptors are received with the request, before it's dispatched.
+    //
+    vector<int> fds = Ice::takeFileDescriptors(current.con, static_cast<size_t>(count));
+    test(fds.size() == static_cast<size_t>(count));
+
+    Ice::ByteSeq data;
+    for(vector<int>::const_iterator p = fds.begin(); p != fds.end(); ++p)
+    {
+        Ice::Byte buf[4096];
+        ssize_t ret;
+        while((ret = ::read(*p, buf, sizeof(buf))) > 0)
+        {
+            data.insert(data.end(), buf, buf + ret);
+        }
+        test(ret == 0);
+        ::close(*p);
+    }
+    test(Ice::takeFileDescriptors(current.con, 1).empty());
+    return data;
+}
+
+void
+TestIntfI::sendFileDescriptor(ICE_IN(Ice::ByteSeq) data, const Ice::Current& current)
+{
+    int fds[2];
+    test(::pipe(fds) == 0);
+    test(::write(fds[1], &data[0], data.size()) == static_cast<ssize_t>(data.size()));
+    ::close(fds[1]);
+
+    //
+    // The descriptor is sent with the reply.
+    //
+    Ice::sendFileDescriptors(current.con, vector<int>(1, fds[0]));
+    ::close(fds[0]);
+}
+
+void
+TestIntfI::closeConnection(const Ice::Current& current)
+{
+    current.con->close(ICE_SCOPED_ENUM(Ice::ConnectionClose, Forcefully));
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
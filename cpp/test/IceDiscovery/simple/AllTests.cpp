@@ -193,6 +193,103 @@ allTests(Test::TestHelper* helper, int num)
     }
     cout << "ok" << endl;
 
+    cout << "testing batched lookups... " << flush;
+    {
+        //
+        // Resolve the proxies concurrently with a new communicator, the lookups are
+        // sent with batched requests.
+        //
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        Ice::CommunicatorPtr com = Ice::initialize(initData);
+#ifdef ICE_CPP11_MAPPING
+        vector<future<void>> results;
+        for(int i = 0; i < num; ++i)
+        {
+            results.push_back(com->stringToProxy(indirectProxies[i]->ice_toString())->ice_pingAsync());
+            results.push_back(com->stringToProxy(proxies[i]->ice_toString())->ice_pingAsync());
+        }
+        for(vector<future<void>>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            p->get();
+        }
+#else
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < num; ++i)
+        {
+            results.push_back(com->stringToProxy(indirectProxies[i]->ice_toString())->begin_ice_ping());
+            results.push_back(com->stringToProxy(proxies[i]->ice_toString())->begin_ice_ping());
+        }
+        for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            (*p)->getProxy()->end_ice_ping(*p);
+        }
+#endif
+        com->destroy();
+
+        //
+        // If the servers don't answer batched lookups, the lookups are retried with
+        // the per-id requests. This retry doesn't count against the retry count.
+        //
+        initData.properties->setProperty("IceDiscovery.RetryCount", "0");
+        initData.properties->setProperty("IceDiscovery.Timeout", "500");
+        com = Ice::initialize(initData);
+        com->stringToProxy("controller0@control0")->ice_ping();
+        com->stringToProxy("controller0")->ice_ping();
+        com->destroy();
+
+        //
+        // Batched lookups disabled.
+        //
+        initData.properties->setProperty("IceDiscovery.BatchSize", "0");
+        com = Ice::initialize(initData);
+        com->stringToProxy("controller0@control0")->ice_ping();
+        com->stringToProxy("controller0")->ice_ping();
+        com->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing lookup cache... " << flush;
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("IceDiscovery.CacheTimeout", "-1");
+        Ice::CommunicatorPtr com = Ice::initialize(initData);
+
+        proxies[0]->activateObjectAdapter("oa", "oa1", "");
+        proxies[0]->addObject("oa", "object");
+        com->stringToProxy("object @ oa1")->ice_locatorCacheTimeout(0)->ice_ping();
+        proxies[0]->deactivateObjectAdapter("oa");
+
+        //
+        // The adapter endpoints are returned by the cache even if the adapter is no
+        // longer registered.
+        //
+        try
+        {
+            com->stringToProxy("object @ oa1")->ice_locatorCacheTimeout(0)->ice_ping();
+            test(false);
+        }
+        catch(const Ice::NoEndpointException&)
+        {
+            test(false);
+        }
+        catch(const Ice::LocalException&)
+        {
+        }
+        com->destroy();
+
+        try
+        {
+            communicator->stringToProxy("object @ oa1")->ice_locatorCacheTimeout(0)->ice_ping();
+            test(false);
+        }
+        catch(const Ice::NoEndpointException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
     cout << "testing invalid lookup endpoints... " << flush;
     {
         string multicast;
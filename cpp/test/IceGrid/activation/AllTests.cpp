@@ -742,6 +742,140 @@ allTests(Test::TestHelper* helper)
     }
     cout << "ok" << endl;
 
+    //
+    // node-3 activates a single server at a time, node-4 doesn't limit the
+    // number of concurrent activations.
+    //
+    const char* concurrentNodes[] = { "node-3", "node-4" };
+    const int nConcurrentServers = 10;
+    {
+        IceGrid::ApplicationInfo info = admin->getApplicationInfo("Test");
+        IceGrid::ApplicationDescriptor testApp;
+        testApp.name = "ConcurrentApp";
+        testApp.serverTemplates = info.descriptor.serverTemplates;
+        testApp.variables = info.descriptor.variables;
+        for(int n = 0; n < 2; ++n)
+        {
+            for(int i = 0; i < nConcurrentServers; ++i)
+            {
+                ostringstream id;
+                id << concurrentNodes[n] << "-server-" << i;
+                IceGrid::ServerInstanceDescriptor server;
+                server._cpp_template = "Server";
+                server.parameterValues["id"] = id.str();
+                testApp.nodes[concurrentNodes[n]].serverInstances.push_back(server);
+            }
+        }
+        try
+        {
+            admin->addApplication(testApp);
+        }
+        catch(const IceGrid::DeploymentException& ex)
+        {
+            cerr << ex.reason << endl;
+            test(false);
+        }
+    }
+
+    cout << "testing concurrent activation... " << flush;
+    for(int n = 0; n < 2; ++n)
+    {
+        admin->startServer(concurrentNodes[n]);
+        nRetry = 0;
+        while(!admin->pingNode(concurrentNodes[n]) && nRetry < 15)
+        {
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+            ++nRetry;
+        }
+
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < nConcurrentServers; ++i)
+        {
+            ostringstream id;
+            id << concurrentNodes[n] << "-server-" << i;
+            results.push_back(admin->begin_startServer(id.str()));
+        }
+        for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            try
+            {
+                admin->end_startServer(*p);
+            }
+            catch(const IceGrid::ServerStartException& ex)
+            {
+                cerr << ex.reason << endl;
+                test(false);
+            }
+        }
+        for(int i = 0; i < nConcurrentServers; ++i)
+        {
+            ostringstream id;
+            id << concurrentNodes[n] << "-server-" << i;
+            test(admin->getServerState(id.str()) == IceGrid::Active);
+            TestIntfPrx::checkedCast(communicator->stringToProxy(id.str()))->ice_ping();
+            admin->stopServer(id.str());
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing node shutdown during activation... " << flush;
+    for(int n = 0; n < 2; ++n)
+    {
+        //
+        // Shutdown the node while the servers are being activated. The
+        // activations either complete before the shutdown or fail, and the
+        // processes created while the node shuts down are killed.
+        //
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < nConcurrentServers; ++i)
+        {
+            ostringstream id;
+            id << concurrentNodes[n] << "-server-" << i;
+            results.push_back(admin->begin_startServer(id.str()));
+        }
+        admin->shutdownNode(concurrentNodes[n]);
+        for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            try
+            {
+                admin->end_startServer(*p);
+            }
+            catch(const IceGrid::ServerStartException&)
+            {
+            }
+            catch(const IceGrid::NodeUnreachableException&)
+            {
+            }
+            catch(const IceGrid::DeploymentException&)
+            {
+            }
+        }
+        waitForServerState(admin, concurrentNodes[n], IceGrid::Inactive);
+        test(admin->getServerState(concurrentNodes[n]) == IceGrid::Inactive);
+
+        //
+        // The servers can be activated again once the node is restarted.
+        //
+        admin->startServer(concurrentNodes[n]);
+        nRetry = 0;
+        while(!admin->pingNode(concurrentNodes[n]) && nRetry < 15)
+        {
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+            ++nRetry;
+        }
+        for(int i = 0; i < nConcurrentServers; ++i)
+        {
+            ostringstream id;
+            id << concurrentNodes[n] << "-server-" << i;
+            test(admin->getServerState(id.str()) == IceGrid::Inactive);
+            TestIntfPrx::checkedCast(communicator->stringToProxy(id.str()))->ice_ping();
+            admin->stopServer(id.str());
+        }
+        admin->stopServer(concurrentNodes[n]);
+    }
+    admin->removeApplication("ConcurrentApp");
+    cout << "ok" << endl;
+
     admin->stopServer("node-1");
     admin->stopServer("node-2");
 
@@ -485,6 +485,55 @@ allTests(Test::TestHelper* helper)
     }
     cout << "ok" << endl;
 
+    cout << "testing replication with latency load balancing... " << flush;
+    {
+        //
+        // Server2 delays the dispatch of getReplicaId by 200ms. The node computes
+        // the latency of both servers from their dispatch metrics. Once both
+        // latencies are reported to the registry, the power of two choices between
+        // two replicas always picks Server1.
+        //
+        map<string, string> params;
+        params["replicaGroup"] = "Latency";
+        params["id"] = "Server1";
+        instantiateServer(admin, "Server", "localnode", params);
+        params["id"] = "Server2";
+        params["latencyDelay"] = "200";
+        instantiateServer(admin, "Server", "localnode", params);
+        TestIntfPrx obj = TestIntfPrx::uncheckedCast(comm->stringToProxy("Latency"));
+        obj = TestIntfPrx::uncheckedCast(obj->ice_locatorCacheTimeout(0));
+        obj = TestIntfPrx::uncheckedCast(obj->ice_connectionCached(false));
+
+        bool fastest = false;
+        IceUtil::Time timeout = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::seconds(60);
+        while(!fastest)
+        {
+            test(IceUtil::Time::now(IceUtil::Time::Monotonic) < timeout);
+            fastest = true;
+            for(int i = 0; i < 20; ++i)
+            {
+                try
+                {
+                    string id = obj->getReplicaId();
+                    test(id == "Server1.ReplicatedAdapter" || id == "Server2.ReplicatedAdapter");
+                    fastest = fastest && id == "Server1.ReplicatedAdapter";
+                }
+                catch(const Ice::LocalException& ex)
+                {
+                    cerr << ex << endl;
+                    test(false);
+                }
+            }
+            if(!fastest)
+            {
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(500));
+            }
+        }
+        removeServer(admin, "Server1");
+        removeServer(admin, "Server2");
+    }
+    cout << "ok" << endl;
+
     cout << "testing filters... " << flush;
     {
         map<string, string> params;
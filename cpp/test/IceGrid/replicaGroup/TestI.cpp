@@ -13,6 +13,11 @@ TestI::TestI(const Ice::PropertiesPtr& properties) :
 std::string
 TestI::getReplicaId(const Ice::Current& current)
 {
+    int delay = _properties->getPropertyAsInt("LatencyDelay");
+    if(delay > 0)
+    {
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(delay));
+    }
     return _properties->getProperty(current.adapter->getName() + ".AdapterId");
 }
 
@@ -8,6 +8,8 @@
 #include <TestHelper.h>
 #include <Test.h>
 
+#include <fstream>
+
 using namespace std;
 using namespace Test;
 using namespace IceGrid;
@@ -57,6 +59,49 @@ hasProperty(const CommunicatorDescriptorPtr& desc, const string& name, const str
     return false;
 }
 
+class ApplicationUpdateObserverI : public ApplicationUpdateObserver, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    ApplicationUpdateObserverI() : _revision(0), _updated(0), _total(0)
+    {
+    }
+
+    virtual void
+    updateProgress(const string& application, int revision, int updated, int total, const Ice::Current&)
+    {
+        Lock sync(*this);
+        test(application == "ProgressApp");
+        test(updated <= total);
+        test(revision > _revision || (revision == _revision && updated >= _updated));
+        _revision = revision;
+        _updated = updated;
+        _total = total;
+        notifyAll();
+    }
+
+    void
+    waitForUpdate(int revision, int total)
+    {
+        Lock sync(*this);
+        while(_revision < revision || _updated < _total)
+        {
+            if(!timedWait(IceUtil::Time::seconds(30)))
+            {
+                test(false);
+            }
+        }
+        test(_revision == revision && _total == total);
+    }
+
+private:
+
+    int _revision;
+    int _updated;
+    int _total;
+};
+typedef IceUtil::Handle<ApplicationUpdateObserverI> ApplicationUpdateObserverIPtr;
+
 void
 allTests(Test::TestHelper* helper)
 {
@@ -1295,5 +1340,315 @@ allTests(Test::TestHelper* helper)
         cout << "ok" << endl;
     }
 
+    {
+        cout << "testing application update progress... " << flush;
+
+        Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("UpdateObserver", "tcp");
+        ApplicationUpdateObserverIPtr observer = new ApplicationUpdateObserverI();
+        Ice::ObjectPrx obsPrx = adapter->addWithUUID(observer);
+        adapter->activate();
+        session->setApplicationUpdateObserver(ApplicationUpdateObserverPrx::uncheckedCast(obsPrx));
+
+        ApplicationDescriptor testApp;
+        testApp.name = "ProgressApp";
+        for(int i = 0; i < 3; ++i)
+        {
+            ostringstream id;
+            id << "ProgressServer" << i;
+            ServerDescriptorPtr server = new ServerDescriptor();
+            server->id = id.str();
+            server->exe = properties->getProperty("ServerDir") + "/server";
+            server->pwd = ".";
+            server->applicationDistrib = false;
+            server->allocatable = false;
+            testApp.nodes["localnode"].servers.push_back(server);
+        }
+        admin->addApplication(testApp);
+        observer->waitForUpdate(1, 3);
+
+        //
+        // Updating a single server also updates the revision of the other servers.
+        //
+        ApplicationUpdateDescriptor update;
+        update.name = "ProgressApp";
+        NodeUpdateDescriptor node;
+        node.name = "localnode";
+        ServerDescriptorPtr server = ServerDescriptorPtr::dynamicCast(testApp.nodes["localnode"].servers[0]->ice_clone());
+        addProperty(server, "Dummy", "1");
+        node.servers.push_back(server);
+        update.nodes.push_back(node);
+        admin->updateApplication(update);
+        observer->waitForUpdate(2, 3);
+
+        admin->removeApplication("ProgressApp");
+        session->setApplicationUpdateObserver(0);
+        adapter->destroy();
+
+        cout << "ok" << endl;
+    }
+
+    {
+        //
+        // The registry is configured with IceGrid.Registry.UpdateConcurrency=1, the
+        // load and destroy requests of each node are queued and the nodes are still
+        // updated in parallel.
+        //
+        cout << "testing application update with bounded update concurrency... " << flush;
+
+        const int nNodes = 3;
+        const int nServers = 5;
+
+        ApplicationDescriptor nodeApp;
+        nodeApp.name = "NodeApp";
+
+        ServerDescriptorPtr server = new ServerDescriptor();
+        server->id = "node-${index}";
+        server->exe = properties->getProperty("IceGridNodeExe");
+        server->pwd = ".";
+        server->applicationDistrib = false;
+        server->allocatable = false;
+        server->options.push_back("--nowarn");
+
+        addProperty(server, "IceGrid.Node.Name", "node-${index}");
+        addProperty(server, "IceGrid.Node.Data", properties->getProperty("TestDir") + "/db/node-${index}");
+        addProperty(server, "IceGrid.Node.Endpoints", "default");
+        addProperty(server, "IceGrid.Node.PropertiesOverride", properties->getProperty("NodePropertiesOverride"));
+        addProperty(server, "Ice.Admin.Endpoints", "tcp -h 127.0.0.1");
+
+        nodeApp.serverTemplates["nodeTemplate"].descriptor = server;
+        nodeApp.serverTemplates["nodeTemplate"].parameters.push_back("index");
+
+        for(int i = 1; i <= nNodes; ++i)
+        {
+            ostringstream index;
+            index << i;
+            ServerInstanceDescriptor instance;
+            instance._cpp_template = "nodeTemplate";
+            instance.parameterValues["index"] = index.str();
+            nodeApp.nodes["localnode"].serverInstances.push_back(instance);
+        }
+
+        try
+        {
+            admin->addApplication(nodeApp);
+        }
+        catch(const Ice::Exception& ex)
+        {
+            cerr << ex << endl;
+            test(false);
+        }
+
+        vector<string> nodes;
+        for(int i = 1; i <= nNodes; ++i)
+        {
+            ostringstream node;
+            node << "node-" << i;
+            nodes.push_back(node.str());
+            admin->startServer(node.str());
+        }
+
+        for(vector<string>::const_iterator p = nodes.begin(); p != nodes.end(); ++p)
+        {
+            int retry = 0;
+            while(retry < 20)
+            {
+                try
+                {
+                    if(admin->pingNode(*p))
+                    {
+                        break;
+                    }
+                }
+                catch(const NodeNotExistException&)
+                {
+                }
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(500));
+                ++retry;
+            }
+            test(admin->pingNode(*p));
+        }
+
+        ApplicationDescriptor testApp;
+        testApp.name = "TestApp";
+        for(vector<string>::const_iterator p = nodes.begin(); p != nodes.end(); ++p)
+        {
+            for(int i = 0; i < nServers; ++i)
+            {
+                ostringstream id;
+                id << *p << "-Server" << i;
+                server = new ServerDescriptor();
+                server->id = id.str();
+                server->exe = properties->getProperty("ServerDir") + "/server";
+                server->pwd = ".";
+                server->applicationDistrib = false;
+                server->allocatable = false;
+                addProperty(server, "Ice.Admin.Endpoints", "tcp -h 127.0.0.1");
+                AdapterDescriptor adapter;
+                adapter.name = "Server";
+                adapter.id = id.str() + "Adapter";
+                adapter.registerProcess = false;
+                adapter.serverLifetime = true;
+                server->adapters.push_back(adapter);
+                addProperty(server, "Server.Endpoints", "default");
+                testApp.nodes[*p].servers.push_back(server);
+            }
+        }
+
+        try
+        {
+            admin->addApplication(testApp);
+        }
+        catch(const DeploymentException& ex)
+        {
+            cerr << ex.reason << endl;
+            test(false);
+        }
+
+        for(vector<string>::const_iterator p = nodes.begin(); p != nodes.end(); ++p)
+        {
+            for(int i = 0; i < nServers; ++i)
+            {
+                ostringstream id;
+                id << *p << "-Server" << i;
+                test(admin->getServerInfo(id.str()).node == *p);
+                test(admin->getServerState(id.str()) == Inactive);
+            }
+        }
+
+        //
+        // Update all the servers, the update completes once every node loaded
+        // all its servers.
+        //
+        ApplicationUpdateDescriptor update;
+        update.name = "TestApp";
+        update.variables["dummy"] = "1";
+        for(map<string, NodeDescriptor>::const_iterator p = testApp.nodes.begin(); p != testApp.nodes.end(); ++p)
+        {
+            NodeUpdateDescriptor nodeUpdate;
+            nodeUpdate.name = p->first;
+            for(ServerDescriptorSeq::const_iterator q = p->second.servers.begin(); q != p->second.servers.end(); ++q)
+            {
+                server = ServerDescriptorPtr::dynamicCast((*q)->ice_clone());
+                addProperty(server, "Dummy", "${dummy}");
+                nodeUpdate.servers.push_back(server);
+            }
+            update.nodes.push_back(nodeUpdate);
+        }
+
+        try
+        {
+            admin->updateApplication(update);
+        }
+        catch(const DeploymentException& ex)
+        {
+            cerr << ex.reason << endl;
+            test(false);
+        }
+
+        for(vector<string>::const_iterator p = nodes.begin(); p != nodes.end(); ++p)
+        {
+            for(int i = 0; i < nServers; ++i)
+            {
+                ostringstream id;
+                id << *p << "-Server" << i;
+                ServerInfo info = admin->getServerInfo(id.str());
+                test(info.revision == 2);
+                test(hasProperty(info.descriptor, "Dummy", "1"));
+            }
+        }
+
+        admin->startServer("node-1-Server0");
+        test(admin->getServerState("node-1-Server0") == Active);
+
+        //
+        // Update a single server, the nodes only update the revision of the
+        // other servers and the active server isn't restarted.
+        //
+        int pid = admin->getServerPid("node-1-Server0");
+        update = ApplicationUpdateDescriptor();
+        update.name = "TestApp";
+        NodeUpdateDescriptor nodeUpdate;
+        nodeUpdate.name = "node-1";
+        server = ServerDescriptorPtr::dynamicCast(testApp.nodes["node-1"].servers[1]->ice_clone());
+        addProperty(server, "Dummy", "${dummy}");
+        addProperty(server, "Other", "1");
+        nodeUpdate.servers.push_back(server);
+        update.nodes.push_back(nodeUpdate);
+
+        try
+        {
+            admin->updateApplication(update);
+        }
+        catch(const DeploymentException& ex)
+        {
+            cerr << ex.reason << endl;
+            test(false);
+        }
+
+        test(admin->getServerState("node-1-Server0") == Active);
+        test(admin->getServerPid("node-1-Server0") == pid);
+        test(hasProperty(admin->getServerInfo("node-1-Server1").descriptor, "Other", "1"));
+        for(vector<string>::const_iterator p = nodes.begin(); p != nodes.end(); ++p)
+        {
+            for(int i = 0; i < nServers; ++i)
+            {
+                ostringstream id;
+                id << *p << "-Server" << i;
+                test(admin->getServerInfo(id.str()).revision == 3);
+
+                string path = properties->getProperty("TestDir") + "/db/" + *p + "/servers/" + id.str() + "/revision";
+                ifstream is(path.c_str());
+                test(is.good());
+                string line;
+                bool found = false;
+                while(getline(is, line))
+                {
+                    found = found || line == "revision: 3";
+                }
+                test(found);
+            }
+        }
+
+        try
+        {
+            admin->removeApplication("TestApp");
+        }
+        catch(const DeploymentException& ex)
+        {
+            cerr << ex.reason << endl;
+            test(false);
+        }
+
+        for(vector<string>::const_iterator p = nodes.begin(); p != nodes.end(); ++p)
+        {
+            for(int i = 0; i < nServers; ++i)
+            {
+                ostringstream id;
+                id << *p << "-Server" << i;
+                try
+                {
+                    admin->getServerState(id.str());
+                    test(false);
+                }
+                catch(const ServerNotExistException&)
+                {
+                }
+            }
+            admin->stopServer(*p);
+        }
+
+        try
+        {
+            admin->removeApplication("NodeApp");
+        }
+        catch(const Ice::Exception& ex)
+        {
+            cerr << ex << endl;
+            test(false);
+        }
+
+        cout << "ok" << endl;
+    }
+
     session->destroy();
 }
@@ -9,6 +9,7 @@ class IceGridUpdateTestCase(IceGridTestCase):
         IceGridTestCase.setupClientSide(self, current)
         current.mkdirs("db/node-1")
         current.mkdirs("db/node-2")
+        current.mkdirs("db/node-3")
 
 clientProps = lambda process, current: {
     "NodePropertiesOverride" : current.testcase.icegridnode[0].getPropertiesOverride(current),
@@ -18,5 +19,14 @@ clientProps = lambda process, current: {
     "TestDir" : "{testdir}"
 }
 
+#
+# Each node is sent a single load or destroy request at a time, the update test
+# deploys more servers on each node and uses more nodes than this limit.
+#
+registryProps = { "IceGrid.Registry.UpdateConcurrency" : 1 }
+
+icegridregistry = [IceGridRegistryMaster(props=registryProps), IceGridRegistrySlave(1, props=registryProps)]
+
 if isinstance(platform, Windows) or os.getuid() != 0:
-    TestSuite(__file__, [IceGridUpdateTestCase(application=None, client=IceGridClient(props=clientProps))], multihost=False)
+    TestSuite(__file__, [IceGridUpdateTestCase(application=None, icegridregistry=icegridregistry,
+                                               client=IceGridClient(props=clientProps))], multihost=False)
@@ -0,0 +1,66 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+import time
+
+class IcePatch2CalcTestCase(ClientTestCase):
+
+    def runClientSide(self, current):
+        datadir = os.path.join(self.testsuite.getPath(), "data")
+        if os.path.exists(datadir):
+            shutil.rmtree(datadir)
+        current.mkdirs(["data", os.path.join("data", "dir")])
+
+        def test(b):
+            if not b:
+                raise RuntimeError('test assertion failed')
+
+        def write(file, content, age=10):
+            path = os.path.join(datadir, file)
+            with open(path, "wb") as f:
+                f.write(content)
+            #
+            # The checksum of a file modified during the scan isn't cached, the
+            # files are dated in the past to be cached by the next scan.
+            #
+            mtime = time.time() - age
+            os.utime(path, (mtime, mtime))
+
+        def calc(args):
+            IcePatch2Calc(args=args + [datadir]).run(current)
+            with open(os.path.join(datadir, "IcePatch2.sum"), "r") as f:
+                return f.read()
+
+        files = [
+            [ "small", b"small file" ],
+            [ "medium", os.urandom(100 * 1024) ],
+            [ "dir/large", os.urandom(3 * 1024 * 1024) ],
+            [ "dir/empty", b"" ],
+        ]
+        for [file, content] in files:
+            write(file, content)
+
+        for args in [["-Z"], []]:
+            current.write("testing incremental checksums{0}... ".format(" with compression" if not args else ""))
+            cache = os.path.join(datadir, "IcePatch2.cache")
+            if os.path.exists(cache):
+                os.unlink(cache)
+
+            full = calc(args)
+            test(not os.path.exists(cache))
+
+            # The first incremental run computes and caches the checksums, the second reuses them.
+            test(calc(args + ["--incremental"]) == full)
+            test(os.path.exists(cache))
+            test(calc(args + ["--incremental"]) == full)
+
+            # A file rewritten with the same size must be checksummed again.
+            write("medium", os.urandom(100 * 1024), age=5)
+            incremental = calc(args + ["--incremental"])
+            test(incremental != full)
+            test(calc(args) == incremental)
+            current.writeln("ok")
+
+TestSuite(__file__, [ IcePatch2CalcTestCase() ], multihost=False)
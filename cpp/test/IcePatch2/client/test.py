@@ -0,0 +1,81 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+class IcePatch2ClientTestCase(ClientServerTestCase):
+
+    def setupServerSide(self, current):
+        datadir = os.path.join(current.testsuite.getPath(), "data")
+        if os.path.exists(datadir):
+            shutil.rmtree(datadir)
+        current.mkdirs(["data", os.path.join("data", "dir")])
+
+        files = [
+            [ "small", b"small file" ],
+            [ "medium", os.urandom(100 * 1024) ],
+            [ "dir/large", os.urandom(3 * 1024 * 1024) ],
+            [ "dir/empty", b"" ],
+        ]
+        for i in range(0, 8):
+            files.append([ "dir/file{0}".format(i), os.urandom(200 * 1024) ])
+        for [file, content] in files:
+            with open(os.path.join(datadir, file), "wb") as f:
+                f.write(content)
+
+        IcePatch2Calc(args=[datadir]).run(current)
+
+    def runClientSide(self, current):
+        datadir = os.path.join(current.testsuite.getPath(), "data")
+        patchdir = os.path.join(current.testsuite.getPath(), "patched")
+
+        def test(b):
+            if not b:
+                raise RuntimeError('test assertion failed')
+
+        def files(dir):
+            result = {}
+            for root, dirs, names in os.walk(dir):
+                for name in names:
+                    if name.startswith("IcePatch2.") or name.endswith(".bz2"):
+                        continue
+                    path = os.path.join(root, name)
+                    with open(path, "rb") as f:
+                        result[os.path.relpath(path, dir)] = f.read()
+            return result
+
+        expected = files(datadir)
+
+        def patch(props):
+            props["IcePatch2Client.Proxy"] = "IcePatch2/server:{0}".format(current.getTestEndpoint(0))
+            IcePatch2Client(args=["-t", patchdir], props=props).run(current)
+            test(files(patchdir) == expected)
+
+        configs = [
+            [ "default settings", {} ],
+            [ "large download window and small chunks", { "IcePatch2Client.ChunkSize": 16,
+                                                          "IcePatch2Client.DownloadWindow": 16,
+                                                          "IcePatch2Client.DownloadFiles": 8,
+                                                          "IcePatch2Client.DecompressThreads": 4 } ],
+            [ "no pipelining", { "IcePatch2Client.DownloadWindow": 1,
+                                 "IcePatch2Client.DownloadFiles": 1,
+                                 "IcePatch2Client.DecompressThreads": 1 } ],
+        ]
+
+        current.mkdirs("patched")
+        for [desc, props] in configs:
+            current.write("testing patch with {0}... ".format(desc))
+            shutil.rmtree(patchdir)
+            os.makedirs(patchdir)
+            patch(dict(props))
+
+            # Only the removed, modified and missing files are downloaded again.
+            os.unlink(os.path.join(patchdir, "dir", "large"))
+            with open(os.path.join(patchdir, "dir", "file3"), "wb") as f:
+                f.write(os.urandom(200 * 1024))
+            with open(os.path.join(patchdir, "extra"), "wb") as f:
+                f.write(b"extra file")
+            patch(dict(props))
+            current.writeln("ok")
+
+TestSuite(__file__, [ IcePatch2ClientTestCase(server=IcePatch2Server(args=["{testdir}/data"])) ], multihost=False)
@@ -0,0 +1,173 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IceUtil/DisableWarnings.h>
+#include <Ice/Ice.h>
+#include <IcePatch2/FileServer.h>
+#include <TestHelper.h>
+
+#include <cstdio>
+#include <fstream>
+
+using namespace std;
+using namespace IcePatch2;
+
+namespace
+{
+
+Ice::ByteSeq
+readFile(const string& path)
+{
+    ifstream in(path.c_str(), ios::binary);
+    test(in);
+    return Ice::ByteSeq((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+}
+
+void
+writeFile(const string& path, const Ice::ByteSeq& data)
+{
+    ofstream out(path.c_str(), ios::binary);
+    test(out);
+    out.write(reinterpret_cast<const char*>(&data[0]), static_cast<streamsize>(data.size()));
+    test(out);
+}
+
+Ice::ByteSeq
+getFile(const FileServerPrx& server, const string& path, Ice::Int chunkSize, bool largeFile)
+{
+    Ice::ByteSeq data;
+    for(Ice::Int pos = 0;; pos += chunkSize)
+    {
+        Ice::ByteSeq chunk = largeFile ? server->getLargeFileCompressed(path, pos, chunkSize) :
+                                         server->getFileCompressed(path, pos, chunkSize);
+        test(static_cast<Ice::Int>(chunk.size()) <= chunkSize);
+        if(chunk.empty())
+        {
+            return data;
+        }
+        data.insert(data.end(), chunk.begin(), chunk.end());
+    }
+}
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    if(argc < 2)
+    {
+        throw invalid_argument("usage: client <data directory>");
+    }
+    const string dataDir = argv[1];
+
+    FileServerPrx server = FileServerPrx::checkedCast(
+        communicator->stringToProxy("IcePatch2/server:" + getTestEndpoint()));
+    test(server);
+
+    const char* files[] = { "small", "medium", "dir/large" };
+    const size_t nfiles = sizeof(files) / sizeof(*files);
+
+    //
+    // The files are requested several times: the server caches up to two files,
+    // the chunks are sent from the cached files or from the files after they
+    // were evicted.
+    //
+    cout << "testing getFileCompressed... " << flush;
+    for(int i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < nfiles; ++j)
+        {
+            Ice::ByteSeq expected = readFile(dataDir + "/" + files[j] + ".bz2");
+            test(getFile(server, files[j], 1000, false) == expected);
+            test(getFile(server, files[j], static_cast<Ice::Int>(min(expected.size(), size_t(512 * 1024))), false) ==
+                 expected);
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing getLargeFileCompressed... " << flush;
+    for(int i = 0; i < 3; ++i)
+    {
+        for(size_t j = 0; j < nfiles; ++j)
+        {
+            Ice::ByteSeq expected = readFile(dataDir + "/" + files[j] + ".bz2");
+            test(getFile(server, files[j], 64 * 1024, true) == expected);
+            test(getFile(server, files[j], 777, true) == expected);
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing invalid chunks... " << flush;
+    {
+        Ice::Long size = static_cast<Ice::Long>(readFile(dataDir + "/medium.bz2").size());
+        test(server->getLargeFileCompressed("medium", size, 100).empty());
+        test(server->getLargeFileCompressed("medium", size + 100, 100).empty());
+        test(server->getLargeFileCompressed("medium", 0, 0).empty());
+        test(server->getLargeFileCompressed("medium", -1, 100).empty());
+        test(server->getFileCompressed("medium", 0, -1).empty());
+
+        try
+        {
+            server->getLargeFileCompressed("../medium", 0, 100);
+            test(false);
+        }
+        catch(const FileAccessException&)
+        {
+        }
+
+        try
+        {
+            server->getLargeFileCompressed("unknown", 0, 100);
+            test(false);
+        }
+        catch(const FileAccessException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing files replaced while cached... " << flush;
+    {
+        //
+        // Replace the compressed file with a file of the same size, as icepatch2calc
+        // does by renaming the new file over the previous one. The server checks the
+        // cached files for changes at most once per second.
+        //
+        const string path = dataDir + "/medium.bz2";
+        Ice::ByteSeq previous = readFile(path);
+        test(getFile(server, "medium", 64 * 1024, true) == previous);
+
+        Ice::ByteSeq updated(previous.rbegin(), previous.rend());
+        test(updated != previous);
+        writeFile(path + ".tmp", updated);
+        test(::rename((path + ".tmp").c_str(), path.c_str()) == 0);
+
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1500));
+        test(getFile(server, "medium", 64 * 1024, true) == updated);
+        test(getFile(server, "medium", 1000, false) == updated);
+
+        //
+        // Shrink the file, a file renamed over the cached file doesn't affect the
+        // mapping of the previous file.
+        //
+        Ice::ByteSeq shrunk(updated.begin(), updated.begin() + static_cast<ptrdiff_t>(updated.size() / 2));
+        writeFile(path + ".tmp", shrunk);
+        test(::rename((path + ".tmp").c_str(), path.c_str()) == 0);
+        test(getFile(server, "medium", 64 * 1024, true).size() >= shrunk.size());
+
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1500));
+        test(getFile(server, "medium", 64 * 1024, true) == shrunk);
+    }
+    cout << "ok" << endl;
+}
+
+DEFINE_TEST(Client)
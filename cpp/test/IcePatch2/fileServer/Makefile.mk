@@ -0,0 +1,9 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+$(test)_programs            = client
+$(test)_client_sources      = Client.cpp
+$(test)_client_dependencies = IcePatch2
+
+tests += $(test)
@@ -0,0 +1,35 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+class IcePatch2FileServerTestCase(ClientServerTestCase):
+
+    def setupServerSide(self, current):
+        datadir = os.path.join(current.testsuite.getPath(), "data")
+        if os.path.exists(datadir):
+            shutil.rmtree(datadir)
+        current.mkdirs(["data", os.path.join("data", "dir")])
+
+        files = [
+            [ "small", b"small file" ],
+            [ "medium", os.urandom(100 * 1024) ],
+            [ "dir/large", os.urandom(3 * 1024 * 1024) ],
+        ]
+        for [file, content] in files:
+            with open(os.path.join(datadir, file), "wb") as f:
+                f.write(content)
+
+        IcePatch2Calc(args=[datadir]).run(current)
+
+client = Client(args=["{testdir}/data"])
+
+# The client renames files over the files served by the server, which isn't supported on Windows
+if not isinstance(platform, Windows):
+    TestSuite(__file__, [
+        IcePatch2FileServerTestCase("client/server with file cache", client=client,
+                                    server=IcePatch2Server(args=["{testdir}/data"],
+                                                           props={ "IcePatch2.FileCacheSize": 2 })),
+        IcePatch2FileServerTestCase("client/server without file cache", client=client,
+                                    server=IcePatch2Server(args=["{testdir}/data"])),
+    ], multihost=False)
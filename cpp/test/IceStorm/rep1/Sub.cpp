@@ -36,6 +36,8 @@ Sub::run(int argc, char** argv)
     IceUtilInternal::Options opts;
     opts.addOpt("", "id", IceUtilInternal::Options::NeedArg);
     opts.addOpt("", "unsub");
+    opts.addOpt("", "pipeline", IceUtilInternal::Options::NeedArg);
+    opts.addOpt("", "check");
 
     try
     {
@@ -68,6 +70,86 @@ Sub::run(int argc, char** argv)
 
     ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("SingleAdapter", "default");
 
+    if(opts.isSet("pipeline"))
+    {
+        //
+        // Create topics and subscribe to them concurrently, the master queues the
+        // updates while a batch is in flight and replicates them with a single
+        // batch. Once all the calls returned, each replica has all the updates.
+        //
+        const int count = atoi(opts.optArg("pipeline").c_str());
+        vector<TopicPrx> topics;
+        if(opts.isSet("check"))
+        {
+            for(int i = 0; i < count; ++i)
+            {
+                ostringstream os;
+                os << "pipeline-" << i;
+                topics.push_back(manager->retrieve(os.str()));
+            }
+        }
+        else
+        {
+            vector<AsyncResultPtr> results;
+            for(int i = 0; i < count; ++i)
+            {
+                ostringstream os;
+                os << "pipeline-" << i;
+                results.push_back(manager->begin_create(os.str()));
+            }
+            for(int i = 0; i < count; ++i)
+            {
+                topics.push_back(manager->end_create(results[static_cast<size_t>(i)]));
+            }
+
+            results.clear();
+            for(int i = 0; i < count; ++i)
+            {
+                ostringstream os;
+                os << opts.optArg("id") << "-" << i;
+                Ice::ObjectPrx prx = adapter->add(new SingleI(), stringToIdentity(os.str()));
+                IceStorm::QoS qos;
+                qos["persistent"] = "true";
+                results.push_back(topics[static_cast<size_t>(i)]->begin_subscribeAndGetPublisher(qos, prx));
+            }
+            for(int i = 0; i < count; ++i)
+            {
+                topics[static_cast<size_t>(i)]->end_subscribeAndGetPublisher(results[static_cast<size_t>(i)]);
+            }
+
+            //
+            // Unsubscribe from every other topic.
+            //
+            results.clear();
+            for(int i = 0; i < count; i += 2)
+            {
+                ostringstream os;
+                os << opts.optArg("id") << "-" << i;
+                results.push_back(topics[static_cast<size_t>(i)]->begin_unsubscribe(
+                                      adapter->createProxy(stringToIdentity(os.str()))));
+            }
+            for(int i = 0; i < count; i += 2)
+            {
+                topics[static_cast<size_t>(i)]->end_unsubscribe(results[static_cast<size_t>(i / 2)]);
+            }
+        }
+
+        for(int i = 0; i < count; ++i)
+        {
+            ostringstream os;
+            os << opts.optArg("id") << "-" << i;
+            Ice::IdentitySeq subscribers = topics[static_cast<size_t>(i)]->getSubscribers();
+            if(subscribers.size() != (i % 2 ? 1 : 0) ||
+               (i % 2 && subscribers[0] != stringToIdentity(os.str())))
+            {
+                ostringstream err;
+                err << "unexpected subscribers for topic `" << topics[static_cast<size_t>(i)]->getName() << "'";
+                throw runtime_error(err.str());
+            }
+        }
+        return;
+    }
+
     TopicPrx topic = manager->retrieve("single");
 
     Ice::ObjectPrx prx = adapter->add(new SingleI(), stringToIdentity(opts.optArg("id")));
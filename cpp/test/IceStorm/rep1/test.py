@@ -247,6 +247,32 @@ class IceStormRep1TestCase(IceStormTestCase):
 
         # All replicas are running
 
+        current.write("testing pipelined replication... ")
+        sys.stdout.flush()
+
+        def runpipeline(replica=None, check=False):
+            Subscriber(exe="sub",
+                       instance=None if replica is None else self.icestorm[replica],
+                       args=["--id", "pipe", "--pipeline", "200"] + (["--check"] if check else []),
+                       readyCount=0,
+                       quiet=True).run(current)
+
+        runpipeline()
+
+        for replica in range(0, 3):
+            runpipeline(replica, True)
+
+        # The replicas elect a new master with the replicated state
+        stopReplica(2)
+
+        for replica in range(0, 2):
+            runpipeline(replica, True)
+
+        startReplica(2)
+
+        runpipeline(2, True)
+        current.writeln("ok")
+
         current.write("running twoway subscription test... ")
         runtest("--twoway")
         current.writeln("ok")
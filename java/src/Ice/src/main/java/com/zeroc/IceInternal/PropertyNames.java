@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Dec 11 11:59:14 2023
+// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Oct 19 05:16:07 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -60,6 +60,7 @@ public final class PropertyNames
         new Property("Ice\\.Admin\\.ThreadPool\\.SizeWarn", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.StackSize", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.Serialize", false, null),
+        new Property("Ice\\.Admin\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("Ice\\.Admin\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("Ice\\.Admin\\.MessageSizeMax", false, null),
@@ -115,6 +116,9 @@ public final class PropertyNames
         new Property("Ice\\.Default\\.Timeout", false, null),
         new Property("Ice\\.EventLog\\.Source", false, null),
         new Property("Ice\\.FactoryAssemblies", false, null),
+        new Property("Ice\\.HostResolver\\.CacheTTL", false, null),
+        new Property("Ice\\.HostResolver\\.NegativeCacheTTL", false, null),
+        new Property("Ice\\.HostResolver\\.Size", false, null),
         new Property("Ice\\.HTTPProxyHost", false, null),
         new Property("Ice\\.HTTPProxyPort", false, null),
         new Property("Ice\\.ImplicitContext", false, null),
@@ -143,6 +147,8 @@ public final class PropertyNames
         new Property("Ice\\.ProgramName", false, null),
         new Property("Ice\\.RetryIntervals", false, null),
         new Property("Ice\\.ServerIdleTime", false, null),
+        new Property("Ice\\.SHM\\.RcvSize", false, null),
+        new Property("Ice\\.SHM\\.SndSize", false, null),
         new Property("Ice\\.SOCKSProxyHost", false, null),
         new Property("Ice\\.SOCKSProxyPort", false, null),
         new Property("Ice\\.StdErr", false, null),
@@ -153,6 +159,7 @@ public final class PropertyNames
         new Property("Ice\\.ThreadPool\\.Client\\.SizeWarn", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.StackSize", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.Serialize", false, null),
+        new Property("Ice\\.ThreadPool\\.Client\\.MessageBatchSize", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.ThreadIdleTime", false, null),
         new Property("Ice\\.ThreadPool\\.Client\\.ThreadPriority", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.Size", false, null),
@@ -160,6 +167,7 @@ public final class PropertyNames
         new Property("Ice\\.ThreadPool\\.Server\\.SizeWarn", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.StackSize", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.Serialize", false, null),
+        new Property("Ice\\.ThreadPool\\.Server\\.MessageBatchSize", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.ThreadIdleTime", false, null),
         new Property("Ice\\.ThreadPool\\.Server\\.ThreadPriority", false, null),
         new Property("Ice\\.ThreadPriority", false, null),
@@ -195,6 +203,8 @@ public final class PropertyNames
 
     public static final Property IceMXProps[] =
     {
+        new Property("IceMX\\.Exporter\\.Host", false, null),
+        new Property("IceMX\\.Exporter\\.Port", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.GroupBy", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.Map", false, null),
         new Property("IceMX\\.Metrics\\.[^\\s]+\\.RetainDetached", false, null),
@@ -240,6 +250,7 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.StackSize", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceDiscovery\\.Multicast\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceDiscovery\\.Multicast\\.MessageSizeMax", false, null),
@@ -277,6 +288,7 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.StackSize", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceDiscovery\\.Reply\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceDiscovery\\.Reply\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceDiscovery\\.Reply\\.MessageSizeMax", false, null),
@@ -314,6 +326,7 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.StackSize", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceDiscovery\\.Locator\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceDiscovery\\.Locator\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceDiscovery\\.Locator\\.MessageSizeMax", false, null),
@@ -321,6 +334,9 @@ public final class PropertyNames
         new Property("IceDiscovery\\.Timeout", false, null),
         new Property("IceDiscovery\\.RetryCount", false, null),
         new Property("IceDiscovery\\.LatencyMultiplier", false, null),
+        new Property("IceDiscovery\\.BatchSize", false, null),
+        new Property("IceDiscovery\\.BatchDelay", false, null),
+        new Property("IceDiscovery\\.CacheTimeout", false, null),
         new Property("IceDiscovery\\.Address", false, null),
         new Property("IceDiscovery\\.Port", false, null),
         new Property("IceDiscovery\\.Interface", false, null),
@@ -364,6 +380,7 @@ public final class PropertyNames
         new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.StackSize", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceLocatorDiscovery\\.Reply\\.MessageSizeMax", false, null),
@@ -401,6 +418,7 @@ public final class PropertyNames
         new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.StackSize", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceLocatorDiscovery\\.Locator\\.MessageSizeMax", false, null),
@@ -489,6 +507,7 @@ public final class PropertyNames
         new Property("IceBridge\\.Source\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceBridge\\.Source\\.ThreadPool\\.StackSize", false, null),
         new Property("IceBridge\\.Source\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceBridge\\.Source\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceBridge\\.Source\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceBridge\\.Source\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceBridge\\.Source\\.MessageSizeMax", false, null),
@@ -541,6 +560,7 @@ public final class PropertyNames
         new Property("IceGridAdmin\\.Server\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceGridAdmin\\.Server\\.ThreadPool\\.StackSize", false, null),
         new Property("IceGridAdmin\\.Server\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceGridAdmin\\.Server\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceGridAdmin\\.Server\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGridAdmin\\.Server\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceGridAdmin\\.Server\\.MessageSizeMax", false, null),
@@ -581,6 +601,7 @@ public final class PropertyNames
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.StackSize", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Reply\\.MessageSizeMax", false, null),
@@ -618,6 +639,7 @@ public final class PropertyNames
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.StackSize", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceGridAdmin\\.Discovery\\.Locator\\.MessageSizeMax", false, null),
@@ -662,6 +684,7 @@ public final class PropertyNames
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.StackSize", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.AdminRouter\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceGrid\\.AdminRouter\\.MessageSizeMax", false, null),
@@ -700,14 +723,17 @@ public final class PropertyNames
         new Property("IceGrid\\.Node\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.StackSize", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceGrid\\.Node\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Node\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceGrid\\.Node\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Node\\.AdapterLatencyPeriod", false, null),
         new Property("IceGrid\\.Node\\.AllowRunningServersAsRoot", false, null),
         new Property("IceGrid\\.Node\\.AllowEndpointsOverride", false, null),
         new Property("IceGrid\\.Node\\.CollocateRegistry", false, null),
         new Property("IceGrid\\.Node\\.Data", false, null),
         new Property("IceGrid\\.Node\\.DisableOnFailure", false, null),
+        new Property("IceGrid\\.Node\\.MaxConcurrentActivations", false, null),
         new Property("IceGrid\\.Node\\.Name", false, null),
         new Property("IceGrid\\.Node\\.Output", false, null),
         new Property("IceGrid\\.Node\\.ProcessorSocketCount", false, null),
@@ -778,6 +804,7 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.StackSize", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceGrid\\.Registry\\.AdminSessionManager\\.MessageSizeMax", false, null),
@@ -825,6 +852,7 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.StackSize", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceGrid\\.Registry\\.Client\\.MessageSizeMax", false, null),
@@ -864,6 +892,7 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.StackSize", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceGrid\\.Registry\\.Discovery\\.MessageSizeMax", false, null),
@@ -906,9 +935,11 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.StackSize", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceGrid\\.Registry\\.Internal\\.MessageSizeMax", false, null),
+        new Property("IceGrid\\.Registry\\.LMDB\\.GroupCommitWindow", false, null),
         new Property("IceGrid\\.Registry\\.LMDB\\.MapSize", false, null),
         new Property("IceGrid\\.Registry\\.LMDB\\.Path", false, null),
         new Property("IceGrid\\.Registry\\.NodeSessionTimeout", false, null),
@@ -960,6 +991,7 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.StackSize", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceGrid\\.Registry\\.Server\\.MessageSizeMax", false, null),
@@ -998,6 +1030,7 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.StackSize", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.Serialize", false, null),
+        new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IceGrid\\.Registry\\.SessionManager\\.MessageSizeMax", false, null),
@@ -1026,6 +1059,7 @@ public final class PropertyNames
         new Property("IceGrid\\.Registry\\.Trace\\.Subscriber", false, null),
         new Property("IceGrid\\.Registry\\.Trace\\.Topic", false, null),
         new Property("IceGrid\\.Registry\\.Trace\\.TopicManager", false, null),
+        new Property("IceGrid\\.Registry\\.UpdateConcurrency", false, null),
         new Property("IceGrid\\.Registry\\.UserAccounts", false, null),
         null
     };
@@ -1066,10 +1100,12 @@ public final class PropertyNames
         new Property("IcePatch2\\.ThreadPool\\.SizeWarn", false, null),
         new Property("IcePatch2\\.ThreadPool\\.StackSize", false, null),
         new Property("IcePatch2\\.ThreadPool\\.Serialize", false, null),
+        new Property("IcePatch2\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("IcePatch2\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("IcePatch2\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("IcePatch2\\.MessageSizeMax", false, null),
         new Property("IcePatch2\\.Directory", false, null),
+        new Property("IcePatch2\\.FileCacheSize", false, null),
         new Property("IcePatch2\\.InstanceName", false, null),
         null
     };
@@ -1077,7 +1113,10 @@ public final class PropertyNames
     public static final Property IcePatch2ClientProps[] =
     {
         new Property("IcePatch2Client\\.ChunkSize", false, null),
+        new Property("IcePatch2Client\\.DecompressThreads", false, null),
         new Property("IcePatch2Client\\.Directory", false, null),
+        new Property("IcePatch2Client\\.DownloadFiles", false, null),
+        new Property("IcePatch2Client\\.DownloadWindow", false, null),
         new Property("IcePatch2Client\\.Proxy", false, null),
         new Property("IcePatch2Client\\.Remove", false, null),
         new Property("IcePatch2Client\\.Thorough", false, null),
@@ -1187,6 +1226,7 @@ public final class PropertyNames
         new Property("Glacier2\\.Client\\.ThreadPool\\.SizeWarn", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.StackSize", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.Serialize", false, null),
+        new Property("Glacier2\\.Client\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("Glacier2\\.Client\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("Glacier2\\.Client\\.MessageSizeMax", false, null),
@@ -1262,6 +1302,7 @@ public final class PropertyNames
         new Property("Glacier2\\.Server\\.ThreadPool\\.SizeWarn", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.StackSize", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.Serialize", false, null),
+        new Property("Glacier2\\.Server\\.ThreadPool\\.MessageBatchSize", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.ThreadIdleTime", false, null),
         new Property("Glacier2\\.Server\\.ThreadPool\\.ThreadPriority", false, null),
         new Property("Glacier2\\.Server\\.MessageSizeMax", false, null),
@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Dec 11 11:59:14 2023
+// Generated by makeprops.py from file ./config/PropertyNames.xml, Mon Oct 19 05:16:07 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -63,6 +63,7 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Admin\.ThreadPool\.SizeWarn/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.StackSize/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.Serialize/", false, null),
+    new Property("/^Ice\.Admin\.ThreadPool\.MessageBatchSize/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.ThreadPriority/", false, null),
     new Property("/^Ice\.Admin\.MessageSizeMax/", false, null),
@@ -118,6 +119,9 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Default\.Timeout/", false, null),
     new Property("/^Ice\.EventLog\.Source/", false, null),
     new Property("/^Ice\.FactoryAssemblies/", false, null),
+    new Property("/^Ice\.HostResolver\.CacheTTL/", false, null),
+    new Property("/^Ice\.HostResolver\.NegativeCacheTTL/", false, null),
+    new Property("/^Ice\.HostResolver\.Size/", false, null),
     new Property("/^Ice\.HTTPProxyHost/", false, null),
     new Property("/^Ice\.HTTPProxyPort/", false, null),
     new Property("/^Ice\.ImplicitContext/", false, null),
@@ -146,6 +150,8 @@ PropertyNames.IceProps =
     new Property("/^Ice\.ProgramName/", false, null),
     new Property("/^Ice\.RetryIntervals/", false, null),
     new Property("/^Ice\.ServerIdleTime/", false, null),
+    new Property("/^Ice\.SHM\.RcvSize/", false, null),
+    new Property("/^Ice\.SHM\.SndSize/", false, null),
     new Property("/^Ice\.SOCKSProxyHost/", false, null),
     new Property("/^Ice\.SOCKSProxyPort/", false, null),
     new Property("/^Ice\.StdErr/", false, null),
@@ -156,6 +162,7 @@ PropertyNames.IceProps =
     new Property("/^Ice\.ThreadPool\.Client\.SizeWarn/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.StackSize/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.Serialize/", false, null),
+    new Property("/^Ice\.ThreadPool\.Client\.MessageBatchSize/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.ThreadPriority/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.Size/", false, null),
@@ -163,6 +170,7 @@ PropertyNames.IceProps =
     new Property("/^Ice\.ThreadPool\.Server\.SizeWarn/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.StackSize/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.Serialize/", false, null),
+    new Property("/^Ice\.ThreadPool\.Server\.MessageBatchSize/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.ThreadPriority/", false, null),
     new Property("/^Ice\.ThreadPriority/", false, null),
@@ -119,9 +119,17 @@ class Ice(Component):
                 if testId == "IceStorm/repgrid":
                     return False
 
+        # The shared memory transport is only supported on Linux
+        if testId == "Ice/shm" and not isinstance(platform, Linux):
+            return False
+
+        # Unix domain sockets aren't supported on Windows
+        if testId == "Ice/unix" and isinstance(platform, Windows):
+            return False
+
         # No C++11 tests for IceStorm, IceGrid, etc
         if isinstance(mapping, CppMapping) and current.config.cpp11:
-            if parent in ["IceStorm", "IceBridge"]:
+            if parent in ["IceStorm", "IceBridge", "IcePatch2"]:
                 return False
             elif parent in ["IceGrid"] and testId not in ["IceGrid/simple"]:
                 return False
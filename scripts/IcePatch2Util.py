@@ -20,10 +20,16 @@ class IcePatch2Client(ProcessFromBinDir, ProcessIsReleaseOnly, Process):
     def getExe(self, current):
         return self.exe + "_32" if current.config.buildPlatform == "ppc" else self.exe
 
-class IcePatch2Server(ProcessFromBinDir, ProcessIsReleaseOnly, Process):
+class IcePatch2Server(ProcessFromBinDir, ProcessIsReleaseOnly, Server):
 
     def __init__(self, *args, **kargs):
-        Process.__init__(self, exe="icepatch2server", mapping=Mapping.getByName("cpp"), *args, **kargs)
+        Server.__init__(self, "icepatch2server", mapping=Mapping.getByName("cpp"), desc="IcePatch2 server",
+                        waitForShutdown=False, *args, **kargs)
 
     def getExe(self, current):
         return self.exe + "_32" if current.config.buildPlatform == "ppc" else self.exe
+
+    def getProps(self, current):
+        props = Server.getProps(self, current)
+        props["IcePatch2.Endpoints"] = current.getTestEndpoint(0)
+        return props
@@ -7,10 +7,14 @@ import uuid
 
 domainId = uuid.uuid4() # Ensures each test uses a unique domain ID
 
-props = lambda process, current: {
+#
+# With batchServers=False, the servers behave like peers which don't support batched lookups
+#
+props = lambda batchServers: lambda process, current: {
     "IceDiscovery.Timeout": 50,
     "IceDiscovery.RetryCount": 20,
     "IceDiscovery.DomainId": domainId,
+    "IceDiscovery.BatchSize": 32 if batchServers or not isinstance(process, Server) else 0,
     "IceDiscovery.Interface": "" if isinstance(platform, Linux) else "::1" if current.config.ipv6 else "127.0.0.1",
     "IceDiscovery.Port": current.driver.getTestPort(10),
     "Ice.Plugin.IceDiscovery": current.getPluginEntryPoint("IceDiscovery", process),
@@ -48,7 +52,11 @@ if isinstance(platform,AIX):
     options = { "ipv6" : [False] }
 
 TestSuite(__name__, [
-   ClientServerTestCase(client=Client(args=[3], props=props, outfilters=outfilters),
-                        servers=[Server(args=[i], readyCount=4, props=props) for i in range(0, 3)],
+   ClientServerTestCase(client=Client(args=[3], props=props(True), outfilters=outfilters),
+                        servers=[Server(args=[i], readyCount=4, props=props(True)) for i in range(0, 3)],
+                        traceProps=traceProps),
+   ClientServerTestCase("client/server without batched lookups on the servers",
+                        client=Client(args=[3], props=props(False), outfilters=outfilters),
+                        servers=[Server(args=[i], readyCount=4, props=props(False)) for i in range(0, 3)],
                         traceProps=traceProps)
 ], multihost=False, options=options)